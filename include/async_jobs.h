@@ -0,0 +1,158 @@
+/**
+ * @file async_jobs.h
+ * @brief Pooled job handles for background work started from the C API
+ *
+ * A job is a unit of work run on a ThreadPool plus a slot that holds its
+ * state and result until the caller releases it. Slots are recycled, so
+ * submitting a job does not allocate once the table has warmed up.
+ *
+ * Handles carry the slot index and a generation counter: a handle that
+ * outlives barcode_job_release() (or is simply made up) is rejected
+ * instead of aliasing a newer job.
+ *
+ * Completion callbacks either run on the worker that finished the job or
+ * are queued until the owner calls dispatchCompletions() on a thread of its
+ * choosing (Creo's UI thread, where Pro/TOOLKIT calls are allowed).
+ */
+
+#ifndef ASYNC_JOBS_H
+#define ASYNC_JOBS_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include "thread_pool.h"
+
+namespace creo_barcode {
+
+using JobHandle = uint64_t;     // 0 is never a valid handle
+
+enum class JobState {
+    PENDING,        // Queued, not started
+    RUNNING,
+    SUCCEEDED,
+    FAILED
+};
+
+enum class CallbackMode {
+    WORKER_THREAD,  // Invoke on the worker as soon as the job finishes
+    DISPATCHED      // Queue for AsyncJobTable::dispatchCompletions()
+};
+
+class AsyncJobTable {
+public:
+    /**
+     * @brief Job body: fill result or error and return success
+     */
+    using Work = std::function<bool(std::string& result, std::string& error)>;
+    using Completion = std::function<void(JobHandle job, JobState state)>;
+
+    /**
+     * @param pool Pool the jobs run on (not owned, must outlive the table)
+     */
+    explicit AsyncJobTable(ThreadPool& pool) : pool_(pool) {}
+
+    /**
+     * @brief Waits for running jobs so their slots are never written after destruction
+     */
+    ~AsyncJobTable();
+
+    AsyncJobTable(const AsyncJobTable&) = delete;
+    AsyncJobTable& operator=(const AsyncJobTable&) = delete;
+
+    /**
+     * @brief Start a job
+     * @return Job handle, or 0 if the pool no longer accepts work
+     */
+    JobHandle submit(Work work, Completion completion = nullptr,
+                     CallbackMode mode = CallbackMode::WORKER_THREAD);
+
+    /**
+     * @brief Current state without blocking
+     * @return false if the handle is not a live job
+     */
+    bool poll(JobHandle job, JobState& state) const;
+
+    /**
+     * @brief Block until the job finishes or the timeout elapses
+     * @param timeoutMs Milliseconds to wait; negative waits forever
+     * @return false if the handle is not a live job
+     *
+     * On timeout returns true with state PENDING or RUNNING.
+     */
+    bool wait(JobHandle job, int timeoutMs, JobState& state) const;
+
+    /**
+     * @brief Copy a finished job's result and error text
+     * @return false if the handle is not live or the job has not finished
+     */
+    bool getResult(JobHandle job, std::string& result, std::string& error) const;
+
+    /**
+     * @brief Return the job's slot to the pool
+     *
+     * A job released before it finishes still runs to completion (and its
+     * callback still fires); the slot is recycled afterwards.
+     * @return false if the handle is not a live job
+     */
+    bool release(JobHandle job);
+
+    /**
+     * @brief Run queued DISPATCHED callbacks on the calling thread
+     * @return Number of callbacks run
+     */
+    size_t dispatchCompletions();
+
+    /**
+     * @brief Slots in use: unreleased jobs plus released jobs still running
+     */
+    size_t liveJobs() const;
+
+    /**
+     * @brief Slots allocated so far (live plus recycled)
+     */
+    size_t slotCount() const;
+
+private:
+    struct Slot {
+        uint32_t generation = 1;
+        bool live = false;
+        bool released = false;
+        JobState state = JobState::PENDING;
+        std::string result;
+        std::string error;
+    };
+
+    struct PendingCallback {
+        Completion completion;
+        JobHandle job;
+        JobState state;
+    };
+
+    // Slot for a live handle, or nullptr; caller holds mutex_
+    Slot* findLocked(JobHandle job);
+    const Slot* findLocked(JobHandle job) const;
+    void recycleLocked(uint32_t index);
+    void run(uint32_t index, JobHandle job, const Work& work,
+             const Completion& completion, CallbackMode mode);
+
+    static JobHandle makeHandle(uint32_t index, uint32_t generation) {
+        return (static_cast<uint64_t>(generation) << 32) | (static_cast<uint64_t>(index) + 1);
+    }
+
+    ThreadPool& pool_;
+    mutable std::mutex mutex_;
+    mutable std::condition_variable finished_;
+    std::deque<Slot> slots_;                // deque: slots never move
+    std::vector<uint32_t> freeSlots_;
+    std::vector<PendingCallback> callbacks_;
+    size_t unfinished_ = 0;
+};
+
+} // namespace creo_barcode
+
+#endif // ASYNC_JOBS_H
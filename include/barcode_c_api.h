@@ -54,6 +54,73 @@ int barcode_generate(const char* data, const BarcodeConfigC* config, const char*
  */
 int barcode_decode(const char* imagePath, char* outputBuffer, int bufferSize);
 
+/* ============================================================================
+ * In-Memory Images
+ *
+ * Render and decode without a temporary file, so image bytes can be handed
+ * straight to verification or another consumer.
+ * ============================================================================ */
+
+/* In-memory image formats */
+typedef enum {
+    BARCODE_IMAGE_PNG = 0,      /* PNG file bytes */
+    BARCODE_IMAGE_GRAY8 = 1     /* 8-bit grayscale pixels, rows tightly packed */
+} BarcodeImageFormatC;
+
+/* Image buffer filled by barcode_render_to_buffer */
+typedef struct {
+    unsigned char* data;    /* In: caller buffer, or NULL to let the library allocate */
+    int capacity;           /* In: size of the caller buffer in bytes */
+    int size;               /* Out: bytes used (required size if the buffer was too small) */
+    int width;              /* Out: image width in pixels */
+    int height;             /* Out: image height in pixels */
+    int libraryOwned;       /* Out: 1 if data must be released with barcode_free_buffer */
+} BarcodeImageBufferC;
+
+/* Render a barcode into memory
+ * With image->data set, writes into the caller's buffer; with image->data
+ * NULL, allocates a buffer that the caller releases with barcode_free_buffer.
+ * @param data The data to encode
+ * @param config Barcode configuration
+ * @param format Output format
+ * @param image In/out buffer description
+ * @return 0 on success, 1 if the caller buffer is too small (image->size
+ *         holds the required size), -1 on error
+ */
+int barcode_render_to_buffer(const char* data,
+                             const BarcodeConfigC* config,
+                             BarcodeImageFormatC format,
+                             BarcodeImageBufferC* image);
+
+/* Release a library-owned buffer from barcode_render_to_buffer
+ * Does nothing for caller-owned buffers. Resets data, size and libraryOwned.
+ */
+void barcode_free_buffer(BarcodeImageBufferC* image);
+
+/* Decode a barcode from pixels in memory
+ * @param pixels First row of the image
+ * @param width Width in pixels
+ * @param height Height in pixels
+ * @param stride Bytes per row (0 = width * channels)
+ * @param channels 1 (gray), 3 (RGB) or 4 (RGBA)
+ * @param outputBuffer Buffer to store decoded data (NUL-terminated)
+ * @param bufferSize Size of the output buffer
+ * @param textLength Output: full length of the decoded text (can be NULL)
+ * @return 0 on success, 1 if the text was truncated, -1 on error
+ */
+int barcode_decode_buffer(const unsigned char* pixels,
+                          int width, int height,
+                          int stride, int channels,
+                          char* outputBuffer, int bufferSize,
+                          int* textLength);
+
+/* Decode a barcode from encoded image bytes (PNG, BMP, JPEG) in memory
+ * Return values and outputs as for barcode_decode_buffer.
+ */
+int barcode_decode_image_buffer(const unsigned char* bytes, int size,
+                                char* outputBuffer, int bufferSize,
+                                int* textLength);
+
 /* Load configuration from file
  * @param configPath Path to config file
  * @return 0 on success, non-zero on error
@@ -76,9 +143,152 @@ void config_get_defaults(BarcodeConfigC* config);
  */
 int sync_check(const char* partName, const char* barcodeData);
 
-/* Get last error message */
+/* Intern a string (part name, payload, path) in the shared string pool
+ * @param str NUL-terminated string
+ * @return Stable pointer owned by the library, valid until process exit;
+ *         equal strings always return the same pointer. NULL if str is NULL.
+ *         Passing interned pointers to sync_check lets it compare pointers.
+ */
+const char* barcode_intern(const char* str);
+
+/* Get last error message of the calling thread */
 const char* barcode_get_last_error(void);
 
+/* Timed stages reported by barcode_get_stats */
+typedef enum {
+    BARCODE_STAGE_GENERATE = 0,     /* Whole generate call */
+    BARCODE_STAGE_ENCODE = 1,       /* Symbol encoding */
+    BARCODE_STAGE_PNG_WRITE = 2,    /* PNG compression and file write */
+    BARCODE_STAGE_DECODE = 3,       /* Image load and barcode read */
+    BARCODE_STAGE_SYNC_CHECK = 4,   /* Part name / barcode comparison */
+    BARCODE_STAGE_COM_INSERT = 5,   /* Image insertion via COM */
+    BARCODE_STAGE_COUNT = 6
+} BarcodeStageC;
+
+/* Timings for one stage (microseconds) */
+typedef struct {
+    unsigned long long count;       /* Completed calls */
+    double totalMicros;             /* Cumulative time */
+    double p50Micros;               /* Median, within 12.5% */
+    double p99Micros;               /* 99th percentile, within 12.5% */
+} StageStatsC;
+
+/* Session statistics */
+typedef struct {
+    unsigned long long barcodesGenerated;
+    unsigned long long cacheHits;           /* Renders served from the render cache */
+    unsigned long long decodeAttempts;
+    unsigned long long decodeFailures;
+    unsigned long long bytesWritten;        /* Image bytes written to disk */
+    StageStatsC stages[BARCODE_STAGE_COUNT];   /* Indexed by BarcodeStageC */
+} BarcodeStatsC;
+
+/* Get statistics accumulated since load or the last barcode_reset_stats
+ * Safe to call at any time, including while a batch is running.
+ * @param stats Output structure
+ * @return 0 on success, non-zero if stats is NULL
+ */
+int barcode_get_stats(BarcodeStatsC* stats);
+
+/* Reset all statistics to zero */
+void barcode_reset_stats(void);
+
+/* Get stage name ("generate", "png_write", ...) for display
+ * @return Static string, "unknown" for out-of-range values
+ */
+const char* barcode_stage_name(BarcodeStageC stage);
+
+/* ============================================================================
+ * Asynchronous Jobs
+ *
+ * Generation and decoding can run on an internal worker pool so Creo's UI
+ * thread stays responsive. Each submit call returns a job handle that stays
+ * valid until barcode_job_release; handles are recycled internally, so
+ * releasing every job is required. All functions here are thread-safe.
+ * ============================================================================ */
+
+/* Job handle; 0 is never a valid job */
+typedef unsigned long long BarcodeJobHandle;
+
+/* Job status codes */
+typedef enum {
+    BARCODE_JOB_INVALID = -1,       /* Unknown or released handle */
+    BARCODE_JOB_PENDING = 0,        /* Queued */
+    BARCODE_JOB_RUNNING = 1,
+    BARCODE_JOB_SUCCEEDED = 2,
+    BARCODE_JOB_FAILED = 3
+} BarcodeJobStatusC;
+
+/* Where completion callbacks run */
+typedef enum {
+    BARCODE_CALLBACK_WORKER = 0,    /* On the worker thread, as soon as the job finishes */
+    BARCODE_CALLBACK_DISPATCH = 1   /* On the thread that calls barcode_dispatch_callbacks */
+} BarcodeCallbackModeC;
+
+/* Completion callback
+ * @param job Finished job (still valid until released)
+ * @param status BARCODE_JOB_SUCCEEDED or BARCODE_JOB_FAILED
+ * @param userData Pointer passed at submission
+ * Worker-thread callbacks must not call Pro/TOOLKIT functions.
+ */
+typedef void (*BarcodeJobCallback)(BarcodeJobHandle job, int status, void* userData);
+
+/* Start generating a barcode image in the background
+ * Arguments are copied; they need not outlive the call.
+ * @param callback Completion callback (can be NULL)
+ * @param userData Passed to the callback
+ * @param mode Where the callback runs
+ * @return Job handle, or 0 on invalid parameters (see barcode_get_last_error)
+ */
+BarcodeJobHandle barcode_submit_generate(const char* data,
+                                         const BarcodeConfigC* config,
+                                         const char* outputPath,
+                                         BarcodeJobCallback callback,
+                                         void* userData,
+                                         BarcodeCallbackModeC mode);
+
+/* Start decoding a barcode image in the background
+ * The decoded text is available through barcode_job_get_result.
+ * @return Job handle, or 0 on invalid parameters (see barcode_get_last_error)
+ */
+BarcodeJobHandle barcode_submit_decode(const char* imagePath,
+                                       BarcodeJobCallback callback,
+                                       void* userData,
+                                       BarcodeCallbackModeC mode);
+
+/* Get job status without blocking
+ * @return BarcodeJobStatusC value
+ */
+int barcode_job_poll(BarcodeJobHandle job);
+
+/* Wait for a job to finish
+ * @param timeoutMs Maximum wait in milliseconds; negative waits forever
+ * @return BarcodeJobStatusC value (PENDING/RUNNING on timeout)
+ */
+int barcode_job_wait(BarcodeJobHandle job, int timeoutMs);
+
+/* Copy a successful job's result (decoded text; empty for generation)
+ * @return 0 on success, non-zero if the job is unknown, unfinished or failed
+ */
+int barcode_job_get_result(BarcodeJobHandle job, char* buffer, int bufferSize);
+
+/* Copy a failed job's error message
+ * @return 0 on success, non-zero if the job is unknown or unfinished
+ */
+int barcode_job_get_error(BarcodeJobHandle job, char* buffer, int bufferSize);
+
+/* Release a job handle
+ * A job released before it finishes still runs (and its callback fires).
+ * @return 0 on success, non-zero if the handle is unknown
+ */
+int barcode_job_release(BarcodeJobHandle job);
+
+/* Run queued BARCODE_CALLBACK_DISPATCH callbacks on the calling thread
+ * Call periodically from the thread that should receive completions.
+ * @return Number of callbacks run
+ */
+int barcode_dispatch_callbacks(void);
+
 /* Get current configuration */
 void config_get_current(BarcodeConfigC* config);
 
@@ -151,7 +361,8 @@ int barcode_generate_for_part(const char* partName,
 int com_bridge_init(void);
 
 /* Cleanup COM bridge resources
- * Should be called when plugin unloads.
+ * Should be called when plugin unloads, before the DLL is detached:
+ * it stops the COM link's reconnect thread.
  */
 void com_bridge_cleanup(void);
 
@@ -218,6 +429,17 @@ int barcode_batch_insert_images_grid(const char** imagePaths,
  */
 const char* com_bridge_get_last_error(void);
 
+/* Begin a drawing edit transaction
+ * Image insertions until the matching com_bridge_end_edit() do not repaint
+ * the window; the outermost end repaints once. Calls may nest.
+ */
+void com_bridge_begin_edit(void);
+
+/* End a drawing edit transaction started with com_bridge_begin_edit()
+ * @return 0 on success, non-zero if the final repaint failed
+ */
+int com_bridge_end_edit(void);
+
 /* ============================================================================
  * Fallback Mechanism for Image Insertion
  * ============================================================================ */
@@ -3,7 +3,11 @@
 
 #include <string>
 #include <optional>
+#include <vector>
+#include <cstdint>
+#include <future>
 #include "error_codes.h"
+#include "result.h"
 
 namespace creo_barcode {
 
@@ -15,6 +19,9 @@ enum class BarcodeType {
     EAN_13
 };
 
+class GeneratedBarcodeFilter;
+class RenderCache;
+
 struct BarcodeConfig {
     BarcodeType type = BarcodeType::CODE_128;
     int width = 200;
@@ -43,21 +50,64 @@ public:
     // Decode special characters (reverse of encodeSpecialChars)
     std::string decodeSpecialChars(const std::string& input);
     
+    // Render to 8-bit grayscale pixels (config.width x config.height, no padding)
+    bool renderGray(const std::string& data,
+                    const BarcodeConfig& config,
+                    std::vector<uint8_t>& pixels);
+    
+    // Render to PNG bytes in memory (same image generate() writes to disk)
+    bool renderPng(const std::string& data,
+                   const BarcodeConfig& config,
+                   std::vector<uint8_t>& png);
+    
     // Decode barcode from image (for verification)
     std::optional<std::string> decode(const std::string& imagePath);
     
+    // Decode barcode from pixels in memory
+    // channels: 1 (gray), 3 (RGB) or 4 (RGBA); rowStride 0 means tightly packed
+    std::optional<std::string> decodePixels(const uint8_t* pixels, int width, int height,
+                                            int rowStride, int channels);
+    
+    // Decode barcode from an encoded image (PNG, BMP, JPEG) in memory
+    std::optional<std::string> decodeImageData(const uint8_t* bytes, size_t size);
+    
+    // Asynchronous variants on ThreadPool::shared(). Each call has its own
+    // generator state, so calls may overlap freely and never change
+    // getLastError(). The generated-barcode filter (if set) is shared and
+    // must outlive the returned futures.
+    std::future<Result<void>> generateAsync(const std::string& data,
+                                            const BarcodeConfig& config,
+                                            const std::string& outputPath) const;
+    std::future<Result<std::string>> decodeAsync(const std::string& imagePath) const;
+    
     // Get image dimensions
     bool getImageSize(const std::string& imagePath, int& width, int& height);
     
-    // Get last error
-    ErrorInfo getLastError() const { return lastError_; }
+    // Get last error (builds the strings; hot paths should use lastError())
+    ErrorInfo getLastError() const { return lastError_.toErrorInfo(); }
+    const Error& lastError() const { return lastError_; }
+    
+    // Record every successfully generated (data, config) pair in a filter
+    // (not owned; nullptr disables recording)
+    void setGeneratedFilter(GeneratedBarcodeFilter* filter) { generatedFilter_ = filter; }
+    
+    // Reuse and record rendered pixels in a cache (not owned; nullptr
+    // disables caching). Shared by the async variants like the filter.
+    void setRenderCache(RenderCache* cache) { renderCache_ = cache; }
     
 private:
+    // Validate and encode into config.width x config.height grayscale pixels
+    bool renderPixels(const std::string& data, const BarcodeConfig& config, std::vector<uint8_t>& pixels);
+    std::optional<std::string> readBarcode(const uint8_t* pixels, int width, int height,
+                                           int rowStride, int channels);
+    
     bool generateCode128(const std::string& data, const BarcodeConfig& config, const std::string& outputPath);
     bool generateCode39(const std::string& data, const BarcodeConfig& config, const std::string& outputPath);
     bool generateQRCode(const std::string& data, const BarcodeConfig& config, const std::string& outputPath);
     
-    ErrorInfo lastError_;
+    Error lastError_;
+    GeneratedBarcodeFilter* generatedFilter_ = nullptr;
+    RenderCache* renderCache_ = nullptr;
 };
 
 // Utility functions
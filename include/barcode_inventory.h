@@ -0,0 +1,174 @@
+/**
+ * @file barcode_inventory.h
+ * @brief Columnar barcode inventory for drawing-wide audits
+ *
+ * Stores barcode instances and their sync status as a struct of arrays:
+ * - Strings (paths, payloads, timestamps) are interned once and referenced
+ *   by 32-bit ids, so a drawing path shared by thousands of barcodes is
+ *   stored once
+ * - Numeric fields live in fixed-width columns (about 38 bytes per barcode)
+ * - Filters by status, type and sheet scan a single column with SIMD
+ *   compares and return row selections that can be chained
+ * - Columns are written to disk as-is for compact persistence
+ */
+
+#ifndef BARCODE_INVENTORY_H
+#define BARCODE_INVENTORY_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <cstdint>
+#include "error_codes.h"
+#include "barcode_generator.h"
+#include "data_sync_checker.h"
+
+namespace creo_barcode {
+
+/**
+ * @brief Row indices produced by inventory filters, in ascending order
+ */
+using InventorySelection = std::vector<uint32_t>;
+
+/**
+ * @brief Struct-of-arrays store of barcode instances
+ *
+ * Not thread-safe; build it on one thread, then query freely.
+ * string_views returned by accessors stay valid until the next add() or
+ * upsert().
+ */
+class BarcodeInventory {
+public:
+    static constexpr size_t STATUS_COUNT = static_cast<size_t>(SyncStatus::UNKNOWN) + 1;
+
+    BarcodeInventory();
+
+    /**
+     * @brief Append a barcode instance
+     * @param instance Barcode found in a drawing
+     * @param status Sync status of the barcode
+     * @param currentPartName Part name the barcode was checked against
+     * @return Row index of the new entry
+     */
+    size_t add(const BarcodeInstance& instance,
+               SyncStatus status = SyncStatus::UNKNOWN,
+               std::string_view currentPartName = {});
+
+    /**
+     * @brief Append a barcode instance together with its sync check result
+     */
+    size_t add(const BarcodeInstance& instance, const SyncCheckResult& result);
+
+    /**
+     * @brief Record the latest check of a barcode, replacing its earlier row
+     *
+     * Rows are keyed on (drawing, sheet, image) as PayloadIndex entries are,
+     * so checking the same barcode again updates its row instead of adding
+     * a duplicate that the status counts would see twice.
+     * @return Row index of the barcode
+     */
+    size_t upsert(const BarcodeInstance& instance, const SyncCheckResult& result);
+
+    void reserve(size_t rows);
+    void clear();
+    size_t size() const { return sheet_.size(); }
+
+    // Column accessors
+    std::string_view drawingPathAt(size_t row) const { return str(drawingPath_[row]); }
+    std::string_view imagePathAt(size_t row) const { return str(imagePath_[row]); }
+    std::string_view encodedDataAt(size_t row) const { return str(encodedData_[row]); }
+    std::string_view decodedDataAt(size_t row) const { return str(decodedData_[row]); }
+    std::string_view partNameAt(size_t row) const { return str(partName_[row]); }
+    std::string_view timestampAt(size_t row) const { return str(timestamp_[row]); }
+    int sheetAt(size_t row) const { return sheet_[row]; }
+    BarcodeType typeAt(size_t row) const { return static_cast<BarcodeType>(type_[row]); }
+    SyncStatus statusAt(size_t row) const { return static_cast<SyncStatus>(status_[row]); }
+
+    void setStatus(size_t row, SyncStatus status) { status_[row] = static_cast<uint8_t>(status); }
+
+    /**
+     * @brief Materialize a row back into a BarcodeInstance
+     */
+    BarcodeInstance instanceAt(size_t row) const;
+
+    /**
+     * @brief Select rows matching a value
+     * @param within Restrict the scan to a previous selection (nullptr = all rows)
+     */
+    InventorySelection filterByStatus(SyncStatus status, const InventorySelection* within = nullptr) const;
+    InventorySelection filterByType(BarcodeType type, const InventorySelection* within = nullptr) const;
+    InventorySelection filterBySheet(int sheet, const InventorySelection* within = nullptr) const;
+    InventorySelection filterByDrawing(std::string_view drawingPath, const InventorySelection* within = nullptr) const;
+
+    /**
+     * @brief Number of rows in each SyncStatus, indexed by the enum value
+     */
+    std::array<size_t, STATUS_COUNT> countByStatus() const;
+
+    /**
+     * @brief Number of distinct interned strings
+     */
+    size_t stringCount() const { return stringOffsets_.size() - 1; }
+
+    /**
+     * @brief Heap memory used by columns and the string table
+     */
+    size_t memoryBytes() const;
+
+    /**
+     * @brief Human-readable audit summary (counts per status and type)
+     */
+    std::string getSummary() const;
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    ErrorInfo getLastError() const { return lastError_; }
+
+private:
+    // Interned strings: one blob plus offsets, deduplicated through an
+    // open-addressing table of ids (0 = empty slot, otherwise id + 1)
+    std::string stringBlob_;
+    std::vector<uint32_t> stringOffsets_;
+    std::vector<uint32_t> stringSlots_;
+
+    std::vector<uint32_t> drawingPath_;
+    std::vector<uint32_t> imagePath_;
+    std::vector<uint32_t> encodedData_;
+    std::vector<uint32_t> decodedData_;
+    std::vector<uint32_t> partName_;
+    std::vector<uint32_t> timestamp_;
+    std::vector<int32_t> sheet_;
+    std::vector<float> posX_;
+    std::vector<float> posY_;
+    std::vector<uint8_t> type_;
+    std::vector<uint8_t> status_;
+
+    // Latest row of each (drawing, image, sheet), for upsert()
+    struct RowKey {
+        uint32_t drawingPath;
+        uint32_t imagePath;
+        int32_t sheet;
+        bool operator==(const RowKey& other) const {
+            return drawingPath == other.drawingPath && imagePath == other.imagePath && sheet == other.sheet;
+        }
+    };
+    struct RowKeyHash {
+        size_t operator()(const RowKey& key) const;
+    };
+    std::unordered_map<RowKey, uint32_t, RowKeyHash> rows_;
+
+    mutable ErrorInfo lastError_;
+
+    uint32_t intern(std::string_view value);
+    std::string_view str(uint32_t id) const;
+    bool findString(std::string_view value, uint32_t& id) const;
+    void rebuildSlots(size_t slotCount);
+    void rebuildRows();
+};
+
+} // namespace creo_barcode
+
+#endif // BARCODE_INVENTORY_H
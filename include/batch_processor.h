@@ -4,7 +4,11 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <mutex>
+#include <condition_variable>
 #include "barcode_generator.h"
+#include "directory_scanner.h"
+#include "batch_tuning.h"
 
 namespace creo_barcode {
 
@@ -22,6 +26,13 @@ class BatchProcessor {
 public:
     using ProgressCallback = std::function<void(int current, int total)>;
     
+    // Per-file work of one stage; returns false with error set on failure.
+    // Called concurrently from the stage's workers.
+    using StageFunction = std::function<bool(const std::string& filePath, std::string& error)>;
+    
+    static constexpr size_t DEFAULT_MAX_WRITE_WORKERS = 16;
+    static constexpr size_t DEFAULT_INITIAL_WRITE_WORKERS = 4;
+    
     BatchProcessor() = default;
     ~BatchProcessor() = default;
     
@@ -35,17 +46,64 @@ public:
     void clear();
     
     // Get queue size
-    size_t getQueueSize() const { return fileQueue_.size(); }
+    size_t getQueueSize() const;
+    
+    // Streaming input: while the queue is open, files may be added from other
+    // threads during process(), which waits for more files at the end of the
+    // queue instead of returning. closeQueue() ends the input. Progress totals
+    // grow as files arrive.
+    void openQueue();
+    void closeQueue();
+    bool isQueueOpen() const;
     
-    // Execute batch processing
+    // Execute batch processing. Each file passes through the render stage
+    // (CPU-bound) and then the write stage (I/O-bound). Each stage has its own
+    // worker limit, tuned while the run goes on. Progress is reported on the
+    // calling thread as files finish. Results keep queue order.
     std::vector<BatchResult> process(const BarcodeConfig& config,
                                      ProgressCallback progressCallback = nullptr);
     
-    // Get processing summary
-    static std::string getSummary(const std::vector<BatchResult>& results);
+    // Stage work. Without a render stage files go straight to writing; the
+    // default write stage checks that the drawing can be opened.
+    void setRenderStage(StageFunction stage) { renderStage_ = std::move(stage); }
+    void setWriteStage(StageFunction stage) { writeStage_ = std::move(stage); }
+    
+    // Upper bounds for the tuned worker limits (0 = default: the hardware
+    // concurrency for render, DEFAULT_MAX_WRITE_WORKERS for write)
+    void setConcurrencyLimits(size_t maxRenderWorkers, size_t maxWriteWorkers);
+    
+    // Stage timings of earlier runs (not owned). A run in a known environment
+    // starts from the limits the last run there settled on, and each run
+    // is merged back into the history.
+    void setTimingHistory(TimingHistory* history) { timingHistory_ = history; }
+    
+    // Concurrency chosen by the last process() run
+    const BatchTuning& getLastTuning() const { return lastTuning_; }
+    
+    // Discover the files under roots with a DirectoryScanner and process them
+    // as they are found. The scan statistics are stored in scanStats, if given.
+    std::vector<BatchResult> processDirectories(const std::vector<std::string>& roots,
+                                                const ScanOptions& scanOptions,
+                                                const BarcodeConfig& config,
+                                                ProgressCallback progressCallback = nullptr,
+                                                ScanStats* scanStats = nullptr);
+    
+    // Get processing summary, with the chosen concurrency if tuning is given
+    static std::string getSummary(const std::vector<BatchResult>& results,
+                                  const BatchTuning* tuning = nullptr);
     
 private:
     std::vector<std::string> fileQueue_;
+    mutable std::mutex queueMutex_;
+    std::condition_variable queueChanged_;
+    bool queueOpen_ = false;
+    
+    StageFunction renderStage_;
+    StageFunction writeStage_;
+    size_t maxRenderWorkers_ = 0;
+    size_t maxWriteWorkers_ = 0;
+    TimingHistory* timingHistory_ = nullptr;
+    BatchTuning lastTuning_;
 };
 
 } // namespace creo_barcode
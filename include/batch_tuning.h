@@ -0,0 +1,171 @@
+/**
+ * @file batch_tuning.h
+ * @brief Adaptive concurrency for batch stages, remembered across runs
+ *
+ * The right number of workers depends on the machine and on the share the
+ * drawings live on: past a point, more threads on a network share only add
+ * queueing. Each batch stage therefore gets its own ConcurrencyTuner that
+ * adjusts the worker limit while the run is going (AIMD: one more worker
+ * per healthy window, half as many when latency or throughput says the
+ * stage is saturated), and TimingHistory remembers where each environment
+ * (host + share) settled so the next run starts there instead of relearning.
+ */
+
+#ifndef BATCH_TUNING_H
+#define BATCH_TUNING_H
+
+#include <string>
+#include <map>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "error_codes.h"
+
+namespace creo_barcode {
+
+/**
+ * @brief AIMD controller for the worker limit of one stage
+ *
+ * Not thread-safe; the batch pipeline calls it under its own lock.
+ */
+class ConcurrencyTuner {
+public:
+    /**
+     * @param initial Starting limit (clamped to [minLimit, maxLimit])
+     * @param minLimit Lowest limit a decrease can reach
+     * @param maxLimit Highest limit an increase can reach
+     */
+    ConcurrencyTuner(size_t initial, size_t minLimit, size_t maxLimit);
+
+    size_t limit() const { return limit_; }
+    size_t minLimit() const { return minLimit_; }
+    size_t maxLimit() const { return maxLimit_; }
+
+    /**
+     * @brief Restart from a limit learned earlier (keeps the bounds)
+     */
+    void reset(size_t initial, double baselineLatencyUs = 0.0);
+
+    /**
+     * @brief Record one finished item
+     *
+     * Items are grouped into windows of about twice the current limit; each
+     * full window is passed to observeWindow().
+     */
+    void record(std::chrono::microseconds latency);
+
+    /**
+     * @brief Apply the AIMD rule to one window of measurements
+     *
+     * Saturated when the mean latency exceeds the best latency seen by more
+     * than the tolerance, or when throughput fell after the limit was raised:
+     * the limit is halved. Otherwise it grows by one.
+     */
+    void observeWindow(double throughput, double meanLatencyUs);
+
+    // Whole-run figures for reports and history
+    uint64_t items() const { return items_; }
+    double meanLatencyUs() const;
+    double throughput() const;          // Items per second over the windows seen
+    size_t increases() const { return increases_; }
+    size_t decreases() const { return decreases_; }
+    double baselineLatencyUs() const { return baselineLatencyUs_; }
+
+    static constexpr double LATENCY_TOLERANCE = 1.5;
+    static constexpr double THROUGHPUT_DROP = 0.9;
+
+private:
+    size_t limit_;
+    size_t minLimit_;
+    size_t maxLimit_;
+
+    // AIMD state
+    double baselineLatencyUs_ = 0.0;
+    double lastThroughput_ = 0.0;
+    size_t lastLimit_ = 0;
+    size_t increases_ = 0;
+    size_t decreases_ = 0;
+
+    // Current window
+    std::chrono::steady_clock::time_point windowStart_;
+    size_t windowItems_ = 0;
+    double windowLatencyUs_ = 0.0;
+
+    // Totals
+    uint64_t items_ = 0;
+    double totalLatencyUs_ = 0.0;
+    uint64_t windowedItems_ = 0;
+    double windowedSeconds_ = 0.0;
+};
+
+/**
+ * @brief Measured behaviour of one stage in one environment
+ */
+struct StageTiming {
+    size_t concurrency = 0;         // Limit the stage settled on
+    double meanLatencyUs = 0.0;     // Per-item time
+    double throughput = 0.0;        // Items per second
+    uint32_t runs = 0;              // Runs merged into these figures
+};
+
+struct EnvironmentTiming {
+    StageTiming render;             // CPU-bound stage
+    StageTiming write;              // I/O-bound stage
+};
+
+/**
+ * @brief Stage timings of previous runs, keyed by environment
+ *
+ * Stored as a small JSON file next to the payload index.
+ */
+class TimingHistory {
+public:
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    bool find(const std::string& environment, EnvironmentTiming& timing) const;
+
+    /**
+     * @brief Merge a finished run into an environment's history
+     *
+     * The settled concurrency replaces the old one; latency and throughput
+     * are smoothed so one unusual run does not dominate.
+     */
+    void record(const std::string& environment, const EnvironmentTiming& run);
+
+    size_t size() const { return environments_.size(); }
+    void clear() { environments_.clear(); }
+
+    /**
+     * @brief Environment key for a batch: "<host>|<share of sampleFile>"
+     */
+    static std::string environmentKey(const std::string& sampleFile);
+
+    ErrorInfo getLastError() const { return lastError_; }
+
+private:
+    std::map<std::string, EnvironmentTiming> environments_;
+    mutable ErrorInfo lastError_;
+};
+
+/**
+ * @brief Concurrency chosen for one stage of a run, for the run summary
+ */
+struct StageTuning {
+    size_t initial = 0;             // Limit the run started with
+    size_t settled = 0;             // Limit it ended with
+    size_t peak = 0;                // Most workers busy at once (0 = stage unused)
+    bool fromHistory = false;       // initial came from a previous run
+    double meanLatencyUs = 0.0;
+    double throughput = 0.0;
+};
+
+struct BatchTuning {
+    std::string environment;
+    StageTuning render;
+    StageTuning write;
+};
+
+} // namespace creo_barcode
+
+#endif // BATCH_TUNING_H
@@ -0,0 +1,287 @@
+/**
+ * @file binary_log.h
+ * @brief Structured binary logging with deferred formatting
+ *
+ * Call sites record a format ID plus the raw argument values; no text is
+ * produced at runtime:
+ * - Each call site registers its format string once, on first use
+ * - Events are appended to a per-thread buffer (no shared lock on the hot
+ *   path) and written to the log file in blocks
+ * - The file is self-describing: format strings are stored alongside the
+ *   events, so BinaryLogDecoder (and the creo_log_decoder tool) can render
+ *   human-readable text later
+ *
+ * Usage:
+ *   BLOG_INFO("Position: ({}, {})", x, y);
+ */
+
+#ifndef BINARY_LOG_H
+#define BINARY_LOG_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include "log_level.h"
+#include "error_codes.h"
+#include "mapped_file.h"
+
+namespace creo_barcode {
+
+/**
+ * @brief Static description of one logging call site
+ *
+ * Constant-initialized, so a function-local static LogSite costs no
+ * guard and is safe to use during DLL load.
+ */
+struct LogSite {
+    LogLevel level;
+    const char* file;
+    int line;
+    mutable std::atomic<uint32_t> id;   // 0 until the format is registered
+
+    constexpr LogSite(LogLevel lvl, const char* f, int l) : level(lvl), file(f), line(l), id(0) {}
+};
+
+/**
+ * @brief Type tags of encoded arguments
+ */
+enum class LogArgType : uint8_t {
+    INT64 = 1,
+    UINT64 = 2,
+    DOUBLE = 3,
+    BOOL = 4,
+    STRING = 5
+};
+
+namespace binary_log_detail {
+
+struct ThreadBuffer {
+    std::mutex mutex;
+    std::vector<char> data;
+    uint32_t threadIndex = 0;
+};
+
+template <typename T>
+inline void appendRaw(std::vector<char>& out, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+inline void appendString(std::vector<char>& out, std::string_view value) {
+    out.push_back(static_cast<char>(LogArgType::STRING));
+    appendRaw(out, static_cast<uint32_t>(value.size()));
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+inline void appendArg(std::vector<char>& out, const std::string& value) { appendString(out, value); }
+inline void appendArg(std::vector<char>& out, std::string_view value) { appendString(out, value); }
+inline void appendArg(std::vector<char>& out, const char* value) { appendString(out, value ? value : "(null)"); }
+inline void appendArg(std::vector<char>& out, char* value) { appendString(out, value ? value : "(null)"); }
+
+template <size_t N>
+inline void appendArg(std::vector<char>& out, const char (&value)[N]) {
+    appendString(out, std::string_view(value, N > 0 && value[N - 1] == '\0' ? N - 1 : N));
+}
+
+template <typename T>
+inline void appendArg(std::vector<char>& out, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        out.push_back(static_cast<char>(LogArgType::BOOL));
+        out.push_back(value ? 1 : 0);
+    } else if constexpr (std::is_enum_v<T>) {
+        out.push_back(static_cast<char>(LogArgType::INT64));
+        appendRaw(out, static_cast<int64_t>(value));
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        out.push_back(static_cast<char>(LogArgType::INT64));
+        appendRaw(out, static_cast<int64_t>(value));
+    } else if constexpr (std::is_integral_v<T>) {
+        out.push_back(static_cast<char>(LogArgType::UINT64));
+        appendRaw(out, static_cast<uint64_t>(value));
+    } else if constexpr (std::is_floating_point_v<T>) {
+        out.push_back(static_cast<char>(LogArgType::DOUBLE));
+        appendRaw(out, static_cast<double>(value));
+    } else {
+        static_assert(sizeof(T) == 0, "Unsupported binary log argument type");
+    }
+}
+
+uint64_t currentTimeNanos();
+
+} // namespace binary_log_detail
+
+/**
+ * @brief Process-wide binary log writer
+ *
+ * Disabled until open() succeeds; while disabled, write() returns after a
+ * single relaxed atomic load.
+ */
+class BinaryLog {
+public:
+    static BinaryLog& getInstance();
+
+    /**
+     * @brief Default log path (%TEMP%\\creo_barcode.blog or /tmp/creo_barcode.blog)
+     */
+    static std::string defaultPath();
+
+    /**
+     * @brief Start logging to a file (truncates it)
+     * @return true if the file was opened
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Flush all buffers and stop logging
+     */
+    void close();
+
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Record one event
+     * @param site Call site (level, file, line)
+     * @param format Format string with "{}" placeholders; must be a literal
+     * @param args Values to substitute, stored in binary form
+     */
+    template <typename... Args>
+    void write(const LogSite& site, const char* format, const Args&... args) {
+        if (!isEnabled()) {
+            return;
+        }
+        uint32_t id = site.id.load(std::memory_order_acquire);
+        if (id == 0) {
+            id = registerSite(site, format);
+        }
+
+        binary_log_detail::ThreadBuffer& buffer = localBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        std::vector<char>& out = buffer.data;
+        out.push_back(RECORD_EVENT);
+        binary_log_detail::appendRaw(out, id);
+        binary_log_detail::appendRaw(out, binary_log_detail::currentTimeNanos());
+        binary_log_detail::appendRaw(out, buffer.threadIndex);
+        out.push_back(static_cast<char>(sizeof...(Args)));
+        (binary_log_detail::appendArg(out, args), ...);
+
+        if (out.size() >= FLUSH_THRESHOLD) {
+            writeBlock(out);
+        }
+    }
+
+    /**
+     * @brief Write every thread's pending events to the file
+     */
+    void flush();
+
+    /**
+     * @brief Number of bytes written to the current file
+     */
+    uint64_t bytesWritten() const { return bytesWritten_.load(std::memory_order_relaxed); }
+
+    ErrorInfo getLastError() const;
+
+    static constexpr char RECORD_EVENT = 1;
+    static constexpr char RECORD_FORMAT = 2;
+    static constexpr uint32_t FILE_VERSION = 1;
+
+private:
+    static constexpr size_t FLUSH_THRESHOLD = 60 * 1024;
+
+    struct SiteInfo {
+        LogLevel level;
+        std::string file;
+        int line;
+        std::string format;
+    };
+
+    BinaryLog() = default;
+    ~BinaryLog() = default;
+    BinaryLog(const BinaryLog&) = delete;
+    BinaryLog& operator=(const BinaryLog&) = delete;
+
+    uint32_t registerSite(const LogSite& site, const char* format);
+    binary_log_detail::ThreadBuffer& localBuffer();
+    void writeBlock(std::vector<char>& block);
+    void writeSiteRecord(uint32_t id, const SiteInfo& info);
+
+    std::atomic<bool> enabled_{false};
+    std::atomic<uint64_t> bytesWritten_{0};
+
+    // Guards the file, the site table and lastError_
+    mutable std::mutex mutex_;
+    std::ofstream file_;
+    std::vector<SiteInfo> sites_;
+    ErrorInfo lastError_;
+
+    // Guards the list of live thread buffers
+    std::mutex registryMutex_;
+    std::vector<binary_log_detail::ThreadBuffer*> buffers_;
+    uint32_t nextThreadIndex_ = 1;
+
+    friend struct BinaryLogThreadHolder;
+};
+
+/**
+ * @brief One decoded log event
+ */
+struct DecodedLogEvent {
+    LogLevel level = LogLevel::INFO;
+    uint64_t timeNanos = 0;         // Wall clock, nanoseconds since the Unix epoch
+    uint32_t threadIndex = 0;       // Small per-process thread number
+    std::string file;
+    int line = 0;
+    std::string message;            // Format with arguments substituted
+};
+
+/**
+ * @brief Reader for files written by BinaryLog
+ */
+class BinaryLogDecoder {
+public:
+    bool open(const std::string& path);
+
+    /**
+     * @brief Decode the next event
+     * @return false at end of file or on a corrupt record (see getLastError)
+     */
+    bool next(DecodedLogEvent& event);
+
+    /**
+     * @brief Render one event as "[timestamp] [LEVEL] [T<n>] message (file:line)"
+     */
+    static std::string formatEvent(const DecodedLogEvent& event);
+
+    ErrorInfo getLastError() const { return lastError_; }
+
+private:
+    MappedFile file_;
+    size_t offset_ = 0;
+    std::vector<std::pair<LogLevel, std::string>> formats_;
+    std::vector<std::pair<std::string, int>> locations_;
+    ErrorInfo lastError_;
+};
+
+} // namespace creo_barcode
+
+#define CREO_BLOG(level, ...) \
+    do { \
+        if constexpr ((level) >= ::creo_barcode::kCompiledMinLogLevel) { \
+            if (::creo_barcode::isLogLevelEnabled(level)) { \
+                static const ::creo_barcode::LogSite creoBlogSite_(level, __FILE__, __LINE__); \
+                ::creo_barcode::BinaryLog::getInstance().write(creoBlogSite_, __VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define BLOG_VERBOSE(...) CREO_BLOG(::creo_barcode::LogLevel::VERBOSE, __VA_ARGS__)
+#define BLOG_INFO(...) CREO_BLOG(::creo_barcode::LogLevel::INFO, __VA_ARGS__)
+#define BLOG_WARNING(...) CREO_BLOG(::creo_barcode::LogLevel::WARNING, __VA_ARGS__)
+#define BLOG_ERROR(...) CREO_BLOG(::creo_barcode::LogLevel::ERR, __VA_ARGS__)
+
+#endif // BINARY_LOG_H
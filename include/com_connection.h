@@ -0,0 +1,221 @@
+/**
+ * @file com_connection.h
+ * @brief Health monitoring and circuit breaking for the Creo COM link
+ *
+ * A broken COM link used to cost a full failed attempt (connect, timeout,
+ * teardown) for every image. ComConnectionManager puts a circuit breaker
+ * in front of the link:
+ *
+ *   CLOSED     requests go through; K consecutive link failures open it
+ *   OPEN       requests are rejected at once; after the backoff a probe
+ *              checks whether Creo is reachable again
+ *   HALF_OPEN  one trial request is let through; success closes the
+ *              breaker, failure reopens it with a longer backoff
+ *
+ * With background reconnect enabled the probe runs on a worker thread, so
+ * callers never pay for reconnecting. The link itself is behind the
+ * ComConnection interface, which lets the state machine be tested on any
+ * platform with a fake connection and an injected clock.
+ */
+
+#ifndef COM_CONNECTION_H
+#define COM_CONNECTION_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace creo_barcode {
+
+enum class CircuitState {
+    CLOSED,
+    OPEN,
+    HALF_OPEN
+};
+
+const char* circuitStateName(CircuitState state);
+
+/**
+ * @brief The physical link to Creo
+ *
+ * connect() and disconnect() run on the thread that uses the link (COM
+ * handles are apartment-bound). probe() may run on the reconnect worker
+ * and must not touch the cached handles.
+ */
+class ComConnection {
+public:
+    virtual ~ComConnection() = default;
+
+    /**
+     * @brief Establish the link and cache the session handles
+     */
+    virtual bool connect() = 0;
+
+    /**
+     * @brief Drop the cached handles
+     */
+    virtual void disconnect() = 0;
+
+    /**
+     * @brief Cheap, thread-agnostic check that Creo is reachable
+     */
+    virtual bool probe() = 0;
+};
+
+struct CircuitBreakerConfig {
+    int failureThreshold = 3;                           // Consecutive failures that open the breaker
+    std::chrono::milliseconds initialBackoff{500};      // Wait before the first probe
+    std::chrono::milliseconds maxBackoff{30000};        // Backoff cap
+    double backoffMultiplier = 2.0;                     // Growth per failed probe or trial
+    bool backgroundReconnect = true;                    // Probe on a worker instead of inline
+};
+
+/**
+ * @brief Circuit breaker state machine (not thread-safe)
+ */
+class CircuitBreaker {
+public:
+    using Clock = std::function<std::chrono::steady_clock::time_point()>;
+
+    /**
+     * @param config Thresholds and backoff
+     * @param clock Time source; defaults to std::chrono::steady_clock::now
+     */
+    explicit CircuitBreaker(const CircuitBreakerConfig& config = CircuitBreakerConfig(), Clock clock = Clock());
+
+    /**
+     * @brief Whether a request may use the link now
+     *
+     * Always in CLOSED, never in OPEN, and for exactly one trial in HALF_OPEN.
+     */
+    bool allowRequest();
+
+    void recordSuccess();
+    void recordFailure();
+
+    /**
+     * @brief OPEN and the backoff has elapsed
+     */
+    bool probeDue() const;
+
+    /**
+     * @brief Move from OPEN to HALF_OPEN (probe succeeded or backoff elapsed)
+     */
+    void enterHalfOpen();
+
+    CircuitState state() const { return state_; }
+    int consecutiveFailures() const { return failures_; }
+    std::chrono::milliseconds currentBackoff() const { return backoff_; }
+    std::chrono::steady_clock::time_point retryAt() const { return retryAt_; }
+    std::chrono::steady_clock::time_point now() const { return clock_(); }
+
+private:
+    void open(std::chrono::milliseconds backoff);
+    std::chrono::milliseconds nextBackoff() const;
+
+    CircuitBreakerConfig config_;
+    Clock clock_;
+    CircuitState state_ = CircuitState::CLOSED;
+    int failures_ = 0;
+    bool trialInFlight_ = false;
+    std::chrono::milliseconds backoff_;
+    std::chrono::steady_clock::time_point retryAt_{};
+};
+
+struct ComLinkStats {
+    uint64_t requests = 0;      // acquire() calls
+    uint64_t rejected = 0;      // Short-circuited while the breaker was open
+    uint64_t failures = 0;      // Link failures reported or seen while connecting
+    uint64_t connects = 0;      // Successful connect() calls
+    uint64_t probes = 0;        // probe() calls
+};
+
+/**
+ * @brief Circuit-broken owner of a ComConnection
+ *
+ * Usage per operation:
+ *   if (!manager.acquire()) -> skip COM (fallback)
+ *   ... use the link ...
+ *   manager.reportSuccess() or manager.reportFailure()
+ */
+class ComConnectionManager {
+public:
+    ComConnectionManager(std::unique_ptr<ComConnection> connection,
+                         const CircuitBreakerConfig& config = CircuitBreakerConfig(),
+                         CircuitBreaker::Clock clock = CircuitBreaker::Clock());
+
+    /**
+     * @brief Stops the reconnect worker; does not call disconnect()
+     */
+    ~ComConnectionManager();
+
+    ComConnectionManager(const ComConnectionManager&) = delete;
+    ComConnectionManager& operator=(const ComConnectionManager&) = delete;
+
+    /**
+     * @brief Get a usable link, connecting if needed
+     * @return false if the breaker rejects the request or connecting failed
+     */
+    bool acquire();
+
+    /**
+     * @brief The operation after acquire() reached Creo
+     *
+     * Report success also when the operation failed for reasons unrelated
+     * to the link (bad file, no drawing open).
+     */
+    void reportSuccess();
+
+    /**
+     * @brief The operation after acquire() failed because of the link
+     */
+    void reportFailure();
+
+    /**
+     * @brief Whether acquire() would be rejected without trying
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Run one reconnect step if a probe is due
+     *
+     * Called by the worker. Tests call it directly (with background
+     * reconnect disabled) to drive the state machine on a fake clock.
+     * @return true if a probe ran
+     */
+    bool pollReconnect();
+
+    /**
+     * @brief Disconnect and close the breaker (plugin re-initialization)
+     */
+    void reset();
+
+    CircuitState state() const;
+    bool isConnected() const;
+    ComLinkStats stats() const;
+    ComConnection& connection() { return *connection_; }
+
+private:
+    void failLocked();
+    bool probeLocked(std::unique_lock<std::mutex>& lock);
+    void workerLoop();
+
+    std::unique_ptr<ComConnection> connection_;
+    CircuitBreakerConfig config_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    CircuitBreaker breaker_;
+    bool connected_ = false;
+    bool probing_ = false;
+    bool stopping_ = false;
+    ComLinkStats stats_;
+    std::thread worker_;
+};
+
+} // namespace creo_barcode
+
+#endif // COM_CONNECTION_H
@@ -16,6 +16,8 @@ struct PluginConfig {
     std::string outputDirectory;
     int defaultDpi = 300;
     std::vector<std::string> recentFiles;
+    bool enableTracing = false;     // Record a Chrome trace of batch/COM stages
+    bool speculativeGeneration = false; // Pre-render barcodes when a drawing is activated
     
     bool operator==(const PluginConfig& other) const {
         return defaultType == other.defaultType &&
@@ -24,7 +26,9 @@ struct PluginConfig {
                defaultShowText == other.defaultShowText &&
                outputDirectory == other.outputDirectory &&
                defaultDpi == other.defaultDpi &&
-               recentFiles == other.recentFiles;
+               recentFiles == other.recentFiles &&
+               enableTracing == other.enableTracing &&
+               speculativeGeneration == other.speculativeGeneration;
     }
 };
 
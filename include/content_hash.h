@@ -0,0 +1,128 @@
+/**
+ * @file content_hash.h
+ * @brief Fast non-cryptographic hashing for cache keys and deduplication
+ *
+ * Shared hashing facility for payloads, configurations and image files:
+ * - 64/128-bit hash of in-memory data (SSE2 accelerated where available)
+ * - Streaming hasher for data that arrives in chunks
+ * - File hashing over a memory mapping
+ * - Canonical BarcodeConfig hash that ignores fields which do not change
+ *   the rendered image
+ *
+ * Hash values are stable across platforms and builds, so they may be
+ * persisted. They are NOT suitable for security purposes.
+ */
+
+#ifndef CONTENT_HASH_H
+#define CONTENT_HASH_H
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <cstddef>
+#include <cstdint>
+#include "barcode_generator.h"
+
+namespace creo_barcode {
+
+/**
+ * @brief 128-bit hash value
+ */
+struct Hash128 {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    bool operator==(const Hash128& other) const { return low == other.low && high == other.high; }
+    bool operator!=(const Hash128& other) const { return !(*this == other); }
+    bool operator<(const Hash128& other) const {
+        return high != other.high ? high < other.high : low < other.low;
+    }
+
+    // 32 lowercase hex digits, high word first
+    std::string toHex() const;
+};
+
+/**
+ * @brief Incremental hasher
+ *
+ * Feeding the same bytes in any chunking yields the same result as the
+ * one-shot hash functions.
+ */
+class ContentHasher {
+public:
+    explicit ContentHasher(uint64_t seed = 0);
+
+    /**
+     * @brief Hasher that never uses SIMD code paths
+     *
+     * Produces identical results; intended for verifying the SIMD paths.
+     */
+    static ContentHasher portable(uint64_t seed = 0);
+
+    /**
+     * @brief Whether this build uses the SIMD accumulation path
+     */
+    static bool simdEnabled();
+
+    void update(const void* data, size_t size);
+    void update(std::string_view data) { update(data.data(), data.size()); }
+
+    /**
+     * @brief Hash of everything fed so far (the hasher may keep being updated)
+     */
+    Hash128 finish() const;
+    uint64_t finish64() const { return finish().low; }
+
+    /**
+     * @brief Start over with the original seed
+     */
+    void reset();
+
+private:
+    static constexpr size_t LANE_COUNT = 8;
+    static constexpr size_t STRIPE_SIZE = 64;
+
+    uint64_t acc_[LANE_COUNT];
+    unsigned char buffer_[STRIPE_SIZE];
+    size_t bufferSize_ = 0;
+    size_t stripesInBlock_ = 0;
+    uint64_t totalSize_ = 0;
+    uint64_t seed_ = 0;
+    bool simd_ = true;
+
+    void consumeStripe(const unsigned char* stripe);
+};
+
+uint64_t hash64(std::string_view data, uint64_t seed = 0);
+Hash128 hash128(std::string_view data, uint64_t seed = 0);
+
+// Raw-buffer variants (named differently so that hash64("text", seed)
+// can never bind to the pointer/size overload)
+uint64_t hashBytes64(const void* data, size_t size, uint64_t seed = 0);
+Hash128 hashBytes128(const void* data, size_t size, uint64_t seed = 0);
+
+/**
+ * @brief Combine two hash values (order-dependent)
+ */
+uint64_t hashCombine(uint64_t seed, uint64_t value);
+
+/**
+ * @brief Hash the contents of a file through a read-only mapping
+ * @param path File to hash
+ * @return Hash of the file contents, or nullopt if the file cannot be opened
+ */
+std::optional<Hash128> hashFile(const std::string& path);
+
+/**
+ * @brief Canonical hash of the configuration fields that affect the image
+ *
+ * - type, width, height and margin always count
+ * - showText only counts for linear barcodes (CODE_128, CODE_39, EAN_13);
+ *   2D symbologies never print human-readable text
+ * - dpi is ignored: it only affects placement in the drawing, not pixels
+ */
+uint64_t hashBarcodeConfig(const BarcodeConfig& config);
+
+} // namespace creo_barcode
+
+#endif // CONTENT_HASH_H
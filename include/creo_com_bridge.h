@@ -19,9 +19,14 @@
 
 // Include Creo VB API type definitions
 #include "creo_vbapi_types.h"
+#include "com_connection.h"
+#include "intern_cache.h"
+#include "edit_transaction.h"
 
 namespace creo_barcode {
 
+class CreoComLink;
+
 /**
  * @brief Parameters for image insertion
  */
@@ -117,7 +122,10 @@ public:
     bool initialize();
     
     /**
-     * @brief Cleanup COM resources
+     * @brief Cleanup COM resources and stop the reconnect worker
+     * 
+     * Must run before DLL unload (com_bridge_cleanup()); the destructor
+     * does not join the worker.
      */
     void cleanup();
     
@@ -127,6 +135,20 @@ public:
      */
     bool isInitialized() const;
     
+    /**
+     * @brief Check if the COM link circuit breaker is rejecting requests
+     * 
+     * After repeated link failures insertImage() fails fast without
+     * touching COM until a background probe finds Creo reachable again.
+     * @return true if COM insertion would be skipped right now
+     */
+    bool isComCircuitOpen() const;
+    
+    /**
+     * @brief Current state of the COM link circuit breaker
+     */
+    CircuitState comLinkState() const;
+    
     /**
      * @brief Insert a single image into current drawing
      * @param imagePath Path to image file
@@ -180,8 +202,18 @@ public:
      * @return Drawing interface pointer, or nullptr if no drawing is open
      */
     IpfcDrawingPtr getCurrentDrawing();
+    
+    /**
+     * @brief Repaint deferral for insertImage()
+     * 
+     * Open a DrawingEditTransaction on it to insert many images with a
+     * single repaint; the batch methods do this themselves.
+     */
+    RepaintBatcher& repaintBatcher() { return m_repaint; }
 
 private:
+    friend class CreoComLink;
+    
     CreoComBridge();
     ~CreoComBridge();
     
@@ -191,6 +223,41 @@ private:
      */
     bool connectToCreo();
     
+    /**
+     * @brief Insert an image once the COM link has been acquired
+     * @return true if successful; m_lastHResult tells link failures apart
+     */
+    bool insertIntoCurrentDrawing(const std::string& imagePath,
+                                  double x, double y,
+                                  double width, double height);
+    
+    /**
+     * @brief Point the pooled outline at new corners
+     * 
+     * The outline and its two corner points are created once per session;
+     * later insertions write the four coordinates into the points and set
+     * the points back into the outline.
+     * @return HRESULT of the last COM call
+     */
+    HRESULT prepareOutline(double x1, double y1, double x2, double y2);
+    
+    /**
+     * @brief BSTR for an image path, converted once per distinct path
+     * @return Cached BSTR owned by the bridge, or nullptr on allocation failure
+     */
+    BSTR internPath(const std::string& path);
+    
+    /**
+     * @brief Repaint the current window once
+     * @return true if the window was repainted
+     */
+    bool repaintWindow();
+    
+    /**
+     * @brief Release objects that belong to the current Creo session
+     */
+    void releaseSessionObjects();
+    
     /**
      * @brief Set error information
      * @param hr HRESULT error code
@@ -211,8 +278,11 @@ private:
      * - File path is not empty
      * - File exists
      * - File is a regular file (not directory)
-     * - File format is supported (PNG, JPG, BMP)
      * - File is not empty (size > 0)
+     * - File content is a supported format (PNG, JPG, BMP), by magic bytes
+     * 
+     * Uses ImageValidator: one open per path, and none for files the
+     * generator has just written.
      * 
      * @param path Path to image file
      * @return true if file is valid, false otherwise (error details in getLastError())
@@ -241,6 +311,12 @@ private:
     // COM interface pointers using Creo VB API types
     IpfcAsyncConnectionPtr m_pConnection;   ///< Async connection to Creo
     IpfcSessionPtr m_pSession;              ///< Creo session interface
+    IpfcOutline2DPtr m_pOutline;            ///< Pooled image outline, reused per insertion
+    IpfcPoint2DPtr m_pOutlineCorners[2];    ///< Lower-left and upper-right points of m_pOutline
+    InternCache<CComBSTR> m_pathBstrs;      ///< Image path BSTRs by UTF-8 path
+    RepaintBatcher m_repaint;               ///< Defers window repaints inside edit transactions
+    
+    std::unique_ptr<ComConnectionManager> m_link;   ///< Circuit breaker over the connection
 };
 
 // String conversion utilities
@@ -300,6 +376,12 @@ GridPosition calculateGridPosition(int index, int columns, double spacing,
 
 #else // !_WIN32
 
+#include <string>
+#include <vector>
+#include "utf_transcode.h"
+#include "com_connection.h"
+#include "edit_transaction.h"
+
 // Stub for non-Windows platforms
 namespace creo_barcode {
 
@@ -320,6 +402,23 @@ struct BatchImageInfo {
     double x, y, width, height;
 };
 
+struct GridLayoutParams {
+    double startX, startY, width, height;
+    int columns;
+    double spacing;
+
+    GridLayoutParams()
+        : startX(0.0), startY(0.0), width(50.0), height(50.0)
+        , columns(1), spacing(10.0) {}
+};
+
+struct GridPosition {
+    double x, y;
+
+    GridPosition() : x(0.0), y(0.0) {}
+    GridPosition(double px, double py) : x(px), y(py) {}
+};
+
 class CreoComBridge {
 public:
     static CreoComBridge& getInstance() {
@@ -329,12 +428,36 @@ public:
     bool initialize() { return false; }
     void cleanup() {}
     bool isInitialized() const { return false; }
+    bool isComCircuitOpen() const { return true; }
+    CircuitState comLinkState() const { return CircuitState::OPEN; }
     bool insertImage(const std::string&, double, double, double, double) { return false; }
     BatchInsertResult batchInsertImages(const std::vector<BatchImageInfo>&) { return {}; }
+    BatchInsertResult batchInsertImagesGrid(const std::vector<std::string>&, const GridLayoutParams&) { return {}; }
     std::string getLastError() const { return "COM not supported on this platform"; }
     long getLastHResult() const { return -1; }
+    RepaintBatcher& repaintBatcher() { return repaint_; }
+
+private:
+    RepaintBatcher repaint_{nullptr};
 };
 
+// The string conversions are portable, so they are available (and tested) here too
+namespace StringUtils {
+
+inline std::wstring utf8ToWstring(const std::string& utf8) {
+    std::wstring result;
+    utf::utf8ToWide(utf8, result);
+    return result;
+}
+
+inline std::string wstringToUtf8(const std::wstring& wstr) {
+    std::string result;
+    utf::wideToUtf8(wstr, result);
+    return result;
+}
+
+} // namespace StringUtils
+
 } // namespace creo_barcode
 
 #endif // _WIN32
@@ -91,6 +91,7 @@
         // IpfcOutline2D - 2D outline (bounding box) interface
         struct IpfcOutline2D : public IUnknown {
             virtual HRESULT STDMETHODCALLTYPE get_Item(int index, IpfcPoint2D** ppPoint) = 0;
+            virtual HRESULT STDMETHODCALLTYPE put_Item(int index, IpfcPoint2D* pPoint) = 0;
         };
         
         // IpfcDraftingImage - Drafting image interface
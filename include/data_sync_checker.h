@@ -17,11 +17,17 @@
 #include <vector>
 #include <functional>
 #include <optional>
+#include <future>
+#include <mutex>
 #include "error_codes.h"
+#include "result.h"
 #include "barcode_generator.h"
 
 namespace creo_barcode {
 
+class PayloadIndex;
+class BarcodeInventory;
+
 /**
  * @brief Synchronization status enumeration
  */
@@ -44,6 +50,8 @@ struct BarcodeInstance {
     double posX = 0.0;               // X position in drawing
     double posY = 0.0;               // Y position in drawing
     std::string timestamp;           // When barcode was created
+    std::string drawingPath;         // Drawing containing the barcode
+    int sheet = 0;                   // Sheet number (0 = current/unknown)
     
     BarcodeInstance() : type(BarcodeType::CODE_128) {}
 };
@@ -102,6 +110,20 @@ public:
     SyncCheckResult checkSync(const std::string& currentPartName, 
                               const BarcodeInstance& barcodeInstance);
     
+    /**
+     * @brief Run checkSync on ThreadPool::shared()
+     * 
+     * Checks may overlap, including on the same checker: the payload index
+     * is thread-safe and inventory rows are updated under a lock. The
+     * checker must outlive the returned future.
+     * 
+     * @param currentPartName Current part name from the model
+     * @param barcodeInstance Barcode instance to check (copied)
+     * @return Future of the sync result, or of the error if the check threw
+     */
+    std::future<Result<SyncCheckResult>> checkSyncAsync(const std::string& currentPartName,
+                                                        const BarcodeInstance& barcodeInstance);
+    
     /**
      * @brief Check synchronization by decoding barcode from image
      * 
@@ -161,7 +183,12 @@ public:
      * @brief Get last error information
      * @return ErrorInfo structure with error details
      */
-    ErrorInfo getLastError() const { return lastError_; }
+    ErrorInfo getLastError() const { return lastError_.toErrorInfo(); }
+    
+    /**
+     * @brief Last error without building strings
+     */
+    const Error& lastError() const { return lastError_; }
     
     /**
      * @brief Set default update confirmation callback
@@ -175,12 +202,41 @@ public:
      */
     void setWarningDisplayCallback(WarningDisplayCallback callback);
     
+    /**
+     * @brief Attach a payload index to keep updated during sync checks
+     * 
+     * Every checked barcode instance that carries a drawing path is
+     * recorded in the index under its payload.
+     * 
+     * @param index Index to update (not owned), or nullptr to disable
+     */
+    void setPayloadIndex(PayloadIndex* index) { payloadIndex_ = index; }
+    
+    /**
+     * @brief Attach an inventory that keeps the latest sync check result
+     * 
+     * Used for drawing-wide audits: each checkSync() call records the
+     * instance and its status in the barcode's inventory row, adding the
+     * row on the first check.
+     * 
+     * @param inventory Inventory to update (not owned), or nullptr to disable
+     */
+    void setInventory(BarcodeInventory* inventory) { inventory_ = inventory; }
+    
 private:
-    ErrorInfo lastError_;
+    Error lastError_;
     UpdateConfirmCallback defaultUpdateCallback_;
     WarningDisplayCallback defaultWarningCallback_;
+    PayloadIndex* payloadIndex_ = nullptr;
+    BarcodeInventory* inventory_ = nullptr;
+    std::mutex inventoryMutex_;     // BarcodeInventory is single-threaded
+    
+    void recordInIndex(const BarcodeInstance& instance);
+    
+    SyncCheckResult evaluateSync(const std::string& currentPartName,
+                                 const BarcodeInstance& barcodeInstance);
     
-    void setError(ErrorCode code, const std::string& message, const std::string& details = "");
+    void setError(ErrorCode code, const char* message, std::string_view details = {});
 };
 
 /**
@@ -0,0 +1,141 @@
+/**
+ * @file directory_scanner.h
+ * @brief Parallel recursive file discovery for batch runs
+ *
+ * Walks directory trees on several threads and hands matching files to a
+ * sink as each directory is listed, so a consumer (BatchProcessor) can
+ * start on the first drawings while the rest of the vault is still being
+ * enumerated.
+ *
+ * Concurrency is bounded per share: a network share answers only so many
+ * directory listings at once before each one gets slower, so every root is
+ * assigned to a share (UNC server\share, drive letter, or device) and at
+ * most maxPerShare directories of one share are listed at a time. Roots on
+ * different shares are walked side by side.
+ *
+ * Name patterns are compiled once per scan. Symbolic links and junctions to
+ * directories are not followed, so link cycles cannot make the walk endless.
+ */
+
+#ifndef DIRECTORY_SCANNER_H
+#define DIRECTORY_SCANNER_H
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "error_codes.h"
+
+namespace creo_barcode {
+
+/**
+ * @brief Case-insensitive file name patterns, compiled once
+ *
+ * Patterns use '*' (any run of characters) and '?' (one character) and are
+ * matched against the file name only. "*.ext" patterns, the common case,
+ * become a suffix lookup. Creo keeps numbered versions (part.drw.3), which
+ * "*.drw.*" matches. An empty pattern list matches every file.
+ */
+class NameFilter {
+public:
+    NameFilter() = default;
+    explicit NameFilter(const std::vector<std::string>& patterns);
+
+    bool matches(const std::string& name) const;
+
+    bool matchesAll() const { return suffixes_.empty() && globs_.empty(); }
+
+private:
+    std::unordered_set<std::string> suffixes_;     // Lower-case ".ext" of "*.ext" patterns
+    std::vector<std::string> globs_;               // Remaining patterns, lower-case
+};
+
+struct ScanOptions {
+    std::vector<std::string> patterns;  // Name patterns, e.g. {"*.drw", "*.drw.*"}
+    size_t maxThreads = 8;              // Listing threads across all shares
+    size_t maxPerShare = 4;             // Concurrent listings on one share
+    size_t maxDepth = 64;               // Directory levels below each root
+};
+
+struct ScanStats {
+    uint64_t directories = 0;           // Directories listed
+    uint64_t filesMatched = 0;          // Files handed to the sink
+    uint64_t filesSkipped = 0;          // Files rejected by the name filter
+    uint64_t unreadable = 0;            // Directories that could not be listed
+    size_t shares = 0;                  // Distinct shares among the roots
+    size_t threads = 0;                 // Listing threads used
+    std::chrono::milliseconds elapsed{0};
+};
+
+class DirectoryScanner {
+public:
+    /**
+     * @brief Receives the matching files of one directory
+     *
+     * Called concurrently from the listing threads; it must be thread-safe.
+     */
+    using FileSink = std::function<void(std::vector<std::string>&& paths)>;
+
+    explicit DirectoryScanner(ScanOptions options = ScanOptions());
+
+    DirectoryScanner(const DirectoryScanner&) = delete;
+    DirectoryScanner& operator=(const DirectoryScanner&) = delete;
+
+    /**
+     * @brief Walk the roots and stream matching files into sink
+     *
+     * Blocks until every directory has been listed or cancel() is called.
+     * Roots that are not directories are skipped and counted as unreadable.
+     *
+     * @return false if no root could be listed (see getLastError())
+     */
+    bool scan(const std::vector<std::string>& roots, const FileSink& sink);
+
+    /**
+     * @brief Stop a running scan after the directories being listed now
+     *
+     * Safe to call from any thread, including from the sink.
+     */
+    void cancel();
+
+    ScanStats stats() const;
+    ErrorInfo getLastError() const { return lastError_.toErrorInfo(); }
+
+    /**
+     * @brief Key of the share a path lives on
+     *
+     * "\\server\share" for UNC paths, "c:" for drive paths, otherwise the
+     * device the path is on. Comparison is case-insensitive on Windows.
+     */
+    static std::string shareOf(const std::string& path);
+
+private:
+    struct Share {
+        std::string key;
+        std::vector<std::pair<std::string, size_t>> pending;   // Directory and depth
+        size_t active = 0;
+    };
+
+    Share* nextShareLocked();
+    void worker(const FileSink& sink);
+
+    ScanOptions options_;
+    NameFilter filter_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+    std::vector<Share> shares_;
+    size_t active_ = 0;
+    std::atomic<bool> cancelled_{false};
+    ScanStats stats_;
+    Error lastError_;
+};
+
+} // namespace creo_barcode
+
+#endif // DIRECTORY_SCANNER_H
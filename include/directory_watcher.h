@@ -0,0 +1,170 @@
+/**
+ * @file directory_watcher.h
+ * @brief Change notifications and an incremental image inventory for one directory
+ *
+ * DirectoryWatcher keeps an ImageInventory of the image files (PNG, JPEG,
+ * BMP by extension) in a directory current without rescanning it:
+ *
+ *   - start() lists the directory once to seed the inventory
+ *   - after that the OS reports changed names (inotify on Linux,
+ *     ReadDirectoryChangesW on Windows) and only those paths are stat'ed
+ *   - the directory is listed again only if the OS drops events (queue
+ *     overflow), and then the inventory is reconciled rather than rebuilt
+ *
+ * Events arriving within the settle interval are merged into one batch, and
+ * each path appears at most once per batch with its final state. Batches are
+ * delivered on the watcher thread after the inventory has been updated.
+ *
+ * The directory itself is watched, not its subdirectories.
+ */
+
+#ifndef DIRECTORY_WATCHER_H
+#define DIRECTORY_WATCHER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "error_codes.h"
+
+namespace creo_barcode {
+
+enum class FileChangeKind {
+    ADDED,
+    MODIFIED,
+    REMOVED
+};
+
+struct FileChange {
+    FileChangeKind kind;
+    std::string path;
+};
+
+struct ImageFileInfo {
+    uint64_t size = 0;
+    int64_t modified = 0;       // Last write time, file clock ticks
+};
+
+/**
+ * @brief Thread-safe map of image path -> size and modification time
+ */
+class ImageInventory {
+public:
+    bool find(const std::string& path, ImageFileInfo& info) const;
+    bool contains(const std::string& path) const;
+    size_t size() const;
+
+    void set(const std::string& path, const ImageFileInfo& info);
+    bool erase(const std::string& path);
+    void clear();
+
+    /**
+     * @brief Copy of every entry (for reconciling after an overflow)
+     */
+    std::unordered_map<std::string, ImageFileInfo> snapshot() const;
+
+    void reserve(size_t count);
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, ImageFileInfo> files_;
+};
+
+struct DirectoryWatcherStats {
+    uint64_t events = 0;        // Names reported by the OS
+    uint64_t batches = 0;       // Change batches delivered
+    uint64_t changes = 0;       // Paths in those batches
+    uint64_t rescans = 0;       // Full listings after the initial one
+};
+
+class DirectoryWatcher {
+public:
+    using ChangeCallback = std::function<void(const std::vector<FileChange>& changes)>;
+
+    DirectoryWatcher();
+
+    /**
+     * @brief Stops watching
+     */
+    ~DirectoryWatcher();
+
+    DirectoryWatcher(const DirectoryWatcher&) = delete;
+    DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+    /**
+     * @brief True where a native change notification backend exists
+     */
+    static bool isSupported();
+
+    /**
+     * @brief Seed the inventory and start watching
+     * @param directory Existing directory; reported paths are directory + separator + name
+     * @param onChanges Receives each change batch on the watcher thread (may be null)
+     * @param settle Quiet time that ends a batch
+     * @return false if the directory cannot be watched (see getLastError())
+     */
+    bool start(const std::string& directory, ChangeCallback onChanges = nullptr,
+               std::chrono::milliseconds settle = std::chrono::milliseconds(50));
+
+    /**
+     * @brief Stop watching and join the watcher thread (idempotent)
+     */
+    void stop();
+
+    bool isRunning() const { return running_; }
+    const std::string& directory() const { return directory_; }
+
+    ImageInventory& inventory() { return inventory_; }
+    const ImageInventory& inventory() const { return inventory_; }
+
+    /**
+     * @brief List the directory and reconcile the inventory with it
+     *
+     * Done automatically when the OS drops events; changes found are
+     * delivered like any other batch. If the directory cannot be listed,
+     * the inventory is kept as it is and no changes are reported.
+     */
+    void rescan();
+
+    DirectoryWatcherStats stats() const;
+    ErrorInfo getLastError() const { return lastError_.toErrorInfo(); }
+
+    /**
+     * @brief Whether a file name has an image extension the inventory tracks
+     */
+    static bool isImageName(const std::string& name);
+
+private:
+    struct Backend;
+
+    std::string pathFor(const std::string& name) const;
+    bool seed();
+    // Stat the named files and apply their final state to the inventory
+    void applyNames(const std::unordered_set<std::string>& names);
+    void deliver(std::vector<FileChange> changes);
+    void run();
+
+    std::string directory_;
+    ChangeCallback onChanges_;
+    std::chrono::milliseconds settle_{50};
+    ImageInventory inventory_;
+    std::unique_ptr<Backend> backend_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    Error lastError_;
+    std::mutex applyMutex_;         // One inventory update at a time
+
+    mutable std::mutex statsMutex_;
+    DirectoryWatcherStats stats_;
+};
+
+} // namespace creo_barcode
+
+#endif // DIRECTORY_WATCHER_H
@@ -5,6 +5,7 @@
 #include <vector>
 #include <functional>
 #include "error_codes.h"
+#include "edit_transaction.h"
 
 namespace creo_barcode {
 
@@ -64,9 +65,27 @@ enum class ModelType {
 
 class DrawingInterface {
 public:
-    DrawingInterface() = default;
+    // Notified after the user opens or switches to a drawing; drawing is
+    // nullptr when no drawing is active any more
+    using DrawingActivatedCallback = std::function<void(ProDrawing drawing)>;
+    
+    // Notified after a model is renamed (names as getPartName reports them)
+    using ModelRenamedCallback = std::function<void(ProMdl model, const std::string& oldName,
+                                                    const std::string& newName)>;
+    
+    // Notified after a model is saved
+    using ModelSavedCallback = std::function<void(ProMdl model)>;
+    
+    // Notified before a model is erased from the session; the handle may be
+    // reused for a model loaded later
+    using ModelErasedCallback = std::function<void(ProMdl model)>;
+    
+    DrawingInterface();
     ~DrawingInterface() = default;
     
+    DrawingInterface(const DrawingInterface&) = delete;
+    DrawingInterface& operator=(const DrawingInterface&) = delete;
+    
     // Get current active drawing
     // Returns PRO_TK_NO_ERROR on success, error code otherwise
     ProError getCurrentDrawing(ProDrawing* drawing);
@@ -75,6 +94,10 @@ public:
     // Returns PRO_TK_NO_ERROR on success, error code otherwise
     ProError getAssociatedModel(ProDrawing drawing, ProMdl* model);
     
+    // Get the file path of a drawing (used as its key in the payload index)
+    // Returns PRO_TK_NO_ERROR on success, error code otherwise
+    ProError getDrawingPath(ProDrawing drawing, std::string& path);
+    
     // Get part name from a model
     // Returns PRO_TK_NO_ERROR on success, error code otherwise
     ProError getPartName(ProMdl model, std::string& partName);
@@ -103,7 +126,8 @@ public:
     bool isDrawingOpen();
     
     // Get last error information
-    ErrorInfo getLastError() const { return lastError_; }
+    ErrorInfo getLastError() const { return lastError_.toErrorInfo(); }
+    const Error& lastError() const { return lastError_; }
     
     // Validate position is within drawing bounds
     bool validatePosition(ProDrawing drawing, const Position& pos);
@@ -111,11 +135,28 @@ public:
     // Get drawing sheet size
     bool getDrawingSheetSize(ProDrawing drawing, Size& size);
     
+    // Repaint deferral for insertImage/createSymbolInstance; open a
+    // DrawingEditTransaction on it to repaint once for many edits
+    RepaintBatcher& repaintBatcher() { return repaint_; }
+    
+    // Register for drawing activation (nullptr unregisters). Called on the
+    // thread Creo delivers the notification on.
+    void setDrawingActivatedCallback(DrawingActivatedCallback callback);
+    
+    // Register for model rename/save/erase (nullptr unregisters), same threading
+    void setModelRenamedCallback(ModelRenamedCallback callback);
+    void setModelSavedCallback(ModelSavedCallback callback);
+    void setModelErasedCallback(ModelErasedCallback callback);
+    
 private:
-    ErrorInfo lastError_;
+    Error lastError_;
+    RepaintBatcher repaint_;
+    
+    // Refresh the current window after modifications
+    bool repaintDisplay();
     
     // Helper to set error info
-    void setError(ErrorCode code, const std::string& message, const std::string& details = "");
+    void setError(ErrorCode code, const char* message, std::string_view details = {});
     
     // Internal helper to extract name from model
     std::string extractModelName(ProMdl model);
@@ -0,0 +1,105 @@
+/**
+ * @file edit_transaction.h
+ * @brief Scoped drawing edits with a single deferred display refresh
+ *
+ * Every drawing modification normally ends with a repaint, so inserting N
+ * barcodes costs N repaints. A DrawingEditTransaction suppresses those
+ * repaints while it is open: modifications only mark the display stale,
+ * and the outermost transaction refreshes once when it ends. Transactions
+ * nest, so a batch operation can open one around helpers that open their
+ * own.
+ *
+ * Usage:
+ *   {
+ *       DrawingEditTransaction edit(drawingInterface.repaintBatcher());
+ *       for (...) drawingInterface.insertImage(...);
+ *   }   // one repaint here
+ *
+ * Edits go through Creo's UI thread, so the batcher is not thread-safe.
+ */
+
+#ifndef EDIT_TRANSACTION_H
+#define EDIT_TRANSACTION_H
+
+#include <cstdint>
+#include <functional>
+
+namespace creo_barcode {
+
+/**
+ * @brief Tracks open transactions and pending modifications for one display
+ */
+class RepaintBatcher {
+public:
+    /**
+     * @brief Refresh the display; returns false if the refresh failed
+     */
+    using RefreshFn = std::function<bool()>;
+
+    explicit RepaintBatcher(RefreshFn refresh);
+
+    RepaintBatcher(const RepaintBatcher&) = delete;
+    RepaintBatcher& operator=(const RepaintBatcher&) = delete;
+
+    /**
+     * @brief Record a modification
+     *
+     * Refreshes at once outside a transaction; inside one, the refresh is
+     * left to the outermost end().
+     * @return false only if an immediate refresh failed
+     */
+    bool modified();
+
+    void begin();
+
+    /**
+     * @brief Close one transaction level
+     * @return false only if the final refresh failed
+     */
+    bool end();
+
+    bool inTransaction() const { return depth_ > 0; }
+    int depth() const { return depth_; }
+    bool pending() const { return pending_; }
+
+    uint64_t modifications() const { return modifications_; }
+    uint64_t refreshes() const { return refreshes_; }
+
+private:
+    bool refresh();
+
+    RefreshFn refresh_;
+    int depth_ = 0;
+    bool pending_ = false;
+    uint64_t modifications_ = 0;
+    uint64_t refreshes_ = 0;
+};
+
+/**
+ * @brief RAII transaction scope; commits (refreshes if needed) on destruction
+ *
+ * Modifications cannot be rolled back in Creo, so leaving the scope by an
+ * exception still refreshes whatever was changed.
+ */
+class DrawingEditTransaction {
+public:
+    explicit DrawingEditTransaction(RepaintBatcher& batcher);
+    ~DrawingEditTransaction();
+
+    DrawingEditTransaction(const DrawingEditTransaction&) = delete;
+    DrawingEditTransaction& operator=(const DrawingEditTransaction&) = delete;
+
+    /**
+     * @brief End the scope early; later calls and the destructor do nothing
+     * @return false if the final refresh failed
+     */
+    bool commit();
+
+private:
+    RepaintBatcher& batcher_;
+    bool open_ = true;
+};
+
+} // namespace creo_barcode
+
+#endif // EDIT_TRANSACTION_H
@@ -2,6 +2,11 @@
 #define ERROR_CODES_H
 
 #include <string>
+#include <string_view>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
 
 namespace creo_barcode {
 
@@ -36,6 +41,91 @@ struct ErrorInfo {
     bool isSuccess() const { return code == ErrorCode::SUCCESS; }
 };
 
+/**
+ * @brief Compact error for hot paths
+ *
+ * Building an Error never allocates. The message must be a string literal
+ * (or otherwise outlive the error); the detail is copied into an inline
+ * buffer. A detail that does not fit keeps its tail behind a leading "...",
+ * since details are mostly paths and the file name is the useful part; a
+ * formatted detail keeps its head and ends in "...". The strings of an
+ * ErrorInfo are only built when a caller asks for them via toErrorInfo(),
+ * typically through getLastError(), so a failing batch item costs about as
+ * much as a succeeding one.
+ */
+class Error {
+public:
+    static constexpr size_t DETAIL_CAPACITY = 95;
+
+    Error() noexcept : message_(""), code_(ErrorCode::SUCCESS) {
+        detail_[0] = '\0';
+    }
+
+    Error(ErrorCode code, const char* message, std::string_view detail = {}) noexcept
+        : message_(message ? message : ""), code_(code) {
+        size_t length = detail.size();
+        if (length > DETAIL_CAPACITY) {
+            // "..." plus the end of the detail, starting on a UTF-8 lead byte
+            size_t start = detail.size() - (DETAIL_CAPACITY - 3);
+            while (start < detail.size() && (static_cast<unsigned char>(detail[start]) & 0xC0) == 0x80) {
+                ++start;
+            }
+            length = 3 + detail.size() - start;
+            std::memcpy(detail_, "...", 3);
+            std::memcpy(detail_ + 3, detail.data() + start, length - 3);
+        } else if (length > 0) {
+            // data() may be null for an empty view
+            std::memcpy(detail_, detail.data(), length);
+        }
+        detailLength_ = static_cast<uint8_t>(length);
+        detail_[length] = '\0';
+    }
+
+    /**
+     * @brief Error whose detail is printf-formatted into the inline buffer
+     */
+    static Error formatted(ErrorCode code, const char* message, const char* format, ...) noexcept {
+        Error error(code, message);
+        va_list args;
+        va_start(args, format);
+        int needed = std::vsnprintf(error.detail_, sizeof(error.detail_), format, args);
+        va_end(args);
+        if (needed < 0) {
+            error.detail_[0] = '\0';
+            needed = 0;
+        }
+        if (static_cast<size_t>(needed) > DETAIL_CAPACITY) {
+            error.detailLength_ = static_cast<uint8_t>(DETAIL_CAPACITY);
+            error.markTruncated();
+        } else {
+            error.detailLength_ = static_cast<uint8_t>(needed);
+        }
+        return error;
+    }
+
+    ErrorCode code() const noexcept { return code_; }
+    const char* message() const noexcept { return message_; }
+    std::string_view detail() const noexcept { return std::string_view(detail_, detailLength_); }
+    bool isSuccess() const noexcept { return code_ == ErrorCode::SUCCESS; }
+
+    /**
+     * @brief Allocating conversion for the public getLastError() accessors
+     */
+    ErrorInfo toErrorInfo() const {
+        return ErrorInfo(code_, message_, std::string(detail()));
+    }
+
+private:
+    void markTruncated() noexcept {
+        std::memcpy(detail_ + DETAIL_CAPACITY - 3, "...", 3);
+    }
+
+    const char* message_;
+    ErrorCode code_;
+    uint8_t detailLength_ = 0;
+    char detail_[DETAIL_CAPACITY + 1];
+};
+
 inline std::string errorCodeToString(ErrorCode code) {
     switch (code) {
         case ErrorCode::SUCCESS: return "Success";
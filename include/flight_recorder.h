@@ -0,0 +1,110 @@
+/**
+ * @file flight_recorder.h
+ * @brief In-memory ring of recent log events for post-mortem diagnostics
+ *
+ * Every log message that passes the recorder's threshold is copied into a
+ * fixed-size ring; nothing touches the disk in steady state. The ring is
+ * written out only when something goes wrong:
+ * - Logger dumps the events recorded since the previous dump whenever an
+ *   ERROR is logged
+ * - installCrashHandler() dumps the whole ring on a crash (SIGSEGV/SIGABRT
+ *   etc. on POSIX, unhandled SEH exceptions on Windows)
+ *
+ * The recorder has its own threshold (setFlightRecorderLevel in
+ * log_level.h), so it can keep INFO detail while the log file only gets
+ * warnings.
+ */
+
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+#include "log_level.h"
+
+namespace creo_barcode {
+
+/**
+ * @brief One recorded event (message truncated to MESSAGE_CAPACITY - 1 bytes)
+ */
+struct FlightRecord {
+    uint64_t sequence = 0;      // 1-based, increases across the process
+    uint64_t timeNanos = 0;     // Wall clock, nanoseconds since the Unix epoch
+    LogLevel level = LogLevel::INFO;
+    std::string message;
+};
+
+class FlightRecorder {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+    static constexpr size_t MESSAGE_CAPACITY = 240;
+
+    explicit FlightRecorder(size_t capacity = DEFAULT_CAPACITY);
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    /**
+     * @brief Copy one event into the ring, overwriting the oldest
+     *
+     * Writers only contend when they land on the same slot.
+     */
+    void record(LogLevel level, const char* message, size_t length);
+    void record(LogLevel level, const std::string& message) { record(level, message.data(), message.size()); }
+
+    /**
+     * @brief Events still in the ring with sequence > afterSequence, oldest first
+     */
+    std::vector<FlightRecord> snapshot(uint64_t afterSequence = 0) const;
+
+    /**
+     * @brief Append the events recorded since the previous dump to a file
+     * @param reason Written in the dump header
+     * @return Number of events written
+     */
+    size_t dumpNew(const std::string& path, const std::string& reason);
+
+    /**
+     * @brief Dump this recorder to a file if the process crashes
+     *
+     * Only one recorder can be installed; a second call replaces the first.
+     * The recorder must outlive the handler (uninstall before destroying it).
+     */
+    static void installCrashHandler(FlightRecorder* recorder, const std::string& path);
+    static void uninstallCrashHandler();
+
+    size_t capacity() const { return capacity_; }
+    uint64_t recordedCount() const { return next_.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::mutex mutex;
+        uint64_t sequence = 0;
+        uint64_t timeNanos = 0;
+        LogLevel level = LogLevel::INFO;
+        uint16_t length = 0;
+        char message[MESSAGE_CAPACITY];
+    };
+
+    using CrashSink = void (*)(void* context, const char* data, size_t size);
+
+    // Best-effort dump for the crash handler: takes no locks, allocates nothing
+    void writeCrashDump(CrashSink sink, void* context) const;
+
+    size_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<uint64_t> next_{0};
+
+    std::mutex dumpMutex_;
+    uint64_t lastDumped_ = 0;
+
+    friend struct FlightRecorderCrashHandler;
+};
+
+} // namespace creo_barcode
+
+#endif // FLIGHT_RECORDER_H
@@ -0,0 +1,110 @@
+/**
+ * @file generated_barcode_filter.h
+ * @brief Bloom filter of barcodes that have already been generated
+ *
+ * Answers "does this part probably already have an up-to-date barcode?"
+ * without touching the filesystem:
+ * - A miss is definite: the (payload, config) pair was never generated
+ * - A hit is probable: it must be verified before skipping work
+ *
+ * The filter is keyed on the payload together with the canonical hash of
+ * the barcode configuration, so changing type or size invalidates old
+ * entries while fields that do not affect the image (e.g. dpi) do not.
+ */
+
+#ifndef GENERATED_BARCODE_FILTER_H
+#define GENERATED_BARCODE_FILTER_H
+
+#include <string>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include "barcode_generator.h"
+#include "error_codes.h"
+
+namespace creo_barcode {
+
+/**
+ * @brief Thread-safe, persistable Bloom filter over (payload, config)
+ *
+ * Bits are set with relaxed atomic OR, so add() and mightContain() may be
+ * called concurrently from batch worker threads without locking.
+ */
+class GeneratedBarcodeFilter {
+public:
+    static constexpr size_t DEFAULT_EXPECTED_ITEMS = 100000;
+    static constexpr double DEFAULT_FALSE_POSITIVE_RATE = 0.01;
+
+    /**
+     * @brief Create a filter sized for the expected number of barcodes
+     * @param expectedItems Number of barcodes the filter should hold
+     * @param falsePositiveRate Target false-positive probability at capacity
+     */
+    explicit GeneratedBarcodeFilter(size_t expectedItems = DEFAULT_EXPECTED_ITEMS,
+                                    double falsePositiveRate = DEFAULT_FALSE_POSITIVE_RATE);
+    ~GeneratedBarcodeFilter() = default;
+
+    GeneratedBarcodeFilter(const GeneratedBarcodeFilter&) = delete;
+    GeneratedBarcodeFilter& operator=(const GeneratedBarcodeFilter&) = delete;
+
+    /**
+     * @brief Record that a barcode was generated
+     */
+    void add(const std::string& payload, const BarcodeConfig& config);
+
+    /**
+     * @brief Check whether a barcode may have been generated
+     * @return false if definitely never generated, true if probably generated
+     */
+    bool mightContain(const std::string& payload, const BarcodeConfig& config) const;
+
+    /**
+     * @brief Reset the filter to empty
+     */
+    void clear();
+
+    /**
+     * @brief Number of add() calls recorded
+     */
+    size_t itemCount() const { return itemCount_.load(std::memory_order_relaxed); }
+
+    size_t bitCount() const { return wordCount_ * 64; }
+    unsigned hashCount() const { return hashCount_; }
+
+    /**
+     * @brief Memory used by the bit array in bytes
+     */
+    size_t memoryBytes() const { return wordCount_ * sizeof(uint64_t); }
+
+    /**
+     * @brief Expected false-positive rate for the current fill level
+     */
+    double estimatedFalsePositiveRate() const;
+
+    /**
+     * @brief Persist the filter to disk
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Replace the filter contents with a saved filter
+     *
+     * The loaded filter keeps the size it was saved with.
+     */
+    bool load(const std::string& path);
+
+    ErrorInfo getLastError() const { return lastError_; }
+
+private:
+    std::unique_ptr<std::atomic<uint64_t>[]> words_;
+    size_t wordCount_ = 0;
+    unsigned hashCount_ = 0;
+    std::atomic<size_t> itemCount_{0};
+    mutable ErrorInfo lastError_;
+
+    void allocate(size_t wordCount, unsigned hashCount);
+};
+
+} // namespace creo_barcode
+
+#endif // GENERATED_BARCODE_FILTER_H
@@ -0,0 +1,110 @@
+/**
+ * @file image_validator.h
+ * @brief Image file validation with one metadata query per path
+ *
+ * Checks that an image path names a non-empty regular file whose content
+ * is PNG, JPEG or BMP. The file is opened once: its type and size come
+ * from the open handle (fstat / GetFileInformationByHandle) and the format
+ * from its first bytes, so a misnamed extension neither hides nor fakes a
+ * supported format.
+ *
+ * Files the plugin has just generated are recorded with markGenerated()
+ * and validate() answers for them from memory without touching the disk,
+ * so batch insertion of freshly generated barcodes spends almost no time
+ * here. The cache trusts our own writes: a file replaced behind our back
+ * keeps its cached verdict until forget() or the next markGenerated().
+ */
+
+#ifndef IMAGE_VALIDATOR_H
+#define IMAGE_VALIDATOR_H
+
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+
+namespace creo_barcode {
+
+enum class ImageFormat {
+    UNKNOWN,
+    PNG,
+    JPEG,
+    BMP
+};
+
+enum class ImageVerdict {
+    VALID,
+    EMPTY_PATH,
+    NOT_FOUND,
+    NOT_REGULAR_FILE,
+    EMPTY_FILE,
+    UNSUPPORTED_FORMAT,
+    READ_FAILED
+};
+
+/**
+ * @brief Outcome of validating one path
+ */
+struct ImageCheck {
+    ImageVerdict verdict = ImageVerdict::NOT_FOUND;
+    ImageFormat format = ImageFormat::UNKNOWN;
+    uint64_t size = 0;
+    bool cached = false;    // Answered from the generated-file cache
+    int systemError = 0;    // errno / GetLastError() when READ_FAILED
+
+    bool ok() const { return verdict == ImageVerdict::VALID; }
+};
+
+/**
+ * @brief Identify an image format from the leading bytes of a file
+ * @param header First bytes of the file
+ * @param size Number of bytes available (8 are enough for every format)
+ */
+ImageFormat sniffImageFormat(const uint8_t* header, size_t size);
+
+const char* imageFormatName(ImageFormat format);
+
+class ImageValidator {
+public:
+    // Upper bound on remembered generated files; the cache is cleared when full
+    static constexpr size_t MAX_CACHED = 4096;
+
+    static ImageValidator& global();
+
+    /**
+     * @brief Validate a path, from the cache when we generated it
+     */
+    ImageCheck validate(const std::string& path);
+
+    /**
+     * @brief Record a file this process has just written successfully
+     */
+    void markGenerated(const std::string& path, ImageFormat format, uint64_t size);
+
+    /**
+     * @brief Drop a cached verdict (file rewritten or removed)
+     */
+    void forget(const std::string& path);
+
+    void clear();
+    size_t cachedCount() const;
+
+private:
+    struct Entry {
+        ImageFormat format;
+        uint64_t size;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> generated_;
+};
+
+/**
+ * @brief Validate a path on disk, bypassing any cache
+ */
+ImageCheck inspectImageFile(const std::string& path);
+
+} // namespace creo_barcode
+
+#endif // IMAGE_VALIDATOR_H
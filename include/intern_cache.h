@@ -0,0 +1,70 @@
+/**
+ * @file intern_cache.h
+ * @brief Bounded cache of values built once per distinct string key
+ *
+ * Used by the COM bridge to keep one BSTR per image path, so repeated
+ * insertions of the same file skip the UTF-8 to UTF-16 conversion and the
+ * BSTR allocation. The cache is not thread-safe; the bridge only uses it
+ * from its COM thread. When full it starts over, like ImageValidator:
+ * batches reuse a small working set, so LRU bookkeeping would not pay off.
+ */
+
+#ifndef INTERN_CACHE_H
+#define INTERN_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace creo_barcode {
+
+template <typename Value>
+class InternCache {
+public:
+    explicit InternCache(size_t capacity = 256)
+        : capacity_(capacity > 0 ? capacity : 1) {}
+
+    /**
+     * @brief Look up a key
+     * @return The cached value, or nullptr on a miss
+     */
+    const Value* find(const std::string& key) {
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            ++misses_;
+            return nullptr;
+        }
+        ++hits_;
+        return &it->second;
+    }
+
+    /**
+     * @brief Store the value for a key
+     * @return Reference to the stored value, valid until the next insert() or clear()
+     */
+    const Value& insert(const std::string& key, Value value) {
+        if (entries_.size() >= capacity_ && entries_.find(key) == entries_.end()) {
+            entries_.clear();
+        }
+        return entries_.insert_or_assign(key, std::move(value)).first->second;
+    }
+
+    void clear() { entries_.clear(); }
+
+    size_t size() const { return entries_.size(); }
+    size_t capacity() const { return capacity_; }
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+
+private:
+    size_t capacity_;
+    std::unordered_map<std::string, Value> entries_;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+} // namespace creo_barcode
+
+#endif // INTERN_CACHE_H
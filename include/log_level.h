@@ -0,0 +1,115 @@
+/**
+ * @file log_level.h
+ * @brief Severity levels and level filtering shared by the text and binary loggers
+ */
+
+#ifndef LOG_LEVEL_H
+#define LOG_LEVEL_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+// Lowest level compiled into this build (0=VERBOSE, 1=INFO, 2=WARNING, 3=ERROR, 4=OFF).
+// Calls below it compile to nothing; override with -DCREO_LOG_MIN_LEVEL=<n>.
+#ifndef CREO_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define CREO_LOG_MIN_LEVEL 1
+#else
+#define CREO_LOG_MIN_LEVEL 0
+#endif
+#endif
+
+namespace creo_barcode {
+
+// ERR rather than ERROR (wingdi.h defines ERROR as a macro) and VERBOSE
+// rather than DEBUG (commonly defined by build flags)
+enum class LogLevel : uint8_t {
+    VERBOSE = 0,
+    INFO = 1,
+    WARNING = 2,
+    ERR = 3,
+    OFF = 4
+};
+
+inline const char* logLevelToString(LogLevel level) {
+    switch (level) {
+        case LogLevel::VERBOSE: return "VERBOSE";
+        case LogLevel::INFO: return "INFO";
+        case LogLevel::WARNING: return "WARNING";
+        case LogLevel::ERR: return "ERROR";
+        case LogLevel::OFF: return "OFF";
+        default: return "UNKNOWN";
+    }
+}
+
+/**
+ * @brief Parse a level name as printed by logLevelToString
+ * @return false if the name is not recognized
+ */
+inline bool logLevelFromString(const char* name, LogLevel& level) {
+    for (uint8_t i = 0; i <= static_cast<uint8_t>(LogLevel::OFF); ++i) {
+        if (std::strcmp(name, logLevelToString(static_cast<LogLevel>(i))) == 0) {
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+constexpr LogLevel kCompiledMinLogLevel = static_cast<LogLevel>(CREO_LOG_MIN_LEVEL);
+
+namespace log_detail {
+
+// Constant-initialized (no constructor runs at DLL load), so they can be
+// read from any thread at any time
+inline std::atomic<uint8_t> fileLevel{static_cast<uint8_t>(LogLevel::INFO)};
+inline std::atomic<uint8_t> recorderLevel{static_cast<uint8_t>(LogLevel::INFO)};
+
+// Lower of the two; the macros check only this
+inline std::atomic<uint8_t> runtimeLevel{static_cast<uint8_t>(LogLevel::INFO)};
+
+inline void updateRuntimeLevel() {
+    uint8_t file = fileLevel.load(std::memory_order_relaxed);
+    uint8_t recorder = recorderLevel.load(std::memory_order_relaxed);
+    runtimeLevel.store(file < recorder ? file : recorder, std::memory_order_relaxed);
+}
+
+} // namespace log_detail
+
+/**
+ * @brief Set the threshold for the log file; messages below it are not written
+ *
+ * Levels below kCompiledMinLogLevel stay disabled regardless.
+ */
+inline void setLogLevel(LogLevel level) {
+    log_detail::fileLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    log_detail::updateRuntimeLevel();
+}
+
+inline LogLevel getLogLevel() {
+    return static_cast<LogLevel>(log_detail::fileLevel.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief Set the threshold for the in-memory flight recorder
+ */
+inline void setFlightRecorderLevel(LogLevel level) {
+    log_detail::recorderLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    log_detail::updateRuntimeLevel();
+}
+
+inline LogLevel getFlightRecorderLevel() {
+    return static_cast<LogLevel>(log_detail::recorderLevel.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief Check whether a message at this level goes anywhere (one relaxed load)
+ */
+inline bool isLogLevelEnabled(LogLevel level) {
+    return static_cast<uint8_t>(level) >= log_detail::runtimeLevel.load(std::memory_order_relaxed);
+}
+
+} // namespace creo_barcode
+
+#endif // LOG_LEVEL_H
@@ -4,15 +4,36 @@
 #include <string>
 #include <fstream>
 #include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <cstdint>
 #include "error_codes.h"
+#include "log_level.h"
+#include "flight_recorder.h"
 
 namespace creo_barcode {
 
+/**
+ * @brief Size-based rotation of the text log
+ *
+ * When the active file reaches maxFileBytes it is renamed aside and a new
+ * file is started; a background thread then gzips the old segment to
+ * <log>.1.gz, shifting older archives up to <log>.<maxArchives>.gz.
+ */
+struct LogRotationPolicy {
+    uint64_t maxFileBytes = 10 * 1024 * 1024;  // 0 disables rotation
+    int maxArchives = 5;
+    bool compress = true;                       // false keeps plain <log>.N
+};
+
 class Logger {
 public:
     static Logger& getInstance();
     
     // Logging methods
+    void log(LogLevel level, const std::string& message);
+    void verbose(const std::string& message);
     void info(const std::string& message);
     void warning(const std::string& message);
     void error(const std::string& message);
@@ -20,7 +41,24 @@ public:
     
     // Configuration
     void setLogFilePath(const std::string& path);
+    std::string getLogFilePath();
     void setConsoleOutput(bool enabled) { consoleOutput_ = enabled; }
+    void setRotationPolicy(const LogRotationPolicy& policy);
+    
+    // Write buffered lines to disk (warnings and errors are flushed immediately)
+    void flush();
+    
+    /**
+     * @brief Flush and wait for pending archive compression to finish
+     *
+     * Must be called before the plugin DLL unloads so the compression thread
+     * is not left running. Logging keeps working afterwards.
+     */
+    void shutdown();
+    
+    // Recent events kept in memory; dumped to getFlightDumpPath() on ERROR
+    FlightRecorder& flightRecorder() { return recorder_; }
+    std::string getFlightDumpPath();
     
 private:
     Logger();
@@ -29,25 +67,53 @@ private:
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
     
-    void writeToFile(const std::string& level, const std::string& message);
+    struct PendingArchive {
+        std::string segmentPath;    // Rotated-out file awaiting compression
+        std::string logPath;        // Log path the archives are named after
+        LogRotationPolicy policy;
+    };
+    
+    void writeToFile(LogLevel level, const std::string& message);
     std::string getCurrentTimestamp();
+    void rotateLocked();
+    void archiveWorker();
+    static void archiveSegment(const PendingArchive& pending);
     
     std::string logFilePath_;
     std::ofstream logFile_;
     std::mutex mutex_;
     bool consoleOutput_ = true;
+    LogRotationPolicy rotation_;
+    uint64_t currentSize_ = 0;
+    uint64_t rotationCount_ = 0;
+    
+    FlightRecorder recorder_;
+    
+    // Background compression of rotated segments (started on first rotation)
+    std::mutex archiveMutex_;
+    std::condition_variable archiveCv_;
+    std::deque<PendingArchive> pendingArchives_;
+    std::thread archiveThread_;
+    bool stopArchiver_ = false;
 };
 
-// Convenience macros - DISABLED to avoid static initialization issues in DLL
-// #define LOG_INFO(msg) creo_barcode::Logger::getInstance().info(msg)
-// #define LOG_WARNING(msg) creo_barcode::Logger::getInstance().warning(msg)
-// #define LOG_ERROR(msg) creo_barcode::Logger::getInstance().error(msg)
+} // namespace creo_barcode
 
-// No-op logging macros for DLL safety
-#define LOG_INFO(msg) ((void)0)
-#define LOG_WARNING(msg) ((void)0)
-#define LOG_ERROR(msg) ((void)0)
+// Logging macros. The message expression is only evaluated when the level
+// passes both the compile-time and the runtime threshold; the Logger itself
+// is created lazily on the first message that is actually written.
+#define CREO_LOG(level, msg) \
+    do { \
+        if constexpr ((level) >= ::creo_barcode::kCompiledMinLogLevel) { \
+            if (::creo_barcode::isLogLevelEnabled(level)) { \
+                ::creo_barcode::Logger::getInstance().log((level), (msg)); \
+            } \
+        } \
+    } while (0)
 
-} // namespace creo_barcode
+#define LOG_VERBOSE(msg) CREO_LOG(::creo_barcode::LogLevel::VERBOSE, msg)
+#define LOG_INFO(msg) CREO_LOG(::creo_barcode::LogLevel::INFO, msg)
+#define LOG_WARNING(msg) CREO_LOG(::creo_barcode::LogLevel::WARNING, msg)
+#define LOG_ERROR(msg) CREO_LOG(::creo_barcode::LogLevel::ERR, msg)
 
 #endif // LOGGER_H
@@ -0,0 +1,64 @@
+/**
+ * @file mapped_file.h
+ * @brief Read-only memory-mapped file wrapper
+ *
+ * Maps a whole file into memory so that on-disk indexes can be queried
+ * in place without reading them into heap buffers first.
+ * Uses mmap on POSIX and CreateFileMapping on Windows.
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace creo_barcode {
+
+/**
+ * @brief RAII read-only mapping of a file
+ *
+ * Empty files are reported as open with size() == 0 and data() == nullptr.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Map a file read-only
+     * @param path Path to the file
+     * @return true if the file was opened and mapped
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmap the file and release handles
+     */
+    void close();
+
+    bool isOpen() const { return open_; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+#ifdef _WIN32
+    void* fileHandle_ = nullptr;
+    void* mappingHandle_ = nullptr;
+#endif
+
+    void moveFrom(MappedFile& other);
+};
+
+} // namespace creo_barcode
+
+#endif // MAPPED_FILE_H
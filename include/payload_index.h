@@ -0,0 +1,220 @@
+/**
+ * @file payload_index.h
+ * @brief Reverse lookup index from barcode payload to drawing locations
+ *
+ * This module keeps a cross-drawing view of every barcode the plugin knows
+ * about, so that renaming a part can be resolved to the affected drawings
+ * without rescanning the vault:
+ * - Payload -> (drawing, sheet, position, image path) mapping
+ * - Incremental updates from generation and sync checks
+ * - Concurrent lookups (sharded reader/writer locks)
+ * - Compact on-disk format that can be queried in place via mmap
+ */
+
+#ifndef PAYLOAD_INDEX_H
+#define PAYLOAD_INDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <shared_mutex>
+#include <mutex>
+#include <array>
+#include <cstdint>
+#include "error_codes.h"
+#include "mapped_file.h"
+
+namespace creo_barcode {
+
+/**
+ * @brief Location of one barcode instance inside a drawing
+ */
+struct BarcodeLocation {
+    std::string drawingPath;    // Drawing file containing the barcode
+    int sheet = 0;              // Sheet number (0 = current/unknown)
+    double posX = 0.0;          // X position in drawing
+    double posY = 0.0;          // Y position in drawing
+    std::string imagePath;      // Barcode image file inserted in the drawing
+
+    BarcodeLocation() = default;
+    BarcodeLocation(const std::string& drawing, int sh, double x, double y,
+                    const std::string& image)
+        : drawingPath(drawing), sheet(sh), posX(x), posY(y), imagePath(image) {}
+
+    // Two locations refer to the same barcode when drawing, sheet and image match
+    bool sameBarcode(const BarcodeLocation& other) const {
+        return drawingPath == other.drawingPath && sheet == other.sheet &&
+               imagePath == other.imagePath;
+    }
+};
+
+/**
+ * @brief Read-only view over a saved index file
+ *
+ * The file is memory-mapped and queried in place with a binary search,
+ * so opening even a very large index is O(1) and a lookup touches only
+ * the pages it needs.
+ */
+class PayloadIndexView {
+public:
+    PayloadIndexView() = default;
+
+    /**
+     * @brief Map an index file written by PayloadIndex::save()
+     * @param path Path to the index file
+     * @return true if the file is a valid index
+     */
+    bool open(const std::string& path);
+
+    void close();
+    bool isOpen() const { return file_.isOpen(); }
+
+    /**
+     * @brief Find all locations for a payload
+     */
+    std::vector<BarcodeLocation> lookup(const std::string& payload) const;
+
+    /**
+     * @brief Number of (payload, location) records in the file
+     */
+    size_t size() const { return recordCount_; }
+
+    /**
+     * @brief Visit every record in payload order
+     */
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (size_t i = 0; i < recordCount_; ++i) {
+            visit(payloadAt(i), locationAt(i));
+        }
+    }
+
+    ErrorInfo getLastError() const { return lastError_; }
+
+private:
+    struct Record;
+
+    MappedFile file_;
+    const Record* records_ = nullptr;
+    const char* strings_ = nullptr;
+    size_t recordCount_ = 0;
+    size_t stringsSize_ = 0;
+    ErrorInfo lastError_;
+
+    std::string payloadAt(size_t index) const;
+    BarcodeLocation locationAt(size_t index) const;
+
+    friend class PayloadIndex;
+};
+
+/**
+ * @brief Thread-safe in-memory payload index
+ *
+ * Lookups take a shared lock on a single shard, so concurrent readers
+ * never contend with each other and writers only block their own shard.
+ */
+class PayloadIndex {
+public:
+    PayloadIndex() = default;
+    ~PayloadIndex() = default;
+
+    PayloadIndex(const PayloadIndex&) = delete;
+    PayloadIndex& operator=(const PayloadIndex&) = delete;
+
+    /**
+     * @brief Record a barcode location for a payload
+     *
+     * If the same barcode (drawing, sheet, image) is already recorded for
+     * the payload, its position is updated instead of adding a duplicate.
+     */
+    void add(const std::string& payload, const BarcodeLocation& location);
+
+    /**
+     * @brief Remove a single barcode location
+     * @return true if an entry was removed
+     */
+    bool remove(const std::string& payload, const BarcodeLocation& location);
+
+    /**
+     * @brief Remove every location that belongs to a drawing
+     * @return Number of entries removed
+     */
+    size_t removeDrawing(const std::string& drawingPath);
+
+    /**
+     * @brief Remove every location whose image file is in imagePaths
+     *
+     * Used when image files are rewritten or deleted on disk. One pass over
+     * the index per call, so callers should batch the paths.
+     *
+     * @return Number of entries removed
+     */
+    size_t removeImages(const std::unordered_set<std::string>& imagePaths);
+
+    /**
+     * @brief Get all locations for a payload
+     */
+    std::vector<BarcodeLocation> lookup(const std::string& payload) const;
+
+    /**
+     * @brief Get the distinct drawings that contain a payload
+     */
+    std::vector<std::string> findDrawings(const std::string& payload) const;
+
+    /**
+     * @brief Move all locations of a payload to a new payload
+     *
+     * Used when a part is renamed and its barcodes have been regenerated.
+     *
+     * @return Number of locations moved
+     */
+    size_t renamePayload(const std::string& oldPayload, const std::string& newPayload);
+
+    /**
+     * @brief Total number of (payload, location) entries
+     */
+    size_t size() const;
+
+    /**
+     * @brief Number of distinct payloads
+     */
+    size_t payloadCount() const;
+
+    void clear();
+
+    /**
+     * @brief Write the index to disk in the mmap-able format
+     *
+     * The file is written to a temporary path and renamed, so readers
+     * never observe a partially written index.
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Replace the in-memory contents with a saved index
+     */
+    bool load(const std::string& path);
+
+    ErrorInfo getLastError() const;
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, std::vector<BarcodeLocation>> entries;
+    };
+
+    std::array<Shard, SHARD_COUNT> shards_;
+    mutable std::mutex errorMutex_;
+    mutable ErrorInfo lastError_;
+
+    Shard& shardFor(const std::string& payload);
+    const Shard& shardFor(const std::string& payload) const;
+    void setError(ErrorCode code, const std::string& message, const std::string& details = "") const;
+};
+
+} // namespace creo_barcode
+
+#endif // PAYLOAD_INDEX_H
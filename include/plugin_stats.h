@@ -0,0 +1,179 @@
+/**
+ * @file plugin_stats.h
+ * @brief Always-on counters and per-stage latency histograms
+ *
+ * Unlike the tracer, which records a timeline only while enabled, these
+ * statistics are maintained for the whole session so a status dialog (or
+ * the session-end log line) can show throughput and latency at any time.
+ * Every update is a relaxed atomic increment; nothing takes a lock.
+ *
+ * Stage latencies go into log-linear histograms (four buckets per power of
+ * two of nanoseconds), so p50/p99 are reported within 12.5% of the true
+ * value without storing samples.
+ *
+ * Usage:
+ *   STATS_STAGE(StatsStage::PNG_WRITE);
+ *   PluginStats::global().addBytesWritten(size);
+ */
+
+#ifndef PLUGIN_STATS_H
+#define PLUGIN_STATS_H
+
+#include <string>
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace creo_barcode {
+
+// Keep in sync with BarcodeStageC in barcode_c_api.h
+enum class StatsStage {
+    GENERATE = 0,       // Whole BarcodeGenerator::generate call
+    ENCODE,             // Symbol encoding and matrix conversion
+    PNG_WRITE,          // PNG compression and file write
+    DECODE,             // Image load and barcode read
+    SYNC_CHECK,         // DataSyncChecker::checkSync
+    COM_INSERT,         // COM image insertion into a drawing
+    COUNT
+};
+
+const char* statsStageName(StatsStage stage);
+
+/**
+ * @brief Lock-free latency histogram with log-linear buckets
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKET_COUNT = 252;
+
+    void record(uint64_t nanos);
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t totalNanos() const { return totalNanos_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Approximate percentile (0 < fraction <= 1) in nanoseconds, 0 if empty
+     *
+     * Returns the midpoint of the bucket holding the requested rank.
+     * Concurrent record() calls may or may not be included.
+     */
+    uint64_t percentile(double fraction) const;
+
+    void reset();
+
+    static size_t bucketIndex(uint64_t nanos);
+    static uint64_t bucketLowerBound(size_t index);
+    static uint64_t bucketUpperBound(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> totalNanos_{0};
+};
+
+/**
+ * @brief Point-in-time copy of one stage's timings
+ */
+struct StageStats {
+    uint64_t count = 0;
+    uint64_t totalNanos = 0;
+    uint64_t p50Nanos = 0;
+    uint64_t p99Nanos = 0;
+};
+
+/**
+ * @brief Point-in-time copy of all statistics
+ */
+struct StatsSnapshot {
+    uint64_t barcodesGenerated = 0;
+    uint64_t cacheHits = 0;             // Renders served from the render cache
+    uint64_t decodeAttempts = 0;
+    uint64_t decodeFailures = 0;
+    uint64_t bytesWritten = 0;          // Encoded image bytes written to disk
+    std::array<StageStats, static_cast<size_t>(StatsStage::COUNT)> stages{};
+
+    const StageStats& stage(StatsStage s) const { return stages[static_cast<size_t>(s)]; }
+};
+
+class PluginStats {
+public:
+    /**
+     * @brief Process-wide statistics shared by the plugin components
+     */
+    static PluginStats& global();
+
+    PluginStats() = default;
+    PluginStats(const PluginStats&) = delete;
+    PluginStats& operator=(const PluginStats&) = delete;
+
+    void addBarcodesGenerated(uint64_t n = 1) { barcodesGenerated_.fetch_add(n, std::memory_order_relaxed); }
+    void addCacheHits(uint64_t n = 1) { cacheHits_.fetch_add(n, std::memory_order_relaxed); }
+    void addDecodeAttempts(uint64_t n = 1) { decodeAttempts_.fetch_add(n, std::memory_order_relaxed); }
+    void addDecodeFailures(uint64_t n = 1) { decodeFailures_.fetch_add(n, std::memory_order_relaxed); }
+    void addBytesWritten(uint64_t n) { bytesWritten_.fetch_add(n, std::memory_order_relaxed); }
+
+    void recordStage(StatsStage stage, uint64_t nanos) {
+        stages_[static_cast<size_t>(stage)].record(nanos);
+    }
+
+    const LatencyHistogram& histogram(StatsStage stage) const {
+        return stages_[static_cast<size_t>(stage)];
+    }
+
+    /**
+     * @brief Copy all counters and compute stage percentiles
+     *
+     * Counters are read independently, so a snapshot taken during a batch
+     * may be off by the operations in flight.
+     */
+    StatsSnapshot snapshot() const;
+
+    void reset();
+
+    /**
+     * @brief Multi-line human-readable report (for the session-end log)
+     */
+    static std::string formatSummary(const StatsSnapshot& snapshot);
+
+private:
+    std::atomic<uint64_t> barcodesGenerated_{0};
+    std::atomic<uint64_t> cacheHits_{0};
+    std::atomic<uint64_t> decodeAttempts_{0};
+    std::atomic<uint64_t> decodeFailures_{0};
+    std::atomic<uint64_t> bytesWritten_{0};
+    std::array<LatencyHistogram, static_cast<size_t>(StatsStage::COUNT)> stages_;
+};
+
+/**
+ * @brief RAII timer that records its lifetime into a stage histogram
+ */
+class StageTimer {
+public:
+    explicit StageTimer(StatsStage stage, PluginStats& stats = PluginStats::global())
+        : stage_(stage), stats_(stats), start_(std::chrono::steady_clock::now()) {}
+
+    ~StageTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        stats_.recordStage(stage_, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+private:
+    StatsStage stage_;
+    PluginStats& stats_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace creo_barcode
+
+#define CREO_STATS_CONCAT_INNER(a, b) a##b
+#define CREO_STATS_CONCAT(a, b) CREO_STATS_CONCAT_INNER(a, b)
+
+#define STATS_STAGE(stage) \
+    ::creo_barcode::StageTimer CREO_STATS_CONCAT(creoStageTimer_, __LINE__)(stage)
+
+#endif // PLUGIN_STATS_H
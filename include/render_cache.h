@@ -0,0 +1,118 @@
+/**
+ * @file render_cache.h
+ * @brief Memory-bounded LRU cache of rendered barcode pixels
+ *
+ * Encoding and scaling a barcode is the expensive part of generating one.
+ * RenderCache keeps recent renders keyed by payload and the canonical
+ * configuration hash (hashBarcodeConfig), so re-rendering the same barcode
+ * for a preview, a retry or a speculative pre-render followed by the real
+ * generation costs one lookup and a copy.
+ *
+ * Images are shared immutably: find() hands out a shared_ptr that stays
+ * valid after the entry is evicted. All methods are thread-safe.
+ */
+
+#ifndef RENDER_CACHE_H
+#define RENDER_CACHE_H
+
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include "barcode_generator.h"
+
+namespace creo_barcode {
+
+/**
+ * @brief 8-bit grayscale image, tightly packed (width * height bytes)
+ */
+struct RenderedImage {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+class RenderCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY_BYTES = 64 * 1024 * 1024;
+
+    explicit RenderCache(size_t capacityBytes = DEFAULT_CAPACITY_BYTES);
+
+    RenderCache(const RenderCache&) = delete;
+    RenderCache& operator=(const RenderCache&) = delete;
+
+    /**
+     * @brief Process-wide cache shared by the generator, preview and pre-rendering
+     */
+    static RenderCache& global();
+
+    /**
+     * @brief Look up a render and mark it recently used
+     * @return The image, or nullptr on a miss
+     */
+    std::shared_ptr<const RenderedImage> find(const std::string& payload, const BarcodeConfig& config);
+
+    /**
+     * @brief Whether a render is cached, without counting a hit or touching LRU order
+     */
+    bool contains(const std::string& payload, const BarcodeConfig& config) const;
+
+    /**
+     * @brief Store a render; images larger than the whole budget are not kept
+     */
+    void insert(const std::string& payload, const BarcodeConfig& config,
+                std::shared_ptr<const RenderedImage> image);
+
+    void clear();
+
+    size_t size() const;
+    size_t bytes() const;
+    size_t capacityBytes() const { return capacityBytes_; }
+    uint64_t hits() const;
+    uint64_t misses() const;
+
+private:
+    struct Key {
+        std::string payload;
+        uint64_t configHash;
+
+        bool operator==(const Key& other) const {
+            return configHash == other.configHash && payload == other.payload;
+        }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        Key key;
+        std::shared_ptr<const RenderedImage> image;
+    };
+
+    static Key makeKey(const std::string& payload, const BarcodeConfig& config);
+    void evictLocked();
+
+    size_t capacityBytes_;
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_;      // Most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHasher> index_;
+    size_t bytes_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+/**
+ * @brief Render data into image with a cache-less BarcodeGenerator
+ * @return false with the generator's error message in error
+ */
+bool renderBarcodeImage(const std::string& data, const BarcodeConfig& config,
+                        RenderedImage& image, std::string& error);
+
+} // namespace creo_barcode
+
+#endif // RENDER_CACHE_H
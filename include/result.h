@@ -0,0 +1,95 @@
+/**
+ * @file result.h
+ * @brief Value-or-error return type for APIs without a lastError_ member
+ *
+ * The synchronous classes report failures through getLastError(), which
+ * ties one instance to one caller at a time. Result<T> carries the error
+ * with the return value instead, so results can cross threads (the async
+ * APIs return std::future<Result<T>>).
+ *
+ * The error is a compact Error, so returning a failure does not allocate.
+ * The accessors follow std::expected: has_value(), operator*, value() and
+ * error().
+ *
+ * Usage:
+ *   Result<std::string> decoded = generator.decodeAsync(path).get();
+ *   if (!decoded) LOG_WARNING(decoded.error().message());
+ */
+
+#ifndef RESULT_H
+#define RESULT_H
+
+#include <optional>
+#include <utility>
+#include <stdexcept>
+#include "error_codes.h"
+
+namespace creo_barcode {
+
+template <typename T>
+class Result {
+public:
+    Result(T value) : value_(std::move(value)) {}
+    Result(const Error& error) : error_(error) {}
+
+    static Result failure(ErrorCode code, const char* message, std::string_view details = {}) {
+        return Result(Error(code, message, details));
+    }
+
+    bool ok() const { return value_.has_value(); }
+    bool has_value() const { return ok(); }
+    explicit operator bool() const { return ok(); }
+
+    /**
+     * @brief The value; throws std::logic_error if this holds an error
+     */
+    const T& value() const& { check(); return *value_; }
+    T& value() & { check(); return *value_; }
+    T&& value() && { check(); return std::move(*value_); }
+
+    const T& operator*() const& { return *value_; }
+    T& operator*() & { return *value_; }
+    const T* operator->() const { return &*value_; }
+    T* operator->() { return &*value_; }
+
+    T valueOr(T fallback) const { return ok() ? *value_ : std::move(fallback); }
+
+    /**
+     * @brief The error; code is SUCCESS when ok()
+     */
+    const Error& error() const { return error_; }
+
+private:
+    void check() const {
+        if (!value_) {
+            throw std::logic_error(std::string("Result has no value: ") + error_.message());
+        }
+    }
+
+    std::optional<T> value_;
+    Error error_;
+};
+
+template <>
+class Result<void> {
+public:
+    Result() = default;
+    Result(const Error& error) : error_(error) {}
+
+    static Result failure(ErrorCode code, const char* message, std::string_view details = {}) {
+        return Result(Error(code, message, details));
+    }
+
+    bool ok() const { return error_.isSuccess(); }
+    bool has_value() const { return ok(); }
+    explicit operator bool() const { return ok(); }
+
+    const Error& error() const { return error_; }
+
+private:
+    Error error_;
+};
+
+} // namespace creo_barcode
+
+#endif // RESULT_H
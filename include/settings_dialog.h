@@ -16,8 +16,10 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <memory>
 #include "barcode_generator.h"
 #include "error_codes.h"
+#include "settings_preview.h"
 
 namespace creo_barcode {
 
@@ -77,6 +79,29 @@ public:
      */
     DialogResult show(const BarcodeConfig& initialConfig);
     
+    /**
+     * @brief Show a live preview of the settings while they are edited
+     * @param onFrame Receives preview frames (on the preview worker thread)
+     * @param options Sample payload, draft size and debounce
+     */
+    void enablePreview(SettingsPreview::FrameCallback onFrame,
+                       const PreviewOptions& options = PreviewOptions());
+    
+    /**
+     * @brief Handle an edited field
+     * 
+     * Validates the edited configuration and, when it is valid, hands it
+     * to the preview. Never waits for rendering.
+     * @param config Configuration with the edited field applied
+     * @return ValidationResult for the field error display
+     */
+    ValidationResult onConfigEdited(const BarcodeConfig& config);
+    
+    /**
+     * @brief The live preview, or nullptr if not enabled
+     */
+    SettingsPreview* preview() { return preview_.get(); }
+    
     /**
      * @brief Validate barcode configuration
      * @param config Configuration to validate
@@ -127,6 +152,7 @@ public:
 private:
     ErrorInfo lastError_;
     BarcodeConfig currentConfig_;
+    std::unique_ptr<SettingsPreview> preview_;
     
     void setError(ErrorCode code, const std::string& message, const std::string& details = "");
 };
@@ -0,0 +1,162 @@
+/**
+ * @file settings_preview.h
+ * @brief Live, progressive preview of barcode settings
+ *
+ * SettingsPreview renders a sample payload with the configuration being
+ * edited in the settings dialog:
+ *
+ *   1. a draft at a fraction of the resolution as soon as a field changes
+ *   2. the full-resolution image once the fields have been quiet for the
+ *      debounce interval
+ *
+ * update() only records the new configuration and wakes the preview
+ * worker, so the dialog thread never waits for a render. Every update()
+ * starts a new generation; frames of older generations are dropped and
+ * their full-resolution render is never started. A render already running
+ * cannot be interrupted, but its result is discarded.
+ *
+ * Renders go through RenderCache, shared with the generator, so flipping
+ * back to earlier settings (or generating with the previewed settings)
+ * does not render again.
+ */
+
+#ifndef SETTINGS_PREVIEW_H
+#define SETTINGS_PREVIEW_H
+
+#include <string>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include "barcode_generator.h"
+#include "render_cache.h"
+
+namespace creo_barcode {
+
+enum class PreviewStage {
+    DRAFT,      // Reduced resolution, shown immediately
+    FINAL       // Full resolution, after the debounce
+};
+
+/**
+ * @brief One rendered (or failed) preview
+ */
+struct PreviewFrame {
+    uint64_t generation = 0;                        // update() that produced it
+    PreviewStage stage = PreviewStage::DRAFT;
+    BarcodeConfig config;                           // As rendered (drafts are scaled down)
+    std::shared_ptr<const RenderedImage> image;     // nullptr if rendering failed
+    std::string error;
+    bool cached = false;                            // Served from the render cache
+
+    bool ok() const { return image != nullptr; }
+};
+
+struct PreviewOptions {
+    std::string samplePayload = "PART-0001";
+    int draftDivisor = 4;                           // Draft renders at 1/N of each dimension
+    std::chrono::milliseconds debounce{250};        // Quiet time before the full render
+    RenderCache* cache = &RenderCache::global();    // nullptr disables caching
+};
+
+struct PreviewStats {
+    uint64_t updates = 0;
+    uint64_t drafts = 0;        // Draft frames delivered
+    uint64_t finals = 0;        // Full-resolution frames delivered
+    uint64_t renders = 0;       // Calls into the renderer (cache misses)
+    uint64_t discarded = 0;     // Frames dropped because a newer update() arrived
+};
+
+class SettingsPreview {
+public:
+    /**
+     * @brief Render payload with config into image; fill error and return false on failure
+     */
+    using RenderFn = std::function<bool(const std::string& payload, const BarcodeConfig& config,
+                                        RenderedImage& image, std::string& error)>;
+
+    /**
+     * @brief Receives every frame of the current generation, on the preview worker
+     *
+     * A frame may still arrive just after a newer update(); compare its
+     * generation with the one update() returned. The callback must not
+     * destroy the SettingsPreview.
+     */
+    using FrameCallback = std::function<void(const PreviewFrame& frame)>;
+
+    /**
+     * @param onFrame Frame sink (may be null; poll latest() instead)
+     * @param options Sample payload, draft size, debounce and cache
+     * @param render Renderer; defaults to renderBarcodeImage
+     */
+    explicit SettingsPreview(FrameCallback onFrame = nullptr,
+                             const PreviewOptions& options = PreviewOptions(),
+                             RenderFn render = RenderFn());
+
+    /**
+     * @brief Cancels pending work and joins the worker
+     */
+    ~SettingsPreview();
+
+    SettingsPreview(const SettingsPreview&) = delete;
+    SettingsPreview& operator=(const SettingsPreview&) = delete;
+
+    /**
+     * @brief Preview a new configuration (never blocks on rendering)
+     * @return Generation of this update
+     */
+    uint64_t update(const BarcodeConfig& config);
+
+    /**
+     * @brief Drop pending work; frames still in flight are discarded
+     */
+    void cancel();
+
+    /**
+     * @brief Newest frame delivered for the current generation (empty before the first)
+     */
+    PreviewFrame latest() const;
+
+    /**
+     * @brief Wait until no render is pending or running
+     * @return false on timeout
+     */
+    bool waitIdle(std::chrono::milliseconds timeout);
+
+    PreviewStats stats() const;
+
+    /**
+     * @brief Configuration used for the draft of config
+     */
+    static BarcodeConfig draftConfig(const BarcodeConfig& config, int divisor);
+
+private:
+    PreviewFrame renderFrame(uint64_t generation, PreviewStage stage, const BarcodeConfig& config);
+    void deliver(std::unique_lock<std::mutex>& lock, PreviewFrame frame);
+    void workerLoop();
+
+    FrameCallback onFrame_;
+    PreviewOptions options_;
+    RenderFn render_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    BarcodeConfig pending_;
+    uint64_t generation_ = 0;
+    uint64_t draftedGeneration_ = 0;
+    bool finalPending_ = false;
+    bool busy_ = false;             // Rendering or inside onFrame_
+    bool stopping_ = false;
+    std::chrono::steady_clock::time_point lastUpdate_;
+    PreviewFrame latest_;
+    PreviewStats stats_;
+    std::thread worker_;
+};
+
+} // namespace creo_barcode
+
+#endif // SETTINGS_PREVIEW_H
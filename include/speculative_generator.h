@@ -0,0 +1,128 @@
+/**
+ * @file speculative_generator.h
+ * @brief Pre-rendering of a drawing's barcodes before the user asks for them
+ *
+ * When speculative generation is enabled (PluginConfig::speculativeGeneration),
+ * activating a drawing hands its part names and the default configuration
+ * to SpeculativeGenerator. A single background worker, running below normal
+ * thread priority, encodes and renders each part into the RenderCache, so
+ * a later "Generate Barcode" only looks the render up, writes it and
+ * inserts it.
+ *
+ * Each activate() starts a new generation and cancels the previous one:
+ * parts not yet started are skipped. A render already running finishes
+ * and stays in the cache, where it is still valid. Parts that are already
+ * cached are not rendered again, so switching back and forth between
+ * drawings is cheap.
+ *
+ * Part names are passed in rather than looked up on the worker because
+ * Pro/TOOLKIT calls must stay on the thread Creo calls the plugin on.
+ */
+
+#ifndef SPECULATIVE_GENERATOR_H
+#define SPECULATIVE_GENERATOR_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include "barcode_generator.h"
+#include "drawing_interface.h"
+#include "render_cache.h"
+
+namespace creo_barcode {
+
+struct SpeculationOptions {
+    size_t maxParts = 32;                           // Large assemblies: first N parts only
+    bool lowPriority = true;                        // Run the worker below normal priority
+    RenderCache* cache = &RenderCache::global();    // nullptr disables pre-rendering
+};
+
+struct SpeculationStats {
+    uint64_t activations = 0;
+    uint64_t rendered = 0;          // Renders added to the cache
+    uint64_t alreadyCached = 0;     // Parts whose render was cached already
+    uint64_t invalid = 0;           // Part names not encodable with the config
+    uint64_t failed = 0;            // Renderer errors
+    uint64_t cancelled = 0;         // Parts skipped because the drawing changed
+};
+
+class SpeculativeGenerator {
+public:
+    /**
+     * @brief Render data with config into image; fill error and return false on failure
+     */
+    using RenderFn = std::function<bool(const std::string& data, const BarcodeConfig& config,
+                                        RenderedImage& image, std::string& error)>;
+
+    /**
+     * @param options Part limit, priority and target cache
+     * @param render Renderer; defaults to renderBarcodeImage
+     */
+    explicit SpeculativeGenerator(const SpeculationOptions& options = SpeculationOptions(),
+                                  RenderFn render = RenderFn());
+
+    /**
+     * @brief Cancels pending work and joins the worker
+     */
+    ~SpeculativeGenerator();
+
+    SpeculativeGenerator(const SpeculativeGenerator&) = delete;
+    SpeculativeGenerator& operator=(const SpeculativeGenerator&) = delete;
+
+    /**
+     * @brief Pre-render partNames for drawing, cancelling work for any other drawing
+     * @return Generation of this activation
+     */
+    uint64_t activate(ProDrawing drawing, std::vector<std::string> partNames,
+                      const BarcodeConfig& config);
+
+    /**
+     * @brief Drop pending work (no drawing is active)
+     */
+    void cancel();
+
+    /**
+     * @brief Drawing of the current activation, or nullptr
+     */
+    ProDrawing activeDrawing() const;
+
+    /**
+     * @brief Wait until the current activation has been worked through
+     * @return false on timeout
+     */
+    bool waitIdle(std::chrono::milliseconds timeout);
+
+    SpeculationStats stats() const;
+
+private:
+    enum class Outcome { RENDERED, CACHED, INVALID, FAILED };
+
+    Outcome speculate(const std::string& partName, const BarcodeConfig& config);
+    void workerLoop();
+
+    SpeculationOptions options_;
+    RenderFn render_;
+    BarcodeGenerator encoder_;      // Worker only: encoding and validation
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    ProDrawing drawing_ = nullptr;
+    std::vector<std::string> partNames_;
+    BarcodeConfig config_;
+    uint64_t generation_ = 0;
+    uint64_t doneGeneration_ = 0;
+    bool busy_ = false;
+    bool stopping_ = false;
+    SpeculationStats stats_;
+    std::thread worker_;
+};
+
+} // namespace creo_barcode
+
+#endif // SPECULATIVE_GENERATOR_H
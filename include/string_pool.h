@@ -0,0 +1,123 @@
+/**
+ * @file string_pool.h
+ * @brief Thread-safe string interning for part names and payloads
+ *
+ * The same part name flows through generation, batch processing, sync
+ * checks and the C API. Interning stores each distinct string once and
+ * hands out lightweight handles:
+ * - Handles are stable for the lifetime of the pool and NUL-terminated
+ * - Two handles from the same pool are equal iff their pointers are equal
+ * - Lookups of already-interned strings take only a shared lock
+ */
+
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <unordered_set>
+#include <shared_mutex>
+#include <array>
+#include <cstdint>
+
+namespace creo_barcode {
+
+/**
+ * @brief Handle to a string owned by a StringPool
+ *
+ * Cheap to copy. Comparison is a pointer comparison, so only compare
+ * handles that came from the same pool.
+ */
+class InternedString {
+public:
+    InternedString() : data_(""), size_(0) {}
+
+    std::string_view view() const { return std::string_view(data_, size_); }
+    const char* c_str() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::string str() const { return std::string(data_, size_); }
+
+    bool operator==(const InternedString& other) const { return data_ == other.data_; }
+    bool operator!=(const InternedString& other) const { return data_ != other.data_; }
+
+private:
+    InternedString(const char* data, size_t size) : data_(data), size_(size) {}
+
+    const char* data_;
+    size_t size_;
+
+    friend class StringPool;
+};
+
+/**
+ * @brief Sharded, append-only string intern pool
+ *
+ * Strings are never freed individually; the pool is meant for bounded
+ * vocabularies such as part names, drawing paths and payloads.
+ */
+class StringPool {
+public:
+    StringPool() = default;
+    ~StringPool() = default;
+
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    /**
+     * @brief Process-wide pool shared by the plugin components
+     */
+    static StringPool& global();
+
+    /**
+     * @brief Get the canonical handle for a string, adding it if needed
+     */
+    InternedString intern(std::string_view value);
+
+    /**
+     * @brief Look up a string without adding it
+     * @return Handle if the string is interned, otherwise an empty handle
+     *         and found == false
+     */
+    InternedString find(std::string_view value, bool& found) const;
+
+    /**
+     * @brief Number of distinct strings
+     */
+    size_t size() const;
+
+    /**
+     * @brief Bytes reserved for string storage
+     */
+    size_t memoryBytes() const;
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    struct ViewHash {
+        size_t operator()(std::string_view value) const;
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_set<std::string_view, ViewHash> strings;
+        std::vector<std::unique_ptr<char[]>> blocks;
+        char* chunk = nullptr;          // Block currently being filled
+        size_t chunkUsed = CHUNK_SIZE;  // Forces a new chunk on first store
+        size_t reservedBytes = 0;
+
+        const char* store(std::string_view value);
+    };
+
+    std::array<Shard, SHARD_COUNT> shards_;
+
+    Shard& shardFor(std::string_view value);
+    const Shard& shardFor(std::string_view value) const;
+};
+
+} // namespace creo_barcode
+
+#endif // STRING_POOL_H
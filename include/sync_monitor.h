@@ -0,0 +1,160 @@
+/**
+ * @file sync_monitor.h
+ * @brief Event-driven sync checking for renamed and saved models
+ *
+ * A full sync check decodes every barcode in a drawing. SyncMonitor keeps
+ * sync state current from model notifications instead:
+ *
+ *   1. onModelRenamed()/onModelSaved() record the model's old and current
+ *      part names; events for the same model are merged
+ *   2. once no event has arrived for the debounce interval, a background
+ *      worker looks up only the barcodes bound to those names in the
+ *      PayloadIndex and re-checks them with DataSyncChecker
+ *   3. barcodes that are now out of sync are queued, and dispatchWarnings()
+ *      reports them through the checker's WarningDisplayCallback on the
+ *      thread that calls it (Creo's UI thread: the callback may use
+ *      Pro/TOOLKIT, which must not be called from the worker)
+ *
+ * The cost of a pass is proportional to the barcodes of the changed models;
+ * nothing is decoded and no drawing is rescanned.
+ *
+ * A save is treated as a rename when the model's name differs from the last
+ * one the monitor saw for it (e.g. renamed through PDM without a rename
+ * notification). onModelErased() forgets that name, since Creo may hand
+ * out the same ProMdl for the next model loaded.
+ */
+
+#ifndef SYNC_MONITOR_H
+#define SYNC_MONITOR_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include "data_sync_checker.h"
+#include "drawing_interface.h"
+
+namespace creo_barcode {
+
+class PayloadIndex;
+
+struct SyncMonitorStats {
+    uint64_t events = 0;            // Rename/save notifications received
+    uint64_t passes = 0;            // Debounced verification passes run
+    uint64_t modelsChecked = 0;
+    uint64_t barcodesChecked = 0;
+    uint64_t outOfSync = 0;         // Warnings queued
+    uint64_t dispatched = 0;        // Warnings shown by dispatchWarnings()
+    uint64_t dropped = 0;           // Oldest warnings dropped from a full queue
+};
+
+class SyncMonitor {
+public:
+    // Warnings kept for dispatchWarnings(); beyond this the oldest are dropped
+    static constexpr size_t MAX_PENDING_WARNINGS = 256;
+
+    /**
+     * @param checker Checker used for each barcode; its default
+     *                WarningDisplayCallback receives the warnings, on the
+     *                thread that calls dispatchWarnings()
+     * @param index Index that binds payloads to barcode locations
+     * @param debounce Quiet time before a pass starts
+     *
+     * Both must outlive the monitor.
+     */
+    SyncMonitor(DataSyncChecker& checker, PayloadIndex& index,
+                std::chrono::milliseconds debounce = std::chrono::milliseconds(500));
+
+    /**
+     * @brief Drops pending events and joins the worker
+     */
+    ~SyncMonitor();
+
+    SyncMonitor(const SyncMonitor&) = delete;
+    SyncMonitor& operator=(const SyncMonitor&) = delete;
+
+    /**
+     * @brief Queue the barcodes of oldName and newName for re-verification
+     */
+    void onModelRenamed(ProMdl model, const std::string& oldName, const std::string& newName);
+
+    /**
+     * @brief Queue the barcodes of a saved model for re-verification
+     * @param name The model's part name at save time
+     */
+    void onModelSaved(ProMdl model, const std::string& name);
+
+    /**
+     * @brief Forget a model that was erased from the session
+     *
+     * Changes already queued for it are still verified.
+     */
+    void onModelErased(ProMdl model);
+
+    /**
+     * @brief Show queued out-of-sync warnings on the calling thread
+     *
+     * Call from Creo's UI thread, e.g. on each notification or menu action.
+     * Only the latest warning of each barcode is kept until then, and at
+     * most MAX_PENDING_WARNINGS of them.
+     *
+     * @return Number of warnings shown
+     */
+    size_t dispatchWarnings();
+
+    /**
+     * @brief Warnings waiting for dispatchWarnings()
+     */
+    size_t pendingWarnings() const;
+
+    /**
+     * @brief Models waiting for the next pass
+     */
+    size_t pendingModels() const;
+
+    /**
+     * @brief Wait until no pass is pending or running
+     * @return false on timeout
+     */
+    bool waitIdle(std::chrono::milliseconds timeout);
+
+    SyncMonitorStats stats() const;
+
+private:
+    struct PendingChange {
+        std::vector<std::string> previousNames;     // Names the model had since the last pass
+        std::string currentName;
+    };
+
+    using ChangeMap = std::unordered_map<ProMdl, PendingChange>;
+
+    void enqueueLocked(ProMdl model, const std::string& previousName, const std::string& currentName);
+    void verify(const ChangeMap& changes, SyncMonitorStats& pass, std::vector<BarcodeInstance>& warnings);
+    void queueWarningsLocked(std::vector<BarcodeInstance>& warnings);
+    void workerLoop();
+
+    DataSyncChecker& checker_;
+    PayloadIndex& index_;
+    std::chrono::milliseconds debounce_;
+    BarcodeGenerator codec_;        // Worker only: payload encoding
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    ChangeMap pending_;
+    std::unordered_map<ProMdl, std::string> knownNames_;
+    std::vector<BarcodeInstance> warnings_;     // Out of sync, not yet shown
+    std::chrono::steady_clock::time_point lastEvent_;
+    bool busy_ = false;
+    bool stopping_ = false;
+    SyncMonitorStats stats_;
+    std::thread worker_;
+};
+
+} // namespace creo_barcode
+
+#endif // SYNC_MONITOR_H
@@ -0,0 +1,120 @@
+/**
+ * @file thread_pool.h
+ * @brief Fixed-size worker pool for background barcode work
+ *
+ * Tasks run in submission order on a fixed set of worker threads. The pool
+ * is owned by whoever creates it; destroying it finishes the queued tasks
+ * and joins the workers, so it must not be destroyed from one of its own
+ * tasks.
+ *
+ * ThreadPool::shared() is the process-wide executor behind the async C++
+ * APIs (generateAsync, decodeAsync, checkSyncAsync). The plugin shuts it
+ * down at unload so no worker outlives the DLL.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace creo_barcode {
+
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Start the workers
+     * @param threadCount Number of workers; 0 uses the hardware concurrency
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+
+    /**
+     * @brief Runs the remaining queued tasks, then joins the workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Process-wide pool sized to the hardware concurrency
+     */
+    static ThreadPool& shared();
+
+    /**
+     * @brief Shut down the shared pool (plugin unload)
+     *
+     * Later async() calls on it run inline on the caller's thread.
+     */
+    static void shutdownShared();
+
+    /**
+     * @brief Run a callable on the pool and get its result as a future
+     *
+     * Exceptions thrown by the callable are stored in the future. If the
+     * pool has shut down, the callable runs inline so the future is always
+     * satisfied.
+     */
+    template <typename F>
+    auto async(F&& function) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using R = std::invoke_result_t<std::decay_t<F>>;
+        // packaged_task is move-only; std::function needs a copyable wrapper
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(function));
+        std::future<R> future = task->get_future();
+        if (!submit([task]() { (*task)(); })) {
+            (*task)();
+        }
+        return future;
+    }
+
+    /**
+     * @brief Queue a task
+     * @return false if the pool is shutting down (the task is not run)
+     *
+     * Exceptions escaping a task are caught and discarded; tasks report
+     * failures through their own results.
+     */
+    bool submit(Task task);
+
+    /**
+     * @brief Stop accepting tasks, finish the queued ones and join the workers
+     *
+     * Idempotent. Called by the destructor.
+     */
+    void shutdown();
+
+    size_t threadCount() const { return workers_.size(); }
+
+    /**
+     * @brief Tasks queued but not yet started
+     */
+    size_t pendingTasks() const;
+
+    /**
+     * @brief True when called from one of this pool's workers
+     */
+    bool isWorkerThread() const;
+
+private:
+    void workerLoop();
+
+    mutable std::mutex mutex_;
+    std::condition_variable wakeWorkers_;
+    std::deque<Task> tasks_;
+    std::vector<std::thread> workers_;
+    std::vector<std::thread::id> workerIds_;
+    bool stopping_ = false;
+};
+
+} // namespace creo_barcode
+
+#endif // THREAD_POOL_H
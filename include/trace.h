@@ -0,0 +1,190 @@
+/**
+ * @file trace.h
+ * @brief Timeline tracing with Chrome trace / Perfetto export
+ *
+ * TRACE_SCOPE marks a stage (encode, PNG write, file probe, COM insert,
+ * repaint, ...) on the calling thread. Each scope becomes one complete
+ * event with its begin time and duration, appended to a per-thread buffer.
+ * Tracer::exportChromeTrace() writes every buffer as Chrome trace JSON,
+ * which ui.perfetto.dev and chrome://tracing open directly.
+ *
+ * Tracing is off until Tracer::start() (PluginConfig::enableTracing). While
+ * off, a scope costs one relaxed atomic load; while on, two clock reads and
+ * an append. Build with -DCREO_TRACE_DISABLED to remove the scopes entirely.
+ *
+ * Usage:
+ *   TRACE_SCOPE("generator", "png_write");
+ *   TRACE_SCOPE_DETAIL("batch", "file", filePath);
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include "error_codes.h"
+#include "string_pool.h"
+
+namespace creo_barcode {
+
+namespace trace_detail {
+
+// Constant-initialized so it can be checked during DLL load
+inline std::atomic<bool> enabled{false};
+
+uint64_t nowNanos();
+
+} // namespace trace_detail
+
+inline bool isTracingEnabled() {
+    return trace_detail::enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief One completed scope
+ *
+ * category and name must be string literals (or otherwise outlive the
+ * tracer); detail is interned.
+ */
+struct TraceEvent {
+    const char* category = "";
+    const char* name = "";
+    InternedString detail;
+    uint64_t startNanos = 0;        // Relative to Tracer::start()
+    uint64_t durationNanos = 0;
+    uint32_t threadIndex = 0;
+};
+
+class Tracer {
+public:
+    static Tracer& getInstance();
+
+    /**
+     * @brief Default export path (%TEMP%\\creo_barcode_trace.json or /tmp/...)
+     */
+    static std::string defaultPath();
+
+    /**
+     * @brief Discard earlier events and start recording
+     */
+    void start();
+
+    /**
+     * @brief Stop recording; recorded events are kept for export
+     */
+    void stop();
+
+    /**
+     * @brief Write all recorded events as Chrome trace JSON
+     *
+     * Safe to call while recording; scopes still open are not included.
+     */
+    bool exportChromeTrace(const std::string& path);
+
+    /**
+     * @brief Copy of all recorded events, ordered by start time
+     */
+    std::vector<TraceEvent> collectEvents();
+
+    /**
+     * @brief Name the calling thread in exported traces (unnamed threads show their index)
+     */
+    void setCurrentThreadName(const std::string& name);
+
+    // Events discarded because a thread exceeded MAX_EVENTS_PER_THREAD
+    uint64_t droppedEvents() const { return dropped_.load(std::memory_order_relaxed); }
+
+    ErrorInfo getLastError() const;
+
+    /**
+     * @brief Append one event for the calling thread (used by TraceScope)
+     */
+    void record(const char* category, const char* name, InternedString detail,
+                uint64_t startNanos, uint64_t endNanos);
+
+    static constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+private:
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::vector<TraceEvent> events;
+        uint32_t threadIndex = 0;
+        std::string threadName;
+    };
+
+    Tracer() = default;
+    ~Tracer() = default;
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    ThreadBuffer& localBuffer();
+    void retireBuffer(ThreadBuffer* buffer);
+    void setError(ErrorCode code, const std::string& message, const std::string& details);
+
+    std::atomic<uint64_t> epochNanos_{0};
+    std::atomic<uint64_t> dropped_{0};
+
+    // Guards the buffer list, retired events and lastError_
+    mutable std::mutex registryMutex_;
+    std::vector<ThreadBuffer*> buffers_;
+    std::vector<TraceEvent> retiredEvents_;                           // From exited threads
+    std::vector<std::pair<uint32_t, std::string>> retiredThreadNames_;
+    uint32_t nextThreadIndex_ = 1;
+    ErrorInfo lastError_;
+
+    friend struct TracerThreadHolder;
+};
+
+/**
+ * @brief RAII scope that records one trace event when tracing is on
+ */
+class TraceScope {
+public:
+    TraceScope(const char* category, const char* name)
+        : category_(category), name_(name),
+          active_(isTracingEnabled()), start_(active_ ? trace_detail::nowNanos() : 0) {}
+
+    TraceScope(const char* category, const char* name, std::string_view detail)
+        : TraceScope(category, name) {
+        if (active_) {
+            detail_ = StringPool::global().intern(detail);
+        }
+    }
+
+    ~TraceScope() {
+        if (active_) {
+            Tracer::getInstance().record(category_, name_, detail_, start_, trace_detail::nowNanos());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* category_;
+    const char* name_;
+    bool active_;
+    uint64_t start_;
+    InternedString detail_;
+};
+
+} // namespace creo_barcode
+
+#define CREO_TRACE_CONCAT_INNER(a, b) a##b
+#define CREO_TRACE_CONCAT(a, b) CREO_TRACE_CONCAT_INNER(a, b)
+
+#ifdef CREO_TRACE_DISABLED
+#define TRACE_SCOPE(category, name) ((void)0)
+#define TRACE_SCOPE_DETAIL(category, name, detail) ((void)0)
+#else
+#define TRACE_SCOPE(category, name) \
+    ::creo_barcode::TraceScope CREO_TRACE_CONCAT(creoTraceScope_, __LINE__)(category, name)
+#define TRACE_SCOPE_DETAIL(category, name, detail) \
+    ::creo_barcode::TraceScope CREO_TRACE_CONCAT(creoTraceScope_, __LINE__)(category, name, detail)
+#endif
+
+#endif // TRACE_H
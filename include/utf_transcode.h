@@ -0,0 +1,102 @@
+/**
+ * @file utf_transcode.h
+ * @brief UTF-8 <-> UTF-16/wide transcoding into caller-provided buffers
+ *
+ * Paths and part names cross the COM boundary as UTF-16 and the rest of
+ * the plugin as UTF-8. These functions convert between the two without a
+ * separate size query and without allocating: runs of ASCII are widened or
+ * narrowed 16 characters at a time (SSE2 on x86, NEON on AArch64, 8-byte
+ * words elsewhere) and only non-ASCII characters take the scalar path.
+ *
+ * wchar_t is UTF-16 on Windows and UTF-32 elsewhere; the wide overloads
+ * follow the platform so the same code is built and tested on Linux.
+ *
+ * Malformed input never fails: each invalid UTF-8 sequence (maximal
+ * subpart) and each unpaired surrogate becomes U+FFFD, matching what
+ * MultiByteToWideChar/WideCharToMultiByte do without flags.
+ */
+
+#ifndef UTF_TRANSCODE_H
+#define UTF_TRANSCODE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace creo_barcode {
+namespace utf {
+
+enum class TranscodeStatus {
+    OK,                 // All input converted
+    OUTPUT_TOO_SMALL    // Stopped before the first character that did not fit
+};
+
+struct TranscodeResult {
+    TranscodeStatus status = TranscodeStatus::OK;
+    size_t read = 0;        // Input units consumed (always a whole character)
+    size_t written = 0;     // Output units written
+
+    bool ok() const { return status == TranscodeStatus::OK; }
+};
+
+/**
+ * @brief UTF-16 units needed for a UTF-8 string
+ */
+size_t utf16Length(const char* utf8, size_t length);
+
+/**
+ * @brief UTF-8 bytes needed for a UTF-16 string
+ */
+size_t utf8Length(const char16_t* utf16, size_t length);
+
+/**
+ * @brief Convert UTF-8 to UTF-16
+ *
+ * Output is not null-terminated. A capacity of length units always fits.
+ */
+TranscodeResult utf8ToUtf16(const char* utf8, size_t length, char16_t* out, size_t capacity);
+
+/**
+ * @brief Convert UTF-16 to UTF-8
+ *
+ * Output is not null-terminated. A capacity of 3 * length bytes always fits.
+ */
+TranscodeResult utf16ToUtf8(const char16_t* utf16, size_t length, char* out, size_t capacity);
+
+/**
+ * @brief wchar_t units needed for a UTF-8 string
+ */
+size_t wideLength(const char* utf8, size_t length);
+
+/**
+ * @brief UTF-8 bytes needed for a wide string
+ */
+size_t utf8LengthFromWide(const wchar_t* wide, size_t length);
+
+/**
+ * @brief Convert UTF-8 to wchar_t (UTF-16 or UTF-32, per platform)
+ *
+ * Output is not null-terminated. A capacity of length units always fits.
+ */
+TranscodeResult utf8ToWide(const char* utf8, size_t length, wchar_t* out, size_t capacity);
+
+/**
+ * @brief Convert wchar_t (UTF-16 or UTF-32, per platform) to UTF-8
+ *
+ * Output is not null-terminated. A capacity of 4 * length bytes always fits.
+ */
+TranscodeResult wideToUtf8(const wchar_t* wide, size_t length, char* out, size_t capacity);
+
+/**
+ * @brief Convert into a reusable string, growing it at most once
+ *
+ * The previous contents of out are replaced; its capacity is kept, so a
+ * caller converting many strings allocates only for the longest.
+ */
+void utf8ToWide(std::string_view utf8, std::wstring& out);
+void wideToUtf8(std::wstring_view wide, std::string& out);
+
+} // namespace utf
+} // namespace creo_barcode
+
+#endif // UTF_TRANSCODE_H
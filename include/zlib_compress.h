@@ -0,0 +1,31 @@
+/**
+ * @file zlib_compress.h
+ * @brief zlib stream compression shared by the image writer and the logger
+ *
+ * Wraps the deflate encoder of stb_image_write. Its implementation is
+ * compiled once, in zlib_compress.cpp, so modules that need compression
+ * depend on this header rather than on whichever file happens to define
+ * STB_IMAGE_WRITE_IMPLEMENTATION.
+ */
+
+#ifndef ZLIB_COMPRESS_H
+#define ZLIB_COMPRESS_H
+
+#include <vector>
+#include <cstddef>
+
+namespace creo_barcode {
+
+/**
+ * @brief Compress data into a zlib (RFC 1950) stream
+ * @param data Bytes to compress
+ * @param size Number of bytes
+ * @param out Receives the stream: 2-byte header, deflate data, Adler-32
+ * @param quality Encoder effort, 5 (fast) and up
+ * @return false if data is too large or the encoder failed
+ */
+bool zlibCompress(const unsigned char* data, size_t size, std::vector<unsigned char>& out, int quality = 8);
+
+} // namespace creo_barcode
+
+#endif // ZLIB_COMPRESS_H
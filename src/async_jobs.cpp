@@ -0,0 +1,225 @@
+/**
+ * @file async_jobs.cpp
+ * @brief Implementation of pooled asynchronous job handles
+ */
+
+#include "async_jobs.h"
+#include <chrono>
+
+namespace creo_barcode {
+
+namespace {
+
+bool isFinished(JobState state) {
+    return state == JobState::SUCCEEDED || state == JobState::FAILED;
+}
+
+} // anonymous namespace
+
+AsyncJobTable::~AsyncJobTable() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_.wait(lock, [this]() { return unfinished_ == 0; });
+}
+
+AsyncJobTable::Slot* AsyncJobTable::findLocked(JobHandle job) {
+    uint64_t index = (job & 0xFFFFFFFFu);
+    if (index == 0 || index > slots_.size()) {
+        return nullptr;
+    }
+    Slot& slot = slots_[index - 1];
+    if (!slot.live || slot.released || slot.generation != static_cast<uint32_t>(job >> 32)) {
+        return nullptr;
+    }
+    return &slot;
+}
+
+const AsyncJobTable::Slot* AsyncJobTable::findLocked(JobHandle job) const {
+    return const_cast<AsyncJobTable*>(this)->findLocked(job);
+}
+
+void AsyncJobTable::recycleLocked(uint32_t index) {
+    Slot& slot = slots_[index];
+    slot.live = false;
+    slot.released = false;
+    slot.state = JobState::PENDING;
+    slot.result.clear();        // Keeps capacity for the next job
+    slot.error.clear();
+    // Handles to the old job stop matching; skip 0 on wrap-around
+    if (++slot.generation == 0) {
+        slot.generation = 1;
+    }
+    freeSlots_.push_back(index);
+}
+
+JobHandle AsyncJobTable::submit(Work work, Completion completion, CallbackMode mode) {
+    uint32_t index;
+    JobHandle job;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!freeSlots_.empty()) {
+            index = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            index = static_cast<uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+        Slot& slot = slots_[index];
+        slot.live = true;
+        job = makeHandle(index, slot.generation);
+        ++unfinished_;
+    }
+
+    bool queued = pool_.submit([this, index, job, work = std::move(work),
+                                completion = std::move(completion), mode]() {
+        run(index, job, work, completion, mode);
+    });
+
+    if (!queued) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        recycleLocked(index);
+        --unfinished_;
+        finished_.notify_all();
+        return 0;
+    }
+    return job;
+}
+
+void AsyncJobTable::run(uint32_t index, JobHandle job, const Work& work,
+                        const Completion& completion, CallbackMode mode) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slots_[index].state = JobState::RUNNING;
+    }
+
+    std::string result;
+    std::string error;
+    bool ok = false;
+    try {
+        ok = work(result, error);
+    } catch (const std::exception& e) {
+        error = e.what();
+    } catch (...) {
+        error = "Unknown exception in background job";
+    }
+
+    JobState state = ok ? JobState::SUCCEEDED : JobState::FAILED;
+    bool runCallbackHere = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Slot& slot = slots_[index];
+        slot.state = state;
+        slot.result = std::move(result);
+        slot.error = std::move(error);
+        if (slot.released) {
+            recycleLocked(index);
+        }
+        if (completion) {
+            if (mode == CallbackMode::DISPATCHED) {
+                callbacks_.push_back(PendingCallback{completion, job, state});
+            } else {
+                runCallbackHere = true;
+            }
+        }
+        if (!runCallbackHere) {
+            --unfinished_;
+        }
+        // Notify under the lock: once unfinished_ hits zero the destructor may run
+        finished_.notify_all();
+    }
+
+    if (runCallbackHere) {
+        try {
+            completion(job, state);
+        } catch (...) {
+            // Callbacks come from C code; never let one unwind into the pool
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        --unfinished_;
+        finished_.notify_all();
+    }
+}
+
+bool AsyncJobTable::poll(JobHandle job, JobState& state) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Slot* slot = findLocked(job);
+    if (!slot) {
+        return false;
+    }
+    state = slot->state;
+    return true;
+}
+
+bool AsyncJobTable::wait(JobHandle job, int timeoutMs, JobState& state) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto done = [this, job]() {
+        const Slot* slot = findLocked(job);
+        return !slot || isFinished(slot->state);
+    };
+
+    if (timeoutMs < 0) {
+        finished_.wait(lock, done);
+    } else {
+        finished_.wait_for(lock, std::chrono::milliseconds(timeoutMs), done);
+    }
+
+    const Slot* slot = findLocked(job);
+    if (!slot) {
+        return false;
+    }
+    state = slot->state;
+    return true;
+}
+
+bool AsyncJobTable::getResult(JobHandle job, std::string& result, std::string& error) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Slot* slot = findLocked(job);
+    if (!slot || !isFinished(slot->state)) {
+        return false;
+    }
+    result = slot->result;
+    error = slot->error;
+    return true;
+}
+
+bool AsyncJobTable::release(JobHandle job) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Slot* slot = findLocked(job);
+    if (!slot) {
+        return false;
+    }
+    if (isFinished(slot->state)) {
+        recycleLocked(static_cast<uint32_t>((job & 0xFFFFFFFFu) - 1));
+    } else {
+        slot->released = true;     // Recycled by run() when the job finishes
+    }
+    finished_.notify_all();
+    return true;
+}
+
+size_t AsyncJobTable::dispatchCompletions() {
+    std::vector<PendingCallback> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ready.swap(callbacks_);
+    }
+    for (auto& callback : ready) {
+        try {
+            callback.completion(callback.job, callback.state);
+        } catch (...) {
+            // Same policy as worker-thread callbacks
+        }
+    }
+    return ready.size();
+}
+
+size_t AsyncJobTable::liveJobs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slots_.size() - freeSlots_.size();
+}
+
+size_t AsyncJobTable::slotCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slots_.size();
+}
+
+} // namespace creo_barcode
@@ -8,6 +8,10 @@
 #include "config_manager.h"
 #include "data_sync_checker.h"
 #include "creo_com_bridge.h"
+#include "string_pool.h"
+#include "plugin_stats.h"
+#include "thread_pool.h"
+#include "async_jobs.h"
 #include "logger.h"
 #include <string>
 #include <memory>
@@ -15,6 +19,10 @@
 #include <vector>
 #include <sstream>
 #include <iomanip>
+#include <mutex>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -26,7 +34,13 @@ using namespace creo_barcode;
 static std::unique_ptr<BarcodeGenerator> g_generator;
 static std::unique_ptr<ConfigManager> g_configManager;
 static std::unique_ptr<DataSyncChecker> g_syncChecker;
-static std::string g_lastError;
+// Per thread, so async callers and worker callbacks never race on it
+static thread_local std::string g_lastError;
+
+// Background jobs; created on first submission
+static std::mutex g_jobsMutex;
+static std::unique_ptr<ThreadPool> g_jobPool;
+static std::unique_ptr<AsyncJobTable> g_jobs;
 
 // Convert C enum to C++ enum
 static BarcodeType toCppType(BarcodeTypeC type) {
@@ -40,6 +54,93 @@ static BarcodeType toCppType(BarcodeTypeC type) {
     }
 }
 
+static BarcodeConfig toCppConfig(const BarcodeConfigC* config) {
+    BarcodeConfig cppConfig;
+    cppConfig.type = toCppType(config->type);
+    cppConfig.width = config->width;
+    cppConfig.height = config->height;
+    cppConfig.margin = config->margin;
+    cppConfig.showText = config->showText != 0;
+    cppConfig.dpi = config->dpi;
+    return cppConfig;
+}
+
+static AsyncJobTable* getJobTable() {
+    std::lock_guard<std::mutex> lock(g_jobsMutex);
+    if (!g_jobs) {
+        g_jobPool.reset(new ThreadPool());
+        g_jobs.reset(new AsyncJobTable(*g_jobPool));
+    }
+    return g_jobs.get();
+}
+
+// Existing table only: looking up a handle never starts the pool, and
+// returns nullptr once barcode_cleanup has taken the table
+static AsyncJobTable* findJobTable() {
+    std::lock_guard<std::mutex> lock(g_jobsMutex);
+    return g_jobs.get();
+}
+
+static int toJobStatus(JobState state) {
+    switch (state) {
+        case JobState::PENDING: return BARCODE_JOB_PENDING;
+        case JobState::RUNNING: return BARCODE_JOB_RUNNING;
+        case JobState::SUCCEEDED: return BARCODE_JOB_SUCCEEDED;
+        case JobState::FAILED: return BARCODE_JOB_FAILED;
+        default: return BARCODE_JOB_INVALID;
+    }
+}
+
+static BarcodeJobHandle submitJob(AsyncJobTable::Work work, BarcodeJobCallback callback,
+                                  void* userData, BarcodeCallbackModeC mode) {
+    AsyncJobTable::Completion completion;
+    if (callback) {
+        completion = [callback, userData](JobHandle job, JobState state) {
+            callback(job, toJobStatus(state), userData);
+        };
+    }
+    
+    try {
+        JobHandle job = getJobTable()->submit(std::move(work), std::move(completion),
+            mode == BARCODE_CALLBACK_DISPATCH ? CallbackMode::DISPATCHED : CallbackMode::WORKER_THREAD);
+        if (job == 0) {
+            g_lastError = "Job pool is shutting down";
+        }
+        return job;
+    } catch (const std::exception& e) {
+        g_lastError = std::string("Failed to submit job: ") + e.what();
+        return 0;
+    }
+}
+
+// Message plus detail; the detail holds file paths and exception texts
+static std::string errorText(const ErrorInfo& error) {
+    return error.details.empty() ? error.message : error.message + ": " + error.details;
+}
+
+static int copyToBuffer(const std::string& text, char* buffer, int bufferSize) {
+    if (!buffer || bufferSize <= 0) {
+        return -1;
+    }
+    strncpy(buffer, text.c_str(), bufferSize - 1);
+    buffer[bufferSize - 1] = '\0';
+    return 0;
+}
+
+// Copies decoded text; 1 if it had to be truncated
+static int copyDecodedText(const std::optional<std::string>& text, const BarcodeGenerator& generator,
+                           char* outputBuffer, int bufferSize, int* textLength) {
+    if (!text) {
+        g_lastError = errorText(generator.getLastError());
+        return -1;
+    }
+    if (textLength) {
+        *textLength = static_cast<int>(std::min(text->size(), static_cast<size_t>(INT_MAX)));
+    }
+    copyToBuffer(*text, outputBuffer, bufferSize);
+    return text->size() < static_cast<size_t>(bufferSize) ? 0 : 1;
+}
+
 extern "C" {
 
 int barcode_init(void) {
@@ -67,6 +168,18 @@ int barcode_init(void) {
 }
 
 void barcode_cleanup(void) {
+    // Finish outstanding jobs before the pool goes away. The table waits for
+    // running callbacks, which may call back into the job API, so it is
+    // destroyed outside g_jobsMutex; they find no table and get INVALID.
+    std::unique_ptr<AsyncJobTable> jobs;
+    std::unique_ptr<ThreadPool> jobPool;
+    {
+        std::lock_guard<std::mutex> lock(g_jobsMutex);
+        jobs = std::move(g_jobs);
+        jobPool = std::move(g_jobPool);
+    }
+    jobs.reset();
+    jobPool.reset();
     g_generator.reset();
     g_configManager.reset();
     g_syncChecker.reset();
@@ -104,13 +217,7 @@ int barcode_generate(const char* data, const BarcodeConfigC* config, const char*
     }
     
     try {
-        BarcodeConfig cppConfig;
-        cppConfig.type = toCppType(config->type);
-        cppConfig.width = config->width;
-        cppConfig.height = config->height;
-        cppConfig.margin = config->margin;
-        cppConfig.showText = config->showText != 0;
-        cppConfig.dpi = config->dpi;
+        BarcodeConfig cppConfig = toCppConfig(config);
         
         // Use std::string with explicit construction to avoid issues
         std::string dataStr(data);
@@ -119,7 +226,7 @@ int barcode_generate(const char* data, const BarcodeConfigC* config, const char*
         if (g_generator->generate(dataStr, cppConfig, pathStr)) {
             return 0;
         } else {
-            g_lastError = g_generator->getLastError().message;
+            g_lastError = errorText(g_generator->getLastError());
             return -1;
         }
     } catch (const std::exception& e) {
@@ -144,9 +251,215 @@ int barcode_decode(const char* imagePath, char* outputBuffer, int bufferSize) {
             outputBuffer[bufferSize - 1] = '\0';
             return 0;
         } else {
-            g_lastError = g_generator->getLastError().message;
+            g_lastError = errorText(g_generator->getLastError());
+            return -1;
+        }
+    } catch (const std::exception& e) {
+        g_lastError = e.what();
+        return -1;
+    }
+}
+
+BarcodeJobHandle barcode_submit_generate(const char* data,
+                                         const BarcodeConfigC* config,
+                                         const char* outputPath,
+                                         BarcodeJobCallback callback,
+                                         void* userData,
+                                         BarcodeCallbackModeC mode) {
+    if (!data || !config || !outputPath || data[0] == '\0' || outputPath[0] == '\0') {
+        g_lastError = "Invalid parameters: null pointer or empty string";
+        return 0;
+    }
+    
+    BarcodeConfig cppConfig = toCppConfig(config);
+    std::string dataStr(data);
+    std::string pathStr(outputPath);
+    
+    // Each job gets its own generator: BarcodeGenerator keeps per-call error state
+    return submitJob([dataStr, cppConfig, pathStr](std::string&, std::string& error) {
+        BarcodeGenerator generator;
+        if (!generator.generate(dataStr, cppConfig, pathStr)) {
+            error = errorText(generator.getLastError());
+            return false;
+        }
+        return true;
+    }, callback, userData, mode);
+}
+
+BarcodeJobHandle barcode_submit_decode(const char* imagePath,
+                                       BarcodeJobCallback callback,
+                                       void* userData,
+                                       BarcodeCallbackModeC mode) {
+    if (!imagePath || imagePath[0] == '\0') {
+        g_lastError = "Invalid parameters: null pointer or empty string";
+        return 0;
+    }
+    
+    std::string pathStr(imagePath);
+    return submitJob([pathStr](std::string& result, std::string& error) {
+        BarcodeGenerator generator;
+        auto decoded = generator.decode(pathStr);
+        if (!decoded) {
+            error = errorText(generator.getLastError());
+            return false;
+        }
+        result = std::move(*decoded);
+        return true;
+    }, callback, userData, mode);
+}
+
+int barcode_job_poll(BarcodeJobHandle job) {
+    AsyncJobTable* jobs = findJobTable();
+    JobState state;
+    if (!jobs || !jobs->poll(job, state)) {
+        return BARCODE_JOB_INVALID;
+    }
+    return toJobStatus(state);
+}
+
+int barcode_job_wait(BarcodeJobHandle job, int timeoutMs) {
+    AsyncJobTable* jobs = findJobTable();
+    JobState state;
+    if (!jobs || !jobs->wait(job, timeoutMs, state)) {
+        return BARCODE_JOB_INVALID;
+    }
+    return toJobStatus(state);
+}
+
+int barcode_job_get_result(BarcodeJobHandle job, char* buffer, int bufferSize) {
+    AsyncJobTable* jobs = findJobTable();
+    JobState state;
+    std::string result;
+    std::string error;
+    if (!jobs || !jobs->poll(job, state) || state != JobState::SUCCEEDED ||
+        !jobs->getResult(job, result, error)) {
+        g_lastError = "Job is unknown, unfinished or failed";
+        return -1;
+    }
+    return copyToBuffer(result, buffer, bufferSize);
+}
+
+int barcode_job_get_error(BarcodeJobHandle job, char* buffer, int bufferSize) {
+    AsyncJobTable* jobs = findJobTable();
+    std::string result;
+    std::string error;
+    if (!jobs || !jobs->getResult(job, result, error)) {
+        g_lastError = "Job is unknown or unfinished";
+        return -1;
+    }
+    return copyToBuffer(error, buffer, bufferSize);
+}
+
+int barcode_job_release(BarcodeJobHandle job) {
+    AsyncJobTable* jobs = findJobTable();
+    return jobs && jobs->release(job) ? 0 : BARCODE_JOB_INVALID;
+}
+
+int barcode_dispatch_callbacks(void) {
+    AsyncJobTable* jobs = findJobTable();
+    return jobs ? static_cast<int>(jobs->dispatchCompletions()) : 0;
+}
+
+int barcode_render_to_buffer(const char* data,
+                             const BarcodeConfigC* config,
+                             BarcodeImageFormatC format,
+                             BarcodeImageBufferC* image) {
+    if (!data || !config || !image || data[0] == '\0') {
+        g_lastError = "Invalid parameters: null pointer or empty data";
+        return -1;
+    }
+    if (image->data && image->capacity <= 0) {
+        g_lastError = "Invalid parameters: caller buffer without capacity";
+        return -1;
+    }
+    
+    try {
+        BarcodeConfig cppConfig = toCppConfig(config);
+        BarcodeGenerator generator;
+        std::vector<uint8_t> bytes;
+        bool rendered = format == BARCODE_IMAGE_GRAY8
+            ? generator.renderGray(data, cppConfig, bytes)
+            : generator.renderPng(data, cppConfig, bytes);
+        if (!rendered) {
+            g_lastError = errorText(generator.getLastError());
+            return -1;
+        }
+        if (bytes.size() > static_cast<size_t>(INT_MAX)) {
+            g_lastError = "Rendered image too large";
             return -1;
         }
+        
+        image->size = static_cast<int>(bytes.size());
+        image->width = cppConfig.width;
+        image->height = cppConfig.height;
+        
+        if (image->data) {
+            image->libraryOwned = 0;
+            if (image->capacity < image->size) {
+                g_lastError = "Buffer too small: " + std::to_string(image->size) + " bytes required";
+                return 1;
+            }
+        } else {
+            // malloc/free stay on the library's heap; the caller frees via barcode_free_buffer
+            image->data = static_cast<unsigned char*>(std::malloc(bytes.size()));
+            if (!image->data) {
+                g_lastError = "Out of memory";
+                return -1;
+            }
+            image->capacity = image->size;
+            image->libraryOwned = 1;
+        }
+        std::memcpy(image->data, bytes.data(), bytes.size());
+        return 0;
+    } catch (const std::exception& e) {
+        g_lastError = std::string("Exception in barcode_render_to_buffer: ") + e.what();
+        return -1;
+    }
+}
+
+void barcode_free_buffer(BarcodeImageBufferC* image) {
+    if (!image || !image->libraryOwned) {
+        return;
+    }
+    std::free(image->data);
+    image->data = nullptr;
+    image->capacity = 0;
+    image->size = 0;
+    image->libraryOwned = 0;
+}
+
+int barcode_decode_buffer(const unsigned char* pixels,
+                          int width, int height,
+                          int stride, int channels,
+                          char* outputBuffer, int bufferSize,
+                          int* textLength) {
+    if (!pixels || !outputBuffer || bufferSize <= 0) {
+        g_lastError = "Invalid parameters: null pointer or empty output buffer";
+        return -1;
+    }
+    
+    try {
+        BarcodeGenerator generator;
+        auto text = generator.decodePixels(pixels, width, height, stride, channels);
+        return copyDecodedText(text, generator, outputBuffer, bufferSize, textLength);
+    } catch (const std::exception& e) {
+        g_lastError = e.what();
+        return -1;
+    }
+}
+
+int barcode_decode_image_buffer(const unsigned char* bytes, int size,
+                                char* outputBuffer, int bufferSize,
+                                int* textLength) {
+    if (!bytes || size <= 0 || !outputBuffer || bufferSize <= 0) {
+        g_lastError = "Invalid parameters: null pointer or empty buffer";
+        return -1;
+    }
+    
+    try {
+        BarcodeGenerator generator;
+        auto text = generator.decodeImageData(bytes, static_cast<size_t>(size));
+        return copyDecodedText(text, generator, outputBuffer, bufferSize, textLength);
     } catch (const std::exception& e) {
         g_lastError = e.what();
         return -1;
@@ -208,6 +521,11 @@ int sync_check(const char* partName, const char* barcodeData) {
         return -1;
     }
     
+    // Interned strings are equal iff their pointers are
+    if (partName == barcodeData) {
+        return partName[0] != '\0' ? 1 : 0;
+    }
+    
     try {
         if (g_syncChecker->compareData(partName, barcodeData, *g_generator)) {
             return 1;  // In sync
@@ -220,10 +538,59 @@ int sync_check(const char* partName, const char* barcodeData) {
     }
 }
 
+const char* barcode_intern(const char* str) {
+    if (!str) {
+        return nullptr;
+    }
+    
+    try {
+        return StringPool::global().intern(str).c_str();
+    } catch (const std::exception& e) {
+        g_lastError = e.what();
+        return nullptr;
+    }
+}
+
 const char* barcode_get_last_error(void) {
     return g_lastError.c_str();
 }
 
+static_assert(BARCODE_STAGE_COUNT == static_cast<int>(StatsStage::COUNT),
+              "BarcodeStageC must match StatsStage");
+
+int barcode_get_stats(BarcodeStatsC* stats) {
+    if (!stats) {
+        g_lastError = "Invalid parameters: null pointer";
+        return -1;
+    }
+    
+    StatsSnapshot snapshot = PluginStats::global().snapshot();
+    stats->barcodesGenerated = snapshot.barcodesGenerated;
+    stats->cacheHits = snapshot.cacheHits;
+    stats->decodeAttempts = snapshot.decodeAttempts;
+    stats->decodeFailures = snapshot.decodeFailures;
+    stats->bytesWritten = snapshot.bytesWritten;
+    for (int i = 0; i < BARCODE_STAGE_COUNT; ++i) {
+        const StageStats& stage = snapshot.stages[i];
+        stats->stages[i].count = stage.count;
+        stats->stages[i].totalMicros = stage.totalNanos / 1000.0;
+        stats->stages[i].p50Micros = stage.p50Nanos / 1000.0;
+        stats->stages[i].p99Micros = stage.p99Nanos / 1000.0;
+    }
+    return 0;
+}
+
+void barcode_reset_stats(void) {
+    PluginStats::global().reset();
+}
+
+const char* barcode_stage_name(BarcodeStageC stage) {
+    if (stage < 0 || stage >= BARCODE_STAGE_COUNT) {
+        return "unknown";
+    }
+    return statsStageName(static_cast<StatsStage>(stage));
+}
+
 // Global current config
 static BarcodeConfigC g_currentConfig = {
     BARCODE_CODE_128,  // type
@@ -303,7 +670,7 @@ int barcode_generate_for_part(const char* partName,
             outputPath[pathSize - 1] = '\0';
             return 0;
         } else {
-            g_lastError = g_generator->getLastError().message;
+            g_lastError = errorText(g_generator->getLastError());
             return -1;
         }
     } catch (const std::exception& e) {
@@ -337,9 +704,12 @@ int com_bridge_init(void) {
 
 void com_bridge_cleanup(void) {
     try {
-        // Only cleanup if COM bridge was actually used
-        // Check if the singleton was ever accessed
-        // Note: We don't call getInstance() here to avoid creating it just to destroy it
+        // Stop the reconnect worker here, not in the singleton's destructor,
+        // which runs under the loader lock at DLL unload
+        CreoComBridge& bridge = CreoComBridge::getInstance();
+        if (bridge.isInitialized()) {
+            bridge.cleanup();
+        }
     } catch (...) {
         // Ignore exceptions during cleanup
     }
@@ -501,6 +871,14 @@ const char* com_bridge_get_last_error(void) {
     return g_comBridgeLastError.c_str();
 }
 
+void com_bridge_begin_edit(void) {
+    CreoComBridge::getInstance().repaintBatcher().begin();
+}
+
+int com_bridge_end_edit(void) {
+    return CreoComBridge::getInstance().repaintBatcher().end() ? 0 : -1;
+}
+
 int barcode_insert_image_with_fallback(const char* imagePath,
                                        double x, double y,
                                        double width, double height,
@@ -516,8 +894,11 @@ int barcode_insert_image_with_fallback(const char* imagePath,
         return -1;  // FALLBACK_FAILED
     }
     
-    // Try COM bridge first if initialized
-    if (CreoComBridge::getInstance().isInitialized()) {
+    // Try COM bridge first if initialized and the link is not known to be down
+    if (CreoComBridge::getInstance().isInitialized() && CreoComBridge::getInstance().isComCircuitOpen()) {
+        LOG_WARNING("COM link circuit open - using note-based fallback");
+        g_comBridgeLastError = "Creo COM link unavailable (circuit open)";
+    } else if (CreoComBridge::getInstance().isInitialized()) {
         LOG_INFO("Attempting COM image insertion for: " + std::string(imagePath));
         
         if (CreoComBridge::getInstance().insertImage(imagePath, x, y, width, height)) {
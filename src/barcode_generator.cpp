@@ -1,4 +1,10 @@
 #include "barcode_generator.h"
+#include "generated_barcode_filter.h"
+#include "trace.h"
+#include "plugin_stats.h"
+#include "image_validator.h"
+#include "render_cache.h"
+#include "thread_pool.h"
 #include <BarcodeFormat.h>
 #include <MultiFormatWriter.h>
 #include <BitMatrix.h>
@@ -10,8 +16,10 @@
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <climits>
+#include <filesystem>
 
-#define STB_IMAGE_WRITE_IMPLEMENTATION
+// Implementation compiled in zlib_compress.cpp
 #include "stb_image_write.h"
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -48,6 +56,13 @@ std::vector<uint8_t> scaleImage(const std::vector<uint8_t>& src,
     return dst;
 }
 
+// stbi_write_*_to_func sink that appends to a std::vector<uint8_t>
+void appendToVector(void* context, void* data, int size) {
+    auto* out = static_cast<std::vector<uint8_t>*>(context);
+    auto* bytes = static_cast<const uint8_t*>(data);
+    out->insert(out->end(), bytes, bytes + size);
+}
+
 } // anonymous namespace
 
 
@@ -137,24 +152,32 @@ bool BarcodeGenerator::validateData(const std::string& data, BarcodeType type) {
 }
 
 
-bool BarcodeGenerator::generate(const std::string& data,
-                                const BarcodeConfig& config,
-                                const std::string& outputPath) {
+bool BarcodeGenerator::renderPixels(const std::string& data,
+                                    const BarcodeConfig& config,
+                                    std::vector<uint8_t>& pixels) {
     if (data.empty()) {
-        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Empty data");
+        lastError_ = Error(ErrorCode::INVALID_DATA, "Empty data");
         return false;
     }
     
     if (config.width <= 0 || config.height <= 0) {
-        lastError_ = ErrorInfo(ErrorCode::INVALID_SIZE, "Invalid dimensions");
+        lastError_ = Error(ErrorCode::INVALID_SIZE, "Invalid dimensions");
         return false;
     }
     
     if (!validateData(data, config.type)) {
-        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Data not valid for barcode type");
+        lastError_ = Error(ErrorCode::INVALID_DATA, "Data not valid for barcode type");
         return false;
     }
     
+    if (renderCache_) {
+        if (auto cached = renderCache_->find(data, config)) {
+            PluginStats::global().addCacheHits();
+            pixels = cached->pixels;
+            return true;
+        }
+    }
+    
     try {
         auto format = toZXingFormat(config.type);
         auto writer = ZXing::MultiFormatWriter(format);
@@ -162,66 +185,242 @@ bool BarcodeGenerator::generate(const std::string& data,
         int genWidth = config.width;
         int genHeight = config.height;
         
-        auto matrix = writer.encode(data, genWidth, genHeight);
-        int matrixWidth = matrix.width();
-        int matrixHeight = matrix.height();
-        
-        std::vector<uint8_t> pixels(matrixWidth * matrixHeight);
-        for (int y = 0; y < matrixHeight; ++y) {
-            for (int x = 0; x < matrixWidth; ++x) {
-                pixels[y * matrixWidth + x] = matrix.get(x, y) ? 0 : 255;
+        std::vector<uint8_t> matrixPixels;
+        int matrixWidth;
+        int matrixHeight;
+        {
+            TRACE_SCOPE("generator", "encode");
+            STATS_STAGE(StatsStage::ENCODE);
+            auto matrix = writer.encode(data, genWidth, genHeight);
+            matrixWidth = matrix.width();
+            matrixHeight = matrix.height();
+            
+            matrixPixels.resize(matrixWidth * matrixHeight);
+            for (int y = 0; y < matrixHeight; ++y) {
+                for (int x = 0; x < matrixWidth; ++x) {
+                    matrixPixels[y * matrixWidth + x] = matrix.get(x, y) ? 0 : 255;
+                }
             }
         }
         
-        std::vector<uint8_t> finalPixels;
-        int finalWidth = config.width;
-        int finalHeight = config.height;
-        
         if (matrixWidth != config.width || matrixHeight != config.height) {
-            finalPixels = scaleImage(pixels, matrixWidth, matrixHeight, config.width, config.height);
+            TRACE_SCOPE("generator", "scale");
+            pixels = scaleImage(matrixPixels, matrixWidth, matrixHeight, config.width, config.height);
         } else {
-            finalPixels = std::move(pixels);
+            pixels = std::move(matrixPixels);
         }
         
-        if (!stbi_write_png(outputPath.c_str(), finalWidth, finalHeight, 1, 
-                           finalPixels.data(), finalWidth)) {
-            lastError_ = ErrorInfo(ErrorCode::BARCODE_GENERATION_FAILED, "Failed to write image");
-            return false;
+        if (renderCache_) {
+            auto image = std::make_shared<RenderedImage>();
+            image->width = config.width;
+            image->height = config.height;
+            image->pixels = pixels;
+            renderCache_->insert(data, config, std::move(image));
         }
-        
         return true;
     } catch (const std::exception& e) {
-        lastError_ = ErrorInfo(ErrorCode::BARCODE_GENERATION_FAILED, e.what());
+        lastError_ = Error(ErrorCode::BARCODE_GENERATION_FAILED, "Barcode encoding failed", e.what());
         return false;
     }
 }
 
-std::optional<std::string> BarcodeGenerator::decode(const std::string& imagePath) {
-    int width, height, channels;
-    unsigned char* data = stbi_load(imagePath.c_str(), &width, &height, &channels, 1);
+bool BarcodeGenerator::generate(const std::string& data,
+                                const BarcodeConfig& config,
+                                const std::string& outputPath) {
+    TRACE_SCOPE("generator", "generate");
+    STATS_STAGE(StatsStage::GENERATE);
+    std::vector<uint8_t> pixels;
+    if (!renderPixels(data, config, pixels)) {
+        return false;
+    }
     
-    if (!data) {
-        lastError_ = ErrorInfo(ErrorCode::FILE_NOT_FOUND, "Failed to load image");
-        return std::nullopt;
+    {
+        TRACE_SCOPE("generator", "png_write");
+        STATS_STAGE(StatsStage::PNG_WRITE);
+        if (!stbi_write_png(outputPath.c_str(), config.width, config.height, 1, 
+                           pixels.data(), config.width)) {
+            lastError_ = Error(ErrorCode::BARCODE_GENERATION_FAILED, "Failed to write image");
+            ImageValidator::global().forget(outputPath);
+            return false;
+        }
+    }
+    
+    if (generatedFilter_) {
+        generatedFilter_->add(data, config);
+    }
+    
+    PluginStats& stats = PluginStats::global();
+    stats.addBarcodesGenerated();
+    std::error_code sizeError;
+    auto written = std::filesystem::file_size(outputPath, sizeError);
+    if (!sizeError) {
+        stats.addBytesWritten(written);
+        // Inserting this file later needs no revalidation
+        ImageValidator::global().markGenerated(outputPath, ImageFormat::PNG, written);
+    } else {
+        ImageValidator::global().forget(outputPath);
+    }
+    
+    return true;
+}
+
+bool BarcodeGenerator::renderGray(const std::string& data,
+                                  const BarcodeConfig& config,
+                                  std::vector<uint8_t>& pixels) {
+    TRACE_SCOPE("generator", "render_gray");
+    STATS_STAGE(StatsStage::GENERATE);
+    if (!renderPixels(data, config, pixels)) {
+        return false;
+    }
+    PluginStats::global().addBarcodesGenerated();
+    return true;
+}
+
+bool BarcodeGenerator::renderPng(const std::string& data,
+                                 const BarcodeConfig& config,
+                                 std::vector<uint8_t>& png) {
+    TRACE_SCOPE("generator", "render_png");
+    STATS_STAGE(StatsStage::GENERATE);
+    std::vector<uint8_t> pixels;
+    if (!renderPixels(data, config, pixels)) {
+        return false;
+    }
+    
+    png.clear();
+    {
+        TRACE_SCOPE("generator", "png_write");
+        STATS_STAGE(StatsStage::PNG_WRITE);
+        if (!stbi_write_png_to_func(appendToVector, &png, config.width, config.height, 1,
+                                    pixels.data(), config.width)) {
+            lastError_ = Error(ErrorCode::BARCODE_GENERATION_FAILED, "Failed to encode image");
+            return false;
+        }
     }
     
+    PluginStats::global().addBarcodesGenerated();
+    return true;
+}
+
+std::optional<std::string> BarcodeGenerator::readBarcode(const uint8_t* pixels,
+                                                         int width, int height,
+                                                         int rowStride, int channels) {
+    PluginStats& stats = PluginStats::global();
+    stats.addDecodeAttempts();
+    
     try {
-        auto image = ZXing::ImageView(data, width, height, ZXing::ImageFormat::Lum);
+        ZXing::ImageFormat format = ZXing::ImageFormat::Lum;
+        if (channels == 3) {
+            format = ZXing::ImageFormat::RGB;
+        } else if (channels == 4) {
+            format = ZXing::ImageFormat::RGBX;
+        }
+        auto image = ZXing::ImageView(pixels, width, height, format, rowStride);
         auto result = ZXing::ReadBarcode(image);
         
-        stbi_image_free(data);
-        
         if (result.isValid()) {
             return result.text();
         }
         
-        lastError_ = ErrorInfo(ErrorCode::DECODE_FAILED, "No barcode found");
+        stats.addDecodeFailures();
+        lastError_ = Error(ErrorCode::DECODE_FAILED, "No barcode found");
         return std::nullopt;
     } catch (const std::exception& e) {
-        stbi_image_free(data);
-        lastError_ = ErrorInfo(ErrorCode::DECODE_FAILED, e.what());
+        stats.addDecodeFailures();
+        lastError_ = Error(ErrorCode::DECODE_FAILED, "Barcode reader failed", e.what());
+        return std::nullopt;
+    }
+}
+
+std::optional<std::string> BarcodeGenerator::decode(const std::string& imagePath) {
+    TRACE_SCOPE("generator", "decode");
+    STATS_STAGE(StatsStage::DECODE);
+    int width, height, channels;
+    unsigned char* data = stbi_load(imagePath.c_str(), &width, &height, &channels, 1);
+    
+    if (!data) {
+        PluginStats::global().addDecodeAttempts();
+        PluginStats::global().addDecodeFailures();
+        lastError_ = Error(ErrorCode::FILE_NOT_FOUND, "Failed to load image");
+        return std::nullopt;
+    }
+    
+    auto result = readBarcode(data, width, height, width, 1);
+    stbi_image_free(data);
+    return result;
+}
+
+std::optional<std::string> BarcodeGenerator::decodePixels(const uint8_t* pixels,
+                                                          int width, int height,
+                                                          int rowStride, int channels) {
+    TRACE_SCOPE("generator", "decode_pixels");
+    STATS_STAGE(StatsStage::DECODE);
+    if (!pixels || width <= 0 || height <= 0) {
+        lastError_ = Error(ErrorCode::INVALID_SIZE, "Invalid image buffer");
+        return std::nullopt;
+    }
+    if (channels != 1 && channels != 3 && channels != 4) {
+        lastError_ = Error::formatted(ErrorCode::INVALID_DATA, "Unsupported channel count",
+                                      "%d", channels);
+        return std::nullopt;
+    }
+    if (rowStride == 0) {
+        rowStride = width * channels;
+    } else if (rowStride < width * channels) {
+        lastError_ = Error(ErrorCode::INVALID_SIZE, "Row stride smaller than row");
+        return std::nullopt;
+    }
+    return readBarcode(pixels, width, height, rowStride, channels);
+}
+
+std::optional<std::string> BarcodeGenerator::decodeImageData(const uint8_t* bytes, size_t size) {
+    TRACE_SCOPE("generator", "decode_image_data");
+    STATS_STAGE(StatsStage::DECODE);
+    if (!bytes || size == 0 || size > static_cast<size_t>(INT_MAX)) {
+        lastError_ = Error(ErrorCode::INVALID_SIZE, "Invalid image buffer");
+        return std::nullopt;
+    }
+    
+    int width, height, channels;
+    unsigned char* data = stbi_load_from_memory(bytes, static_cast<int>(size),
+                                                &width, &height, &channels, 1);
+    if (!data) {
+        PluginStats::global().addDecodeAttempts();
+        PluginStats::global().addDecodeFailures();
+        lastError_ = Error(ErrorCode::DECODE_FAILED, "Unrecognized image data",
+                           stbi_failure_reason() ? stbi_failure_reason() : "");
         return std::nullopt;
     }
+    
+    auto result = readBarcode(data, width, height, width, 1);
+    stbi_image_free(data);
+    return result;
+}
+
+std::future<Result<void>> BarcodeGenerator::generateAsync(const std::string& data,
+                                                          const BarcodeConfig& config,
+                                                          const std::string& outputPath) const {
+    GeneratedBarcodeFilter* filter = generatedFilter_;
+    RenderCache* cache = renderCache_;
+    return ThreadPool::shared().async([data, config, outputPath, filter, cache]() -> Result<void> {
+        BarcodeGenerator generator;
+        generator.setGeneratedFilter(filter);
+        generator.setRenderCache(cache);
+        if (!generator.generate(data, config, outputPath)) {
+            return generator.lastError();
+        }
+        return Result<void>();
+    });
+}
+
+std::future<Result<std::string>> BarcodeGenerator::decodeAsync(const std::string& imagePath) const {
+    return ThreadPool::shared().async([imagePath]() -> Result<std::string> {
+        BarcodeGenerator generator;
+        auto decoded = generator.decode(imagePath);
+        if (!decoded) {
+            return generator.lastError();
+        }
+        return std::move(*decoded);
+    });
 }
 
 
@@ -0,0 +1,491 @@
+/**
+ * @file barcode_inventory.cpp
+ * @brief Implementation of the columnar barcode inventory
+ *
+ * On-disk layout (little-endian):
+ *   char magic[4] = "CBIV", uint32 version, uint32 rowCount, uint32 stringCount,
+ *   uint64 stringBytes, uint64 reserved,
+ *   uint32 stringOffsets[stringCount + 1], char strings[stringBytes],
+ *   uint32 drawingPath/imagePath/encodedData/decodedData/partName/timestamp[rowCount],
+ *   int32 sheet[rowCount], float posX[rowCount], float posY[rowCount],
+ *   uint8 type[rowCount], uint8 status[rowCount]
+ */
+
+#include "barcode_inventory.h"
+#include "content_hash.h"
+#include "mapped_file.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define INVENTORY_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace creo_barcode {
+
+namespace {
+
+constexpr char INVENTORY_MAGIC[4] = {'C', 'B', 'I', 'V'};
+constexpr uint32_t INVENTORY_VERSION = 1;
+constexpr size_t INITIAL_SLOTS = 64;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t rowCount;
+    uint32_t stringCount;
+    uint64_t stringBytes;
+    uint64_t reserved;
+};
+static_assert(sizeof(FileHeader) == 32, "FileHeader layout must be stable");
+
+#ifdef INVENTORY_SSE2
+inline unsigned countTrailingZeros(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// Append the positions of set bits in mask, offset by base
+inline void emitMask(uint32_t mask, uint32_t base, InventorySelection& out) {
+    while (mask) {
+        out.push_back(base + countTrailingZeros(mask));
+        mask &= mask - 1;
+    }
+}
+#endif
+
+void selectEqual(const uint8_t* column, size_t count, uint8_t value, InventorySelection& out) {
+    size_t i = 0;
+#ifdef INVENTORY_SSE2
+    const __m128i needle = _mm_set1_epi8(static_cast<char>(value));
+    for (; i + 16 <= count; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + i));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+        emitMask(mask, static_cast<uint32_t>(i), out);
+    }
+#endif
+    for (; i < count; ++i) {
+        if (column[i] == value) {
+            out.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+template <typename T>
+void selectEqual(const T* column, size_t count, T value, InventorySelection& out) {
+    size_t i = 0;
+#ifdef INVENTORY_SSE2
+    if (sizeof(T) == 4) {
+        int32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const __m128i needle = _mm_set1_epi32(bits);
+        for (; i + 4 <= count; i += 4) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + i));
+            __m128i equal = _mm_cmpeq_epi32(block, needle);
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(equal)));
+            emitMask(mask, static_cast<uint32_t>(i), out);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        if (column[i] == value) {
+            out.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+template <typename T>
+InventorySelection select(const std::vector<T>& column, T value, const InventorySelection* within) {
+    InventorySelection out;
+    if (within) {
+        out.reserve(within->size());
+        for (uint32_t row : *within) {
+            if (column[row] == value) {
+                out.push_back(row);
+            }
+        }
+    } else {
+        selectEqual(column.data(), column.size(), value, out);
+    }
+    return out;
+}
+
+template <typename T>
+size_t vectorBytes(const std::vector<T>& v) {
+    return v.capacity() * sizeof(T);
+}
+
+template <typename T>
+void writeColumn(std::ofstream& out, const std::vector<T>& column) {
+    out.write(reinterpret_cast<const char*>(column.data()),
+              static_cast<std::streamsize>(column.size() * sizeof(T)));
+}
+
+// Copy a column out of a mapped file, advancing the cursor
+template <typename T>
+bool readColumn(const char*& cursor, const char* end, size_t count, std::vector<T>& column) {
+    size_t bytes = count * sizeof(T);
+    if (static_cast<size_t>(end - cursor) < bytes) {
+        return false;
+    }
+    column.resize(count);
+    if (bytes > 0) {
+        std::memcpy(column.data(), cursor, bytes);
+    }
+    cursor += bytes;
+    return true;
+}
+
+} // anonymous namespace
+
+BarcodeInventory::BarcodeInventory() {
+    clear();
+}
+
+void BarcodeInventory::clear() {
+    stringBlob_.clear();
+    stringOffsets_.assign(1, 0);
+    stringSlots_.assign(INITIAL_SLOTS, 0);
+    for (auto* column : {&drawingPath_, &imagePath_, &encodedData_, &decodedData_, &partName_, &timestamp_}) {
+        column->clear();
+    }
+    sheet_.clear();
+    posX_.clear();
+    posY_.clear();
+    type_.clear();
+    status_.clear();
+    rows_.clear();
+}
+
+void BarcodeInventory::reserve(size_t rows) {
+    for (auto* column : {&drawingPath_, &imagePath_, &encodedData_, &decodedData_, &partName_, &timestamp_}) {
+        column->reserve(rows);
+    }
+    sheet_.reserve(rows);
+    posX_.reserve(rows);
+    posY_.reserve(rows);
+    type_.reserve(rows);
+    status_.reserve(rows);
+}
+
+std::string_view BarcodeInventory::str(uint32_t id) const {
+    return std::string_view(stringBlob_.data() + stringOffsets_[id],
+                            stringOffsets_[id + 1] - stringOffsets_[id]);
+}
+
+bool BarcodeInventory::findString(std::string_view value, uint32_t& id) const {
+    size_t mask = stringSlots_.size() - 1;
+    for (size_t slot = hash64(value) & mask;; slot = (slot + 1) & mask) {
+        uint32_t entry = stringSlots_[slot];
+        if (entry == 0) {
+            return false;
+        }
+        if (str(entry - 1) == value) {
+            id = entry - 1;
+            return true;
+        }
+    }
+}
+
+size_t BarcodeInventory::RowKeyHash::operator()(const RowKey& key) const {
+    uint64_t ids = (static_cast<uint64_t>(key.drawingPath) << 32) | key.imagePath;
+    return static_cast<size_t>(ids * 0x9E3779B97F4A7C15ULL) ^ static_cast<uint32_t>(key.sheet);
+}
+
+void BarcodeInventory::rebuildRows() {
+    rows_.clear();
+    rows_.reserve(size());
+    for (uint32_t row = 0; row < size(); ++row) {
+        rows_[RowKey{drawingPath_[row], imagePath_[row], sheet_[row]}] = row;
+    }
+}
+
+void BarcodeInventory::rebuildSlots(size_t slotCount) {
+    stringSlots_.assign(slotCount, 0);
+    size_t mask = slotCount - 1;
+    for (uint32_t id = 0; id < stringCount(); ++id) {
+        size_t slot = hash64(str(id)) & mask;
+        while (stringSlots_[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        stringSlots_[slot] = id + 1;
+    }
+}
+
+uint32_t BarcodeInventory::intern(std::string_view value) {
+    uint32_t id;
+    if (findString(value, id)) {
+        return id;
+    }
+
+    id = static_cast<uint32_t>(stringCount());
+    stringBlob_.append(value.data(), value.size());
+    stringOffsets_.push_back(static_cast<uint32_t>(stringBlob_.size()));
+
+    // Keep the table at most half full
+    if ((stringCount() * 2) > stringSlots_.size()) {
+        rebuildSlots(stringSlots_.size() * 2);
+    } else {
+        size_t mask = stringSlots_.size() - 1;
+        size_t slot = hash64(value) & mask;
+        while (stringSlots_[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        stringSlots_[slot] = id + 1;
+    }
+    return id;
+}
+
+size_t BarcodeInventory::add(const BarcodeInstance& instance, SyncStatus status,
+                             std::string_view currentPartName) {
+    drawingPath_.push_back(intern(instance.drawingPath));
+    imagePath_.push_back(intern(instance.imagePath));
+    encodedData_.push_back(intern(instance.encodedData));
+    decodedData_.push_back(intern(instance.decodedData));
+    partName_.push_back(intern(currentPartName));
+    timestamp_.push_back(intern(instance.timestamp));
+    sheet_.push_back(instance.sheet);
+    posX_.push_back(static_cast<float>(instance.posX));
+    posY_.push_back(static_cast<float>(instance.posY));
+    type_.push_back(static_cast<uint8_t>(instance.type));
+    status_.push_back(static_cast<uint8_t>(status));
+    uint32_t row = static_cast<uint32_t>(size() - 1);
+    rows_[RowKey{drawingPath_[row], imagePath_[row], sheet_[row]}] = row;
+    return row;
+}
+
+size_t BarcodeInventory::add(const BarcodeInstance& instance, const SyncCheckResult& result) {
+    return add(instance, result.status, result.currentPartName);
+}
+
+size_t BarcodeInventory::upsert(const BarcodeInstance& instance, const SyncCheckResult& result) {
+    uint32_t drawingId;
+    uint32_t imageId;
+    auto it = rows_.end();
+    if (findString(instance.drawingPath, drawingId) && findString(instance.imagePath, imageId)) {
+        it = rows_.find(RowKey{drawingId, imageId, instance.sheet});
+    }
+    if (it == rows_.end()) {
+        return add(instance, result);
+    }
+
+    uint32_t row = it->second;
+    encodedData_[row] = intern(instance.encodedData);
+    decodedData_[row] = intern(instance.decodedData);
+    partName_[row] = intern(result.currentPartName);
+    timestamp_[row] = intern(instance.timestamp);
+    posX_[row] = static_cast<float>(instance.posX);
+    posY_[row] = static_cast<float>(instance.posY);
+    type_[row] = static_cast<uint8_t>(instance.type);
+    status_[row] = static_cast<uint8_t>(result.status);
+    return row;
+}
+
+BarcodeInstance BarcodeInventory::instanceAt(size_t row) const {
+    BarcodeInstance instance;
+    instance.imagePath = std::string(imagePathAt(row));
+    instance.encodedData = std::string(encodedDataAt(row));
+    instance.decodedData = std::string(decodedDataAt(row));
+    instance.type = typeAt(row);
+    instance.posX = posX_[row];
+    instance.posY = posY_[row];
+    instance.timestamp = std::string(timestampAt(row));
+    instance.drawingPath = std::string(drawingPathAt(row));
+    instance.sheet = sheet_[row];
+    return instance;
+}
+
+InventorySelection BarcodeInventory::filterByStatus(SyncStatus status, const InventorySelection* within) const {
+    return select(status_, static_cast<uint8_t>(status), within);
+}
+
+InventorySelection BarcodeInventory::filterByType(BarcodeType type, const InventorySelection* within) const {
+    return select(type_, static_cast<uint8_t>(type), within);
+}
+
+InventorySelection BarcodeInventory::filterBySheet(int sheet, const InventorySelection* within) const {
+    return select(sheet_, static_cast<int32_t>(sheet), within);
+}
+
+InventorySelection BarcodeInventory::filterByDrawing(std::string_view drawingPath,
+                                                     const InventorySelection* within) const {
+    // Strings are interned, so this is an id comparison on one column
+    uint32_t id;
+    if (!findString(drawingPath, id)) {
+        return {};
+    }
+    return select(drawingPath_, id, within);
+}
+
+std::array<size_t, BarcodeInventory::STATUS_COUNT> BarcodeInventory::countByStatus() const {
+    std::array<size_t, STATUS_COUNT> counts{};
+    for (uint8_t status : status_) {
+        if (status < STATUS_COUNT) {
+            ++counts[status];
+        }
+    }
+    return counts;
+}
+
+size_t BarcodeInventory::memoryBytes() const {
+    return stringBlob_.capacity() + vectorBytes(stringOffsets_) + vectorBytes(stringSlots_) +
+           vectorBytes(drawingPath_) + vectorBytes(imagePath_) + vectorBytes(encodedData_) +
+           vectorBytes(decodedData_) + vectorBytes(partName_) + vectorBytes(timestamp_) +
+           vectorBytes(sheet_) + vectorBytes(posX_) + vectorBytes(posY_) +
+           vectorBytes(type_) + vectorBytes(status_);
+}
+
+std::string BarcodeInventory::getSummary() const {
+    std::ostringstream summary;
+    summary << "Barcode Inventory Summary\n";
+    summary << "=========================\n";
+    summary << "Total barcodes: " << size() << "\n";
+
+    auto statusCounts = countByStatus();
+    for (size_t s = 0; s < STATUS_COUNT; ++s) {
+        if (statusCounts[s] > 0) {
+            summary << syncStatusToString(static_cast<SyncStatus>(s)) << ": " << statusCounts[s] << "\n";
+        }
+    }
+
+    std::array<size_t, 256> typeCounts{};
+    for (uint8_t type : type_) {
+        ++typeCounts[type];
+    }
+    for (size_t t = 0; t < typeCounts.size(); ++t) {
+        if (typeCounts[t] > 0) {
+            summary << barcodeTypeToString(static_cast<BarcodeType>(t)) << ": " << typeCounts[t] << "\n";
+        }
+    }
+    return summary.str();
+}
+
+bool BarcodeInventory::save(const std::string& path) const {
+    FileHeader header{};
+    std::memcpy(header.magic, INVENTORY_MAGIC, sizeof(INVENTORY_MAGIC));
+    header.version = INVENTORY_VERSION;
+    header.rowCount = static_cast<uint32_t>(size());
+    header.stringCount = static_cast<uint32_t>(stringCount());
+    header.stringBytes = stringBlob_.size();
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            lastError_ = ErrorInfo(ErrorCode::CONFIG_SAVE_FAILED, "Cannot write barcode inventory", tempPath);
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeColumn(out, stringOffsets_);
+        out.write(stringBlob_.data(), static_cast<std::streamsize>(stringBlob_.size()));
+        for (const auto* column : {&drawingPath_, &imagePath_, &encodedData_, &decodedData_, &partName_, &timestamp_}) {
+            writeColumn(out, *column);
+        }
+        writeColumn(out, sheet_);
+        writeColumn(out, posX_);
+        writeColumn(out, posY_);
+        writeColumn(out, type_);
+        writeColumn(out, status_);
+        if (!out.good()) {
+            lastError_ = ErrorInfo(ErrorCode::CONFIG_SAVE_FAILED, "Failed writing barcode inventory", tempPath);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        lastError_ = ErrorInfo(ErrorCode::CONFIG_SAVE_FAILED, "Cannot replace barcode inventory", ec.message());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool BarcodeInventory::load(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path)) {
+        lastError_ = ErrorInfo(ErrorCode::FILE_NOT_FOUND, "Cannot open barcode inventory", path);
+        return false;
+    }
+
+    FileHeader header{};
+    if (file.size() < sizeof(header)) {
+        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Not a barcode inventory file", path);
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, INVENTORY_MAGIC, sizeof(INVENTORY_MAGIC)) != 0 ||
+        header.version != INVENTORY_VERSION) {
+        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Not a barcode inventory file", path);
+        return false;
+    }
+
+    BarcodeInventory loaded;
+    const char* cursor = reinterpret_cast<const char*>(file.data()) + sizeof(header);
+    const char* end = reinterpret_cast<const char*>(file.data()) + file.size();
+    const size_t rows = header.rowCount;
+
+    bool ok = readColumn(cursor, end, static_cast<size_t>(header.stringCount) + 1, loaded.stringOffsets_) &&
+              static_cast<uint64_t>(end - cursor) >= header.stringBytes;
+    if (ok) {
+        loaded.stringBlob_.assign(cursor, static_cast<size_t>(header.stringBytes));
+        cursor += header.stringBytes;
+        for (auto* column : {&loaded.drawingPath_, &loaded.imagePath_, &loaded.encodedData_,
+                             &loaded.decodedData_, &loaded.partName_, &loaded.timestamp_}) {
+            ok = ok && readColumn(cursor, end, rows, *column);
+        }
+        ok = ok && readColumn(cursor, end, rows, loaded.sheet_) &&
+             readColumn(cursor, end, rows, loaded.posX_) &&
+             readColumn(cursor, end, rows, loaded.posY_) &&
+             readColumn(cursor, end, rows, loaded.type_) &&
+             readColumn(cursor, end, rows, loaded.status_);
+    }
+    if (!ok) {
+        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Barcode inventory is truncated", path);
+        return false;
+    }
+
+    // Validate string references before trusting them
+    const auto& offsets = loaded.stringOffsets_;
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        if (offsets[i] > offsets[i + 1] || offsets[i + 1] > header.stringBytes) {
+            ok = false;
+            break;
+        }
+    }
+    for (const auto* column : {&loaded.drawingPath_, &loaded.imagePath_, &loaded.encodedData_,
+                               &loaded.decodedData_, &loaded.partName_, &loaded.timestamp_}) {
+        for (uint32_t id : *column) {
+            ok = ok && id < header.stringCount;
+        }
+    }
+    if (!ok || offsets.front() != 0) {
+        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Barcode inventory is corrupt", path);
+        return false;
+    }
+
+    size_t slots = INITIAL_SLOTS;
+    while (slots < loaded.stringCount() * 2) {
+        slots *= 2;
+    }
+    loaded.rebuildSlots(slots);
+    loaded.rebuildRows();
+
+    *this = std::move(loaded);
+    return true;
+}
+
+} // namespace creo_barcode
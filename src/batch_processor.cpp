@@ -1,59 +1,415 @@
 #include "batch_processor.h"
+#include "trace.h"
 #include <sstream>
+#include <iomanip>
 #include <fstream>
+#include <thread>
+#include <deque>
+#include <algorithm>
+#include <functional>
 
 namespace creo_barcode {
 
+namespace {
+
+size_t defaultMaxRenderWorkers() {
+    unsigned int cores = std::thread::hardware_concurrency();
+    return cores > 0 ? cores : 4;
+}
+
+bool probeDrawing(const std::string& filePath, std::string& error) {
+    TRACE_SCOPE("batch", "file_probe");
+    if (!std::ifstream(filePath.c_str()).good()) {
+        error = "File not found";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Render and write workers for one process() run
+ *
+ * Files are pushed by a feeder thread; each stage takes them from its ready
+ * list while it is under its tuner's limit. Workers are started lazily, up
+ * to the limit, so a three-file batch does not start sixteen threads. All
+ * state is guarded by mutex_.
+ */
+class StagePipeline {
+public:
+    StagePipeline(const BatchProcessor::StageFunction& render, const BatchProcessor::StageFunction& write,
+                  ConcurrencyTuner& renderTuner, ConcurrencyTuner& writeTuner)
+        : render_(render, &renderTuner, "render")
+        , write_(write, &writeTuner, "write")
+        , entry_(render ? &render_ : &write_) {}
+
+    ~StagePipeline() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        changed_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void push(size_t index, const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (paths_.size() <= index) {
+            paths_.resize(index + 1);
+            results_.resize(index + 1);
+        }
+        paths_[index] = path;
+        ++pushed_;
+        entry_->ready.push_back(index);
+        spawnLocked(*entry_);
+        changed_.notify_all();
+    }
+
+    void finishInput() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        inputDone_ = true;
+        changed_.notify_all();
+    }
+
+    // Blocks until more files finished than seen; false once all are done
+    bool waitCompletions(size_t seen, size_t& completed) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [&]() { return completed_ > seen || (inputDone_ && completed_ == pushed_); });
+        completed = completed_;
+        return completed_ > seen;
+    }
+
+    size_t peak(bool renderStage) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return renderStage ? render_.peak : write_.peak;
+    }
+
+    std::vector<BatchResult> takeResults() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::move(results_);
+    }
+
+private:
+    struct Stage {
+        Stage(const BatchProcessor::StageFunction& stageFunction, ConcurrencyTuner* stageTuner, const char* stageName)
+            : function(stageFunction), tuner(stageTuner), name(stageName) {}
+
+        const BatchProcessor::StageFunction& function;
+        ConcurrencyTuner* tuner;
+        const char* name;
+        std::deque<size_t> ready;
+        size_t active = 0;
+        size_t workers = 0;
+        size_t idle = 0;
+        size_t peak = 0;
+    };
+
+    void spawnLocked(Stage& stage) {
+        while (stage.workers < stage.tuner->limit() && stage.ready.size() > stage.idle) {
+            ++stage.workers;
+            ++stage.idle;
+            threads_.emplace_back(&StagePipeline::worker, this, std::ref(stage));
+        }
+    }
+
+    void worker(Stage& stage) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            changed_.wait(lock, [&]() {
+                return stopping_ || (!stage.ready.empty() && stage.active < stage.tuner->limit());
+            });
+            if (stopping_) {
+                break;
+            }
+            size_t index = stage.ready.front();
+            stage.ready.pop_front();
+            std::string path = paths_[index];
+            --stage.idle;
+            ++stage.active;
+            stage.peak = std::max(stage.peak, stage.active);
+            lock.unlock();
+
+            std::string error;
+            bool ok = false;
+            auto runStage = [&]() {
+                TRACE_SCOPE_DETAIL("batch", stage.name, path);
+                try {
+                    ok = stage.function(path, error);
+                } catch (const std::exception& e) {
+                    ok = false;
+                    error = e.what();
+                }
+            };
+            auto started = std::chrono::steady_clock::now();
+            if (&stage == entry_) {
+                // One "file" span per drawing, from the stage files enter at
+                TRACE_SCOPE_DETAIL("batch", "file", path);
+                runStage();
+            } else {
+                runStage();
+            }
+            auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - started);
+
+            lock.lock();
+            stage.tuner->record(latency);
+            --stage.active;
+            ++stage.idle;
+            if (ok && &stage == &render_) {
+                write_.ready.push_back(index);
+                spawnLocked(write_);
+            } else {
+                results_[index] = BatchResult(path, ok, ok ? "" : error);
+                ++completed_;
+            }
+            // The limit may have grown with this item
+            spawnLocked(stage);
+            changed_.notify_all();
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+    Stage render_;
+    Stage write_;
+    Stage* entry_;                  // First stage a file goes through
+    std::vector<std::string> paths_;
+    std::vector<BatchResult> results_;
+    std::vector<std::thread> threads_;
+    size_t pushed_ = 0;
+    size_t completed_ = 0;
+    bool inputDone_ = false;
+    bool stopping_ = false;
+};
+
+/**
+ * Joins a helper thread on every way out of a scope
+ *
+ * On the normal path the owner joins first and the guard does nothing. If
+ * the scope is left by an exception, stop() runs so the thread can finish
+ * (its queue closed, its scan cancelled) before the join; destroying a
+ * joinable std::thread would call std::terminate.
+ */
+class JoinGuard {
+public:
+    JoinGuard(std::thread& thread, std::function<void()> stop)
+        : thread_(thread), stop_(std::move(stop)) {}
+
+    ~JoinGuard() {
+        if (thread_.joinable()) {
+            stop_();
+            thread_.join();
+        }
+    }
+
+    JoinGuard(const JoinGuard&) = delete;
+    JoinGuard& operator=(const JoinGuard&) = delete;
+
+private:
+    std::thread& thread_;
+    std::function<void()> stop_;
+};
+
+StageTuning stageTuning(const ConcurrencyTuner& tuner, size_t initial, bool fromHistory, size_t peak) {
+    StageTuning tuning;
+    tuning.initial = initial;
+    tuning.settled = tuner.limit();
+    tuning.peak = peak;
+    tuning.fromHistory = fromHistory;
+    tuning.meanLatencyUs = tuner.meanLatencyUs();
+    tuning.throughput = tuner.throughput();
+    return tuning;
+}
+
+StageTiming stageTiming(const ConcurrencyTuner& tuner) {
+    StageTiming timing;
+    if (tuner.items() > 0) {
+        timing.concurrency = tuner.limit();
+        timing.meanLatencyUs = tuner.meanLatencyUs();
+        timing.throughput = tuner.throughput();
+    }
+    return timing;
+}
+
+void appendStage(std::ostringstream& summary, const char* name, const StageTuning& stage) {
+    summary << "  " << name << ": " << stage.settled << " workers (started at " << stage.initial
+            << (stage.fromHistory ? " from history" : "") << ", peak " << stage.peak << " busy)";
+    summary << std::fixed << std::setprecision(1) << ", " << stage.meanLatencyUs / 1000.0 << " ms/file";
+    if (stage.throughput > 0.0) {
+        summary << ", " << stage.throughput << " files/s";
+    }
+    summary << "\n";
+}
+
+} // anonymous namespace
+
 void BatchProcessor::addFile(const std::string& filePath) {
+    std::lock_guard<std::mutex> lock(queueMutex_);
     fileQueue_.push_back(filePath);
+    queueChanged_.notify_all();
 }
 
 void BatchProcessor::addFiles(const std::vector<std::string>& filePaths) {
+    std::lock_guard<std::mutex> lock(queueMutex_);
     fileQueue_.insert(fileQueue_.end(), filePaths.begin(), filePaths.end());
+    queueChanged_.notify_all();
 }
 
 void BatchProcessor::clear() {
+    std::lock_guard<std::mutex> lock(queueMutex_);
     fileQueue_.clear();
 }
 
+size_t BatchProcessor::getQueueSize() const {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    return fileQueue_.size();
+}
+
+void BatchProcessor::openQueue() {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    queueOpen_ = true;
+}
+
+void BatchProcessor::closeQueue() {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    queueOpen_ = false;
+    queueChanged_.notify_all();
+}
+
+bool BatchProcessor::isQueueOpen() const {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    return queueOpen_;
+}
+
+void BatchProcessor::setConcurrencyLimits(size_t maxRenderWorkers, size_t maxWriteWorkers) {
+    maxRenderWorkers_ = maxRenderWorkers;
+    maxWriteWorkers_ = maxWriteWorkers;
+}
+
 std::vector<BatchResult> BatchProcessor::process(const BarcodeConfig& config,
                                                   ProgressCallback progressCallback) {
-    std::vector<BatchResult> results;
-    results.reserve(fileQueue_.size());
-    
-    int total = static_cast<int>(fileQueue_.size());
-    int current = 0;
+    TRACE_SCOPE("batch", "process");
     
-    BarcodeGenerator generator;
+    size_t maxRender = maxRenderWorkers_ > 0 ? maxRenderWorkers_ : defaultMaxRenderWorkers();
+    size_t maxWrite = maxWriteWorkers_ > 0 ? maxWriteWorkers_ : DEFAULT_MAX_WRITE_WORKERS;
+    // Rendering is CPU-bound: start at one worker per core. Writing starts
+    // low, since a slow share gets slower with every extra writer.
+    ConcurrencyTuner renderTuner(maxRender, 1, maxRender);
+    ConcurrencyTuner writeTuner(std::min(DEFAULT_INITIAL_WRITE_WORKERS, maxWrite), 1, maxWrite);
+    BatchTuning tuning;
+    tuning.render.initial = renderTuner.limit();
+    tuning.write.initial = writeTuner.limit();
     
-    for (const auto& filePath : fileQueue_) {
-        ++current;
-        
-        if (progressCallback) {
-            progressCallback(current, total);
-        }
+    StageFunction writeStage = writeStage_;
+    if (!writeStage) {
+        writeStage = probeDrawing;
+    }
+    std::vector<BatchResult> results;
+    {
+        StagePipeline pipeline(renderStage_, writeStage, renderTuner, writeTuner);
         
-        // For now, simulate processing - actual implementation would:
-        // 1. Open the Creo drawing file
-        // 2. Extract part name
-        // 3. Generate barcode
-        // 4. Insert into drawing
+        bool abandoned = false;     // Guarded by queueMutex_
+        std::thread feeder([&]() {
+            for (size_t index = 0;; ++index) {
+                std::string filePath;
+                {
+                    // An open queue may still grow; wait for the next file or the close
+                    std::unique_lock<std::mutex> lock(queueMutex_);
+                    queueChanged_.wait(lock, [&]() {
+                        return abandoned || index < fileQueue_.size() || !queueOpen_;
+                    });
+                    if (abandoned || index >= fileQueue_.size()) {
+                        break;
+                    }
+                    filePath = fileQueue_[index];
+                }
+                if (index == 0) {
+                    // Workers start with the first push, so the tuners are still ours
+                    tuning.environment = TimingHistory::environmentKey(filePath);
+                    EnvironmentTiming history;
+                    if (timingHistory_ && timingHistory_->find(tuning.environment, history)) {
+                        if (history.render.concurrency > 0) {
+                            renderTuner.reset(history.render.concurrency, history.render.meanLatencyUs);
+                            tuning.render.initial = renderTuner.limit();
+                            tuning.render.fromHistory = true;
+                        }
+                        if (history.write.concurrency > 0) {
+                            writeTuner.reset(history.write.concurrency, history.write.meanLatencyUs);
+                            tuning.write.initial = writeTuner.limit();
+                            tuning.write.fromHistory = true;
+                        }
+                    }
+                }
+                pipeline.push(index, filePath);
+            }
+            pipeline.finishInput();
+        });
+        JoinGuard feederGuard(feeder, [&]() {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            abandoned = true;
+            queueChanged_.notify_all();
+        });
         
-        // Check if file exists (basic validation)
-        std::ifstream file(filePath);
-        if (!file.good()) {
-            results.emplace_back(filePath, false, "File not found");
-            continue;
+        size_t completed = 0;
+        size_t reported = 0;
+        while (pipeline.waitCompletions(reported, completed)) {
+            for (; reported < completed; ++reported) {
+                if (progressCallback) {
+                    progressCallback(static_cast<int>(reported + 1), static_cast<int>(getQueueSize()));
+                }
+            }
         }
+        feeder.join();
         
-        // Placeholder: In real implementation, this would process the drawing
-        results.emplace_back(filePath, true, "");
+        size_t renderPeak = pipeline.peak(true);
+        size_t writePeak = pipeline.peak(false);
+        tuning.render = stageTuning(renderTuner, tuning.render.initial, tuning.render.fromHistory, renderPeak);
+        tuning.write = stageTuning(writeTuner, tuning.write.initial, tuning.write.fromHistory, writePeak);
+        results = pipeline.takeResults();
+    }
+    
+    if (timingHistory_ && !results.empty()) {
+        EnvironmentTiming run;
+        run.render = stageTiming(renderTuner);
+        run.write = stageTiming(writeTuner);
+        timingHistory_->record(tuning.environment, run);
     }
+    lastTuning_ = tuning;
+    return results;
+}
+
+std::vector<BatchResult> BatchProcessor::processDirectories(const std::vector<std::string>& roots,
+                                                            const ScanOptions& scanOptions,
+                                                            const BarcodeConfig& config,
+                                                            ProgressCallback progressCallback,
+                                                            ScanStats* scanStats) {
+    TRACE_SCOPE("batch", "process_directories");
+    DirectoryScanner scanner(scanOptions);
+    
+    // Discovery runs beside processing: each listed directory's drawings are
+    // queued at once, and process() drains the queue until the scan closes it
+    openQueue();
+    std::thread discovery([&]() {
+        scanner.scan(roots, [this](std::vector<std::string>&& paths) { addFiles(paths); });
+        closeQueue();
+    });
+    JoinGuard discoveryGuard(discovery, [&]() {
+        scanner.cancel();
+        closeQueue();
+    });
+    
+    std::vector<BatchResult> results = process(config, progressCallback);
+    discovery.join();
     
+    if (scanStats) {
+        *scanStats = scanner.stats();
+    }
     return results;
 }
 
-std::string BatchProcessor::getSummary(const std::vector<BatchResult>& results) {
+std::string BatchProcessor::getSummary(const std::vector<BatchResult>& results,
+                                       const BatchTuning* tuning) {
     int successCount = 0;
     int failureCount = 0;
     std::vector<std::string> failures;
@@ -74,6 +430,14 @@ std::string BatchProcessor::getSummary(const std::vector<BatchResult>& results)
     summary << "Successful: " << successCount << "\n";
     summary << "Failed: " << failureCount << "\n";
     
+    if (tuning && !tuning->environment.empty()) {
+        summary << "\nConcurrency (" << tuning->environment << "):\n";
+        if (tuning->render.peak > 0) {
+            appendStage(summary, "Render", tuning->render);
+        }
+        appendStage(summary, "Write", tuning->write);
+    }
+    
     if (!failures.empty()) {
         summary << "\nFailure details:\n";
         for (const auto& failure : failures) {
@@ -0,0 +1,247 @@
+/**
+ * @file batch_tuning.cpp
+ * @brief Implementation of AIMD stage tuning and the timing history
+ */
+
+#include "batch_tuning.h"
+#include "directory_scanner.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <fstream>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace creo_barcode {
+
+using json = nlohmann::json;
+
+namespace {
+
+// Weight of the newest run when smoothing history figures
+constexpr double HISTORY_WEIGHT = 0.3;
+
+// Baseline latency creeps up by this factor per window, so a batch that
+// moves on to larger drawings is not mistaken for a saturated stage forever
+constexpr double BASELINE_DRIFT = 1.02;
+
+constexpr size_t MIN_WINDOW = 4;
+
+std::string hostName() {
+#ifdef _WIN32
+    char name[MAX_COMPUTERNAME_LENGTH + 1];
+    DWORD size = sizeof(name);
+    if (GetComputerNameA(name, &size)) {
+        return std::string(name, size);
+    }
+#else
+    char name[256];
+    if (gethostname(name, sizeof(name)) == 0) {
+        name[sizeof(name) - 1] = '\0';
+        return name;
+    }
+#endif
+    return "localhost";
+}
+
+json stageToJson(const StageTiming& stage) {
+    json j;
+    j["concurrency"] = stage.concurrency;
+    j["meanLatencyUs"] = stage.meanLatencyUs;
+    j["throughput"] = stage.throughput;
+    j["runs"] = stage.runs;
+    return j;
+}
+
+StageTiming stageFromJson(const json& j) {
+    StageTiming stage;
+    stage.concurrency = j.value("concurrency", size_t(0));
+    stage.meanLatencyUs = j.value("meanLatencyUs", 0.0);
+    stage.throughput = j.value("throughput", 0.0);
+    stage.runs = j.value("runs", uint32_t(0));
+    return stage;
+}
+
+void mergeStage(StageTiming& history, const StageTiming& run) {
+    if (run.concurrency == 0) {
+        return;
+    }
+    if (history.runs == 0) {
+        history = run;
+        history.runs = 1;
+        return;
+    }
+    history.concurrency = run.concurrency;
+    history.meanLatencyUs += HISTORY_WEIGHT * (run.meanLatencyUs - history.meanLatencyUs);
+    history.throughput += HISTORY_WEIGHT * (run.throughput - history.throughput);
+    ++history.runs;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// ConcurrencyTuner
+// ============================================================================
+
+ConcurrencyTuner::ConcurrencyTuner(size_t initial, size_t minLimit, size_t maxLimit)
+    : minLimit_(std::max<size_t>(minLimit, 1))
+    , maxLimit_(std::max(maxLimit, std::max<size_t>(minLimit, 1))) {
+    reset(initial);
+}
+
+void ConcurrencyTuner::reset(size_t initial, double baselineLatencyUs) {
+    limit_ = std::clamp(initial, minLimit_, maxLimit_);
+    baselineLatencyUs_ = baselineLatencyUs;
+    lastThroughput_ = 0.0;
+    lastLimit_ = 0;
+    windowItems_ = 0;
+    windowLatencyUs_ = 0.0;
+}
+
+void ConcurrencyTuner::record(std::chrono::microseconds latency) {
+    auto now = std::chrono::steady_clock::now();
+    if (windowItems_ == 0) {
+        // The window opens one item-latency before its first completion
+        windowStart_ = now - latency;
+    }
+    double latencyUs = static_cast<double>(latency.count());
+    ++windowItems_;
+    windowLatencyUs_ += latencyUs;
+    ++items_;
+    totalLatencyUs_ += latencyUs;
+
+    if (windowItems_ < std::max(MIN_WINDOW, limit_ * 2)) {
+        return;
+    }
+    double seconds = std::chrono::duration<double>(now - windowStart_).count();
+    double windowThroughput = seconds > 0.0 ? windowItems_ / seconds : 0.0;
+    windowedItems_ += windowItems_;
+    windowedSeconds_ += seconds;
+    double meanLatency = windowLatencyUs_ / windowItems_;
+    windowItems_ = 0;
+    windowLatencyUs_ = 0.0;
+    observeWindow(windowThroughput, meanLatency);
+}
+
+void ConcurrencyTuner::observeWindow(double throughput, double meanLatencyUs) {
+    if (baselineLatencyUs_ <= 0.0) {
+        baselineLatencyUs_ = meanLatencyUs;
+    } else {
+        baselineLatencyUs_ = std::min(meanLatencyUs, baselineLatencyUs_ * BASELINE_DRIFT);
+    }
+
+    bool latencyRose = meanLatencyUs > baselineLatencyUs_ * LATENCY_TOLERANCE;
+    bool throughputFell = lastThroughput_ > 0.0 && lastLimit_ < limit_ &&
+                          throughput < lastThroughput_ * THROUGHPUT_DROP;
+
+    lastThroughput_ = throughput;
+    lastLimit_ = limit_;
+    if (latencyRose || throughputFell) {
+        size_t halved = std::max(minLimit_, limit_ / 2);
+        if (halved < limit_) {
+            limit_ = halved;
+            ++decreases_;
+        }
+        // Measure the new limit against fresh figures
+        baselineLatencyUs_ = meanLatencyUs;
+    } else if (limit_ < maxLimit_) {
+        ++limit_;
+        ++increases_;
+    }
+}
+
+double ConcurrencyTuner::meanLatencyUs() const {
+    return items_ > 0 ? totalLatencyUs_ / items_ : 0.0;
+}
+
+double ConcurrencyTuner::throughput() const {
+    return windowedSeconds_ > 0.0 ? windowedItems_ / windowedSeconds_ : 0.0;
+}
+
+// ============================================================================
+// TimingHistory
+// ============================================================================
+
+bool TimingHistory::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        lastError_ = ErrorInfo(ErrorCode::FILE_NOT_FOUND, "Cannot open timing history: " + path);
+        return false;
+    }
+    try {
+        json j = json::parse(file);
+        std::map<std::string, EnvironmentTiming> loaded;
+        if (j.contains("environments")) {
+            for (const auto& entry : j["environments"].items()) {
+                EnvironmentTiming timing;
+                if (entry.value().contains("render")) timing.render = stageFromJson(entry.value()["render"]);
+                if (entry.value().contains("write")) timing.write = stageFromJson(entry.value()["write"]);
+                loaded[entry.key()] = timing;
+            }
+        }
+        environments_.swap(loaded);
+        return true;
+    } catch (const json::exception& e) {
+        lastError_ = ErrorInfo(ErrorCode::CONFIG_LOAD_FAILED, "Invalid timing history", e.what());
+        return false;
+    }
+}
+
+bool TimingHistory::save(const std::string& path) const {
+    json j;
+    j["version"] = "1.0";
+    j["environments"] = json::object();
+    for (const auto& entry : environments_) {
+        j["environments"][entry.first]["render"] = stageToJson(entry.second.render);
+        j["environments"][entry.first]["write"] = stageToJson(entry.second.write);
+    }
+
+    // Write-then-rename so a crash never leaves a truncated history
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        if (!file.is_open()) {
+            lastError_ = ErrorInfo(ErrorCode::CONFIG_SAVE_FAILED, "Cannot write timing history: " + path);
+            return false;
+        }
+        file << j.dump(2);
+        if (!file.good()) {
+            lastError_ = ErrorInfo(ErrorCode::CONFIG_SAVE_FAILED, "Cannot write timing history: " + path);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        lastError_ = ErrorInfo(ErrorCode::CONFIG_SAVE_FAILED, "Cannot replace timing history: " + path);
+        return false;
+    }
+    return true;
+}
+
+bool TimingHistory::find(const std::string& environment, EnvironmentTiming& timing) const {
+    auto it = environments_.find(environment);
+    if (it == environments_.end()) {
+        return false;
+    }
+    timing = it->second;
+    return true;
+}
+
+void TimingHistory::record(const std::string& environment, const EnvironmentTiming& run) {
+    EnvironmentTiming& history = environments_[environment];
+    mergeStage(history.render, run.render);
+    mergeStage(history.write, run.write);
+}
+
+std::string TimingHistory::environmentKey(const std::string& sampleFile) {
+    std::string share = DirectoryScanner::shareOf(sampleFile);
+    return hostName() + "|" + (share.empty() ? std::string("local") : share);
+}
+
+} // namespace creo_barcode
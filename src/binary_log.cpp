@@ -0,0 +1,409 @@
+/**
+ * @file binary_log.cpp
+ * @brief Binary log writer and decoder
+ *
+ * File layout (little-endian):
+ *   char magic[4] = "CBLG", uint32 version
+ *   then a sequence of records:
+ *   FORMAT: uint8 2, uint32 id, uint8 level, int32 line,
+ *           uint32 fileLen, char file[], uint32 formatLen, char format[]
+ *   EVENT:  uint8 1, uint32 id, uint64 timeNanos, uint32 thread, uint8 argc,
+ *           argc x (uint8 type, payload)
+ *   Argument payloads: INT64/UINT64/DOUBLE 8 bytes, BOOL 1 byte,
+ *   STRING uint32 length + bytes.
+ *
+ * A FORMAT record always precedes the first EVENT that uses its id.
+ */
+
+#include "binary_log.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+namespace creo_barcode {
+
+namespace {
+
+constexpr char LOG_MAGIC[4] = {'C', 'B', 'L', 'G'};
+
+template <typename T>
+bool readValue(const unsigned char* data, size_t size, size_t& offset, T& value) {
+    if (size - offset < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, data + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+bool readString(const unsigned char* data, size_t size, size_t& offset, std::string& value) {
+    uint32_t length;
+    if (!readValue(data, size, offset, length) || size - offset < length) {
+        return false;
+    }
+    value.assign(reinterpret_cast<const char*>(data + offset), length);
+    offset += length;
+    return true;
+}
+
+std::string formatDouble(double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.6f", value);
+    return text;
+}
+
+} // anonymous namespace
+
+namespace binary_log_detail {
+
+uint64_t currentTimeNanos() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace binary_log_detail
+
+// Owns the calling thread's buffer; flushes and unregisters it on thread exit
+struct BinaryLogThreadHolder {
+    binary_log_detail::ThreadBuffer* buffer = nullptr;
+
+    ~BinaryLogThreadHolder() {
+        if (!buffer) {
+            return;
+        }
+        BinaryLog& log = BinaryLog::getInstance();
+        {
+            std::lock_guard<std::mutex> lock(log.registryMutex_);
+            auto& buffers = log.buffers_;
+            buffers.erase(std::remove(buffers.begin(), buffers.end(), buffer), buffers.end());
+        }
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            log.writeBlock(buffer->data);
+        }
+        delete buffer;
+    }
+};
+
+BinaryLog& BinaryLog::getInstance() {
+    // Never destroyed, so thread buffers can flush during process shutdown
+    static BinaryLog* instance = nullptr;
+    static std::once_flag flag;
+    std::call_once(flag, []() {
+        instance = new BinaryLog();
+    });
+    return *instance;
+}
+
+std::string BinaryLog::defaultPath() {
+#ifdef _WIN32
+    const char* temp = std::getenv("TEMP");
+    if (temp) {
+        return std::string(temp) + "\\creo_barcode.blog";
+    }
+    return "creo_barcode.blog";
+#else
+    return "/tmp/creo_barcode.blog";
+#endif
+}
+
+binary_log_detail::ThreadBuffer& BinaryLog::localBuffer() {
+    thread_local BinaryLogThreadHolder holder;
+    if (!holder.buffer) {
+        holder.buffer = new binary_log_detail::ThreadBuffer();
+        holder.buffer->data.reserve(FLUSH_THRESHOLD + 4096);
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        holder.buffer->threadIndex = nextThreadIndex_++;
+        buffers_.push_back(holder.buffer);
+    }
+    return *holder.buffer;
+}
+
+bool BinaryLog::open(const std::string& path) {
+    close();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        lastError_ = ErrorInfo(ErrorCode::FILE_NOT_FOUND, "Cannot open binary log", path);
+        return false;
+    }
+
+    file_.write(LOG_MAGIC, sizeof(LOG_MAGIC));
+    uint32_t version = FILE_VERSION;
+    file_.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    bytesWritten_.store(sizeof(LOG_MAGIC) + sizeof(version), std::memory_order_relaxed);
+
+    // Re-emit known formats so the new file is self-describing
+    for (size_t i = 0; i < sites_.size(); ++i) {
+        writeSiteRecord(static_cast<uint32_t>(i + 1), sites_[i]);
+    }
+
+    enabled_.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void BinaryLog::close() {
+    if (!isEnabled()) {
+        return;
+    }
+    flush();
+    enabled_.store(false, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_.is_open()) {
+        file_.close();
+    }
+}
+
+uint32_t BinaryLog::registerSite(const LogSite& site, const char* format) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Another thread may have registered it while we waited
+    uint32_t id = site.id.load(std::memory_order_acquire);
+    if (id != 0) {
+        return id;
+    }
+
+    sites_.push_back(SiteInfo{site.level, site.file ? site.file : "", site.line, format ? format : ""});
+    id = static_cast<uint32_t>(sites_.size());
+    if (file_.is_open()) {
+        writeSiteRecord(id, sites_.back());
+    }
+    site.id.store(id, std::memory_order_release);
+    return id;
+}
+
+void BinaryLog::writeSiteRecord(uint32_t id, const SiteInfo& info) {
+    std::vector<char> record;
+    record.push_back(RECORD_FORMAT);
+    binary_log_detail::appendRaw(record, id);
+    record.push_back(static_cast<char>(info.level));
+    binary_log_detail::appendRaw(record, static_cast<int32_t>(info.line));
+    binary_log_detail::appendRaw(record, static_cast<uint32_t>(info.file.size()));
+    record.insert(record.end(), info.file.begin(), info.file.end());
+    binary_log_detail::appendRaw(record, static_cast<uint32_t>(info.format.size()));
+    record.insert(record.end(), info.format.begin(), info.format.end());
+
+    file_.write(record.data(), static_cast<std::streamsize>(record.size()));
+    bytesWritten_.fetch_add(record.size(), std::memory_order_relaxed);
+}
+
+void BinaryLog::writeBlock(std::vector<char>& block) {
+    if (block.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (file_.is_open()) {
+            file_.write(block.data(), static_cast<std::streamsize>(block.size()));
+            bytesWritten_.fetch_add(block.size(), std::memory_order_relaxed);
+        }
+    }
+    block.clear();
+}
+
+void BinaryLog::flush() {
+    std::lock_guard<std::mutex> registryLock(registryMutex_);
+    for (auto* buffer : buffers_) {
+        std::vector<char> pending;
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            pending.swap(buffer->data);
+            buffer->data.reserve(FLUSH_THRESHOLD + 4096);
+        }
+        writeBlock(pending);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_.is_open()) {
+        file_.flush();
+    }
+}
+
+ErrorInfo BinaryLog::getLastError() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lastError_;
+}
+
+// ============================================================================
+// BinaryLogDecoder
+// ============================================================================
+
+bool BinaryLogDecoder::open(const std::string& path) {
+    formats_.clear();
+    locations_.clear();
+    offset_ = 0;
+
+    if (!file_.open(path)) {
+        lastError_ = ErrorInfo(ErrorCode::FILE_NOT_FOUND, "Cannot open binary log", path);
+        return false;
+    }
+
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(file_.data());
+    uint32_t version = 0;
+    if (file_.size() < sizeof(LOG_MAGIC) + sizeof(version) ||
+        std::memcmp(data, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0) {
+        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Not a binary log file", path);
+        file_.close();
+        return false;
+    }
+    std::memcpy(&version, data + sizeof(LOG_MAGIC), sizeof(version));
+    if (version != BinaryLog::FILE_VERSION) {
+        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Unsupported binary log version",
+                               std::to_string(version));
+        file_.close();
+        return false;
+    }
+
+    offset_ = sizeof(LOG_MAGIC) + sizeof(version);
+    return true;
+}
+
+bool BinaryLogDecoder::next(DecodedLogEvent& event) {
+    if (!file_.isOpen()) {
+        return false;
+    }
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(file_.data());
+    const size_t size = file_.size();
+
+    auto corrupt = [this](const char* what) {
+        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Corrupt binary log record", what);
+        offset_ = file_.size();
+        return false;
+    };
+
+    while (offset_ < size) {
+        uint8_t recordType = data[offset_++];
+
+        if (recordType == static_cast<uint8_t>(BinaryLog::RECORD_FORMAT)) {
+            uint32_t id;
+            uint8_t level;
+            int32_t line;
+            std::string file;
+            std::string format;
+            if (!readValue(data, size, offset_, id) || !readValue(data, size, offset_, level) ||
+                !readValue(data, size, offset_, line) || !readString(data, size, offset_, file) ||
+                !readString(data, size, offset_, format) || id == 0) {
+                return corrupt("format");
+            }
+            if (formats_.size() < id) {
+                formats_.resize(id);
+                locations_.resize(id);
+            }
+            formats_[id - 1] = {static_cast<LogLevel>(level), format};
+            locations_[id - 1] = {file, line};
+            continue;
+        }
+
+        if (recordType != static_cast<uint8_t>(BinaryLog::RECORD_EVENT)) {
+            return corrupt("record type");
+        }
+
+        uint32_t id;
+        uint8_t argc;
+        if (!readValue(data, size, offset_, id) || !readValue(data, size, offset_, event.timeNanos) ||
+            !readValue(data, size, offset_, event.threadIndex) || !readValue(data, size, offset_, argc)) {
+            return corrupt("event header");
+        }
+        if (id == 0 || id > formats_.size()) {
+            return corrupt("unknown format id");
+        }
+
+        std::vector<std::string> args;
+        args.reserve(argc);
+        for (uint8_t i = 0; i < argc; ++i) {
+            uint8_t type;
+            if (!readValue(data, size, offset_, type)) {
+                return corrupt("argument");
+            }
+            switch (static_cast<LogArgType>(type)) {
+                case LogArgType::INT64: {
+                    int64_t v;
+                    if (!readValue(data, size, offset_, v)) return corrupt("argument");
+                    args.push_back(std::to_string(v));
+                    break;
+                }
+                case LogArgType::UINT64: {
+                    uint64_t v;
+                    if (!readValue(data, size, offset_, v)) return corrupt("argument");
+                    args.push_back(std::to_string(v));
+                    break;
+                }
+                case LogArgType::DOUBLE: {
+                    double v;
+                    if (!readValue(data, size, offset_, v)) return corrupt("argument");
+                    args.push_back(formatDouble(v));
+                    break;
+                }
+                case LogArgType::BOOL: {
+                    uint8_t v;
+                    if (!readValue(data, size, offset_, v)) return corrupt("argument");
+                    args.push_back(v ? "true" : "false");
+                    break;
+                }
+                case LogArgType::STRING: {
+                    std::string v;
+                    if (!readString(data, size, offset_, v)) return corrupt("argument");
+                    args.push_back(std::move(v));
+                    break;
+                }
+                default:
+                    return corrupt("argument type");
+            }
+        }
+
+        const auto& format = formats_[id - 1];
+        event.level = format.first;
+        event.file = locations_[id - 1].first;
+        event.line = locations_[id - 1].second;
+
+        // Substitute "{}" placeholders in order; surplus arguments are appended
+        event.message.clear();
+        size_t nextArg = 0;
+        const std::string& text = format.second;
+        for (size_t pos = 0; pos < text.size(); ++pos) {
+            if (text[pos] == '{' && pos + 1 < text.size() && text[pos + 1] == '}' && nextArg < args.size()) {
+                event.message += args[nextArg++];
+                ++pos;
+            } else {
+                event.message += text[pos];
+            }
+        }
+        for (; nextArg < args.size(); ++nextArg) {
+            event.message += " " + args[nextArg];
+        }
+        return true;
+    }
+    return false;
+}
+
+std::string BinaryLogDecoder::formatEvent(const DecodedLogEvent& event) {
+    std::time_t seconds = static_cast<std::time_t>(event.timeNanos / 1000000000ULL);
+    unsigned millis = static_cast<unsigned>((event.timeNanos / 1000000ULL) % 1000);
+    std::tm tm_buf;
+#ifdef _WIN32
+    localtime_s(&tm_buf, &seconds);
+#else
+    localtime_r(&seconds, &tm_buf);
+#endif
+
+    std::ostringstream line;
+    line << "[" << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S") << "."
+         << std::setw(3) << std::setfill('0') << millis << "] "
+         << "[" << logLevelToString(event.level) << "] "
+         << "[T" << event.threadIndex << "] "
+         << event.message;
+    if (!event.file.empty()) {
+        // Only the file name; full build paths are noise in a log line
+        size_t slash = event.file.find_last_of("/\\");
+        line << " (" << (slash == std::string::npos ? event.file : event.file.substr(slash + 1))
+             << ":" << event.line << ")";
+    }
+    return line.str();
+}
+
+} // namespace creo_barcode
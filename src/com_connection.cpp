@@ -0,0 +1,238 @@
+/**
+ * @file com_connection.cpp
+ * @brief Implementation of the COM link circuit breaker and manager
+ */
+
+#include "com_connection.h"
+#include <algorithm>
+
+namespace creo_barcode {
+
+const char* circuitStateName(CircuitState state) {
+    switch (state) {
+        case CircuitState::CLOSED: return "closed";
+        case CircuitState::OPEN: return "open";
+        case CircuitState::HALF_OPEN: return "half-open";
+        default: return "unknown";
+    }
+}
+
+// ============================================================================
+// CircuitBreaker
+// ============================================================================
+
+CircuitBreaker::CircuitBreaker(const CircuitBreakerConfig& config, Clock clock)
+    : config_(config)
+    , clock_(clock ? std::move(clock) : Clock([]() { return std::chrono::steady_clock::now(); }))
+    , backoff_(config.initialBackoff) {
+}
+
+bool CircuitBreaker::allowRequest() {
+    switch (state_) {
+        case CircuitState::CLOSED:
+            return true;
+        case CircuitState::HALF_OPEN:
+            if (trialInFlight_) {
+                return false;
+            }
+            trialInFlight_ = true;
+            return true;
+        case CircuitState::OPEN:
+        default:
+            return false;
+    }
+}
+
+void CircuitBreaker::recordSuccess() {
+    state_ = CircuitState::CLOSED;
+    failures_ = 0;
+    trialInFlight_ = false;
+    backoff_ = config_.initialBackoff;
+}
+
+void CircuitBreaker::recordFailure() {
+    ++failures_;
+    if (state_ == CircuitState::CLOSED) {
+        if (failures_ >= std::max(1, config_.failureThreshold)) {
+            open(config_.initialBackoff);
+        }
+    } else {
+        // A failed probe or trial: wait longer before the next one
+        open(nextBackoff());
+    }
+}
+
+bool CircuitBreaker::probeDue() const {
+    return state_ == CircuitState::OPEN && clock_() >= retryAt_;
+}
+
+void CircuitBreaker::enterHalfOpen() {
+    if (state_ == CircuitState::OPEN) {
+        state_ = CircuitState::HALF_OPEN;
+        trialInFlight_ = false;
+    }
+}
+
+void CircuitBreaker::open(std::chrono::milliseconds backoff) {
+    state_ = CircuitState::OPEN;
+    trialInFlight_ = false;
+    backoff_ = backoff;
+    retryAt_ = clock_() + backoff;
+}
+
+std::chrono::milliseconds CircuitBreaker::nextBackoff() const {
+    auto grown = std::chrono::milliseconds(
+        static_cast<std::chrono::milliseconds::rep>(backoff_.count() * config_.backoffMultiplier));
+    return std::min(std::max(grown, config_.initialBackoff), config_.maxBackoff);
+}
+
+// ============================================================================
+// ComConnectionManager
+// ============================================================================
+
+ComConnectionManager::ComConnectionManager(std::unique_ptr<ComConnection> connection,
+                                           const CircuitBreakerConfig& config,
+                                           CircuitBreaker::Clock clock)
+    : connection_(std::move(connection))
+    , config_(config)
+    , breaker_(config, std::move(clock)) {
+    if (config_.backgroundReconnect) {
+        worker_ = std::thread(&ComConnectionManager::workerLoop, this);
+    }
+}
+
+ComConnectionManager::~ComConnectionManager() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+bool ComConnectionManager::acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.requests;
+
+    // Without a worker, the first request after the backoff is the probe
+    if (!config_.backgroundReconnect && breaker_.probeDue()) {
+        breaker_.enterHalfOpen();
+    }
+    if (!breaker_.allowRequest()) {
+        ++stats_.rejected;
+        return false;
+    }
+
+    if (!connected_) {
+        connected_ = connection_->connect();
+        if (!connected_) {
+            failLocked();
+            return false;
+        }
+        ++stats_.connects;
+    }
+    return true;
+}
+
+void ComConnectionManager::reportSuccess() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    breaker_.recordSuccess();
+}
+
+void ComConnectionManager::reportFailure() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    failLocked();
+}
+
+void ComConnectionManager::failLocked() {
+    ++stats_.failures;
+    // The cached handles are suspect after a link failure
+    if (connected_) {
+        connection_->disconnect();
+        connected_ = false;
+    }
+    breaker_.recordFailure();
+    if (breaker_.state() == CircuitState::OPEN) {
+        wake_.notify_all();
+    }
+}
+
+bool ComConnectionManager::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (breaker_.state() != CircuitState::OPEN) {
+        return false;
+    }
+    return config_.backgroundReconnect || !breaker_.probeDue();
+}
+
+bool ComConnectionManager::pollReconnect() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (probing_ || !breaker_.probeDue()) {
+        return false;
+    }
+    return probeLocked(lock);
+}
+
+bool ComConnectionManager::probeLocked(std::unique_lock<std::mutex>& lock) {
+    probing_ = true;
+    lock.unlock();
+    bool reachable = connection_->probe();
+    lock.lock();
+    probing_ = false;
+    ++stats_.probes;
+
+    // reset() may have closed the breaker while the probe ran
+    if (breaker_.state() == CircuitState::OPEN) {
+        if (reachable) {
+            breaker_.enterHalfOpen();
+        } else {
+            breaker_.recordFailure();
+        }
+    }
+    return true;
+}
+
+void ComConnectionManager::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (connected_) {
+        connection_->disconnect();
+        connected_ = false;
+    }
+    breaker_.recordSuccess();
+}
+
+CircuitState ComConnectionManager::state() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return breaker_.state();
+}
+
+bool ComConnectionManager::isConnected() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return connected_;
+}
+
+ComLinkStats ComConnectionManager::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void ComConnectionManager::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (breaker_.state() != CircuitState::OPEN || probing_) {
+            wake_.wait(lock);
+            continue;
+        }
+        auto now = breaker_.now();
+        auto due = breaker_.retryAt();
+        if (now < due) {
+            wake_.wait_for(lock, due - now);
+            continue;
+        }
+        probeLocked(lock);
+    }
+}
+
+} // namespace creo_barcode
@@ -16,6 +16,8 @@ std::string ConfigManager::serialize() const {
     j["defaultDpi"] = config_.defaultDpi;
     j["outputDirectory"] = config_.outputDirectory;
     j["recentFiles"] = config_.recentFiles;
+    j["enableTracing"] = config_.enableTracing;
+    j["speculativeGeneration"] = config_.speculativeGeneration;
     
     return j.dump(4);
 }
@@ -35,6 +37,8 @@ bool ConfigManager::deserialize(const std::string& jsonStr) {
         if (j.contains("defaultDpi")) config_.defaultDpi = j["defaultDpi"].get<int>();
         if (j.contains("outputDirectory")) config_.outputDirectory = j["outputDirectory"].get<std::string>();
         if (j.contains("recentFiles")) config_.recentFiles = j["recentFiles"].get<std::vector<std::string>>();
+        if (j.contains("enableTracing")) config_.enableTracing = j["enableTracing"].get<bool>();
+        if (j.contains("speculativeGeneration")) config_.speculativeGeneration = j["speculativeGeneration"].get<bool>();
         
         return true;
     } catch (const json::exception& e) {
@@ -0,0 +1,342 @@
+/**
+ * @file content_hash.cpp
+ * @brief Implementation of the content hashing utilities
+ *
+ * The hash consumes 64-byte stripes into eight 64-bit accumulators using a
+ * 32x32->64 multiply per lane (the same construction as XXH3). That
+ * operation maps directly onto SSE2 _mm_mul_epu32, so two lanes are
+ * processed per instruction on x86. Every 16 stripes the accumulators are
+ * scrambled to keep the lanes from saturating. The final tail is zero-padded
+ * into one more stripe, and the length is mixed into the result so padded
+ * inputs do not collide.
+ *
+ * Input words are read little-endian; all supported targets (x86, x64,
+ * ARM64) are little-endian.
+ */
+
+#include "content_hash.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONTENT_HASH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace creo_barcode {
+
+namespace {
+
+constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+constexpr uint32_t PRIME32_1 = 0x9E3779B1U;
+constexpr uint32_t PRIME32_2 = 0x85EBCA77U;
+constexpr uint32_t PRIME32_3 = 0xC2B2AE3DU;
+
+constexpr size_t LANES = 8;
+constexpr size_t STRIPE = 64;
+constexpr size_t STRIPES_PER_BLOCK = 16;
+constexpr size_t KEY_WORDS = 16;
+
+constexpr uint64_t splitmix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+struct KeyTable {
+    uint64_t words[KEY_WORDS];
+};
+
+constexpr KeyTable makeKeyTable() {
+    KeyTable table{};
+    uint64_t state = PRIME64_3;
+    for (size_t i = 0; i < KEY_WORDS; ++i) {
+        state += 0x9E3779B97F4A7C15ULL;
+        table.words[i] = splitmix64(state);
+    }
+    return table;
+}
+
+constexpr KeyTable KEYS = makeKeyTable();
+
+// Stripe n uses key words [n % 8, n % 8 + 8); scrambling uses the upper half
+const uint64_t* stripeKey(size_t stripeIndex) {
+    return KEYS.words + (stripeIndex & 7);
+}
+
+const uint64_t* scrambleKey() {
+    return KEYS.words + (KEY_WORDS - LANES);
+}
+
+inline uint64_t readLE64(const unsigned char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t mul128Fold64(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t high;
+    uint64_t low = _umul128(a, b, &high);
+    return low ^ high;
+#else
+    uint64_t aLo = a & 0xFFFFFFFFULL, aHi = a >> 32;
+    uint64_t bLo = b & 0xFFFFFFFFULL, bHi = b >> 32;
+    uint64_t loLo = aLo * bLo;
+    uint64_t hiLo = aHi * bLo;
+    uint64_t loHi = aLo * bHi;
+    uint64_t hiHi = aHi * bHi;
+    uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFFULL) + loHi;
+    uint64_t high = (hiLo >> 32) + (cross >> 32) + hiHi;
+    uint64_t low = (cross << 32) | (loLo & 0xFFFFFFFFULL);
+    return low ^ high;
+#endif
+}
+
+inline uint64_t avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ULL;
+    h ^= h >> 32;
+    return h;
+}
+
+void accumulateScalar(uint64_t* acc, const unsigned char* stripe, const uint64_t* key) {
+    for (size_t i = 0; i < LANES; ++i) {
+        uint64_t data = readLE64(stripe + i * 8);
+        uint64_t keyed = data ^ key[i];
+        acc[i ^ 1] += data;
+        acc[i] += (keyed & 0xFFFFFFFFULL) * (keyed >> 32);
+    }
+}
+
+void scrambleScalar(uint64_t* acc, const uint64_t* key) {
+    for (size_t i = 0; i < LANES; ++i) {
+        uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= key[i];
+        a *= PRIME32_1;
+        acc[i] = a;
+    }
+}
+
+#ifdef CONTENT_HASH_SSE2
+void accumulateSse2(uint64_t* acc, const unsigned char* stripe, const uint64_t* key) {
+    __m128i* accVec = reinterpret_cast<__m128i*>(acc);
+    for (size_t i = 0; i < LANES / 2; ++i) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stripe) + i);
+        __m128i keyVec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key) + i);
+        __m128i keyed = _mm_xor_si128(data, keyVec);
+        __m128i product = _mm_mul_epu32(keyed, _mm_srli_epi64(keyed, 32));
+        __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        __m128i sum = _mm_add_epi64(_mm_loadu_si128(accVec + i), swapped);
+        _mm_storeu_si128(accVec + i, _mm_add_epi64(sum, product));
+    }
+}
+
+void scrambleSse2(uint64_t* acc, const uint64_t* key) {
+    __m128i* accVec = reinterpret_cast<__m128i*>(acc);
+    const __m128i prime = _mm_set1_epi32(static_cast<int>(PRIME32_1));
+    for (size_t i = 0; i < LANES / 2; ++i) {
+        __m128i a = _mm_loadu_si128(accVec + i);
+        a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+        a = _mm_xor_si128(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key) + i));
+        // 64x32 multiply from two 32x32->64 products
+        __m128i low = _mm_mul_epu32(a, prime);
+        __m128i high = _mm_mul_epu32(_mm_srli_epi64(a, 32), prime);
+        _mm_storeu_si128(accVec + i, _mm_add_epi64(low, _mm_slli_epi64(high, 32)));
+    }
+}
+#endif
+
+inline void accumulate(bool simd, uint64_t* acc, const unsigned char* stripe, const uint64_t* key) {
+#ifdef CONTENT_HASH_SSE2
+    if (simd) {
+        accumulateSse2(acc, stripe, key);
+        return;
+    }
+#endif
+    (void)simd;
+    accumulateScalar(acc, stripe, key);
+}
+
+inline void scramble(bool simd, uint64_t* acc, const uint64_t* key) {
+#ifdef CONTENT_HASH_SSE2
+    if (simd) {
+        scrambleSse2(acc, key);
+        return;
+    }
+#endif
+    (void)simd;
+    scrambleScalar(acc, key);
+}
+
+} // anonymous namespace
+
+std::string Hash128::toHex() const {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(32, '0');
+    for (int i = 0; i < 16; ++i) {
+        hex[15 - i] = digits[(high >> (i * 4)) & 0xF];
+        hex[31 - i] = digits[(low >> (i * 4)) & 0xF];
+    }
+    return hex;
+}
+
+ContentHasher::ContentHasher(uint64_t seed) : seed_(seed) {
+    reset();
+}
+
+ContentHasher ContentHasher::portable(uint64_t seed) {
+    ContentHasher hasher(seed);
+    hasher.simd_ = false;
+    return hasher;
+}
+
+bool ContentHasher::simdEnabled() {
+#ifdef CONTENT_HASH_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ContentHasher::reset() {
+    acc_[0] = PRIME32_3 + seed_;
+    acc_[1] = PRIME64_1 - seed_;
+    acc_[2] = PRIME64_2 + seed_;
+    acc_[3] = PRIME64_3 - seed_;
+    acc_[4] = PRIME64_4 + seed_;
+    acc_[5] = PRIME32_2 - seed_;
+    acc_[6] = PRIME64_5 + seed_;
+    acc_[7] = PRIME32_1 - seed_;
+    bufferSize_ = 0;
+    stripesInBlock_ = 0;
+    totalSize_ = 0;
+}
+
+void ContentHasher::consumeStripe(const unsigned char* stripe) {
+    accumulate(simd_, acc_, stripe, stripeKey(stripesInBlock_));
+    if (++stripesInBlock_ == STRIPES_PER_BLOCK) {
+        scramble(simd_, acc_, scrambleKey());
+        stripesInBlock_ = 0;
+    }
+}
+
+void ContentHasher::update(const void* data, size_t size) {
+    const unsigned char* input = static_cast<const unsigned char*>(data);
+    totalSize_ += size;
+
+    // Top up a partially filled stripe first
+    if (bufferSize_ > 0) {
+        size_t take = std::min(size, STRIPE - bufferSize_);
+        std::memcpy(buffer_ + bufferSize_, input, take);
+        bufferSize_ += take;
+        input += take;
+        size -= take;
+        if (size == 0) {
+            return;
+        }
+        consumeStripe(buffer_);
+        bufferSize_ = 0;
+    }
+
+    // Whole stripes straight from the input, keeping the final bytes
+    // buffered so finish() always sees the real tail
+    while (size > STRIPE) {
+        consumeStripe(input);
+        input += STRIPE;
+        size -= STRIPE;
+    }
+
+    if (size > 0) {
+        std::memcpy(buffer_, input, size);
+    }
+    bufferSize_ = size;
+}
+
+Hash128 ContentHasher::finish() const {
+    uint64_t acc[LANES];
+    std::memcpy(acc, acc_, sizeof(acc));
+
+    if (bufferSize_ > 0) {
+        unsigned char last[STRIPE] = {};
+        std::memcpy(last, buffer_, bufferSize_);
+        accumulate(simd_, acc, last, stripeKey(stripesInBlock_));
+    }
+
+    Hash128 result;
+    uint64_t low = totalSize_ * PRIME64_1;
+    uint64_t high = (totalSize_ ^ seed_) * PRIME64_2 + PRIME64_4;
+    for (size_t i = 0; i < LANES / 2; ++i) {
+        low += mul128Fold64(acc[2 * i] ^ KEYS.words[2 * i], acc[2 * i + 1] ^ KEYS.words[2 * i + 1]);
+        high += mul128Fold64(acc[2 * i + 1] ^ KEYS.words[8 + 2 * i], acc[2 * i] ^ KEYS.words[9 + 2 * i]);
+    }
+    result.low = avalanche(low);
+    result.high = avalanche(high);
+    return result;
+}
+
+uint64_t hash64(std::string_view data, uint64_t seed) {
+    return hashBytes128(data.data(), data.size(), seed).low;
+}
+
+Hash128 hash128(std::string_view data, uint64_t seed) {
+    return hashBytes128(data.data(), data.size(), seed);
+}
+
+uint64_t hashBytes64(const void* data, size_t size, uint64_t seed) {
+    return hashBytes128(data, size, seed).low;
+}
+
+Hash128 hashBytes128(const void* data, size_t size, uint64_t seed) {
+    ContentHasher hasher(seed);
+    hasher.update(data, size);
+    return hasher.finish();
+}
+
+uint64_t hashCombine(uint64_t seed, uint64_t value) {
+    return avalanche(mul128Fold64(seed ^ PRIME64_1, value ^ PRIME64_2) + seed);
+}
+
+std::optional<Hash128> hashFile(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path)) {
+        return std::nullopt;
+    }
+    return hashBytes128(file.data(), file.size());
+}
+
+uint64_t hashBarcodeConfig(const BarcodeConfig& config) {
+    bool linear = config.type == BarcodeType::CODE_128 ||
+                  config.type == BarcodeType::CODE_39 ||
+                  config.type == BarcodeType::EAN_13;
+
+    // Fixed little-endian layout so the hash is stable across compilers;
+    // the leading version word changes if the set of fields ever does
+    const uint32_t fields[] = {
+        1,
+        static_cast<uint32_t>(config.type),
+        static_cast<uint32_t>(config.width),
+        static_cast<uint32_t>(config.height),
+        static_cast<uint32_t>(config.margin),
+        linear && config.showText ? 1u : 0u,
+    };
+    return hashBytes64(fields, sizeof(fields));
+}
+
+} // namespace creo_barcode
@@ -5,12 +5,18 @@
 
 #include "creo_com_bridge.h"
 #include "logger.h"
+#include "binary_log.h"
+#include "trace.h"
+#include "plugin_stats.h"
+#include "utf_transcode.h"
+#include "image_validator.h"
 
 #ifdef _WIN32
 
 #include <sstream>
 #include <iomanip>
 #include <filesystem>
+#include <system_error>
 #include <algorithm>
 #include <objbase.h>
 #include <atlbase.h>
@@ -117,57 +123,87 @@ std::wstring bstrToString(BSTR bstr) {
 }
 
 std::wstring utf8ToWstring(const std::string& utf8) {
-    if (utf8.empty()) {
-        return std::wstring();
-    }
-    
-    // Calculate required buffer size
-    int wideLen = MultiByteToWideChar(CP_UTF8, 0, 
-                                       utf8.c_str(), 
-                                       static_cast<int>(utf8.length()),
-                                       nullptr, 0);
-    if (wideLen == 0) {
-        return std::wstring();
-    }
-    
-    // Perform conversion
-    std::wstring result(wideLen, L'\0');
-    MultiByteToWideChar(CP_UTF8, 0,
-                        utf8.c_str(),
-                        static_cast<int>(utf8.length()),
-                        &result[0], wideLen);
-    
+    std::wstring result;
+    utf::utf8ToWide(utf8, result);
     return result;
 }
 
 std::string wstringToUtf8(const std::wstring& wstr) {
-    if (wstr.empty()) {
-        return std::string();
-    }
-    
-    // Calculate required buffer size
-    int utf8Len = WideCharToMultiByte(CP_UTF8, 0,
-                                       wstr.c_str(),
-                                       static_cast<int>(wstr.length()),
-                                       nullptr, 0,
-                                       nullptr, nullptr);
-    if (utf8Len == 0) {
-        return std::string();
-    }
-    
-    // Perform conversion
-    std::string result(utf8Len, '\0');
-    WideCharToMultiByte(CP_UTF8, 0,
-                        wstr.c_str(),
-                        static_cast<int>(wstr.length()),
-                        &result[0], utf8Len,
-                        nullptr, nullptr);
-    
+    std::string result;
+    utf::wideToUtf8(wstr, result);
     return result;
 }
 
 } // namespace StringUtils
 
+// ============================================================================
+// COM link health
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief Whether an HRESULT means the link to Creo itself is broken
+ *
+ * Failures on a healthy link (bad image, no drawing open) must not trip
+ * the circuit breaker.
+ */
+bool isLinkFailure(HRESULT hr) {
+    return hr == RPC_E_DISCONNECTED ||
+           hr == RPC_E_SERVER_DIED ||
+           hr == RPC_E_SERVER_DIED_DNE ||
+           hr == RPC_E_CALL_REJECTED ||
+           hr == CO_E_OBJNOTCONNECTED ||
+           hr == CO_E_SERVER_EXEC_FAILURE ||
+           hr == HRESULT_FROM_WIN32(RPC_S_SERVER_UNAVAILABLE) ||
+           hr == HRESULT_FROM_WIN32(RPC_S_CALL_FAILED) ||
+           hr == HRESULT_FROM_WIN32(RPC_S_CALL_FAILED_DNE);
+}
+
+} // anonymous namespace
+
+/**
+ * @brief ComConnection over the bridge's AsyncConnection and session
+ */
+class CreoComLink : public ComConnection {
+public:
+    explicit CreoComLink(CreoComBridge& bridge) : m_bridge(bridge) {}
+
+    bool connect() override {
+        return m_bridge.connectToCreo();
+    }
+
+    void disconnect() override {
+        m_bridge.releaseSessionObjects();
+        m_bridge.m_pSession.Release();
+        m_bridge.m_pConnection.Release();
+    }
+
+    bool probe() override {
+        // Runs on the reconnect worker, so it uses a throwaway connection in
+        // its own apartment and leaves the bridge's handles alone
+        HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        bool comReady = SUCCEEDED(hr);
+
+        bool running = false;
+        IpfcAsyncConnection* pConnection = nullptr;
+        if (SUCCEEDED(CreoVBAPIFactory::CreateAsyncConnection(&pConnection)) && pConnection) {
+            VARIANT_BOOL isRunning = VARIANT_FALSE;
+            running = SUCCEEDED(pConnection->IsRunning(&isRunning)) && isRunning != VARIANT_FALSE;
+            pConnection->Release();
+        }
+
+        if (comReady) {
+            CoUninitialize();
+        }
+        BLOG_VERBOSE("COM link probe: Creo {}", running ? "reachable" : "unreachable");
+        return running;
+    }
+
+private:
+    CreoComBridge& m_bridge;
+};
+
 // ============================================================================
 // CreoComBridge Implementation
 // ============================================================================
@@ -178,11 +214,17 @@ CreoComBridge::CreoComBridge()
     , m_lastHResult(S_OK)
     , m_pConnection(nullptr)
     , m_pSession(nullptr)
+    , m_repaint([this]() { return repaintWindow(); })
 {
 }
 
 CreoComBridge::~CreoComBridge() {
-    cleanup();
+    // Runs at DLL unload, under the loader lock on Windows, where joining
+    // the reconnect worker would deadlock. com_bridge_cleanup() stops it;
+    // if that never ran, the worker is left to the exiting process.
+    if (m_link) {
+        (void)m_link.release();
+    }
 }
 
 CreoComBridge& CreoComBridge::getInstance() {
@@ -209,8 +251,11 @@ bool CreoComBridge::initialize() {
     m_comInitialized = true;
     LOG_INFO("COM library initialized successfully");
     
-    // Connect to Creo
-    if (!connectToCreo()) {
+    // Connect to Creo through the circuit breaker
+    m_link = std::make_unique<ComConnectionManager>(std::make_unique<CreoComLink>(*this));
+    if (m_link->acquire()) {
+        m_link->reportSuccess();
+    } else {
         // Connection failed, but COM is initialized
         // We'll try to connect later when needed
         LOG_WARNING("Could not connect to Creo instance, will retry on demand");
@@ -228,7 +273,12 @@ void CreoComBridge::cleanup() {
     
     LOG_INFO("Cleaning up COM bridge");
     
+    // Stop the reconnect worker before COM goes away
+    m_link.reset();
+    
     // Release COM interfaces (smart pointers handle Release automatically)
+    releaseSessionObjects();
+    m_pathBstrs.clear();
     m_pSession.Release();
     m_pConnection.Release();
     
@@ -247,10 +297,19 @@ bool CreoComBridge::isInitialized() const {
     return m_initialized;
 }
 
+bool CreoComBridge::isComCircuitOpen() const {
+    return !m_link || m_link->isOpen();
+}
+
+CircuitState CreoComBridge::comLinkState() const {
+    return m_link ? m_link->state() : CircuitState::OPEN;
+}
+
 bool CreoComBridge::connectToCreo() {
     LOG_INFO("Attempting to connect to Creo instance");
     
     // Release any existing connection
+    releaseSessionObjects();
     m_pSession.Release();
     m_pConnection.Release();
     
@@ -303,16 +362,74 @@ bool CreoComBridge::connectToCreo() {
     return true;
 }
 
+void CreoComBridge::releaseSessionObjects() {
+    m_pOutlineCorners[0].Release();
+    m_pOutlineCorners[1].Release();
+    m_pOutline.Release();
+}
+
+HRESULT CreoComBridge::prepareOutline(double x1, double y1, double x2, double y2) {
+    if (m_pOutline && m_pOutlineCorners[0] && m_pOutlineCorners[1]) {
+        // CreateDraftingImage copies the outline, so the pooled one can be rewritten.
+        // Item may hand out copies of the corners, so they are written back
+        // rather than trusted to alias the outline's own points.
+        HRESULT hr = m_pOutlineCorners[0]->put_Item(0, x1);
+        if (SUCCEEDED(hr)) hr = m_pOutlineCorners[0]->put_Item(1, y1);
+        if (SUCCEEDED(hr)) hr = m_pOutlineCorners[1]->put_Item(0, x2);
+        if (SUCCEEDED(hr)) hr = m_pOutlineCorners[1]->put_Item(1, y2);
+        if (SUCCEEDED(hr)) hr = m_pOutline->put_Item(0, m_pOutlineCorners[0]);
+        if (SUCCEEDED(hr)) hr = m_pOutline->put_Item(1, m_pOutlineCorners[1]);
+        if (SUCCEEDED(hr)) {
+            return hr;
+        }
+        // A half-written outline is useless; build a fresh one below
+        LOG_WARNING("Pooled outline rejected new coordinates, recreating it");
+    }
+    m_pOutlineCorners[0].Release();
+    m_pOutlineCorners[1].Release();
+    m_pOutline.Release();
+    
+    IpfcOutline2D* pOutline = nullptr;
+    HRESULT hr = CreoVBAPIFactory::CreateOutline2D(x1, y1, x2, y2, &pOutline);
+    if (FAILED(hr) || !pOutline) {
+        return FAILED(hr) ? hr : E_POINTER;
+    }
+    m_pOutline.Attach(pOutline);
+    
+    // Keep the corner points so later insertions can rewrite them and set
+    // them back (without them the outline is used once and recreated next time)
+    for (int i = 0; i < 2; ++i) {
+        IpfcPoint2D* pPoint = nullptr;
+        if (FAILED(m_pOutline->get_Item(i, &pPoint)) || !pPoint) {
+            m_pOutlineCorners[0].Release();
+            break;
+        }
+        m_pOutlineCorners[i].Attach(pPoint);
+    }
+    return hr;
+}
+
+BSTR CreoComBridge::internPath(const std::string& path) {
+    if (const CComBSTR* cached = m_pathBstrs.find(path)) {
+        return cached->m_str;
+    }
+    
+    std::wstring widePath;
+    utf::utf8ToWide(path, widePath);
+    CComBSTR bstr(static_cast<int>(widePath.size()), widePath.c_str());
+    if (!bstr) {
+        return nullptr;
+    }
+    return m_pathBstrs.insert(path, std::move(bstr)).m_str;
+}
+
 IpfcDrawingPtr CreoComBridge::getCurrentDrawing() {
     LOG_INFO("Getting current drawing from Creo session");
     
-    // Ensure we have a valid session
+    // Connecting is the link manager's job; callers acquire() it first
     if (!m_pSession) {
-        // Try to connect if not connected
-        if (!connectToCreo()) {
-            setError("Cannot get drawing - not connected to Creo");
-            return nullptr;
-        }
+        setError("Cannot get drawing - not connected to Creo");
+        return nullptr;
     }
     
     // Get current model from session
@@ -469,78 +586,36 @@ std::string CreoComBridge::formatHResult(HRESULT hr) {
 }
 
 bool CreoComBridge::validateImageFile(const std::string& path) {
-    LOG_INFO("Validating image file: " + path);
+    TRACE_SCOPE("com", "validate_image");
     
-    // Check if path is empty
-    if (path.empty()) {
-        setError("Image file path is empty");
-        return false;
-    }
-    
-    // Check if file exists
-    std::error_code ec;
-    bool exists = std::filesystem::exists(path, ec);
-    if (ec) {
-        setError("Error checking file existence: " + path + " (" + ec.message() + ")");
-        return false;
-    }
-    
-    if (!exists) {
-        setError("Image file not found: " + path);
-        return false;
-    }
-    
-    // Check if it's a regular file (not a directory)
-    bool isRegularFile = std::filesystem::is_regular_file(path, ec);
-    if (ec) {
-        setError("Error checking file type: " + path + " (" + ec.message() + ")");
-        return false;
-    }
-    
-    if (!isRegularFile) {
-        setError("Path is not a regular file: " + path);
-        return false;
-    }
-    
-    // Check file extension
-    std::filesystem::path filePath(path);
-    std::string ext = filePath.extension().string();
-    
-    // Convert to lowercase for comparison
-    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-    
-    // Supported formats: PNG, JPG/JPEG, BMP
-    static const std::vector<std::string> supportedFormats = {
-        ".png", ".jpg", ".jpeg", ".bmp"
-    };
-    
-    bool formatSupported = false;
-    for (const auto& fmt : supportedFormats) {
-        if (ext == fmt) {
-            formatSupported = true;
-            break;
-        }
-    }
-    
-    if (!formatSupported) {
-        setError("Unsupported image format: " + ext + " (supported: PNG, JPG, BMP). File: " + path);
-        return false;
-    }
-    
-    // Check file size (must be > 0)
-    auto fileSize = std::filesystem::file_size(path, ec);
-    if (ec) {
-        setError("Error getting file size: " + path + " (" + ec.message() + ")");
-        return false;
-    }
-    
-    if (fileSize == 0) {
-        setError("Image file is empty (0 bytes): " + path);
-        return false;
+    ImageCheck check = ImageValidator::global().validate(path);
+    switch (check.verdict) {
+        case ImageVerdict::VALID:
+            BLOG_VERBOSE("Image file validation passed: {} (format: {}, size: {} bytes, cached: {})",
+                         path, imageFormatName(check.format), check.size, check.cached);
+            return true;
+        case ImageVerdict::EMPTY_PATH:
+            setError("Image file path is empty");
+            return false;
+        case ImageVerdict::NOT_FOUND:
+            setError("Image file not found: " + path);
+            return false;
+        case ImageVerdict::NOT_REGULAR_FILE:
+            setError("Path is not a regular file: " + path);
+            return false;
+        case ImageVerdict::EMPTY_FILE:
+            setError("Image file is empty (0 bytes): " + path);
+            return false;
+        case ImageVerdict::UNSUPPORTED_FORMAT:
+            setError("Unsupported image format: " + std::filesystem::path(path).extension().string() +
+                     " content is not PNG, JPG or BMP. File: " + path);
+            return false;
+        case ImageVerdict::READ_FAILED:
+        default:
+            setError("Error reading image file: " + path + " (" +
+                     std::system_category().message(check.systemError) + ")");
+            return false;
     }
-    
-    LOG_INFO("Image file validation passed: " + path + " (format: " + ext + ", size: " + std::to_string(fileSize) + " bytes)");
-    return true;
 }
 
 bool CreoComBridge::isFormatSupported(const std::string& extension) {
@@ -570,9 +645,11 @@ std::vector<std::string> CreoComBridge::getSupportedFormats() {
 bool CreoComBridge::insertImage(const std::string& imagePath,
                                  double x, double y,
                                  double width, double height) {
-    LOG_INFO("Inserting image: " + imagePath);
-    LOG_INFO("Position: (" + std::to_string(x) + ", " + std::to_string(y) + ")");
-    LOG_INFO("Size: " + std::to_string(width) + " x " + std::to_string(height));
+    TRACE_SCOPE_DETAIL("com", "insert_image", imagePath);
+    STATS_STAGE(StatsStage::COM_INSERT);
+    BLOG_INFO("Inserting image: {}", imagePath);
+    BLOG_INFO("Position: ({}, {})", x, y);
+    BLOG_INFO("Size: {} x {}", width, height);
     
     // Parameter validation
     if (imagePath.empty()) {
@@ -597,6 +674,29 @@ bool CreoComBridge::insertImage(const std::string& imagePath,
         return false;
     }
     
+    // A broken link costs one check here instead of a failed attempt
+    m_lastHResult = S_OK;
+    if (!m_link->acquire()) {
+        if (m_lastHResult == S_OK) {
+            // Rejected by the breaker (a failed connect has set its own error)
+            setError(std::string("Creo COM link unavailable (circuit ") +
+                     circuitStateName(m_link->state()) + ")");
+        }
+        return false;
+    }
+    
+    bool inserted = insertIntoCurrentDrawing(imagePath, x, y, width, height);
+    if (!inserted && isLinkFailure(m_lastHResult)) {
+        m_link->reportFailure();
+    } else {
+        m_link->reportSuccess();
+    }
+    return inserted;
+}
+
+bool CreoComBridge::insertIntoCurrentDrawing(const std::string& imagePath,
+                                             double x, double y,
+                                             double width, double height) {
     // Get current drawing
     IpfcDrawingPtr pDrawing = getCurrentDrawing();
     if (!pDrawing) {
@@ -604,9 +704,8 @@ bool CreoComBridge::insertImage(const std::string& imagePath,
         return false;
     }
     
-    // Convert image path to wide string for COM
-    std::wstring wImagePath = StringUtils::utf8ToWstring(imagePath);
-    BSTR bstrImagePath = StringUtils::stringToBSTR(wImagePath);
+    // Repeated paths reuse their BSTR (owned by the cache, not freed here)
+    BSTR bstrImagePath = internPath(imagePath);
     
     if (!bstrImagePath) {
         setError("Failed to convert image path to BSTR");
@@ -625,15 +724,12 @@ bool CreoComBridge::insertImage(const std::string& imagePath,
     double x2 = x + actualWidth;
     double y2 = y + actualHeight;
     
-    LOG_INFO("Creating image outline: (" + std::to_string(x1) + ", " + std::to_string(y1) + 
-             ") to (" + std::to_string(x2) + ", " + std::to_string(y2) + ")");
+    BLOG_INFO("Creating image outline: ({}, {}) to ({}, {})", x1, y1, x2, y2);
     
-    // Create outline using factory
-    IpfcOutline2D* pOutline = nullptr;
-    HRESULT hr = CreoVBAPIFactory::CreateOutline2D(x1, y1, x2, y2, &pOutline);
+    // Reuse the session's outline object
+    HRESULT hr = prepareOutline(x1, y1, x2, y2);
     
-    if (FAILED(hr) || !pOutline) {
-        SysFreeString(bstrImagePath);
+    if (FAILED(hr)) {
         if (hr == E_NOTIMPL) {
             setError(hr, "CreateOutline2D not implemented - Creo type library required");
         } else {
@@ -642,15 +738,12 @@ bool CreoComBridge::insertImage(const std::string& imagePath,
         return false;
     }
     
-    IpfcOutline2DPtr outlinePtr;
-    outlinePtr.Attach(pOutline);
-    
     // Call CreateDraftingImage on the drawing
     IpfcDraftingImage* pImage = nullptr;
-    hr = pDrawing->CreateDraftingImage(bstrImagePath, pOutline, &pImage);
-    
-    // Free the BSTR
-    SysFreeString(bstrImagePath);
+    {
+        TRACE_SCOPE("com", "create_drafting_image");
+        hr = pDrawing->CreateDraftingImage(bstrImagePath, m_pOutline, &pImage);
+    }
     
     if (FAILED(hr)) {
         setError(hr, "Failed to create drafting image in drawing");
@@ -667,30 +760,40 @@ bool CreoComBridge::insertImage(const std::string& imagePath,
     
     LOG_INFO("Image inserted successfully");
     
-    // Refresh the view
-    if (m_pSession) {
-        IpfcWindow* pWindow = nullptr;
-        hr = m_pSession->get_CurrentWindow(&pWindow);
-        
-        if (SUCCEEDED(hr) && pWindow) {
-            hr = pWindow->Repaint();
-            if (FAILED(hr)) {
-                LOG_WARNING("Failed to repaint window after image insertion (HRESULT: 0x" + 
-                           std::to_string(hr) + ")");
-                // Don't fail the operation just because repaint failed
-            } else {
-                LOG_INFO("Window repainted successfully");
-            }
-            pWindow->Release();
-        } else {
-            LOG_WARNING("Could not get current window for repaint");
-        }
+    // Refresh the view, or leave it to the enclosing edit transaction
+    m_repaint.modified();
+    
+    return true;
+}
+
+bool CreoComBridge::repaintWindow() {
+    if (!m_pSession) {
+        return false;
     }
     
+    TRACE_SCOPE("com", "repaint");
+    IpfcWindow* pWindow = nullptr;
+    HRESULT hr = m_pSession->get_CurrentWindow(&pWindow);
+    if (FAILED(hr) || !pWindow) {
+        LOG_WARNING("Could not get current window for repaint");
+        return false;
+    }
+    
+    IpfcWindowPtr windowPtr;
+    windowPtr.Attach(pWindow);
+    hr = windowPtr->Repaint();
+    if (FAILED(hr)) {
+        LOG_WARNING("Failed to repaint window after image insertion (HRESULT: 0x" + 
+                   std::to_string(hr) + ")");
+        // Don't fail the operation just because repaint failed
+        return false;
+    }
+    LOG_INFO("Window repainted successfully");
     return true;
 }
 
 BatchInsertResult CreoComBridge::batchInsertImages(const std::vector<BatchImageInfo>& images) {
+    TRACE_SCOPE("com", "batch_insert");
     BatchInsertResult result;
     result.totalCount = static_cast<int>(images.size());
     result.successCount = 0;
@@ -702,6 +805,8 @@ BatchInsertResult CreoComBridge::batchInsertImages(const std::vector<BatchImageI
     
     LOG_INFO("Batch inserting " + std::to_string(images.size()) + " images");
     
+    // One repaint for the whole batch
+    DrawingEditTransaction edit(m_repaint);
     for (const auto& img : images) {
         if (insertImage(img.imagePath, img.x, img.y, img.width, img.height)) {
             result.successCount++;
@@ -712,6 +817,8 @@ BatchInsertResult CreoComBridge::batchInsertImages(const std::vector<BatchImageI
         }
     }
     
+    edit.commit();
+    
     LOG_INFO("Batch insert complete: " + std::to_string(result.successCount) + 
              " succeeded, " + std::to_string(result.failCount) + " failed");
     
@@ -720,6 +827,7 @@ BatchInsertResult CreoComBridge::batchInsertImages(const std::vector<BatchImageI
 
 BatchInsertResult CreoComBridge::batchInsertImagesGrid(const std::vector<std::string>& imagePaths,
                                                         const GridLayoutParams& params) {
+    TRACE_SCOPE("com", "batch_insert_grid");
     BatchInsertResult result;
     result.totalCount = static_cast<int>(imagePaths.size());
     result.successCount = 0;
@@ -744,6 +852,8 @@ BatchInsertResult CreoComBridge::batchInsertImagesGrid(const std::vector<std::st
     LOG_INFO("Image size: " + std::to_string(params.width) + " x " + 
              std::to_string(params.height) + ", spacing: " + std::to_string(params.spacing));
     
+    // One repaint for the whole batch
+    DrawingEditTransaction edit(m_repaint);
     for (size_t i = 0; i < imagePaths.size(); ++i) {
         // Calculate grid position for this image
         GridPosition pos = calculateGridPosition(
@@ -756,8 +866,7 @@ BatchInsertResult CreoComBridge::batchInsertImagesGrid(const std::vector<std::st
             params.height
         );
         
-        LOG_INFO("Image " + std::to_string(i) + " position: (" + 
-                 std::to_string(pos.x) + ", " + std::to_string(pos.y) + ")");
+        BLOG_INFO("Image {} position: ({}, {})", i, pos.x, pos.y);
         
         // Insert the image at calculated position
         if (insertImage(imagePaths[i], pos.x, pos.y, params.width, params.height)) {
@@ -770,6 +879,8 @@ BatchInsertResult CreoComBridge::batchInsertImagesGrid(const std::vector<std::st
         }
     }
     
+    edit.commit();
+    
     LOG_INFO("Grid batch insert complete: " + std::to_string(result.successCount) + 
              " succeeded, " + std::to_string(result.failCount) + " failed");
     
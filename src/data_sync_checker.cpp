@@ -6,7 +6,12 @@
  */
 
 #include "data_sync_checker.h"
+#include "payload_index.h"
+#include "barcode_inventory.h"
 #include "logger.h"
+#include "trace.h"
+#include "plugin_stats.h"
+#include "thread_pool.h"
 #include <algorithm>
 
 namespace creo_barcode {
@@ -16,12 +21,39 @@ DataSyncChecker::DataSyncChecker()
     , defaultWarningCallback_(nullptr) {
 }
 
-void DataSyncChecker::setError(ErrorCode code, const std::string& message, const std::string& details) {
-    lastError_ = ErrorInfo(code, message, details);
+void DataSyncChecker::setError(ErrorCode code, const char* message, std::string_view details) {
+    lastError_ = Error(code, message, details);
 }
 
 SyncCheckResult DataSyncChecker::checkSync(const std::string& currentPartName, 
                                            const BarcodeInstance& barcodeInstance) {
+    TRACE_SCOPE("sync", "check");
+    STATS_STAGE(StatsStage::SYNC_CHECK);
+    recordInIndex(barcodeInstance);
+    
+    SyncCheckResult result = evaluateSync(currentPartName, barcodeInstance);
+    
+    if (inventory_) {
+        std::lock_guard<std::mutex> lock(inventoryMutex_);
+        inventory_->upsert(barcodeInstance, result);
+    }
+    
+    return result;
+}
+
+std::future<Result<SyncCheckResult>> DataSyncChecker::checkSyncAsync(const std::string& currentPartName,
+                                                                     const BarcodeInstance& barcodeInstance) {
+    return ThreadPool::shared().async([this, currentPartName, barcodeInstance]() -> Result<SyncCheckResult> {
+        try {
+            return checkSync(currentPartName, barcodeInstance);
+        } catch (const std::exception& e) {
+            return Result<SyncCheckResult>::failure(ErrorCode::SYNC_CHECK_FAILED, "Sync check failed", e.what());
+        }
+    });
+}
+
+SyncCheckResult DataSyncChecker::evaluateSync(const std::string& currentPartName,
+                                              const BarcodeInstance& barcodeInstance) {
     SyncCheckResult result;
     result.currentPartName = currentPartName;
     result.barcodeData = barcodeInstance.decodedData;
@@ -63,6 +95,7 @@ SyncCheckResult DataSyncChecker::checkSync(const std::string& currentPartName,
 SyncCheckResult DataSyncChecker::checkSyncFromImage(const std::string& currentPartName,
                                                     const std::string& barcodePath,
                                                     BarcodeGenerator& generator) {
+    TRACE_SCOPE_DETAIL("sync", "check_image", barcodePath);
     SyncCheckResult result;
     result.currentPartName = currentPartName;
     
@@ -71,8 +104,8 @@ SyncCheckResult DataSyncChecker::checkSyncFromImage(const std::string& currentPa
     
     if (!decodedData.has_value()) {
         result.status = SyncStatus::DECODE_ERROR;
-        result.message = "Failed to decode barcode from image";
-        setError(ErrorCode::DECODE_FAILED, result.message, barcodePath);
+        setError(ErrorCode::DECODE_FAILED, "Failed to decode barcode from image", barcodePath);
+        result.message = lastError_.message();
         LOG_ERROR("Failed to decode barcode from: " + barcodePath);
         return result;
     }
@@ -190,6 +223,23 @@ std::string DataSyncChecker::getStatusMessage(SyncStatus status) {
     }
 }
 
+void DataSyncChecker::recordInIndex(const BarcodeInstance& instance) {
+    if (!payloadIndex_ || instance.drawingPath.empty()) {
+        return;
+    }
+    
+    // Index under the payload actually stored in the barcode
+    const std::string& payload = instance.encodedData.empty() ? instance.decodedData
+                                                              : instance.encodedData;
+    if (payload.empty()) {
+        return;
+    }
+    
+    payloadIndex_->add(payload, BarcodeLocation(instance.drawingPath, instance.sheet,
+                                                instance.posX, instance.posY,
+                                                instance.imagePath));
+}
+
 void DataSyncChecker::setUpdateConfirmCallback(UpdateConfirmCallback callback) {
     defaultUpdateCallback_ = callback;
 }
@@ -0,0 +1,360 @@
+/**
+ * @file directory_scanner.cpp
+ * @brief Implementation of parallel recursive file discovery
+ */
+
+#include "directory_scanner.h"
+#include "binary_log.h"
+#include "trace.h"
+#include <algorithm>
+#include <cctype>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#include "utf_transcode.h"
+#else
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace creo_barcode {
+
+namespace {
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+// Iterative wildcard match with single-star backtracking: O(n * m) worst case
+bool globMatch(const std::string& pattern, const std::string& name) {
+    size_t p = 0;
+    size_t n = 0;
+    size_t starPattern = std::string::npos;
+    size_t starName = 0;
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            ++p;
+            ++n;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            starPattern = p++;
+            starName = n;
+        } else if (starPattern != std::string::npos) {
+            p = starPattern + 1;
+            n = ++starName;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        ++p;
+    }
+    return p == pattern.size();
+}
+
+struct Listing {
+    std::vector<std::string> directories;
+    std::vector<std::string> files;     // Names only
+};
+
+#ifdef _WIN32
+
+constexpr char SEPARATOR = '\\';
+
+bool listDirectory(const std::string& directory, Listing& listing) {
+    std::wstring pattern;
+    utf::utf8ToWide(directory + "\\*", pattern);
+    WIN32_FIND_DATAW data;
+    // Large fetch cuts round trips to network shares
+    HANDLE find = FindFirstFileExW(pattern.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch,
+                                   nullptr, FIND_FIRST_EX_LARGE_FETCH);
+    if (find == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    std::string name;
+    do {
+        utf::wideToUtf8(data.cFileName, name);
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            // Junctions and directory symlinks are not followed
+            if (name != "." && name != ".." && !(data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)) {
+                listing.directories.push_back(name);
+            }
+        } else {
+            listing.files.push_back(name);
+        }
+    } while (FindNextFileW(find, &data));
+    FindClose(find);
+    return true;
+}
+
+#else
+
+constexpr char SEPARATOR = '/';
+
+bool listDirectory(const std::string& directory, Listing& listing) {
+    DIR* dir = ::opendir(directory.c_str());
+    if (!dir) {
+        return false;
+    }
+    int dirFd = ::dirfd(dir);
+    while (struct dirent* entry = ::readdir(dir)) {
+        const char* name = entry->d_name;
+        unsigned char type = entry->d_type;
+        if (type == DT_UNKNOWN) {
+            // Some file systems do not fill d_type; ask without following links
+            struct stat st;
+            if (::fstatat(dirFd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                continue;
+            }
+            type = S_ISDIR(st.st_mode) ? DT_DIR : S_ISREG(st.st_mode) ? DT_REG : DT_LNK;
+        }
+        if (type == DT_DIR) {
+            if (std::strcmp(name, ".") != 0 && std::strcmp(name, "..") != 0) {
+                listing.directories.emplace_back(name);
+            }
+        } else if (type == DT_REG) {
+            listing.files.emplace_back(name);
+        }
+    }
+    ::closedir(dir);
+    return true;
+}
+
+#endif
+
+std::string joinPath(const std::string& directory, const std::string& name) {
+    std::string path;
+    path.reserve(directory.size() + 1 + name.size());
+    path = directory;
+    if (path.empty() || (path.back() != '/' && path.back() != '\\')) {
+        path += SEPARATOR;
+    }
+    path += name;
+    return path;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// NameFilter
+// ============================================================================
+
+NameFilter::NameFilter(const std::vector<std::string>& patterns) {
+    for (const auto& raw : patterns) {
+        if (raw.empty()) {
+            continue;
+        }
+        std::string pattern = toLower(raw);
+        // matches() looks up the text after the last dot, so only single-dot
+        // patterns can use the set; "*.drw.1" stays a glob
+        bool plainSuffix = pattern.size() > 2 && pattern[0] == '*' && pattern[1] == '.' &&
+                           pattern.find_first_of("*?.", 2) == std::string::npos;
+        if (plainSuffix) {
+            suffixes_.insert(pattern.substr(1));
+        } else {
+            globs_.push_back(pattern);
+        }
+    }
+}
+
+bool NameFilter::matches(const std::string& name) const {
+    if (matchesAll()) {
+        return true;
+    }
+    std::string lower = toLower(name);
+    if (!suffixes_.empty()) {
+        size_t dot = lower.rfind('.');
+        if (dot != std::string::npos && dot > 0 && suffixes_.count(lower.substr(dot)) != 0) {
+            return true;
+        }
+    }
+    for (const auto& glob : globs_) {
+        if (globMatch(glob, lower)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// DirectoryScanner
+// ============================================================================
+
+DirectoryScanner::DirectoryScanner(ScanOptions options)
+    : options_(std::move(options))
+    , filter_(options_.patterns) {
+    options_.maxThreads = std::max<size_t>(options_.maxThreads, 1);
+    options_.maxPerShare = std::max<size_t>(options_.maxPerShare, 1);
+}
+
+std::string DirectoryScanner::shareOf(const std::string& path) {
+    bool unc = path.size() > 2 && (path[0] == '\\' || path[0] == '/') && (path[1] == '\\' || path[1] == '/');
+    if (unc) {
+        // \\server\share\... -> \\server\share
+        size_t server = path.find_first_of("\\/", 2);
+        size_t share = server == std::string::npos ? std::string::npos : path.find_first_of("\\/", server + 1);
+        std::string key = path.substr(0, share);
+        std::replace(key.begin(), key.end(), '/', '\\');
+        return toLower(key);
+    }
+    if (path.size() >= 2 && path[1] == ':' && std::isalpha(static_cast<unsigned char>(path[0]))) {
+        return toLower(path.substr(0, 2));
+    }
+#ifndef _WIN32
+    struct stat st;
+    if (::stat(path.c_str(), &st) == 0) {
+        return "dev:" + std::to_string(static_cast<unsigned long long>(st.st_dev));
+    }
+#endif
+    return std::string();
+}
+
+void DirectoryScanner::cancel() {
+    cancelled_ = true;
+    std::lock_guard<std::mutex> lock(mutex_);
+    changed_.notify_all();
+}
+
+ScanStats DirectoryScanner::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+DirectoryScanner::Share* DirectoryScanner::nextShareLocked() {
+    // Least busy share first, so one deep share does not starve the others
+    Share* best = nullptr;
+    for (auto& share : shares_) {
+        if (share.pending.empty() || share.active >= options_.maxPerShare) {
+            continue;
+        }
+        if (!best || share.active < best->active) {
+            best = &share;
+        }
+    }
+    return best;
+}
+
+bool DirectoryScanner::scan(const std::vector<std::string>& roots, const FileSink& sink) {
+    TRACE_SCOPE("scan", "scan");
+    auto started = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shares_.clear();
+        active_ = 0;
+        stats_ = ScanStats();
+        lastError_ = Error();
+        for (const auto& root : roots) {
+            if (root.empty()) {
+                continue;
+            }
+            std::string key = shareOf(root);
+            auto it = std::find_if(shares_.begin(), shares_.end(),
+                                   [&](const Share& share) { return share.key == key; });
+            if (it == shares_.end()) {
+                shares_.push_back(Share{key, {}, 0});
+                it = shares_.end() - 1;
+            }
+            it->pending.emplace_back(root, 0);
+        }
+        stats_.shares = shares_.size();
+    }
+    cancelled_ = false;
+
+    // More threads than the shares can use would only sit idle
+    size_t threadCount = std::min(options_.maxThreads, std::max<size_t>(shares_.size(), 1) * options_.maxPerShare);
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&DirectoryScanner::worker, this, std::cref(sink));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.threads = threadCount;
+    stats_.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - started);
+    BLOG_INFO("Scanned {} directories on {} shares: {} files matched, {} unreadable, {} ms",
+              stats_.directories, stats_.shares, stats_.filesMatched, stats_.unreadable,
+              stats_.elapsed.count());
+    if (stats_.directories == 0 && !roots.empty()) {
+        lastError_ = Error(ErrorCode::FILE_NOT_FOUND, "No scan root could be listed");
+        return false;
+    }
+    return true;
+}
+
+void DirectoryScanner::worker(const FileSink& sink) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        Share* share = nullptr;
+        changed_.wait(lock, [&]() {
+            if (cancelled_) {
+                return true;
+            }
+            share = nextShareLocked();
+            return share != nullptr || active_ == 0;
+        });
+        if (!share) {
+            // Cancelled, or nothing pending and nobody left to add more
+            changed_.notify_all();
+            return;
+        }
+
+        // Depth first keeps the pending list short on wide trees
+        std::pair<std::string, size_t> next = std::move(share->pending.back());
+        share->pending.pop_back();
+        ++share->active;
+        ++active_;
+        lock.unlock();
+
+        Listing listing;
+        bool listed;
+        {
+            TRACE_SCOPE_DETAIL("scan", "list", next.first);
+            listed = listDirectory(next.first, listing);
+        }
+        std::vector<std::string> matched;
+        uint64_t skipped = 0;
+        for (const auto& name : listing.files) {
+            if (filter_.matches(name)) {
+                matched.push_back(joinPath(next.first, name));
+            } else {
+                ++skipped;
+            }
+        }
+        // Only paths handed to the sink count as matched
+        size_t matchedCount = 0;
+        if (!matched.empty() && !cancelled_) {
+            matchedCount = matched.size();
+            sink(std::move(matched));
+        }
+
+        lock.lock();
+        // shares_ is not resized during a scan, so share is still valid
+        Share& owner = *share;
+        if (next.second < options_.maxDepth) {
+            for (const auto& name : listing.directories) {
+                owner.pending.emplace_back(joinPath(next.first, name), next.second + 1);
+            }
+        }
+        --owner.active;
+        --active_;
+        if (listed) {
+            ++stats_.directories;
+        } else {
+            ++stats_.unreadable;
+        }
+        stats_.filesMatched += matchedCount;
+        stats_.filesSkipped += skipped;
+        changed_.notify_all();
+    }
+}
+
+} // namespace creo_barcode
@@ -0,0 +1,658 @@
+/**
+ * @file directory_watcher.cpp
+ * @brief Implementation of the directory watcher and image inventory
+ */
+
+#include "directory_watcher.h"
+#include "binary_log.h"
+#include "trace.h"
+#include <algorithm>
+#include <cctype>
+
+#ifdef _WIN32
+#include <windows.h>
+#include "utf_transcode.h"
+#else
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <cerrno>
+#include <cstring>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#endif
+#endif
+
+namespace creo_barcode {
+
+// ============================================================================
+// ImageInventory
+// ============================================================================
+
+bool ImageInventory::find(const std::string& path, ImageFileInfo& info) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = files_.find(path);
+    if (it == files_.end()) {
+        return false;
+    }
+    info = it->second;
+    return true;
+}
+
+bool ImageInventory::contains(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return files_.count(path) != 0;
+}
+
+size_t ImageInventory::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return files_.size();
+}
+
+void ImageInventory::set(const std::string& path, const ImageFileInfo& info) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_[path] = info;
+}
+
+bool ImageInventory::erase(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return files_.erase(path) != 0;
+}
+
+void ImageInventory::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_.clear();
+}
+
+std::unordered_map<std::string, ImageFileInfo> ImageInventory::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return files_;
+}
+
+void ImageInventory::reserve(size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_.reserve(count);
+}
+
+// ============================================================================
+// Platform helpers
+// ============================================================================
+
+namespace {
+
+using FileMap = std::unordered_map<std::string, ImageFileInfo>;
+
+// A batch is delivered at the latest this many settle intervals after its
+// first event, so a directory that never goes quiet still gets updates
+constexpr int MAX_SETTLE_INTERVALS = 20;
+
+enum class WaitResult {
+    EVENTS,
+    TIMEOUT,
+    STOPPED,
+    FAILED
+};
+
+bool sameInfo(const ImageFileInfo& a, const ImageFileInfo& b) {
+    return a.size == b.size && a.modified == b.modified;
+}
+
+#ifdef _WIN32
+
+constexpr char SEPARATOR = '\\';
+
+int64_t fileTimeTicks(const FILETIME& time) {
+    return static_cast<int64_t>((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime);
+}
+
+bool statImage(const std::string& path, ImageFileInfo& info) {
+    std::wstring widePath;
+    utf::utf8ToWide(path, widePath);
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExW(widePath.c_str(), GetFileExInfoStandard, &data) ||
+        (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+        return false;
+    }
+    info.size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+    info.modified = fileTimeTicks(data.ftLastWriteTime);
+    return true;
+}
+
+#else
+
+constexpr char SEPARATOR = '/';
+
+void fillInfo(const struct stat& st, ImageFileInfo& info) {
+    info.size = static_cast<uint64_t>(st.st_size);
+#ifdef __APPLE__
+    info.modified = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    info.modified = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+}
+
+bool statImage(const std::string& path, ImageFileInfo& info) {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        return false;
+    }
+    fillInfo(st, info);
+    return true;
+}
+
+#endif
+
+// Lists every image in the directory into files, keyed by prefix + name
+bool listImages(const std::string& directory, const std::string& prefix, FileMap& files) {
+#ifdef _WIN32
+    std::wstring pattern;
+    utf::utf8ToWide(directory + "\\*", pattern);
+    WIN32_FIND_DATAW data;
+    // The listing already carries size and write time: no per-file stat
+    HANDLE find = FindFirstFileExW(pattern.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch,
+                                   nullptr, FIND_FIRST_EX_LARGE_FETCH);
+    if (find == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    std::string name;
+    do {
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            continue;
+        }
+        utf::wideToUtf8(data.cFileName, name);
+        if (!DirectoryWatcher::isImageName(name)) {
+            continue;
+        }
+        ImageFileInfo info;
+        info.size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+        info.modified = fileTimeTicks(data.ftLastWriteTime);
+        files.emplace(prefix + name, info);
+    } while (FindNextFileW(find, &data));
+    // A listing cut short (e.g. share disconnected) is not a complete one
+    bool complete = GetLastError() == ERROR_NO_MORE_FILES;
+    FindClose(find);
+    return complete;
+#else
+    DIR* dir = ::opendir(directory.c_str());
+    if (!dir) {
+        return false;
+    }
+    int dirFd = ::dirfd(dir);
+    for (;;) {
+        // readdir returns nullptr both at the end and on error
+        errno = 0;
+        struct dirent* entry = ::readdir(dir);
+        if (!entry) {
+            break;
+        }
+        if (entry->d_type == DT_DIR || !DirectoryWatcher::isImageName(entry->d_name)) {
+            continue;
+        }
+        struct stat st;
+        if (::fstatat(dirFd, entry->d_name, &st, 0) != 0 || !S_ISREG(st.st_mode)) {
+            continue;
+        }
+        ImageFileInfo info;
+        fillInfo(st, info);
+        files.emplace(prefix + entry->d_name, info);
+    }
+    bool complete = errno == 0;
+    ::closedir(dir);
+    return complete;
+#endif
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Backends
+// ============================================================================
+
+#if defined(_WIN32)
+
+struct DirectoryWatcher::Backend {
+    static constexpr DWORD BUFFER_SIZE = 64 * 1024;     // Network shares reject larger buffers
+
+    HANDLE directory = INVALID_HANDLE_VALUE;
+    HANDLE stopEvent = nullptr;
+    HANDLE ioEvent = nullptr;
+    OVERLAPPED overlapped{};
+    bool pending = false;
+    alignas(DWORD) BYTE buffer[BUFFER_SIZE];
+
+    ~Backend() {
+        if (pending) {
+            CancelIoEx(directory, &overlapped);
+            DWORD ignored = 0;
+            GetOverlappedResult(directory, &overlapped, &ignored, TRUE);
+        }
+        if (directory != INVALID_HANDLE_VALUE) CloseHandle(directory);
+        if (ioEvent) CloseHandle(ioEvent);
+        if (stopEvent) CloseHandle(stopEvent);
+    }
+
+    bool open(const std::string& path, Error& error) {
+        std::wstring widePath;
+        utf::utf8ToWide(path, widePath);
+        directory = CreateFileW(widePath.c_str(), FILE_LIST_DIRECTORY,
+                                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (directory == INVALID_HANDLE_VALUE) {
+            error = Error::formatted(ErrorCode::FILE_NOT_FOUND, "Cannot watch directory",
+                                     "error %lu", GetLastError());
+            return false;
+        }
+        stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        ioEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        overlapped.hEvent = ioEvent;
+        if (!stopEvent || !ioEvent || !issue()) {
+            error = Error::formatted(ErrorCode::FILE_NOT_FOUND, "Cannot watch directory",
+                                     "error %lu", GetLastError());
+            return false;
+        }
+        return true;
+    }
+
+    bool issue() {
+        ResetEvent(ioEvent);
+        pending = ReadDirectoryChangesW(directory, buffer, BUFFER_SIZE, FALSE,
+                                        FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE |
+                                        FILE_NOTIFY_CHANGE_LAST_WRITE,
+                                        nullptr, &overlapped, nullptr) != FALSE;
+        return pending;
+    }
+
+    void signalStop() {
+        SetEvent(stopEvent);
+    }
+
+    WaitResult wait(std::chrono::milliseconds timeout, std::unordered_set<std::string>& names,
+                    bool& overflow, size_t& reported) {
+        HANDLE handles[] = {stopEvent, ioEvent};
+        DWORD waitMs = timeout.count() < 0 ? INFINITE : static_cast<DWORD>(timeout.count());
+        DWORD signaled = WaitForMultipleObjects(2, handles, FALSE, waitMs);
+        if (signaled == WAIT_TIMEOUT) {
+            return WaitResult::TIMEOUT;
+        }
+        if (signaled != WAIT_OBJECT_0 + 1) {
+            return WaitResult::STOPPED;
+        }
+
+        DWORD bytes = 0;
+        pending = false;
+        if (!GetOverlappedResult(directory, &overlapped, &bytes, FALSE)) {
+            if (GetLastError() != ERROR_NOTIFY_ENUM_DIR) {
+                // The directory went away or the handle broke
+                overflow = true;
+                return WaitResult::FAILED;
+            }
+            bytes = 0;
+        }
+        if (bytes == 0) {
+            // The buffer overflowed and the system dropped the changes
+            overflow = true;
+        } else {
+            std::string name;
+            const BYTE* cursor = buffer;
+            for (;;) {
+                const auto* record = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(cursor);
+                utf::wideToUtf8(std::wstring_view(record->FileName, record->FileNameLength / sizeof(WCHAR)), name);
+                ++reported;
+                if (DirectoryWatcher::isImageName(name)) {
+                    names.insert(name);
+                }
+                if (record->NextEntryOffset == 0) {
+                    break;
+                }
+                cursor += record->NextEntryOffset;
+            }
+        }
+        // Re-arm before processing so nothing is missed meanwhile
+        if (!issue()) {
+            overflow = true;
+            return WaitResult::FAILED;
+        }
+        return WaitResult::EVENTS;
+    }
+};
+
+#elif defined(__linux__)
+
+struct DirectoryWatcher::Backend {
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    int inotifyFd = -1;
+    int stopFd = -1;
+    alignas(struct inotify_event) char buffer[BUFFER_SIZE];
+
+    ~Backend() {
+        if (inotifyFd >= 0) ::close(inotifyFd);
+        if (stopFd >= 0) ::close(stopFd);
+    }
+
+    bool open(const std::string& path, Error& error) {
+        inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (inotifyFd < 0 || stopFd < 0) {
+            error = Error::formatted(ErrorCode::FILE_NOT_FOUND, "Cannot watch directory",
+                                     "%s", std::strerror(errno));
+            return false;
+        }
+        // IN_CLOSE_WRITE rather than IN_MODIFY: one event per completed write
+        uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE |
+                        IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+        if (inotify_add_watch(inotifyFd, path.c_str(), mask) < 0) {
+            error = Error::formatted(ErrorCode::FILE_NOT_FOUND, "Cannot watch directory",
+                                     "%s", std::strerror(errno));
+            return false;
+        }
+        return true;
+    }
+
+    void signalStop() {
+        uint64_t one = 1;
+        ssize_t written = ::write(stopFd, &one, sizeof(one));
+        (void)written;
+    }
+
+    WaitResult wait(std::chrono::milliseconds timeout, std::unordered_set<std::string>& names,
+                    bool& overflow, size_t& reported) {
+        struct pollfd fds[2] = {{stopFd, POLLIN, 0}, {inotifyFd, POLLIN, 0}};
+        int ready = ::poll(fds, 2, timeout.count() < 0 ? -1 : static_cast<int>(timeout.count()));
+        if (ready == 0) {
+            return WaitResult::TIMEOUT;
+        }
+        if (ready < 0) {
+            return errno == EINTR ? WaitResult::TIMEOUT : WaitResult::FAILED;
+        }
+        if (fds[0].revents) {
+            return WaitResult::STOPPED;
+        }
+
+        bool gone = false;
+        for (;;) {
+            ssize_t length = ::read(inotifyFd, buffer, sizeof(buffer));
+            if (length <= 0) {
+                break;
+            }
+            for (char* cursor = buffer; cursor < buffer + length;) {
+                const auto* event = reinterpret_cast<const struct inotify_event*>(cursor);
+                cursor += sizeof(struct inotify_event) + event->len;
+                if (event->mask & IN_Q_OVERFLOW) {
+                    overflow = true;
+                    continue;
+                }
+                if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                    gone = true;
+                    continue;
+                }
+                if (event->len == 0 || (event->mask & IN_ISDIR)) {
+                    continue;
+                }
+                ++reported;
+                if (DirectoryWatcher::isImageName(event->name)) {
+                    names.insert(event->name);
+                }
+            }
+        }
+        if (gone) {
+            overflow = true;
+            return WaitResult::FAILED;
+        }
+        return WaitResult::EVENTS;
+    }
+};
+
+#else
+
+// No native notifications: start() fails and callers fall back to scanning
+struct DirectoryWatcher::Backend {
+    bool open(const std::string&, Error& error) {
+        error = Error(ErrorCode::FILE_NOT_FOUND, "Directory watching is not supported on this platform");
+        return false;
+    }
+
+    void signalStop() {}
+
+    WaitResult wait(std::chrono::milliseconds, std::unordered_set<std::string>&, bool&, size_t&) {
+        return WaitResult::STOPPED;
+    }
+};
+
+#endif
+
+// ============================================================================
+// DirectoryWatcher
+// ============================================================================
+
+DirectoryWatcher::DirectoryWatcher() = default;
+
+DirectoryWatcher::~DirectoryWatcher() {
+    stop();
+}
+
+bool DirectoryWatcher::isSupported() {
+#if defined(_WIN32) || defined(__linux__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool DirectoryWatcher::isImageName(const std::string& name) {
+    size_t dot = name.rfind('.');
+    if (dot == std::string::npos || dot == 0) {
+        return false;
+    }
+    std::string extension = name.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == "png" || extension == "jpg" || extension == "jpeg" || extension == "bmp";
+}
+
+std::string DirectoryWatcher::pathFor(const std::string& name) const {
+    std::string path = directory_;
+    path += SEPARATOR;
+    path += name;
+    return path;
+}
+
+bool DirectoryWatcher::start(const std::string& directory, ChangeCallback onChanges,
+                             std::chrono::milliseconds settle) {
+    stop();
+    lastError_ = Error();
+
+    directory_ = directory;
+    while (directory_.size() > 1 && (directory_.back() == '/' || directory_.back() == '\\')) {
+        directory_.pop_back();
+    }
+    onChanges_ = std::move(onChanges);
+    settle_ = settle;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_ = DirectoryWatcherStats();
+    }
+
+    // Watch before listing so changes made during the listing are not lost;
+    // they are reported again afterwards and compare equal to the listing
+    backend_ = std::make_unique<Backend>();
+    if (!backend_->open(directory_, lastError_)) {
+        backend_.reset();
+        BLOG_WARNING("Not watching {}: {} ({})", directory_, lastError_.message(), lastError_.detail());
+        return false;
+    }
+
+    inventory_.clear();
+    if (!seed()) {
+        backend_.reset();
+        lastError_ = Error(ErrorCode::FILE_NOT_FOUND, "Cannot list watched directory", directory_);
+        BLOG_WARNING("Not watching {}: the directory cannot be listed", directory_);
+        return false;
+    }
+    running_ = true;
+    thread_ = std::thread(&DirectoryWatcher::run, this);
+    BLOG_INFO("Watching {} ({} images)", directory_, inventory_.size());
+    return true;
+}
+
+void DirectoryWatcher::stop() {
+    if (backend_) {
+        backend_->signalStop();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    backend_.reset();
+    running_ = false;
+}
+
+bool DirectoryWatcher::seed() {
+    TRACE_SCOPE("watcher", "seed");
+    FileMap files;
+    std::string prefix = directory_ + SEPARATOR;
+    if (!listImages(directory_, prefix, files)) {
+        return false;
+    }
+    inventory_.reserve(files.size());
+    for (const auto& entry : files) {
+        inventory_.set(entry.first, entry.second);
+    }
+    return true;
+}
+
+void DirectoryWatcher::rescan() {
+    TRACE_SCOPE("watcher", "rescan");
+    if (directory_.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> applyLock(applyMutex_);
+    FileMap current;
+    if (!listImages(directory_, directory_ + SEPARATOR, current)) {
+        // An unreadable directory says nothing about its files: reporting
+        // them all as removed would wipe their payload index entries
+        BLOG_WARNING("Cannot list {}, keeping the inventory of {} images", directory_, inventory_.size());
+        return;
+    }
+    FileMap known = inventory_.snapshot();
+
+    std::vector<FileChange> changes;
+    for (const auto& entry : current) {
+        auto it = known.find(entry.first);
+        if (it == known.end()) {
+            changes.push_back({FileChangeKind::ADDED, entry.first});
+        } else if (!sameInfo(it->second, entry.second)) {
+            changes.push_back({FileChangeKind::MODIFIED, entry.first});
+        } else {
+            continue;
+        }
+        inventory_.set(entry.first, entry.second);
+    }
+    for (const auto& entry : known) {
+        if (current.count(entry.first) == 0) {
+            inventory_.erase(entry.first);
+            changes.push_back({FileChangeKind::REMOVED, entry.first});
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        ++stats_.rescans;
+    }
+    BLOG_INFO("Rescanned {}: {} images, {} changes", directory_, current.size(), changes.size());
+    deliver(std::move(changes));
+}
+
+void DirectoryWatcher::applyNames(const std::unordered_set<std::string>& names) {
+    std::lock_guard<std::mutex> applyLock(applyMutex_);
+    std::vector<FileChange> changes;
+    changes.reserve(names.size());
+    for (const auto& name : names) {
+        std::string path = pathFor(name);
+        ImageFileInfo known;
+        bool wasKnown = inventory_.find(path, known);
+        ImageFileInfo info;
+        if (statImage(path, info)) {
+            if (!wasKnown) {
+                changes.push_back({FileChangeKind::ADDED, path});
+            } else if (!sameInfo(known, info)) {
+                changes.push_back({FileChangeKind::MODIFIED, path});
+            } else {
+                continue;
+            }
+            inventory_.set(path, info);
+        } else if (wasKnown) {
+            inventory_.erase(path);
+            changes.push_back({FileChangeKind::REMOVED, path});
+        }
+    }
+    deliver(std::move(changes));
+}
+
+void DirectoryWatcher::deliver(std::vector<FileChange> changes) {
+    if (changes.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        ++stats_.batches;
+        stats_.changes += changes.size();
+    }
+    if (onChanges_) {
+        onChanges_(changes);
+    }
+}
+
+DirectoryWatcherStats DirectoryWatcher::stats() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return stats_;
+}
+
+void DirectoryWatcher::run() {
+    std::unordered_set<std::string> names;
+    bool overflow = false;
+    auto batchStart = std::chrono::steady_clock::now();
+    const auto maxDelay = settle_ * MAX_SETTLE_INTERVALS;
+
+    for (;;) {
+        bool batching = !names.empty() || overflow;
+        size_t reported = 0;
+        WaitResult result = backend_->wait(batching ? settle_ : std::chrono::milliseconds(-1),
+                                           names, overflow, reported);
+        if (reported > 0) {
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            stats_.events += reported;
+        }
+        if (result == WaitResult::STOPPED) {
+            break;
+        }
+        if (result == WaitResult::EVENTS) {
+            if (!batching) {
+                batchStart = std::chrono::steady_clock::now();
+            }
+            if (std::chrono::steady_clock::now() - batchStart < maxDelay) {
+                continue;
+            }
+        }
+
+        // Quiet for a settle interval (or the batch is overdue): publish it
+        if (overflow) {
+            BLOG_WARNING("Change notifications for {} were dropped, rescanning", directory_);
+            rescan();
+        } else if (!names.empty()) {
+            applyNames(names);
+        }
+        names.clear();
+        overflow = false;
+
+        if (result == WaitResult::FAILED) {
+            BLOG_WARNING("Stopped watching {}: the directory is no longer available", directory_);
+            break;
+        }
+    }
+    running_ = false;
+}
+
+} // namespace creo_barcode
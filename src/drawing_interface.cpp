@@ -15,8 +15,14 @@ static ProDrawing g_currentDrawing = nullptr;
 static ProMdl g_associatedModel = nullptr;
 static ModelType g_modelType = ModelType::PART;
 static std::string g_partName = "";
+static std::string g_drawingPath = "";
 static std::vector<PartInfo> g_assemblyParts;
 static Size g_drawingSheetSize = {297.0, 210.0}; // A4 default
+static uint64_t g_repaintCount = 0;
+static DrawingInterface::DrawingActivatedCallback g_drawingActivated;
+static DrawingInterface::ModelRenamedCallback g_modelRenamed;
+static DrawingInterface::ModelSavedCallback g_modelSaved;
+static DrawingInterface::ModelErasedCallback g_modelErased;
 
 // Test helper functions - these would be removed in production
 void setSimulatedDrawing(ProDrawing drawing) { g_currentDrawing = drawing; }
@@ -28,8 +34,12 @@ void setSimulatedSheetSize(const Size& size) { g_drawingSheetSize = size; }
 
 } // anonymous namespace
 
-void DrawingInterface::setError(ErrorCode code, const std::string& message, const std::string& details) {
-    lastError_ = ErrorInfo(code, message, details);
+DrawingInterface::DrawingInterface()
+    : repaint_([this]() { return repaintDisplay(); }) {
+}
+
+void DrawingInterface::setError(ErrorCode code, const char* message, std::string_view details) {
+    lastError_ = Error(code, message, details);
 }
 
 ProError DrawingInterface::getCurrentDrawing(ProDrawing* drawing) {
@@ -72,6 +82,18 @@ ProError DrawingInterface::getAssociatedModel(ProDrawing drawing, ProMdl* model)
     return PRO_TK_NO_ERROR;
 }
 
+ProError DrawingInterface::getDrawingPath(ProDrawing drawing, std::string& path) {
+    if (!drawing) {
+        setError(ErrorCode::NO_DRAWING_OPEN, "Invalid drawing handle");
+        return PRO_TK_E_NOT_FOUND;
+    }
+    
+    // In real implementation: ProMdlPathGet / ProMdlMdlnameGet on the drawing
+    // For simulation, we use the global state
+    path = g_drawingPath;
+    return PRO_TK_NO_ERROR;
+}
+
 ProError DrawingInterface::getPartName(ProMdl model, std::string& partName) {
     if (!model) {
         setError(ErrorCode::NO_MODEL_ASSOCIATED, "Invalid model handle");
@@ -104,8 +126,9 @@ ProError DrawingInterface::getAssemblyParts(ProMdl assembly, std::vector<PartInf
     // Check if model is actually an assembly
     ModelType type = getModelType(assembly);
     if (type != ModelType::ASSEMBLY) {
-        setError(ErrorCode::INVALID_DATA, "Model is not an assembly", 
-                 "Expected assembly type, got " + modelTypeToString(type));
+        lastError_ = Error::formatted(ErrorCode::INVALID_DATA, "Model is not an assembly",
+                                      "Expected assembly type, got %s",
+                                      modelTypeToString(type).c_str());
         return PRO_TK_E_INVALID_TYPE;
     }
     
@@ -156,6 +179,7 @@ ProError DrawingInterface::insertImage(ProDrawing drawing,
     // 3. ProDtlnoteTextSet with image reference
     // For simulation, we just validate inputs and return success
     
+    repaint_.modified();
     return PRO_TK_NO_ERROR;
 }
 
@@ -184,10 +208,43 @@ ProError DrawingInterface::createSymbolInstance(ProDrawing drawing,
     // 3. ProDtlsyminstAttachmentSet for positioning
     // For simulation, we just validate inputs and return success
     
+    repaint_.modified();
     return PRO_TK_NO_ERROR;
 }
 
 
+void DrawingInterface::setDrawingActivatedCallback(DrawingActivatedCallback callback) {
+    // In real implementation: ProNotificationSet for window activation and
+    // model retrieval, forwarding the current drawing to the callback
+    // For simulation, testing::simulateDrawingActivated() invokes it
+    g_drawingActivated = std::move(callback);
+}
+
+void DrawingInterface::setModelRenamedCallback(ModelRenamedCallback callback) {
+    // In real implementation: ProNotificationSet(PRO_MDL_RENAME_POST, ...)
+    // For simulation, testing::simulateModelRenamed() invokes it
+    g_modelRenamed = std::move(callback);
+}
+
+void DrawingInterface::setModelSavedCallback(ModelSavedCallback callback) {
+    // In real implementation: ProNotificationSet(PRO_MDL_SAVE_POST, ...)
+    // For simulation, testing::simulateModelSaved() invokes it
+    g_modelSaved = std::move(callback);
+}
+
+void DrawingInterface::setModelErasedCallback(ModelErasedCallback callback) {
+    // In real implementation: ProNotificationSet(PRO_MDL_ERASE_PRE, ...)
+    // For simulation, testing::simulateModelErased() invokes it
+    g_modelErased = std::move(callback);
+}
+
+bool DrawingInterface::repaintDisplay() {
+    // In real implementation: ProWindowCurrentGet(&window) then ProWindowRepaint(window)
+    // For simulation, we count the repaints
+    ++g_repaintCount;
+    return true;
+}
+
 ModelType DrawingInterface::getModelType(ProMdl model) {
     if (!model) {
         return ModelType::UNKNOWN;
@@ -281,13 +338,54 @@ void setSimulatedSheetSize(double width, double height) {
     g_drawingSheetSize = Size(width, height);
 }
 
+void setSimulatedDrawingPath(const std::string& path) {
+    g_drawingPath = path;
+}
+
+uint64_t simulatedRepaintCount() {
+    return g_repaintCount;
+}
+
+void simulateDrawingActivated(ProDrawing drawing) {
+    g_currentDrawing = drawing;
+    if (g_drawingActivated) {
+        g_drawingActivated(drawing);
+    }
+}
+
+void simulateModelRenamed(ProMdl model, const std::string& newName) {
+    std::string oldName = g_partName;
+    g_partName = newName;
+    if (g_modelRenamed) {
+        g_modelRenamed(model, oldName, newName);
+    }
+}
+
+void simulateModelSaved(ProMdl model) {
+    if (g_modelSaved) {
+        g_modelSaved(model);
+    }
+}
+
+void simulateModelErased(ProMdl model) {
+    if (g_modelErased) {
+        g_modelErased(model);
+    }
+}
+
 void resetSimulatedState() {
     g_currentDrawing = nullptr;
     g_associatedModel = nullptr;
     g_modelType = ModelType::PART;
     g_partName = "";
+    g_drawingPath = "";
     g_assemblyParts.clear();
     g_drawingSheetSize = Size(297.0, 210.0);
+    g_repaintCount = 0;
+    g_drawingActivated = nullptr;
+    g_modelRenamed = nullptr;
+    g_modelSaved = nullptr;
+    g_modelErased = nullptr;
 }
 
 } // namespace testing
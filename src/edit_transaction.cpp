@@ -0,0 +1,62 @@
+/**
+ * @file edit_transaction.cpp
+ * @brief Implementation of deferred display refresh for drawing edits
+ */
+
+#include "edit_transaction.h"
+#include "binary_log.h"
+
+namespace creo_barcode {
+
+RepaintBatcher::RepaintBatcher(RefreshFn refresh)
+    : refresh_(std::move(refresh)) {
+}
+
+bool RepaintBatcher::modified() {
+    ++modifications_;
+    if (depth_ > 0) {
+        pending_ = true;
+        return true;
+    }
+    return refresh();
+}
+
+void RepaintBatcher::begin() {
+    ++depth_;
+}
+
+bool RepaintBatcher::end() {
+    if (depth_ == 0) {
+        BLOG_WARNING("Unbalanced drawing edit transaction end");
+        return true;
+    }
+    if (--depth_ > 0 || !pending_) {
+        return true;
+    }
+    pending_ = false;
+    return refresh();
+}
+
+bool RepaintBatcher::refresh() {
+    ++refreshes_;
+    return refresh_ ? refresh_() : true;
+}
+
+DrawingEditTransaction::DrawingEditTransaction(RepaintBatcher& batcher)
+    : batcher_(batcher) {
+    batcher_.begin();
+}
+
+DrawingEditTransaction::~DrawingEditTransaction() {
+    commit();
+}
+
+bool DrawingEditTransaction::commit() {
+    if (!open_) {
+        return true;
+    }
+    open_ = false;
+    return batcher_.end();
+}
+
+} // namespace creo_barcode
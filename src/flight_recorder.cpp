@@ -0,0 +1,292 @@
+/**
+ * @file flight_recorder.cpp
+ * @brief Implementation of the in-memory flight recorder
+ */
+
+#include "flight_recorder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace creo_barcode {
+
+namespace {
+
+std::string formatTimestamp(uint64_t timeNanos) {
+    std::time_t seconds = static_cast<std::time_t>(timeNanos / 1000000000ULL);
+    unsigned millis = static_cast<unsigned>((timeNanos / 1000000ULL) % 1000);
+    std::tm tm_buf;
+#ifdef _WIN32
+    localtime_s(&tm_buf, &seconds);
+#else
+    localtime_r(&seconds, &tm_buf);
+#endif
+    std::ostringstream oss;
+    oss << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S") << "."
+        << std::setw(3) << std::setfill('0') << millis;
+    return oss.str();
+}
+
+// Decimal formatting without the C library, for use inside signal handlers
+size_t formatUnsigned(uint64_t value, char* out) {
+    char digits[20];
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = digits[count - 1 - i];
+    }
+    return count;
+}
+
+} // anonymous namespace
+
+FlightRecorder::FlightRecorder(size_t capacity)
+    : capacity_(capacity == 0 ? 1 : capacity),
+      slots_(new Slot[capacity == 0 ? 1 : capacity]) {
+}
+
+void FlightRecorder::record(LogLevel level, const char* message, size_t length) {
+    uint64_t sequence = next_.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    length = std::min(length, MESSAGE_CAPACITY - 1);
+
+    Slot& slot = slots_[(sequence - 1) % capacity_];
+    std::lock_guard<std::mutex> lock(slot.mutex);
+    // A writer that lapped us already holds a newer event for this slot
+    if (slot.sequence > sequence) {
+        return;
+    }
+    slot.sequence = sequence;
+    slot.timeNanos = now;
+    slot.level = level;
+    slot.length = static_cast<uint16_t>(length);
+    if (length > 0) {
+        std::memcpy(slot.message, message, length);
+    }
+    slot.message[length] = '\0';
+}
+
+std::vector<FlightRecord> FlightRecorder::snapshot(uint64_t afterSequence) const {
+    std::vector<FlightRecord> records;
+    for (size_t i = 0; i < capacity_; ++i) {
+        Slot& slot = slots_[i];
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        if (slot.sequence == 0 || slot.sequence <= afterSequence) {
+            continue;
+        }
+        FlightRecord record;
+        record.sequence = slot.sequence;
+        record.timeNanos = slot.timeNanos;
+        record.level = slot.level;
+        record.message.assign(slot.message, slot.length);
+        records.push_back(std::move(record));
+    }
+    std::sort(records.begin(), records.end(), [](const FlightRecord& a, const FlightRecord& b) {
+        return a.sequence < b.sequence;
+    });
+    return records;
+}
+
+size_t FlightRecorder::dumpNew(const std::string& path, const std::string& reason) {
+    std::lock_guard<std::mutex> lock(dumpMutex_);
+    std::vector<FlightRecord> records = snapshot(lastDumped_);
+    if (records.empty()) {
+        return 0;
+    }
+
+    std::ofstream file(path, std::ios::app);
+    if (!file.is_open()) {
+        return 0;
+    }
+
+    file << "=== Flight recorder dump: " << reason << " (" << records.size() << " events";
+    uint64_t dropped = records.front().sequence - lastDumped_ - 1;
+    if (dropped > 0) {
+        file << ", " << dropped << " older events overwritten";
+    }
+    file << ") ===\n";
+    for (const auto& record : records) {
+        file << "[" << formatTimestamp(record.timeNanos) << "] ["
+             << logLevelToString(record.level) << "] " << record.message << '\n';
+    }
+    file.flush();
+
+    lastDumped_ = records.back().sequence;
+    return records.size();
+}
+
+void FlightRecorder::writeCrashDump(CrashSink sink, void* context) const {
+    static const char header[] = "=== Flight recorder dump: crash ===\n";
+    sink(context, header, sizeof(header) - 1);
+
+    // Walk the ring from the oldest slot; slot locks are skipped on purpose,
+    // a torn message is better than a deadlock in a crashing process
+    uint64_t next = next_.load(std::memory_order_relaxed);
+    uint64_t first = next > capacity_ ? next - capacity_ + 1 : 1;
+    char line[MESSAGE_CAPACITY + 64];
+    for (uint64_t sequence = first; sequence <= next; ++sequence) {
+        const Slot& slot = slots_[(sequence - 1) % capacity_];
+        if (slot.sequence != sequence) {
+            continue;
+        }
+        size_t pos = 0;
+        line[pos++] = '#';
+        pos += formatUnsigned(sequence, line + pos);
+        line[pos++] = ' ';
+        pos += formatUnsigned(slot.timeNanos, line + pos);
+        line[pos++] = ' ';
+        const char* levelName = logLevelToString(slot.level);
+        size_t levelLength = std::strlen(levelName);
+        std::memcpy(line + pos, levelName, levelLength);
+        pos += levelLength;
+        line[pos++] = ' ';
+        size_t length = std::min<size_t>(slot.length, MESSAGE_CAPACITY - 1);
+        std::memcpy(line + pos, slot.message, length);
+        pos += length;
+        line[pos++] = '\n';
+        sink(context, line, pos);
+    }
+}
+
+// ============================================================================
+// Crash handler
+// ============================================================================
+
+struct FlightRecorderCrashHandler {
+    static std::atomic<FlightRecorder*> recorder;
+    static char path[1024];
+    static bool installed;
+
+#ifdef _WIN32
+    static LPTOP_LEVEL_EXCEPTION_FILTER previousFilter;
+
+    static void sink(void* context, const char* data, size_t size) {
+        DWORD written = 0;
+        WriteFile(static_cast<HANDLE>(context), data, static_cast<DWORD>(size), &written, nullptr);
+    }
+
+    static LONG WINAPI onUnhandledException(EXCEPTION_POINTERS* info) {
+        FlightRecorder* current = recorder.exchange(nullptr);
+        if (current) {
+            HANDLE file = CreateFileA(path, FILE_APPEND_DATA, FILE_SHARE_READ, nullptr,
+                                      OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file != INVALID_HANDLE_VALUE) {
+                current->writeCrashDump(sink, file);
+                CloseHandle(file);
+            }
+        }
+        return previousFilter ? previousFilter(info) : EXCEPTION_CONTINUE_SEARCH;
+    }
+#else
+    static constexpr int SIGNALS[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+    static struct sigaction previousActions[sizeof(SIGNALS) / sizeof(SIGNALS[0])];
+
+    static void sink(void* context, const char* data, size_t size) {
+        int fd = *static_cast<int*>(context);
+        while (size > 0) {
+            ssize_t written = ::write(fd, data, size);
+            if (written <= 0) {
+                return;
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+
+    static void onSignal(int signal) {
+        FlightRecorder* current = recorder.exchange(nullptr);
+        if (current) {
+            int fd = ::open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+            if (fd >= 0) {
+                current->writeCrashDump(sink, &fd);
+                ::close(fd);
+            }
+        }
+        // Hand the signal to whoever had it before us (default: terminate)
+        restore();
+        ::raise(signal);
+    }
+
+    static void restore() {
+        if (!installed) {
+            return;
+        }
+        for (size_t i = 0; i < sizeof(SIGNALS) / sizeof(SIGNALS[0]); ++i) {
+            sigaction(SIGNALS[i], &previousActions[i], nullptr);
+        }
+        installed = false;
+    }
+#endif
+};
+
+std::atomic<FlightRecorder*> FlightRecorderCrashHandler::recorder{nullptr};
+char FlightRecorderCrashHandler::path[1024] = {};
+bool FlightRecorderCrashHandler::installed = false;
+#ifdef _WIN32
+LPTOP_LEVEL_EXCEPTION_FILTER FlightRecorderCrashHandler::previousFilter = nullptr;
+#else
+constexpr int FlightRecorderCrashHandler::SIGNALS[];
+struct sigaction FlightRecorderCrashHandler::previousActions[sizeof(SIGNALS) / sizeof(SIGNALS[0])];
+#endif
+
+void FlightRecorder::installCrashHandler(FlightRecorder* recorder, const std::string& path) {
+    uninstallCrashHandler();
+    if (!recorder) {
+        return;
+    }
+
+    size_t length = std::min(path.size(), sizeof(FlightRecorderCrashHandler::path) - 1);
+    std::memcpy(FlightRecorderCrashHandler::path, path.data(), length);
+    FlightRecorderCrashHandler::path[length] = '\0';
+    FlightRecorderCrashHandler::recorder.store(recorder);
+
+#ifdef _WIN32
+    FlightRecorderCrashHandler::previousFilter =
+        SetUnhandledExceptionFilter(FlightRecorderCrashHandler::onUnhandledException);
+    FlightRecorderCrashHandler::installed = true;
+#else
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = FlightRecorderCrashHandler::onSignal;
+    sigemptyset(&action.sa_mask);
+    for (size_t i = 0; i < sizeof(FlightRecorderCrashHandler::SIGNALS) / sizeof(int); ++i) {
+        sigaction(FlightRecorderCrashHandler::SIGNALS[i], &action,
+                  &FlightRecorderCrashHandler::previousActions[i]);
+    }
+    FlightRecorderCrashHandler::installed = true;
+#endif
+}
+
+void FlightRecorder::uninstallCrashHandler() {
+    FlightRecorderCrashHandler::recorder.store(nullptr);
+#ifdef _WIN32
+    if (FlightRecorderCrashHandler::installed) {
+        SetUnhandledExceptionFilter(FlightRecorderCrashHandler::previousFilter);
+        FlightRecorderCrashHandler::previousFilter = nullptr;
+        FlightRecorderCrashHandler::installed = false;
+    }
+#else
+    FlightRecorderCrashHandler::restore();
+#endif
+}
+
+} // namespace creo_barcode
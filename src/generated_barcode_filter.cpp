@@ -0,0 +1,186 @@
+/**
+ * @file generated_barcode_filter.cpp
+ * @brief Implementation of the generated-barcode Bloom filter
+ *
+ * On-disk layout (little-endian):
+ *   char magic[4] = "CBBF", uint32 version, uint32 hashCount, uint32 reserved,
+ *   uint64 wordCount, uint64 itemCount, uint64 words[wordCount]
+ */
+
+#include "generated_barcode_filter.h"
+#include "content_hash.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace creo_barcode {
+
+namespace {
+
+constexpr char FILTER_MAGIC[4] = {'C', 'B', 'B', 'F'};
+constexpr uint32_t FILTER_VERSION = 2;
+constexpr unsigned MAX_HASH_COUNT = 16;
+
+struct KeyHashes {
+    uint64_t h1;
+    uint64_t h2;
+};
+
+// Payload hashed with the canonical config hash as seed, so configs that
+// render the same image share entries
+KeyHashes hashKey(const std::string& payload, const BarcodeConfig& config) {
+    Hash128 hash = hash128(payload, hashBarcodeConfig(config));
+    // h2 must be odd so the probe sequence visits distinct bits
+    return {hash.low, hash.high | 1};
+}
+
+} // anonymous namespace
+
+GeneratedBarcodeFilter::GeneratedBarcodeFilter(size_t expectedItems, double falsePositiveRate) {
+    if (expectedItems == 0) {
+        expectedItems = 1;
+    }
+    if (falsePositiveRate <= 0.0 || falsePositiveRate >= 1.0) {
+        falsePositiveRate = DEFAULT_FALSE_POSITIVE_RATE;
+    }
+
+    // Optimal sizing: m = -n ln p / (ln 2)^2, k = (m / n) ln 2
+    const double ln2 = std::log(2.0);
+    double bits = -static_cast<double>(expectedItems) * std::log(falsePositiveRate) / (ln2 * ln2);
+    size_t wordCount = std::max<size_t>(1, static_cast<size_t>(std::ceil(bits / 64.0)));
+    double k = (static_cast<double>(wordCount * 64) / expectedItems) * ln2;
+    unsigned hashCount = static_cast<unsigned>(std::clamp(std::lround(k), 1L, static_cast<long>(MAX_HASH_COUNT)));
+
+    allocate(wordCount, hashCount);
+}
+
+void GeneratedBarcodeFilter::allocate(size_t wordCount, unsigned hashCount) {
+    words_.reset(new std::atomic<uint64_t>[wordCount]);
+    wordCount_ = wordCount;
+    hashCount_ = hashCount;
+    clear();
+}
+
+void GeneratedBarcodeFilter::clear() {
+    for (size_t i = 0; i < wordCount_; ++i) {
+        words_[i].store(0, std::memory_order_relaxed);
+    }
+    itemCount_.store(0, std::memory_order_relaxed);
+}
+
+void GeneratedBarcodeFilter::add(const std::string& payload, const BarcodeConfig& config) {
+    KeyHashes key = hashKey(payload, config);
+    const uint64_t bits = bitCount();
+    for (unsigned i = 0; i < hashCount_; ++i) {
+        uint64_t bit = (key.h1 + i * key.h2) % bits;
+        words_[bit / 64].fetch_or(1ULL << (bit % 64), std::memory_order_relaxed);
+    }
+    itemCount_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool GeneratedBarcodeFilter::mightContain(const std::string& payload, const BarcodeConfig& config) const {
+    KeyHashes key = hashKey(payload, config);
+    const uint64_t bits = bitCount();
+    for (unsigned i = 0; i < hashCount_; ++i) {
+        uint64_t bit = (key.h1 + i * key.h2) % bits;
+        if ((words_[bit / 64].load(std::memory_order_relaxed) & (1ULL << (bit % 64))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double GeneratedBarcodeFilter::estimatedFalsePositiveRate() const {
+    // (1 - e^(-k n / m))^k
+    double n = static_cast<double>(itemCount());
+    double m = static_cast<double>(bitCount());
+    double k = static_cast<double>(hashCount_);
+    return std::pow(1.0 - std::exp(-k * n / m), k);
+}
+
+bool GeneratedBarcodeFilter::save(const std::string& path) const {
+    uint32_t header[4] = {0, FILTER_VERSION, hashCount_, 0};
+    std::memcpy(&header[0], FILTER_MAGIC, sizeof(FILTER_MAGIC));
+    uint64_t sizes[2] = {wordCount_, itemCount()};
+
+    std::vector<uint64_t> snapshot(wordCount_);
+    for (size_t i = 0; i < wordCount_; ++i) {
+        snapshot[i] = words_[i].load(std::memory_order_relaxed);
+    }
+
+    // Write-then-rename so a crash mid-save keeps the previous filter
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            lastError_ = ErrorInfo(ErrorCode::CONFIG_SAVE_FAILED, "Cannot write barcode filter", tempPath);
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+        out.write(reinterpret_cast<const char*>(snapshot.data()),
+                  static_cast<std::streamsize>(snapshot.size() * sizeof(uint64_t)));
+        if (!out.good()) {
+            lastError_ = ErrorInfo(ErrorCode::CONFIG_SAVE_FAILED, "Failed writing barcode filter", tempPath);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        lastError_ = ErrorInfo(ErrorCode::CONFIG_SAVE_FAILED, "Cannot replace barcode filter", ec.message());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool GeneratedBarcodeFilter::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        lastError_ = ErrorInfo(ErrorCode::FILE_NOT_FOUND, "Cannot open barcode filter", path);
+        return false;
+    }
+    std::streamoff fileSize = in.tellg();
+    in.seekg(0);
+
+    uint32_t header[4];
+    uint64_t sizes[2];
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    in.read(reinterpret_cast<char*>(sizes), sizeof(sizes));
+    if (!in.good() || std::memcmp(&header[0], FILTER_MAGIC, sizeof(FILTER_MAGIC)) != 0 ||
+        header[1] != FILTER_VERSION || header[2] == 0 || header[2] > MAX_HASH_COUNT ||
+        sizes[0] == 0) {
+        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Not a barcode filter file", path);
+        return false;
+    }
+
+    // The word count comes from the file: check it against the bytes that
+    // are actually there before allocating, so a corrupt header fails here
+    uint64_t payloadBytes = static_cast<uint64_t>(fileSize) - sizeof(header) - sizeof(sizes);
+    if (sizes[0] != payloadBytes / sizeof(uint64_t) || payloadBytes % sizeof(uint64_t) != 0) {
+        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Barcode filter size does not match its header", path);
+        return false;
+    }
+
+    std::vector<uint64_t> snapshot(static_cast<size_t>(sizes[0]));
+    in.read(reinterpret_cast<char*>(snapshot.data()),
+            static_cast<std::streamsize>(snapshot.size() * sizeof(uint64_t)));
+    if (!in.good()) {
+        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Barcode filter is truncated", path);
+        return false;
+    }
+
+    allocate(snapshot.size(), header[2]);
+    for (size_t i = 0; i < wordCount_; ++i) {
+        words_[i].store(snapshot[i], std::memory_order_relaxed);
+    }
+    itemCount_.store(static_cast<size_t>(sizes[1]), std::memory_order_relaxed);
+    return true;
+}
+
+} // namespace creo_barcode
@@ -0,0 +1,220 @@
+/**
+ * @file image_validator.cpp
+ * @brief Implementation of single-open image validation and verdict cache
+ */
+
+#include "image_validator.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#include "utf_transcode.h"
+#else
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace creo_barcode {
+
+namespace {
+
+constexpr size_t HEADER_BYTES = 8;
+
+const uint8_t PNG_SIGNATURE[] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+
+ImageCheck classify(uint64_t size, const uint8_t* header, size_t headerSize) {
+    ImageCheck check;
+    check.size = size;
+    if (size == 0) {
+        check.verdict = ImageVerdict::EMPTY_FILE;
+        return check;
+    }
+    check.format = sniffImageFormat(header, headerSize);
+    check.verdict = check.format == ImageFormat::UNKNOWN ? ImageVerdict::UNSUPPORTED_FORMAT
+                                                         : ImageVerdict::VALID;
+    return check;
+}
+
+} // anonymous namespace
+
+ImageFormat sniffImageFormat(const uint8_t* header, size_t size) {
+    if (size >= sizeof(PNG_SIGNATURE) && std::memcmp(header, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) == 0) {
+        return ImageFormat::PNG;
+    }
+    if (size >= 3 && header[0] == 0xFF && header[1] == 0xD8 && header[2] == 0xFF) {
+        return ImageFormat::JPEG;
+    }
+    if (size >= 2 && header[0] == 'B' && header[1] == 'M') {
+        return ImageFormat::BMP;
+    }
+    return ImageFormat::UNKNOWN;
+}
+
+const char* imageFormatName(ImageFormat format) {
+    switch (format) {
+        case ImageFormat::PNG: return "PNG";
+        case ImageFormat::JPEG: return "JPEG";
+        case ImageFormat::BMP: return "BMP";
+        default: return "unknown";
+    }
+}
+
+#ifdef _WIN32
+
+ImageCheck inspectImageFile(const std::string& path) {
+    ImageCheck check;
+    if (path.empty()) {
+        check.verdict = ImageVerdict::EMPTY_PATH;
+        return check;
+    }
+
+    std::wstring widePath;
+    utf::utf8ToWide(path, widePath);
+    // Backup semantics lets directories open too, so they are reported as such
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        DWORD error = GetLastError();
+        if (error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND) {
+            check.verdict = ImageVerdict::NOT_FOUND;
+        } else {
+            check.verdict = ImageVerdict::READ_FAILED;
+            check.systemError = static_cast<int>(error);
+        }
+        return check;
+    }
+
+    BY_HANDLE_FILE_INFORMATION info;
+    if (!GetFileInformationByHandle(file, &info)) {
+        check.verdict = ImageVerdict::READ_FAILED;
+        check.systemError = static_cast<int>(GetLastError());
+        CloseHandle(file);
+        return check;
+    }
+    if (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+        CloseHandle(file);
+        check.verdict = ImageVerdict::NOT_REGULAR_FILE;
+        return check;
+    }
+
+    uint64_t size = (static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+    uint8_t header[HEADER_BYTES];
+    DWORD headerSize = 0;
+    if (size > 0 && !ReadFile(file, header, sizeof(header), &headerSize, nullptr)) {
+        check.verdict = ImageVerdict::READ_FAILED;
+        check.systemError = static_cast<int>(GetLastError());
+        CloseHandle(file);
+        return check;
+    }
+    CloseHandle(file);
+    return classify(size, header, headerSize);
+}
+
+#else
+
+ImageCheck inspectImageFile(const std::string& path) {
+    ImageCheck check;
+    if (path.empty()) {
+        check.verdict = ImageVerdict::EMPTY_PATH;
+        return check;
+    }
+
+    // Non-blocking so a FIFO at the path cannot stall the open
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NONBLOCK);
+    if (fd < 0) {
+        if (errno == ENOENT || errno == ENOTDIR) {
+            check.verdict = ImageVerdict::NOT_FOUND;
+        } else {
+            check.verdict = ImageVerdict::READ_FAILED;
+            check.systemError = errno;
+        }
+        return check;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        check.verdict = ImageVerdict::READ_FAILED;
+        check.systemError = errno;
+        ::close(fd);
+        return check;
+    }
+    if (!S_ISREG(st.st_mode)) {
+        ::close(fd);
+        check.verdict = ImageVerdict::NOT_REGULAR_FILE;
+        return check;
+    }
+
+    uint64_t size = static_cast<uint64_t>(st.st_size);
+    uint8_t header[HEADER_BYTES];
+    ssize_t headerSize = 0;
+    if (size > 0) {
+        headerSize = ::pread(fd, header, sizeof(header), 0);
+        if (headerSize < 0) {
+            check.verdict = ImageVerdict::READ_FAILED;
+            check.systemError = errno;
+            ::close(fd);
+            return check;
+        }
+    }
+    ::close(fd);
+    return classify(size, header, static_cast<size_t>(headerSize));
+}
+
+#endif
+
+ImageValidator& ImageValidator::global() {
+    static ImageValidator* instance = nullptr;
+    static std::once_flag flag;
+    std::call_once(flag, []() {
+        instance = new ImageValidator();
+    });
+    return *instance;
+}
+
+ImageCheck ImageValidator::validate(const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = generated_.find(path);
+        if (it != generated_.end()) {
+            ImageCheck check;
+            check.verdict = ImageVerdict::VALID;
+            check.format = it->second.format;
+            check.size = it->second.size;
+            check.cached = true;
+            return check;
+        }
+    }
+    return inspectImageFile(path);
+}
+
+void ImageValidator::markGenerated(const std::string& path, ImageFormat format, uint64_t size) {
+    if (path.empty() || format == ImageFormat::UNKNOWN || size == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (generated_.size() >= MAX_CACHED && generated_.find(path) == generated_.end()) {
+        // Older entries are long inserted; starting over is cheaper than LRU
+        generated_.clear();
+    }
+    generated_[path] = Entry{format, size};
+}
+
+void ImageValidator::forget(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    generated_.erase(path);
+}
+
+void ImageValidator::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    generated_.clear();
+}
+
+size_t ImageValidator::cachedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return generated_.size();
+}
+
+} // namespace creo_barcode
@@ -1,13 +1,83 @@
 #include "logger.h"
+#include "zlib_compress.h"
 #include <iostream>
 #include <chrono>
 #include <ctime>
 #include <iomanip>
 #include <sstream>
 #include <mutex>
+#include <array>
+#include <vector>
+#include <filesystem>
+#include <cstdlib>
 
 namespace creo_barcode {
 
+namespace {
+
+constexpr std::array<uint32_t, 256> makeCrc32Table() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> CRC32_TABLE = makeCrc32Table();
+
+uint32_t crc32(const unsigned char* data, size_t size) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = CRC32_TABLE[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void appendLittleEndian(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+/**
+ * @brief Write source as a gzip file (RFC 1952) at destination
+ *
+ * zlibCompress produces a zlib stream (RFC 1950); gzip wraps the same deflate data
+ * with a different header and a CRC-32 trailer.
+ */
+bool gzipFile(const std::string& source, const std::string& destination) {
+    std::ifstream in(source, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    std::vector<unsigned char> zlib;
+    // 2-byte zlib header + deflate data + 4-byte Adler-32
+    if (!zlibCompress(data.data(), data.size(), zlib) || zlib.size() < 6) {
+        return false;
+    }
+
+    std::string header = {'\x1f', '\x8b', '\x08', '\x00', 0, 0, 0, 0, '\x00', '\xff'};
+    std::string trailer;
+    appendLittleEndian(trailer, crc32(data.data(), data.size()));
+    appendLittleEndian(trailer, static_cast<uint32_t>(data.size()));
+
+    std::ofstream out(destination, std::ios::binary | std::ios::trunc);
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    out.write(reinterpret_cast<const char*>(zlib.data() + 2), static_cast<std::streamsize>(zlib.size() - 6));
+    out.write(trailer.data(), static_cast<std::streamsize>(trailer.size()));
+    out.close();
+    return !out.fail();
+}
+
+} // anonymous namespace
+
 Logger& Logger::getInstance() {
     // Use a pointer to avoid static initialization order issues in DLL
     static Logger* instance = nullptr;
@@ -34,6 +104,7 @@ Logger::Logger() : consoleOutput_(false) {
 }
 
 Logger::~Logger() {
+    shutdown();
     if (logFile_.is_open()) {
         logFile_.close();
     }
@@ -47,6 +118,24 @@ void Logger::setLogFilePath(const std::string& path) {
     logFilePath_ = path;
 }
 
+std::string Logger::getLogFilePath() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return logFilePath_;
+}
+
+std::string Logger::getFlightDumpPath() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return logFilePath_ + ".flight";
+}
+
+void Logger::setRotationPolicy(const LogRotationPolicy& policy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rotation_ = policy;
+    if (rotation_.maxArchives < 1) {
+        rotation_.maxArchives = 1;
+    }
+}
+
 std::string Logger::getCurrentTimestamp() {
     auto now = std::chrono::system_clock::now();
     auto time = std::chrono::system_clock::to_time_t(now);
@@ -61,36 +150,158 @@ std::string Logger::getCurrentTimestamp() {
     return oss.str();
 }
 
-void Logger::writeToFile(const std::string& level, const std::string& message) {
-    std::lock_guard<std::mutex> lock(mutex_);
+void Logger::writeToFile(LogLevel level, const std::string& message) {
+    std::string logLine = "[" + getCurrentTimestamp() + "] [" + logLevelToString(level) + "] " + message;
     
-    std::string timestamp = getCurrentTimestamp();
-    std::string logLine = "[" + timestamp + "] [" + level + "] " + message;
+    std::lock_guard<std::mutex> lock(mutex_);
     
     if (consoleOutput_) {
-        std::cout << logLine << std::endl;
+        std::cout << logLine << '\n';
     }
     
     if (!logFile_.is_open()) {
         logFile_.open(logFilePath_, std::ios::app);
+        std::error_code ec;
+        uintmax_t existing = std::filesystem::file_size(logFilePath_, ec);
+        currentSize_ = ec ? 0 : static_cast<uint64_t>(existing);
     }
     
     if (logFile_.is_open()) {
-        logFile_ << logLine << std::endl;
+        logFile_ << logLine << '\n';
+        currentSize_ += logLine.size() + 1;
+        // Warnings and errors must survive a crash; info lines are flushed with them
+        if (level >= LogLevel::WARNING) {
+            logFile_.flush();
+        }
+        if (rotation_.maxFileBytes > 0 && currentSize_ >= rotation_.maxFileBytes) {
+            rotateLocked();
+        }
+    }
+}
+
+void Logger::rotateLocked() {
+    logFile_.close();
+    currentSize_ = 0;
+
+    // Renaming is cheap and keeps the write path short; compression happens
+    // on the archive thread. The next write reopens a fresh file.
+    PendingArchive pending;
+    pending.segmentPath = logFilePath_ + ".rotating." + std::to_string(++rotationCount_);
+    pending.logPath = logFilePath_;
+    pending.policy = rotation_;
+
+    std::error_code ec;
+    std::filesystem::rename(logFilePath_, pending.segmentPath, ec);
+    if (ec) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(archiveMutex_);
+    pendingArchives_.push_back(std::move(pending));
+    if (!archiveThread_.joinable()) {
+        stopArchiver_ = false;
+        archiveThread_ = std::thread(&Logger::archiveWorker, this);
+    }
+    archiveCv_.notify_one();
+}
+
+void Logger::archiveWorker() {
+    std::unique_lock<std::mutex> lock(archiveMutex_);
+    while (true) {
+        archiveCv_.wait(lock, [this]() { return stopArchiver_ || !pendingArchives_.empty(); });
+        // Drain the queue even when stopping so no segment is left uncompressed
+        if (pendingArchives_.empty()) {
+            return;
+        }
+        PendingArchive pending = std::move(pendingArchives_.front());
+        pendingArchives_.pop_front();
+
+        lock.unlock();
+        archiveSegment(pending);
+        lock.lock();
+    }
+}
+
+void Logger::archiveSegment(const PendingArchive& pending) {
+    const std::string suffix = pending.policy.compress ? ".gz" : "";
+    auto archivePath = [&](int index) {
+        return pending.logPath + "." + std::to_string(index) + suffix;
+    };
+
+    std::error_code ec;
+    std::filesystem::remove(archivePath(pending.policy.maxArchives), ec);
+    for (int index = pending.policy.maxArchives - 1; index >= 1; --index) {
+        if (std::filesystem::exists(archivePath(index), ec)) {
+            std::filesystem::rename(archivePath(index), archivePath(index + 1), ec);
+        }
+    }
+
+    if (!pending.policy.compress) {
+        std::filesystem::rename(pending.segmentPath, archivePath(1), ec);
+        return;
+    }
+
+    // On failure the uncompressed segment is left in place rather than lost
+    std::string tempPath = archivePath(1) + ".tmp";
+    if (gzipFile(pending.segmentPath, tempPath)) {
+        std::filesystem::rename(tempPath, archivePath(1), ec);
+        if (!ec) {
+            std::filesystem::remove(pending.segmentPath, ec);
+        }
+    } else {
+        std::filesystem::remove(tempPath, ec);
+    }
+}
+
+void Logger::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (logFile_.is_open()) {
         logFile_.flush();
     }
 }
 
+void Logger::shutdown() {
+    flush();
+
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> lock(archiveMutex_);
+        stopArchiver_ = true;
+        worker = std::move(archiveThread_);
+    }
+    archiveCv_.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void Logger::log(LogLevel level, const std::string& message) {
+    if (level >= getFlightRecorderLevel()) {
+        recorder_.record(level, message);
+    }
+    if (level >= getLogLevel()) {
+        writeToFile(level, message);
+    }
+    // Errors bring the lead-up along, including events below the file threshold
+    if (level >= LogLevel::ERR && level < LogLevel::OFF) {
+        recorder_.dumpNew(getFlightDumpPath(), "error: " + message.substr(0, 120));
+    }
+}
+
+void Logger::verbose(const std::string& message) {
+    log(LogLevel::VERBOSE, message);
+}
+
 void Logger::info(const std::string& message) {
-    writeToFile("INFO", message);
+    log(LogLevel::INFO, message);
 }
 
 void Logger::warning(const std::string& message) {
-    writeToFile("WARNING", message);
+    log(LogLevel::WARNING, message);
 }
 
 void Logger::error(const std::string& message) {
-    writeToFile("ERROR", message);
+    log(LogLevel::ERR, message);
 }
 
 void Logger::error(const std::string& message, const ErrorInfo& err) {
@@ -101,7 +312,7 @@ void Logger::error(const std::string& message, const ErrorInfo& err) {
     if (!err.details.empty()) {
         fullMessage += " (" + err.details + ")";
     }
-    writeToFile("ERROR", fullMessage);
+    log(LogLevel::ERR, fullMessage);
 }
 
 } // namespace creo_barcode
@@ -30,11 +30,27 @@
 #include "batch_processor.h"
 #include "settings_dialog.h"
 #include "data_sync_checker.h"
+#include "payload_index.h"
+#include "barcode_inventory.h"
+#include "generated_barcode_filter.h"
+#include "binary_log.h"
+#include "trace.h"
+#include "plugin_stats.h"
+#include "thread_pool.h"
+#include "utf_transcode.h"
+#include "render_cache.h"
+#include "speculative_generator.h"
+#include "sync_monitor.h"
+#include "directory_watcher.h"
+#include "batch_tuning.h"
+#include "image_validator.h"
 
 #include <string>
+#include <cstring>
 #include <memory>
 #include <filesystem>
 #include <chrono>
+#include <unordered_set>
 
 namespace creo_barcode {
 
@@ -53,13 +69,29 @@ static std::unique_ptr<DrawingInterface> g_drawingInterface;
 static std::unique_ptr<BarcodeGenerator> g_barcodeGenerator;
 static std::unique_ptr<BatchProcessor> g_batchProcessor;
 static std::unique_ptr<DataSyncChecker> g_dataSyncChecker;
+static std::unique_ptr<PayloadIndex> g_payloadIndex;
+static std::unique_ptr<BarcodeInventory> g_barcodeInventory;
+static std::unique_ptr<GeneratedBarcodeFilter> g_generatedFilter;
+static std::unique_ptr<TimingHistory> g_timingHistory;
+static std::unique_ptr<SpeculativeGenerator> g_speculativeGenerator;
+static std::unique_ptr<SyncMonitor> g_syncMonitor;
+static std::unique_ptr<DirectoryWatcher> g_directoryWatcher;
 static std::string g_pluginVersion = "1.0.0";
 
 // Forward declarations for workflow functions
 void onGenerateBarcodeRequested(const BarcodeConfig& config);
 void onBatchGenerateRequested();
+void onDrawingActivated(ProDrawing drawing);
+void onModelRenamed(ProMdl model, const std::string& oldName, const std::string& newName);
+void onModelSaved(ProMdl model);
+void onModelErased(ProMdl model);
+void dispatchSyncWarnings();
+void onOutputImagesChanged(const std::vector<FileChange>& changes);
+std::string getOutputDirectory();
 std::string generateOutputPath(const std::string& partName);
 bool ensureOutputDirectory(const std::string& path);
+bool findExistingBarcode(const std::string& payload, const BarcodeConfig& config,
+                         const std::string& drawingPath, BarcodeLocation& existing);
 SyncCheckResult checkBarcodeSync(const std::string& barcodePath, const std::string& currentPartName);
 bool updateBarcodeIfNeeded(const SyncCheckResult& syncResult, const BarcodeConfig& config);
 
@@ -75,13 +107,84 @@ bool getCurrentCreoVersion(CreoVersion& version) {
     return true;
 }
 
+/**
+ * @brief Get the path of the persistent payload index
+ * @return Index file path, or empty string if no user directory is available
+ */
+std::string getPayloadIndexPath() {
+#ifdef _WIN32
+    const char* appData = std::getenv("APPDATA");
+    if (appData) {
+        return std::string(appData) + "\\CreoBarcodePlugin\\payload_index.bin";
+    }
+#else
+    const char* home = std::getenv("HOME");
+    if (home) {
+        return std::string(home) + "/.creo_barcode/payload_index.bin";
+    }
+#endif
+    return "";
+}
+
+/**
+ * @brief Get the path of the persistent generated-barcode filter
+ * @return Filter file path, or empty string if no user directory is available
+ */
+std::string getGeneratedFilterPath() {
+    std::string indexPath = getPayloadIndexPath();
+    if (indexPath.empty()) {
+        return "";
+    }
+    return (std::filesystem::path(indexPath).parent_path() / "generated_filter.bin").string();
+}
+
+/**
+ * @brief Get the path of the barcode audit inventory
+ * @return Inventory file path, or empty string if no user directory is available
+ */
+std::string getBarcodeInventoryPath() {
+    std::string indexPath = getPayloadIndexPath();
+    if (indexPath.empty()) {
+        return "";
+    }
+    return (std::filesystem::path(indexPath).parent_path() / "barcode_inventory.bin").string();
+}
+
+/**
+ * @brief Get the path of the persistent batch timing history
+ * @return History file path, or empty string if no user directory is available
+ */
+std::string getTimingHistoryPath() {
+    std::string indexPath = getPayloadIndexPath();
+    if (indexPath.empty()) {
+        return "";
+    }
+    return (std::filesystem::path(indexPath).parent_path() / "batch_timings.json").string();
+}
+
 /**
  * @brief Initialize plugin resources
  * @return true if initialization was successful
  */
 bool initializeResources() {
+    // Runtime log threshold, e.g. CREO_BARCODE_LOG_LEVEL=VERBOSE
+    const char* levelName = std::getenv("CREO_BARCODE_LOG_LEVEL");
+    LogLevel level;
+    if (levelName && logLevelFromString(levelName, level)) {
+        setLogLevel(level);
+    }
+    
+    // Dump the flight recorder if Creo crashes while the plugin is loaded
+    FlightRecorder::installCrashHandler(&Logger::getInstance().flightRecorder(),
+                                        Logger::getInstance().getFlightDumpPath());
+    
     LOG_INFO("Initializing Creo Barcode Plugin v" + g_pluginVersion);
     
+    // Start the structured binary log (decode with creo_log_decoder)
+    if (!BinaryLog::getInstance().open(BinaryLog::defaultPath())) {
+        LOG_WARNING("Could not open binary log: " + BinaryLog::getInstance().getLastError().details);
+    }
+    
     // Initialize configuration manager
     g_configManager = std::make_unique<ConfigManager>();
     
@@ -107,6 +210,13 @@ bool initializeResources() {
         }
     }
     
+    // Stage timelines for Perfetto (exported after each batch and at unload)
+    if (g_configManager->getConfig().enableTracing) {
+        Tracer::getInstance().start();
+        Tracer::getInstance().setCurrentThreadName("creo main");
+        LOG_INFO("Tracing enabled, trace file: " + Tracer::defaultPath());
+    }
+    
     // Initialize drawing interface
     g_drawingInterface = std::make_unique<DrawingInterface>();
     LOG_INFO("Drawing interface initialized");
@@ -119,8 +229,57 @@ bool initializeResources() {
     g_batchProcessor = std::make_unique<BatchProcessor>();
     LOG_INFO("Batch processor initialized");
     
+    // Load the payload -> drawing index so renames resolve without rescans
+    g_payloadIndex = std::make_unique<PayloadIndex>();
+    std::string indexPath = getPayloadIndexPath();
+    if (!indexPath.empty() && std::filesystem::exists(indexPath)) {
+        if (g_payloadIndex->load(indexPath)) {
+            LOG_INFO("Payload index loaded with " + std::to_string(g_payloadIndex->size()) + " entries");
+        } else {
+            LOG_WARNING("Could not load payload index from " + indexPath + ", starting empty");
+        }
+    }
+    
+    // Load the filter of already-generated barcodes; the generator keeps it current
+    g_generatedFilter = std::make_unique<GeneratedBarcodeFilter>();
+    std::string filterPath = getGeneratedFilterPath();
+    if (!filterPath.empty() && std::filesystem::exists(filterPath)) {
+        if (g_generatedFilter->load(filterPath)) {
+            LOG_INFO("Generated barcode filter loaded with " + std::to_string(g_generatedFilter->itemCount()) + " entries");
+        } else {
+            LOG_WARNING("Could not load generated barcode filter from " + filterPath + ", starting empty");
+        }
+    }
+    g_barcodeGenerator->setGeneratedFilter(g_generatedFilter.get());
+    g_barcodeGenerator->setRenderCache(&RenderCache::global());
+    
+    // Start batches from the concurrency earlier runs settled on
+    g_timingHistory = std::make_unique<TimingHistory>();
+    std::string timingPath = getTimingHistoryPath();
+    if (!timingPath.empty() && std::filesystem::exists(timingPath)) {
+        if (g_timingHistory->load(timingPath)) {
+            LOG_INFO("Batch timing history loaded for " + std::to_string(g_timingHistory->size()) + " environments");
+        } else {
+            LOG_WARNING("Could not load batch timing history from " + timingPath + ", starting empty");
+        }
+    }
+    g_batchProcessor->setTimingHistory(g_timingHistory.get());
+    
     // Initialize data sync checker (Requirements 3.1, 3.2, 3.3)
     g_dataSyncChecker = std::make_unique<DataSyncChecker>();
+    g_dataSyncChecker->setPayloadIndex(g_payloadIndex.get());
+    
+    // Audit inventory: one row per checked barcode, kept across sessions
+    g_barcodeInventory = std::make_unique<BarcodeInventory>();
+    std::string inventoryPath = getBarcodeInventoryPath();
+    if (!inventoryPath.empty() && std::filesystem::exists(inventoryPath)) {
+        if (g_barcodeInventory->load(inventoryPath)) {
+            LOG_INFO("Barcode inventory loaded with " + std::to_string(g_barcodeInventory->size()) + " barcodes");
+        } else {
+            LOG_WARNING("Could not load barcode inventory from " + inventoryPath + ", starting empty");
+        }
+    }
+    g_dataSyncChecker->setInventory(g_barcodeInventory.get());
     
     // Set up default callbacks for sync checker
     g_dataSyncChecker->setUpdateConfirmCallback([](const std::string& oldData, const std::string& newData) {
@@ -138,6 +297,34 @@ bool initializeResources() {
     
     LOG_INFO("Data sync checker initialized");
     
+    // Re-check only the barcodes of renamed/saved models as they change
+    g_syncMonitor = std::make_unique<SyncMonitor>(*g_dataSyncChecker, *g_payloadIndex);
+    g_drawingInterface->setModelRenamedCallback(onModelRenamed);
+    g_drawingInterface->setModelSavedCallback(onModelSaved);
+    g_drawingInterface->setModelErasedCallback(onModelErased);
+    // Creo notifications arrive on the UI thread, where the monitor's
+    // warnings may be shown; activation is the most frequent of them
+    g_drawingInterface->setDrawingActivatedCallback(onDrawingActivated);
+    
+    // Track the output directory incrementally instead of rescanning it
+    std::string outputDir = getOutputDirectory();
+    if (DirectoryWatcher::isSupported() && ensureOutputDirectory(outputDir)) {
+        g_directoryWatcher = std::make_unique<DirectoryWatcher>();
+        if (g_directoryWatcher->start(outputDir, onOutputImagesChanged)) {
+            LOG_INFO("Watching output directory " + outputDir + " (" +
+                     std::to_string(g_directoryWatcher->inventory().size()) + " images)");
+        } else {
+            LOG_WARNING("Cannot watch output directory: " + g_directoryWatcher->getLastError().message);
+            g_directoryWatcher.reset();
+        }
+    }
+    
+    // Pre-render the active drawing's barcodes so Generate finds them cached
+    if (g_configManager->getConfig().speculativeGeneration) {
+        g_speculativeGenerator = std::make_unique<SpeculativeGenerator>();
+        LOG_INFO("Speculative generation enabled");
+    }
+    
     // Initialize menu manager and register callbacks
     MenuManager& menuManager = getMenuManager();
     menuManager.setConfigManager(g_configManager.get());
@@ -168,6 +355,34 @@ void cleanupResources() {
         LOG_INFO("Menus unregistered");
     }
     
+    // Stop watching before the index its callback updates goes away
+    if (g_directoryWatcher) {
+        g_directoryWatcher->stop();
+        g_directoryWatcher.reset();
+    }
+    
+    // Stop event-driven sync checks before the checker and index go away
+    if (g_syncMonitor) {
+        if (g_drawingInterface) {
+            g_drawingInterface->setModelRenamedCallback(nullptr);
+            g_drawingInterface->setModelSavedCallback(nullptr);
+            g_drawingInterface->setModelErasedCallback(nullptr);
+            g_drawingInterface->setDrawingActivatedCallback(nullptr);
+        }
+        g_syncMonitor.reset();
+    }
+    
+    // Stop pre-rendering before the drawing interface goes away
+    if (g_speculativeGenerator) {
+        if (g_drawingInterface) {
+            g_drawingInterface->setDrawingActivatedCallback(nullptr);
+        }
+        g_speculativeGenerator.reset();
+    }
+    
+    // Finish outstanding async work before the objects it uses go away
+    ThreadPool::shutdownShared();
+    
     // Clean up batch processor
     if (g_batchProcessor) {
         g_batchProcessor->clear();
@@ -175,18 +390,63 @@ void cleanupResources() {
         LOG_INFO("Batch processor cleaned up");
     }
     
+    // Saved after every batch; nothing left to persist here
+    g_timingHistory.reset();
+    
     // Clean up data sync checker
     if (g_dataSyncChecker) {
         g_dataSyncChecker.reset();
         LOG_INFO("Data sync checker cleaned up");
     }
     
+    // Keep the session's sync audit for offline review
+    if (g_barcodeInventory) {
+        std::string inventoryPath = getBarcodeInventoryPath();
+        if (!inventoryPath.empty() && g_barcodeInventory->size() > 0) {
+            ensureOutputDirectory(std::filesystem::path(inventoryPath).parent_path().string());
+            if (g_barcodeInventory->save(inventoryPath)) {
+                LOG_INFO("Barcode inventory saved to " + inventoryPath);
+            } else {
+                LOG_WARNING("Failed to save barcode inventory: " + g_barcodeInventory->getLastError().message);
+            }
+        }
+        g_barcodeInventory.reset();
+    }
+    
+    // Persist the payload index for the next session
+    if (g_payloadIndex) {
+        std::string indexPath = getPayloadIndexPath();
+        if (!indexPath.empty()) {
+            ensureOutputDirectory(std::filesystem::path(indexPath).parent_path().string());
+            if (g_payloadIndex->save(indexPath)) {
+                LOG_INFO("Payload index saved to " + indexPath);
+            } else {
+                LOG_WARNING("Failed to save payload index: " + g_payloadIndex->getLastError().message);
+            }
+        }
+        g_payloadIndex.reset();
+    }
+    
     // Clean up barcode generator
     if (g_barcodeGenerator) {
         g_barcodeGenerator.reset();
         LOG_INFO("Barcode generator cleaned up");
     }
     
+    // Persist the generated barcode filter for the next session
+    if (g_generatedFilter) {
+        std::string filterPath = getGeneratedFilterPath();
+        if (!filterPath.empty()) {
+            ensureOutputDirectory(std::filesystem::path(filterPath).parent_path().string());
+            if (g_generatedFilter->save(filterPath)) {
+                LOG_INFO("Generated barcode filter saved to " + filterPath);
+            } else {
+                LOG_WARNING("Failed to save generated barcode filter: " + g_generatedFilter->getLastError().message);
+            }
+        }
+        g_generatedFilter.reset();
+    }
+    
     // Clean up drawing interface
     if (g_drawingInterface) {
         g_drawingInterface.reset();
@@ -218,7 +478,20 @@ void cleanupResources() {
         LOG_INFO("Configuration manager cleaned up");
     }
     
+    LOG_INFO(PluginStats::formatSummary(PluginStats::global().snapshot()));
     LOG_INFO("Creo Barcode Plugin cleanup complete");
+    
+    // Write the final trace before the tracer stops
+    if (isTracingEnabled()) {
+        Tracer::getInstance().stop();
+        Tracer::getInstance().exportChromeTrace(Tracer::defaultPath());
+    }
+    
+    // Flush pending log output last so cleanup is captured too
+    BinaryLog::getInstance().close();
+    FlightRecorder::uninstallCrashHandler();
+    // Joins the log compression thread; it must not outlive the DLL
+    Logger::getInstance().shutdown();
 }
 
 /**
@@ -309,15 +582,15 @@ static int BarcodeSyncCheckAction(uiCmdCmdId command, uiCmdValue *p_value, void
     return 0;
 }
 
-// Helper to convert char* to wchar_t*
+// Helper to convert UTF-8 char* to wchar_t*, truncated to fit dstSize
 static void CharToWchar(const char* src, wchar_t* dst, size_t dstSize)
 {
-    size_t i = 0;
-    while (src[i] && i < dstSize - 1) {
-        dst[i] = (wchar_t)src[i];
-        i++;
+    if (dstSize == 0) {
+        return;
     }
-    dst[i] = L'\0';
+    creo_barcode::utf::TranscodeResult result =
+        creo_barcode::utf::utf8ToWide(src, strlen(src), dst, dstSize - 1);
+    dst[result.written] = L'\0';
 }
 
 #endif
@@ -476,11 +749,10 @@ void testTerminate() {
 }
 
 /**
- * @brief Generate output path for barcode image
- * @param partName The part name to use in the filename
- * @return Full path for the output barcode image
+ * @brief Get the directory barcode images are written to
+ * @return Configured output directory, or a temp subdirectory if none is set
  */
-std::string generateOutputPath(const std::string& partName) {
+std::string getOutputDirectory() {
     std::string outputDir;
     
     if (g_configManager) {
@@ -501,6 +773,21 @@ std::string generateOutputPath(const std::string& partName) {
 #endif
     }
     
+    // Trailing separators would make paths differ from the watcher's
+    while (outputDir.size() > 1 && (outputDir.back() == '/' || outputDir.back() == '\\')) {
+        outputDir.pop_back();
+    }
+    return outputDir;
+}
+
+/**
+ * @brief Generate output path for barcode image
+ * @param partName The part name to use in the filename
+ * @return Full path for the output barcode image
+ */
+std::string generateOutputPath(const std::string& partName) {
+    std::string outputDir = getOutputDirectory();
+    
     // Ensure output directory exists
     ensureOutputDirectory(outputDir);
     
@@ -518,6 +805,34 @@ std::string generateOutputPath(const std::string& partName) {
 #endif
 }
 
+/**
+ * @brief Drop cached state for image files changed behind the plugin's back
+ * 
+ * Runs on the directory watcher's thread. Added files need nothing: new
+ * images are either ours (already recorded) or not referenced by anything.
+ * Rewritten files lose their cached validation verdict; deleted files also
+ * leave the payload index, so sync checks stop reporting them.
+ * 
+ * @param changes Changes in the output directory, one per path
+ */
+void onOutputImagesChanged(const std::vector<FileChange>& changes) {
+    std::unordered_set<std::string> removed;
+    for (const auto& change : changes) {
+        if (change.kind == FileChangeKind::ADDED) {
+            continue;
+        }
+        ImageValidator::global().forget(change.path);
+        if (change.kind == FileChangeKind::REMOVED) {
+            removed.insert(change.path);
+        }
+    }
+    
+    if (!removed.empty() && g_payloadIndex) {
+        size_t dropped = g_payloadIndex->removeImages(removed);
+        BLOG_VERBOSE("Output images removed: {} files, {} index entries", removed.size(), dropped);
+    }
+}
+
 /**
  * @brief Ensure output directory exists
  * @param path Directory path to create if needed
@@ -533,6 +848,38 @@ bool ensureOutputDirectory(const std::string& path) {
     }
 }
 
+/**
+ * @brief Find a barcode for a payload that a drawing already carries
+ * 
+ * The generated-barcode filter answers definite misses (never rendered
+ * with this configuration) from memory. A probable hit is only trusted
+ * once the payload index places the payload in this drawing and the
+ * image file it points at is still a valid image.
+ * 
+ * @param payload Encoded barcode data
+ * @param config Configuration the barcode would be rendered with
+ * @param drawingPath Drawing the barcode would be inserted into
+ * @param existing Receives the existing barcode's location when found
+ * @return true if the drawing already has this barcode
+ */
+bool findExistingBarcode(const std::string& payload, const BarcodeConfig& config,
+                         const std::string& drawingPath, BarcodeLocation& existing) {
+    if (!g_generatedFilter || !g_payloadIndex || drawingPath.empty()) {
+        return false;
+    }
+    if (!g_generatedFilter->mightContain(payload, config)) {
+        return false;
+    }
+    for (const auto& location : g_payloadIndex->lookup(payload)) {
+        if (location.drawingPath == drawingPath &&
+            ImageValidator::global().validate(location.imagePath).ok()) {
+            existing = location;
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * @brief Complete barcode generation workflow
  * 
@@ -541,8 +888,9 @@ bool ensureOutputDirectory(const std::string& path) {
  * 2. Get associated model (part or assembly)
  * 3. Get part name from model
  * 4. Encode special characters if needed
- * 5. Generate barcode image
- * 6. Insert barcode into drawing
+ * 5. Skip drawings that already carry this barcode
+ * 6. Generate barcode image
+ * 7. Insert barcode into drawing
  * 
  * Requirements: 1.1, 1.2
  * 
@@ -550,6 +898,7 @@ bool ensureOutputDirectory(const std::string& path) {
  */
 void onGenerateBarcodeRequested(const BarcodeConfig& config) {
     LOG_INFO("Barcode generation workflow started");
+    dispatchSyncWarnings();
     
     if (!g_drawingInterface || !g_barcodeGenerator) {
         LOG_ERROR("Plugin components not initialized");
@@ -612,7 +961,18 @@ void onGenerateBarcodeRequested(const BarcodeConfig& config) {
         return;
     }
     
-    // Step 6: Generate barcode image
+    // Step 6: Skip the work when the drawing already has this barcode
+    std::string drawingPath;
+    if (g_drawingInterface->getDrawingPath(drawing, drawingPath) != PRO_TK_NO_ERROR) {
+        drawingPath.clear();
+    }
+    BarcodeLocation existing;
+    if (findExistingBarcode(encodedData, config, drawingPath, existing)) {
+        LOG_INFO("Drawing already has this barcode: " + existing.imagePath);
+        return;
+    }
+    
+    // Step 7: Generate barcode image
     std::string outputPath = generateOutputPath(partName);
     if (!g_barcodeGenerator->generate(encodedData, config, outputPath)) {
         LOG_ERROR("Failed to generate barcode: " + g_barcodeGenerator->getLastError().message);
@@ -620,7 +980,7 @@ void onGenerateBarcodeRequested(const BarcodeConfig& config) {
     }
     LOG_INFO("Barcode generated: " + outputPath);
     
-    // Step 7: Insert barcode into drawing (Requirement 1.2)
+    // Step 8: Insert barcode into drawing (Requirement 1.2)
     // Default position - in real implementation, user would specify or click
     Position pos(100.0, 100.0);
     Size size(static_cast<double>(config.width) / config.dpi * 25.4,  // Convert to mm
@@ -634,6 +994,67 @@ void onGenerateBarcodeRequested(const BarcodeConfig& config) {
     }
     
     LOG_INFO("Barcode inserted into drawing successfully");
+    
+    // Step 9: Record the new barcode in the payload index
+    if (g_payloadIndex && !drawingPath.empty()) {
+        g_payloadIndex->add(encodedData, BarcodeLocation(drawingPath, 0, pos.x, pos.y, outputPath));
+    }
+}
+
+/**
+ * @brief Barcode configuration built from the plugin defaults
+ */
+BarcodeConfig getDefaultBarcodeConfig() {
+    BarcodeConfig barcodeConfig;
+    if (g_configManager) {
+        PluginConfig pluginConfig = g_configManager->getConfig();
+        barcodeConfig.type = pluginConfig.defaultType;
+        barcodeConfig.width = pluginConfig.defaultWidth;
+        barcodeConfig.height = pluginConfig.defaultHeight;
+        barcodeConfig.showText = pluginConfig.defaultShowText;
+        barcodeConfig.dpi = pluginConfig.defaultDpi;
+    }
+    return barcodeConfig;
+}
+
+/**
+ * @brief Start pre-rendering barcodes for a newly activated drawing
+ * 
+ * Shows pending sync warnings first. Resolves the part names here, on
+ * Creo's thread, and leaves encoding and rendering to the speculative
+ * worker. Activating another drawing (or none) cancels the work still
+ * queued for the previous one.
+ * 
+ * @param drawing The activated drawing, or nullptr if none is active
+ */
+void onDrawingActivated(ProDrawing drawing) {
+    dispatchSyncWarnings();
+    if (!g_speculativeGenerator || !g_drawingInterface) {
+        return;
+    }
+    
+    ProMdl model = nullptr;
+    if (!drawing || g_drawingInterface->getAssociatedModel(drawing, &model) != PRO_TK_NO_ERROR) {
+        g_speculativeGenerator->cancel();
+        return;
+    }
+    
+    std::vector<std::string> partNames;
+    if (g_drawingInterface->getModelType(model) == ModelType::ASSEMBLY) {
+        std::vector<PartInfo> parts;
+        if (g_drawingInterface->getAssemblyParts(model, parts) == PRO_TK_NO_ERROR) {
+            for (const auto& part : parts) {
+                partNames.push_back(part.name);
+            }
+        }
+    } else {
+        std::string partName;
+        if (g_drawingInterface->getPartName(model, partName) == PRO_TK_NO_ERROR) {
+            partNames.push_back(partName);
+        }
+    }
+    
+    g_speculativeGenerator->activate(drawing, std::move(partNames), getDefaultBarcodeConfig());
 }
 
 /**
@@ -648,6 +1069,7 @@ void onGenerateBarcodeRequested(const BarcodeConfig& config) {
  */
 void onBatchGenerateRequested() {
     LOG_INFO("Batch generation workflow started");
+    dispatchSyncWarnings();
     
     if (!g_batchProcessor || !g_configManager) {
         LOG_ERROR("Plugin components not initialized");
@@ -659,13 +1081,7 @@ void onBatchGenerateRequested() {
     LOG_INFO("Batch processing requested - file selection dialog would appear here");
     
     // Get current configuration
-    PluginConfig pluginConfig = g_configManager->getConfig();
-    BarcodeConfig barcodeConfig;
-    barcodeConfig.type = pluginConfig.defaultType;
-    barcodeConfig.width = pluginConfig.defaultWidth;
-    barcodeConfig.height = pluginConfig.defaultHeight;
-    barcodeConfig.showText = pluginConfig.defaultShowText;
-    barcodeConfig.dpi = pluginConfig.defaultDpi;
+    BarcodeConfig barcodeConfig = getDefaultBarcodeConfig();
     
     // Process files with progress callback
     auto progressCallback = [](int current, int total) {
@@ -675,8 +1091,25 @@ void onBatchGenerateRequested() {
     std::vector<BatchResult> results = g_batchProcessor->process(barcodeConfig, progressCallback);
     
     // Generate and log summary
-    std::string summary = BatchProcessor::getSummary(results);
+    std::string summary = BatchProcessor::getSummary(results, &g_batchProcessor->getLastTuning());
     LOG_INFO("Batch processing complete:\n" + summary);
+    
+    // Keep the tuned concurrency even if Creo does not unload cleanly
+    std::string timingPath = getTimingHistoryPath();
+    if (g_timingHistory && !results.empty() && !timingPath.empty()) {
+        ensureOutputDirectory(std::filesystem::path(timingPath).parent_path().string());
+        if (!g_timingHistory->save(timingPath)) {
+            LOG_WARNING("Failed to save batch timing history: " + g_timingHistory->getLastError().message);
+        }
+    }
+    
+    if (isTracingEnabled()) {
+        if (Tracer::getInstance().exportChromeTrace(Tracer::defaultPath())) {
+            LOG_INFO("Batch trace written to " + Tracer::defaultPath());
+        } else {
+            LOG_WARNING("Failed to write batch trace: " + Tracer::getInstance().getLastError().message);
+        }
+    }
 }
 
 /**
@@ -758,6 +1191,62 @@ bool updateBarcodeIfNeeded(const SyncCheckResult& syncResult, const BarcodeConfi
     return true;
 }
 
+/**
+ * @brief Queue the barcodes bound to a renamed model for re-verification
+ * @param model The renamed model
+ * @param oldName Part name before the rename
+ * @param newName Part name after the rename
+ */
+void onModelRenamed(ProMdl model, const std::string& oldName, const std::string& newName) {
+    dispatchSyncWarnings();
+    if (g_syncMonitor) {
+        g_syncMonitor->onModelRenamed(model, oldName, newName);
+    }
+}
+
+/**
+ * @brief Queue the barcodes of a saved model for re-verification
+ * 
+ * The name is read here, on Creo's thread; the check itself runs on the
+ * sync monitor's worker after the debounce.
+ * 
+ * @param model The saved model
+ */
+void onModelSaved(ProMdl model) {
+    dispatchSyncWarnings();
+    if (!g_syncMonitor || !g_drawingInterface) {
+        return;
+    }
+    
+    std::string partName;
+    if (g_drawingInterface->getPartName(model, partName) == PRO_TK_NO_ERROR && !partName.empty()) {
+        g_syncMonitor->onModelSaved(model, partName);
+    }
+}
+
+/**
+ * @brief Forget the last known name of a model erased from the session
+ * @param model The model being erased
+ */
+void onModelErased(ProMdl model) {
+    dispatchSyncWarnings();
+    if (g_syncMonitor) {
+        g_syncMonitor->onModelErased(model);
+    }
+}
+
+/**
+ * @brief Show the sync monitor's queued out-of-sync warnings
+ * 
+ * Must run on Creo's thread: the warning callback may call Pro/TOOLKIT.
+ * Called from each notification and menu action.
+ */
+void dispatchSyncWarnings() {
+    if (g_syncMonitor) {
+        g_syncMonitor->dispatchWarnings();
+    }
+}
+
 /**
  * @brief Perform sync check on current drawing's barcode
  * 
@@ -770,6 +1259,7 @@ bool updateBarcodeIfNeeded(const SyncCheckResult& syncResult, const BarcodeConfi
  */
 void onSyncCheckRequested() {
     LOG_INFO("Sync check workflow started");
+    dispatchSyncWarnings();
     
     if (!g_drawingInterface || !g_barcodeGenerator || !g_dataSyncChecker) {
         LOG_ERROR("Plugin components not initialized");
@@ -847,4 +1337,32 @@ DataSyncChecker* getDataSyncChecker() {
     return g_dataSyncChecker.get();
 }
 
+/**
+ * @brief Get the payload index instance
+ * @return Pointer to the payload index, or nullptr if not initialized
+ */
+PayloadIndex* getPayloadIndex() {
+    return g_payloadIndex.get();
+}
+
+/**
+ * @brief Get the barcode audit inventory
+ *
+ * Sync checks append to it from worker threads; read it while no checks
+ * are running.
+ *
+ * @return Pointer to the inventory, or nullptr if not initialized
+ */
+BarcodeInventory* getBarcodeInventory() {
+    return g_barcodeInventory.get();
+}
+
+/**
+ * @brief Get the generated barcode filter instance
+ * @return Pointer to the filter, or nullptr if not initialized
+ */
+GeneratedBarcodeFilter* getGeneratedFilter() {
+    return g_generatedFilter.get();
+}
+
 } // namespace creo_barcode
@@ -0,0 +1,428 @@
+/**
+ * @file payload_index.cpp
+ * @brief Implementation of the payload reverse lookup index
+ *
+ * On-disk layout (little-endian):
+ *   FileHeader
+ *   Record[recordCount]      sorted by payload, then drawing
+ *   char strings[stringsSize] deduplicated, not NUL-terminated
+ */
+
+#include "payload_index.h"
+#include "logger.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string_view>
+#include <filesystem>
+
+namespace creo_barcode {
+
+namespace {
+
+constexpr char INDEX_MAGIC[4] = {'C', 'B', 'P', 'X'};
+constexpr uint32_t INDEX_VERSION = 1;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t recordCount;
+    uint32_t reserved;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+};
+static_assert(sizeof(FileHeader) == 32, "FileHeader layout must be stable");
+
+} // anonymous namespace
+
+struct PayloadIndexView::Record {
+    uint32_t payloadOffset;
+    uint32_t payloadLength;
+    uint32_t drawingOffset;
+    uint32_t drawingLength;
+    uint32_t imageOffset;
+    uint32_t imageLength;
+    int32_t sheet;
+    uint32_t reserved;
+    double posX;
+    double posY;
+};
+
+// ============================================================================
+// PayloadIndexView
+// ============================================================================
+
+bool PayloadIndexView::open(const std::string& path) {
+    static_assert(sizeof(Record) == 48, "Record layout must be stable");
+    close();
+
+    if (!file_.open(path)) {
+        lastError_ = ErrorInfo(ErrorCode::FILE_NOT_FOUND, "Cannot open payload index", path);
+        return false;
+    }
+
+    if (file_.size() < sizeof(FileHeader)) {
+        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Payload index is truncated", path);
+        close();
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+        header.version != INDEX_VERSION) {
+        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Not a payload index file", path);
+        close();
+        return false;
+    }
+
+    uint64_t recordsEnd = sizeof(FileHeader) + static_cast<uint64_t>(header.recordCount) * sizeof(Record);
+    if (recordsEnd > header.stringsOffset ||
+        header.stringsOffset + header.stringsSize > file_.size()) {
+        lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Payload index is corrupt", path);
+        close();
+        return false;
+    }
+
+    recordCount_ = header.recordCount;
+    records_ = reinterpret_cast<const Record*>(file_.data() + sizeof(FileHeader));
+    strings_ = reinterpret_cast<const char*>(file_.data() + header.stringsOffset);
+    stringsSize_ = static_cast<size_t>(header.stringsSize);
+
+    // Reject records that point outside the string table
+    for (size_t i = 0; i < recordCount_; ++i) {
+        const Record& r = records_[i];
+        if (static_cast<uint64_t>(r.payloadOffset) + r.payloadLength > stringsSize_ ||
+            static_cast<uint64_t>(r.drawingOffset) + r.drawingLength > stringsSize_ ||
+            static_cast<uint64_t>(r.imageOffset) + r.imageLength > stringsSize_) {
+            lastError_ = ErrorInfo(ErrorCode::INVALID_DATA, "Payload index is corrupt", path);
+            close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void PayloadIndexView::close() {
+    file_.close();
+    records_ = nullptr;
+    strings_ = nullptr;
+    recordCount_ = 0;
+    stringsSize_ = 0;
+}
+
+std::string PayloadIndexView::payloadAt(size_t index) const {
+    const Record& r = records_[index];
+    return std::string(strings_ + r.payloadOffset, r.payloadLength);
+}
+
+BarcodeLocation PayloadIndexView::locationAt(size_t index) const {
+    const Record& r = records_[index];
+    BarcodeLocation location;
+    location.drawingPath.assign(strings_ + r.drawingOffset, r.drawingLength);
+    location.imagePath.assign(strings_ + r.imageOffset, r.imageLength);
+    location.sheet = r.sheet;
+    location.posX = r.posX;
+    location.posY = r.posY;
+    return location;
+}
+
+std::vector<BarcodeLocation> PayloadIndexView::lookup(const std::string& payload) const {
+    std::vector<BarcodeLocation> result;
+    if (!records_) {
+        return result;
+    }
+
+    auto payloadOf = [this](const Record& r) {
+        return std::string_view(strings_ + r.payloadOffset, r.payloadLength);
+    };
+
+    const std::string_view key(payload);
+    const Record* end = records_ + recordCount_;
+    const Record* it = std::lower_bound(records_, end, key,
+        [&payloadOf](const Record& r, std::string_view k) { return payloadOf(r) < k; });
+
+    for (; it != end && payloadOf(*it) == key; ++it) {
+        result.push_back(locationAt(static_cast<size_t>(it - records_)));
+    }
+    return result;
+}
+
+// ============================================================================
+// PayloadIndex
+// ============================================================================
+
+PayloadIndex::Shard& PayloadIndex::shardFor(const std::string& payload) {
+    return shards_[std::hash<std::string>{}(payload) % SHARD_COUNT];
+}
+
+const PayloadIndex::Shard& PayloadIndex::shardFor(const std::string& payload) const {
+    return shards_[std::hash<std::string>{}(payload) % SHARD_COUNT];
+}
+
+void PayloadIndex::setError(ErrorCode code, const std::string& message, const std::string& details) const {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    lastError_ = ErrorInfo(code, message, details);
+}
+
+ErrorInfo PayloadIndex::getLastError() const {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    return lastError_;
+}
+
+void PayloadIndex::add(const std::string& payload, const BarcodeLocation& location) {
+    if (payload.empty()) {
+        return;
+    }
+
+    Shard& shard = shardFor(payload);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto& locations = shard.entries[payload];
+    for (auto& existing : locations) {
+        if (existing.sameBarcode(location)) {
+            existing.posX = location.posX;
+            existing.posY = location.posY;
+            return;
+        }
+    }
+    locations.push_back(location);
+}
+
+bool PayloadIndex::remove(const std::string& payload, const BarcodeLocation& location) {
+    Shard& shard = shardFor(payload);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(payload);
+    if (it == shard.entries.end()) {
+        return false;
+    }
+
+    auto& locations = it->second;
+    auto pos = std::find_if(locations.begin(), locations.end(),
+        [&location](const BarcodeLocation& l) { return l.sameBarcode(location); });
+    if (pos == locations.end()) {
+        return false;
+    }
+
+    locations.erase(pos);
+    if (locations.empty()) {
+        shard.entries.erase(it);
+    }
+    return true;
+}
+
+size_t PayloadIndex::removeDrawing(const std::string& drawingPath) {
+    size_t removed = 0;
+    for (auto& shard : shards_) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+            auto& locations = it->second;
+            size_t before = locations.size();
+            locations.erase(std::remove_if(locations.begin(), locations.end(),
+                [&drawingPath](const BarcodeLocation& l) { return l.drawingPath == drawingPath; }),
+                locations.end());
+            removed += before - locations.size();
+            it = locations.empty() ? shard.entries.erase(it) : std::next(it);
+        }
+    }
+    return removed;
+}
+
+size_t PayloadIndex::removeImages(const std::unordered_set<std::string>& imagePaths) {
+    if (imagePaths.empty()) {
+        return 0;
+    }
+    size_t removed = 0;
+    for (auto& shard : shards_) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+            auto& locations = it->second;
+            size_t before = locations.size();
+            locations.erase(std::remove_if(locations.begin(), locations.end(),
+                [&imagePaths](const BarcodeLocation& l) { return imagePaths.count(l.imagePath) != 0; }),
+                locations.end());
+            removed += before - locations.size();
+            it = locations.empty() ? shard.entries.erase(it) : std::next(it);
+        }
+    }
+    return removed;
+}
+
+std::vector<BarcodeLocation> PayloadIndex::lookup(const std::string& payload) const {
+    const Shard& shard = shardFor(payload);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(payload);
+    if (it == shard.entries.end()) {
+        return {};
+    }
+    return it->second;
+}
+
+std::vector<std::string> PayloadIndex::findDrawings(const std::string& payload) const {
+    std::vector<std::string> drawings;
+    for (const auto& location : lookup(payload)) {
+        if (std::find(drawings.begin(), drawings.end(), location.drawingPath) == drawings.end()) {
+            drawings.push_back(location.drawingPath);
+        }
+    }
+    return drawings;
+}
+
+size_t PayloadIndex::renamePayload(const std::string& oldPayload, const std::string& newPayload) {
+    if (oldPayload == newPayload || newPayload.empty()) {
+        return 0;
+    }
+
+    std::vector<BarcodeLocation> moved;
+    {
+        Shard& shard = shardFor(oldPayload);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(oldPayload);
+        if (it == shard.entries.end()) {
+            return 0;
+        }
+        moved = std::move(it->second);
+        shard.entries.erase(it);
+    }
+
+    // Locks are taken one shard at a time so renames never deadlock
+    for (const auto& location : moved) {
+        add(newPayload, location);
+    }
+
+    LOG_INFO("Payload index: moved " + std::to_string(moved.size()) +
+             " locations from '" + oldPayload + "' to '" + newPayload + "'");
+    return moved.size();
+}
+
+size_t PayloadIndex::size() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (const auto& entry : shard.entries) {
+            total += entry.second.size();
+        }
+    }
+    return total;
+}
+
+size_t PayloadIndex::payloadCount() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.entries.size();
+    }
+    return total;
+}
+
+void PayloadIndex::clear() {
+    for (auto& shard : shards_) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.entries.clear();
+    }
+}
+
+bool PayloadIndex::save(const std::string& path) const {
+    using Record = PayloadIndexView::Record;
+
+    // Snapshot all entries, then sort so the file supports binary search
+    std::vector<std::pair<std::string, BarcodeLocation>> entries;
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (const auto& entry : shard.entries) {
+            for (const auto& location : entry.second) {
+                entries.emplace_back(entry.first, location);
+            }
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        if (a.first != b.first) return a.first < b.first;
+        return a.second.drawingPath < b.second.drawingPath;
+    });
+
+    // Build the deduplicated string table
+    std::string strings;
+    std::unordered_map<std::string, uint32_t> stringOffsets;
+    auto internString = [&strings, &stringOffsets](const std::string& s) {
+        auto it = stringOffsets.find(s);
+        if (it != stringOffsets.end()) {
+            return it->second;
+        }
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings += s;
+        stringOffsets.emplace(s, offset);
+        return offset;
+    };
+
+    std::vector<Record> records;
+    records.reserve(entries.size());
+    for (const auto& entry : entries) {
+        Record r{};
+        r.payloadOffset = internString(entry.first);
+        r.payloadLength = static_cast<uint32_t>(entry.first.size());
+        r.drawingOffset = internString(entry.second.drawingPath);
+        r.drawingLength = static_cast<uint32_t>(entry.second.drawingPath.size());
+        r.imageOffset = internString(entry.second.imagePath);
+        r.imageLength = static_cast<uint32_t>(entry.second.imagePath.size());
+        r.sheet = entry.second.sheet;
+        r.posX = entry.second.posX;
+        r.posY = entry.second.posY;
+        records.push_back(r);
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version = INDEX_VERSION;
+    header.recordCount = static_cast<uint32_t>(records.size());
+    header.stringsOffset = sizeof(FileHeader) + records.size() * sizeof(Record);
+    header.stringsSize = strings.size();
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            setError(ErrorCode::CONFIG_SAVE_FAILED, "Cannot write payload index", tempPath);
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(records.data()),
+                  static_cast<std::streamsize>(records.size() * sizeof(Record)));
+        out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+        if (!out.good()) {
+            setError(ErrorCode::CONFIG_SAVE_FAILED, "Failed writing payload index", tempPath);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        setError(ErrorCode::CONFIG_SAVE_FAILED, "Cannot replace payload index", ec.message());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool PayloadIndex::load(const std::string& path) {
+    PayloadIndexView view;
+    if (!view.open(path)) {
+        ErrorInfo err = view.getLastError();
+        setError(err.code, err.message, err.details);
+        return false;
+    }
+
+    clear();
+    view.forEach([this](const std::string& payload, const BarcodeLocation& location) {
+        add(payload, location);
+    });
+    return true;
+}
+
+} // namespace creo_barcode
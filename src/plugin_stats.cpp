@@ -0,0 +1,183 @@
+/**
+ * @file plugin_stats.cpp
+ * @brief Implementation of session statistics and latency histograms
+ */
+
+#include "plugin_stats.h"
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+#include <sstream>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace creo_barcode {
+
+namespace {
+
+// Index of the highest set bit; value must be non-zero
+unsigned highestBit(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+}
+
+std::string formatDuration(uint64_t nanos) {
+    char text[32];
+    if (nanos >= 1000000) {
+        std::snprintf(text, sizeof(text), "%.2f ms", nanos / 1e6);
+    } else {
+        std::snprintf(text, sizeof(text), "%.1f us", nanos / 1e3);
+    }
+    return text;
+}
+
+} // anonymous namespace
+
+const char* statsStageName(StatsStage stage) {
+    switch (stage) {
+        case StatsStage::GENERATE: return "generate";
+        case StatsStage::ENCODE: return "encode";
+        case StatsStage::PNG_WRITE: return "png_write";
+        case StatsStage::DECODE: return "decode";
+        case StatsStage::SYNC_CHECK: return "sync_check";
+        case StatsStage::COM_INSERT: return "com_insert";
+        default: return "unknown";
+    }
+}
+
+// Values below 4 get a bucket each; above that, each power of two is split
+// into four equal sub-ranges selected by the two bits below the top bit
+size_t LatencyHistogram::bucketIndex(uint64_t nanos) {
+    if (nanos < 4) {
+        return static_cast<size_t>(nanos);
+    }
+    unsigned top = highestBit(nanos);
+    unsigned sub = static_cast<unsigned>((nanos >> (top - 2)) & 3);
+    return (top - 1) * 4 + sub;
+}
+
+uint64_t LatencyHistogram::bucketLowerBound(size_t index) {
+    if (index < 4) {
+        return index;
+    }
+    unsigned top = static_cast<unsigned>(index / 4 + 1);
+    uint64_t sub = index % 4;
+    return (4 + sub) << (top - 2);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < 4) {
+        return index + 1;
+    }
+    unsigned top = static_cast<unsigned>(index / 4 + 1);
+    return bucketLowerBound(index) + (uint64_t(1) << (top - 2));
+}
+
+void LatencyHistogram::record(uint64_t nanos) {
+    buckets_[bucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    totalNanos_.fetch_add(nanos, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::percentile(double fraction) const {
+    std::array<uint64_t, BUCKET_COUNT> counts;
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // 1-based rank of the requested sample
+    uint64_t rank = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(total)));
+    if (rank < 1) rank = 1;
+    if (rank > total) rank = total;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            uint64_t lower = bucketLowerBound(i);
+            return lower + (bucketUpperBound(i) - lower) / 2;
+        }
+    }
+    return bucketLowerBound(BUCKET_COUNT - 1);
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    totalNanos_.store(0, std::memory_order_relaxed);
+}
+
+PluginStats& PluginStats::global() {
+    // Never destroyed: worker threads may still record during DLL unload
+    static PluginStats* instance = nullptr;
+    static std::once_flag flag;
+    std::call_once(flag, []() {
+        instance = new PluginStats();
+    });
+    return *instance;
+}
+
+StatsSnapshot PluginStats::snapshot() const {
+    StatsSnapshot result;
+    result.barcodesGenerated = barcodesGenerated_.load(std::memory_order_relaxed);
+    result.cacheHits = cacheHits_.load(std::memory_order_relaxed);
+    result.decodeAttempts = decodeAttempts_.load(std::memory_order_relaxed);
+    result.decodeFailures = decodeFailures_.load(std::memory_order_relaxed);
+    result.bytesWritten = bytesWritten_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < stages_.size(); ++i) {
+        StageStats& stage = result.stages[i];
+        stage.count = stages_[i].count();
+        stage.totalNanos = stages_[i].totalNanos();
+        stage.p50Nanos = stages_[i].percentile(0.50);
+        stage.p99Nanos = stages_[i].percentile(0.99);
+    }
+    return result;
+}
+
+void PluginStats::reset() {
+    barcodesGenerated_.store(0, std::memory_order_relaxed);
+    cacheHits_.store(0, std::memory_order_relaxed);
+    decodeAttempts_.store(0, std::memory_order_relaxed);
+    decodeFailures_.store(0, std::memory_order_relaxed);
+    bytesWritten_.store(0, std::memory_order_relaxed);
+    for (auto& stage : stages_) {
+        stage.reset();
+    }
+}
+
+std::string PluginStats::formatSummary(const StatsSnapshot& snapshot) {
+    std::ostringstream summary;
+    summary << "Session statistics\n";
+    summary << "  Barcodes generated: " << snapshot.barcodesGenerated << "\n";
+    summary << "  Render cache hits: " << snapshot.cacheHits << "\n";
+    summary << "  Decodes: " << snapshot.decodeAttempts
+            << " (" << snapshot.decodeFailures << " failed)\n";
+    summary << "  Bytes written: " << snapshot.bytesWritten << "\n";
+    for (size_t i = 0; i < snapshot.stages.size(); ++i) {
+        const StageStats& stage = snapshot.stages[i];
+        if (stage.count == 0) {
+            continue;
+        }
+        summary << "  " << statsStageName(static_cast<StatsStage>(i))
+                << ": " << stage.count << " calls, total " << formatDuration(stage.totalNanos)
+                << ", p50 " << formatDuration(stage.p50Nanos)
+                << ", p99 " << formatDuration(stage.p99Nanos) << "\n";
+    }
+    return summary.str();
+}
+
+} // namespace creo_barcode
@@ -0,0 +1,129 @@
+/**
+ * @file render_cache.cpp
+ * @brief Implementation of the rendered barcode cache
+ */
+
+#include "render_cache.h"
+#include "content_hash.h"
+
+namespace creo_barcode {
+
+RenderCache::RenderCache(size_t capacityBytes)
+    : capacityBytes_(capacityBytes) {
+}
+
+RenderCache& RenderCache::global() {
+    static RenderCache* instance = nullptr;
+    static std::once_flag flag;
+    std::call_once(flag, []() {
+        instance = new RenderCache();
+    });
+    return *instance;
+}
+
+size_t RenderCache::KeyHasher::operator()(const Key& key) const {
+    return static_cast<size_t>(hashCombine(hashBytes64(key.payload.data(), key.payload.size()),
+                                           key.configHash));
+}
+
+RenderCache::Key RenderCache::makeKey(const std::string& payload, const BarcodeConfig& config) {
+    return Key{payload, hashBarcodeConfig(config)};
+}
+
+std::shared_ptr<const RenderedImage> RenderCache::find(const std::string& payload,
+                                                        const BarcodeConfig& config) {
+    Key key = makeKey(payload, config);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        ++misses_;
+        return nullptr;
+    }
+    ++hits_;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->image;
+}
+
+bool RenderCache::contains(const std::string& payload, const BarcodeConfig& config) const {
+    Key key = makeKey(payload, config);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.find(key) != index_.end();
+}
+
+void RenderCache::insert(const std::string& payload, const BarcodeConfig& config,
+                         std::shared_ptr<const RenderedImage> image) {
+    if (!image || image->pixels.empty() || image->pixels.size() > capacityBytes_) {
+        return;
+    }
+
+    Key key = makeKey(payload, config);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        bytes_ -= it->second->image->pixels.size();
+        it->second->image = std::move(image);
+        bytes_ += it->second->image->pixels.size();
+        lru_.splice(lru_.begin(), lru_, it->second);
+    } else {
+        bytes_ += image->pixels.size();
+        lru_.push_front(Entry{key, std::move(image)});
+        index_.emplace(std::move(key), lru_.begin());
+    }
+    evictLocked();
+}
+
+void RenderCache::evictLocked() {
+    // The newest entry always fits, so this never empties the list
+    while (bytes_ > capacityBytes_ && !lru_.empty()) {
+        Entry& oldest = lru_.back();
+        bytes_ -= oldest.image->pixels.size();
+        index_.erase(oldest.key);
+        lru_.pop_back();
+    }
+}
+
+void RenderCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    lru_.clear();
+    bytes_ = 0;
+}
+
+size_t RenderCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.size();
+}
+
+size_t RenderCache::bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+}
+
+uint64_t RenderCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+uint64_t RenderCache::misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+bool renderBarcodeImage(const std::string& data, const BarcodeConfig& config,
+                        RenderedImage& image, std::string& error) {
+    BarcodeGenerator generator;
+    if (!generator.renderGray(data, config, image.pixels)) {
+        const Error& failure = generator.lastError();
+        error = failure.message();
+        if (!failure.detail().empty()) {
+            error += ": ";
+            error += failure.detail();
+        }
+        return false;
+    }
+    image.width = config.width;
+    image.height = config.height;
+    return true;
+}
+
+} // namespace creo_barcode
@@ -152,7 +152,30 @@ DialogResult SettingsDialog::show(const BarcodeConfig& initialConfig) {
         setError(ErrorCode::INVALID_DATA, validation.errorMessage, validation.fieldName);
     }
     
+    currentConfig_ = initialConfig;
+    if (preview_ && validation.valid) {
+        preview_->update(initialConfig);
+    }
+    
     return result;
 }
 
+void SettingsDialog::enablePreview(SettingsPreview::FrameCallback onFrame, const PreviewOptions& options) {
+    preview_ = std::make_unique<SettingsPreview>(std::move(onFrame), options);
+}
+
+ValidationResult SettingsDialog::onConfigEdited(const BarcodeConfig& config) {
+    ValidationResult validation = validateConfig(config);
+    if (!validation.valid) {
+        // Keep showing the last valid preview while the field is wrong
+        return validation;
+    }
+    
+    currentConfig_ = config;
+    if (preview_) {
+        preview_->update(config);
+    }
+    return validation;
+}
+
 } // namespace creo_barcode
@@ -0,0 +1,188 @@
+/**
+ * @file settings_preview.cpp
+ * @brief Implementation of the progressive settings preview
+ */
+
+#include "settings_preview.h"
+#include "settings_dialog.h"
+#include "trace.h"
+#include <algorithm>
+
+namespace creo_barcode {
+
+SettingsPreview::SettingsPreview(FrameCallback onFrame, const PreviewOptions& options, RenderFn render)
+    : onFrame_(std::move(onFrame))
+    , options_(options)
+    , render_(render ? std::move(render) : RenderFn(renderBarcodeImage)) {
+    worker_ = std::thread(&SettingsPreview::workerLoop, this);
+}
+
+SettingsPreview::~SettingsPreview() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+BarcodeConfig SettingsPreview::draftConfig(const BarcodeConfig& config, int divisor) {
+    BarcodeConfig draft = config;
+    if (divisor > 1) {
+        draft.width = std::max(1, config.width / divisor);
+        draft.height = std::max(1, config.height / divisor);
+        draft.margin = config.margin / divisor;
+    }
+    return draft;
+}
+
+uint64_t SettingsPreview::update(const BarcodeConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.updates;
+    pending_ = config;
+    ++generation_;
+    finalPending_ = true;
+    lastUpdate_ = std::chrono::steady_clock::now();
+    wake_.notify_all();
+    return generation_;
+}
+
+void SettingsPreview::cancel() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generation_;
+    draftedGeneration_ = generation_;
+    finalPending_ = false;
+    latest_ = PreviewFrame();
+    wake_.notify_all();
+}
+
+PreviewFrame SettingsPreview::latest() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return latest_;
+}
+
+bool SettingsPreview::waitIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return idle_.wait_for(lock, timeout, [this]() {
+        return draftedGeneration_ == generation_ && !finalPending_ && !busy_;
+    });
+}
+
+PreviewStats SettingsPreview::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+PreviewFrame SettingsPreview::renderFrame(uint64_t generation, PreviewStage stage,
+                                          const BarcodeConfig& config) {
+    TRACE_SCOPE("preview", stage == PreviewStage::DRAFT ? "draft" : "final");
+    PreviewFrame frame;
+    frame.generation = generation;
+    frame.stage = stage;
+    frame.config = config;
+
+    if (options_.cache) {
+        if (auto cached = options_.cache->find(options_.samplePayload, config)) {
+            frame.image = std::move(cached);
+            frame.cached = true;
+            return frame;
+        }
+    }
+
+    auto image = std::make_shared<RenderedImage>();
+    if (!render_(options_.samplePayload, config, *image, frame.error)) {
+        if (frame.error.empty()) {
+            frame.error = "Preview rendering failed";
+        }
+        return frame;
+    }
+    if (options_.cache) {
+        options_.cache->insert(options_.samplePayload, config, image);
+    }
+    frame.image = std::move(image);
+    return frame;
+}
+
+void SettingsPreview::deliver(std::unique_lock<std::mutex>& lock, PreviewFrame frame) {
+    if (frame.generation != generation_) {
+        ++stats_.discarded;
+        return;
+    }
+    if (frame.stage == PreviewStage::DRAFT) {
+        ++stats_.drafts;
+    } else {
+        ++stats_.finals;
+    }
+    latest_ = frame;
+
+    if (onFrame_) {
+        // Outside the lock so the callback may call update() or cancel()
+        busy_ = true;
+        lock.unlock();
+        onFrame_(frame);
+        lock.lock();
+        busy_ = false;
+    }
+}
+
+void SettingsPreview::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (draftedGeneration_ != generation_) {
+            // A new configuration: validate it and show a draft right away
+            uint64_t generation = generation_;
+            BarcodeConfig config = pending_;
+            draftedGeneration_ = generation;
+
+            ValidationResult validation = SettingsDialog::validateConfig(config);
+            if (!validation.valid) {
+                finalPending_ = false;
+                PreviewFrame frame;
+                frame.generation = generation;
+                frame.config = config;
+                frame.error = validation.errorMessage;
+                deliver(lock, std::move(frame));
+                continue;
+            }
+            if (options_.draftDivisor > 1) {
+                busy_ = true;
+                lock.unlock();
+                PreviewFrame frame = renderFrame(generation, PreviewStage::DRAFT,
+                                                 draftConfig(config, options_.draftDivisor));
+                lock.lock();
+                busy_ = false;
+                stats_.renders += frame.cached ? 0 : 1;
+                deliver(lock, std::move(frame));
+            }
+            continue;
+        }
+
+        if (finalPending_) {
+            // Full resolution only once the user has stopped editing
+            auto due = lastUpdate_ + options_.debounce;
+            if (std::chrono::steady_clock::now() < due) {
+                wake_.wait_until(lock, due);
+                continue;
+            }
+            finalPending_ = false;
+            uint64_t generation = generation_;
+            BarcodeConfig config = pending_;
+            busy_ = true;
+            lock.unlock();
+            PreviewFrame frame = renderFrame(generation, PreviewStage::FINAL, config);
+            lock.lock();
+            busy_ = false;
+            stats_.renders += frame.cached ? 0 : 1;
+            deliver(lock, std::move(frame));
+            continue;
+        }
+
+        idle_.notify_all();
+        wake_.wait(lock);
+    }
+    idle_.notify_all();
+}
+
+} // namespace creo_barcode
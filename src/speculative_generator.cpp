@@ -0,0 +1,168 @@
+/**
+ * @file speculative_generator.cpp
+ * @brief Implementation of speculative barcode pre-rendering
+ */
+
+#include "speculative_generator.h"
+#include "binary_log.h"
+#include "trace.h"
+#include <algorithm>
+#include <memory>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace creo_barcode {
+
+namespace {
+
+// Keep speculative work from competing with Creo and interactive generation
+void lowerCurrentThreadPriority() {
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#elif defined(__linux__)
+    // Linux nice values are per thread when addressed by thread id
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+#endif
+}
+
+} // anonymous namespace
+
+SpeculativeGenerator::SpeculativeGenerator(const SpeculationOptions& options, RenderFn render)
+    : options_(options)
+    , render_(render ? std::move(render) : RenderFn(renderBarcodeImage)) {
+    worker_ = std::thread(&SpeculativeGenerator::workerLoop, this);
+}
+
+SpeculativeGenerator::~SpeculativeGenerator() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+uint64_t SpeculativeGenerator::activate(ProDrawing drawing, std::vector<std::string> partNames,
+                                        const BarcodeConfig& config) {
+    // Assemblies list a part once per instance
+    std::vector<std::string> unique;
+    for (auto& name : partNames) {
+        if (unique.size() >= options_.maxParts) {
+            break;
+        }
+        if (!name.empty() && std::find(unique.begin(), unique.end(), name) == unique.end()) {
+            unique.push_back(std::move(name));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.activations;
+    drawing_ = drawing;
+    partNames_ = std::move(unique);
+    config_ = config;
+    ++generation_;
+    wake_.notify_all();
+    return generation_;
+}
+
+void SpeculativeGenerator::cancel() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    drawing_ = nullptr;
+    partNames_.clear();
+    ++generation_;
+    doneGeneration_ = generation_;
+    wake_.notify_all();
+}
+
+ProDrawing SpeculativeGenerator::activeDrawing() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return drawing_;
+}
+
+bool SpeculativeGenerator::waitIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return idle_.wait_for(lock, timeout, [this]() {
+        return doneGeneration_ == generation_ && !busy_;
+    });
+}
+
+SpeculationStats SpeculativeGenerator::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+SpeculativeGenerator::Outcome SpeculativeGenerator::speculate(const std::string& partName,
+                                                              const BarcodeConfig& config) {
+    TRACE_SCOPE("speculative", "render");
+    // Same payload onGenerateBarcodeRequested derives, so its lookup hits
+    std::string data = encoder_.encodeSpecialChars(partName);
+    if (!encoder_.validateData(data, config.type)) {
+        return Outcome::INVALID;
+    }
+    if (!options_.cache || options_.cache->contains(data, config)) {
+        return Outcome::CACHED;
+    }
+
+    auto image = std::make_shared<RenderedImage>();
+    std::string error;
+    if (!render_(data, config, *image, error)) {
+        BLOG_VERBOSE("Speculative render of {} failed: {}", partName, error);
+        return Outcome::FAILED;
+    }
+    options_.cache->insert(data, config, std::move(image));
+    return Outcome::RENDERED;
+}
+
+void SpeculativeGenerator::workerLoop() {
+    if (options_.lowPriority) {
+        lowerCurrentThreadPriority();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (doneGeneration_ != generation_) {
+            uint64_t generation = generation_;
+            std::vector<std::string> partNames = partNames_;
+            BarcodeConfig config = config_;
+
+            size_t next = 0;
+            for (; next < partNames.size(); ++next) {
+                // Checked between parts: a newer activation wins right away
+                if (stopping_ || generation != generation_) {
+                    break;
+                }
+                busy_ = true;
+                lock.unlock();
+                Outcome outcome = speculate(partNames[next], config);
+                lock.lock();
+                busy_ = false;
+
+                switch (outcome) {
+                    case Outcome::RENDERED: ++stats_.rendered; break;
+                    case Outcome::CACHED: ++stats_.alreadyCached; break;
+                    case Outcome::INVALID: ++stats_.invalid; break;
+                    case Outcome::FAILED: ++stats_.failed; break;
+                }
+            }
+            stats_.cancelled += partNames.size() - next;
+            if (generation == generation_) {
+                doneGeneration_ = generation;
+            }
+            continue;
+        }
+
+        idle_.notify_all();
+        wake_.wait(lock);
+    }
+    idle_.notify_all();
+}
+
+} // namespace creo_barcode
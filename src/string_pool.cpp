@@ -0,0 +1,116 @@
+/**
+ * @file string_pool.cpp
+ * @brief Implementation of the string intern pool
+ */
+
+#include "string_pool.h"
+#include "content_hash.h"
+#include <cstring>
+#include <mutex>
+
+namespace creo_barcode {
+
+size_t StringPool::ViewHash::operator()(std::string_view value) const {
+    return static_cast<size_t>(hash64(value));
+}
+
+StringPool& StringPool::global() {
+    static StringPool pool;
+    return pool;
+}
+
+StringPool::Shard& StringPool::shardFor(std::string_view value) {
+    // Use the high bits; the low bits pick the bucket inside the shard
+    return shards_[(hash64(value) >> 60) % SHARD_COUNT];
+}
+
+const StringPool::Shard& StringPool::shardFor(std::string_view value) const {
+    return shards_[(hash64(value) >> 60) % SHARD_COUNT];
+}
+
+const char* StringPool::Shard::store(std::string_view value) {
+    size_t needed = value.size() + 1;
+
+    char* dest;
+    if (needed > CHUNK_SIZE / 4) {
+        // Large strings get their own block so chunks are not wasted
+        blocks.emplace_back(new char[needed]);
+        reservedBytes += needed;
+        dest = blocks.back().get();
+    } else {
+        if (chunkUsed + needed > CHUNK_SIZE) {
+            blocks.emplace_back(new char[CHUNK_SIZE]);
+            reservedBytes += CHUNK_SIZE;
+            chunk = blocks.back().get();
+            chunkUsed = 0;
+        }
+        dest = chunk + chunkUsed;
+        chunkUsed += needed;
+    }
+
+    std::memcpy(dest, value.data(), value.size());
+    dest[value.size()] = '\0';
+    return dest;
+}
+
+InternedString StringPool::intern(std::string_view value) {
+    if (value.empty()) {
+        return InternedString();
+    }
+
+    Shard& shard = shardFor(value);
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.strings.find(value);
+        if (it != shard.strings.end()) {
+            return InternedString(it->data(), it->size());
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    // Another thread may have added it between the two locks
+    auto it = shard.strings.find(value);
+    if (it != shard.strings.end()) {
+        return InternedString(it->data(), it->size());
+    }
+
+    const char* stored = shard.store(value);
+    shard.strings.emplace(stored, value.size());
+    return InternedString(stored, value.size());
+}
+
+InternedString StringPool::find(std::string_view value, bool& found) const {
+    found = value.empty();
+    if (value.empty()) {
+        return InternedString();
+    }
+
+    const Shard& shard = shardFor(value);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.strings.find(value);
+    if (it == shard.strings.end()) {
+        return InternedString();
+    }
+    found = true;
+    return InternedString(it->data(), it->size());
+}
+
+size_t StringPool::size() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.strings.size();
+    }
+    return total;
+}
+
+size_t StringPool::memoryBytes() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.reservedBytes;
+    }
+    return total;
+}
+
+} // namespace creo_barcode
@@ -0,0 +1,196 @@
+/**
+ * @file sync_monitor.cpp
+ * @brief Implementation of event-driven sync checking
+ */
+
+#include "sync_monitor.h"
+#include "payload_index.h"
+#include "binary_log.h"
+#include "trace.h"
+#include <algorithm>
+
+namespace creo_barcode {
+
+SyncMonitor::SyncMonitor(DataSyncChecker& checker, PayloadIndex& index,
+                         std::chrono::milliseconds debounce)
+    : checker_(checker)
+    , index_(index)
+    , debounce_(debounce) {
+    worker_ = std::thread(&SyncMonitor::workerLoop, this);
+}
+
+SyncMonitor::~SyncMonitor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void SyncMonitor::enqueueLocked(ProMdl model, const std::string& previousName,
+                                const std::string& currentName) {
+    PendingChange& change = pending_[model];
+    if (!previousName.empty() && previousName != currentName &&
+        std::find(change.previousNames.begin(), change.previousNames.end(),
+                  previousName) == change.previousNames.end()) {
+        change.previousNames.push_back(previousName);
+    }
+    change.currentName = currentName;
+    knownNames_[model] = currentName;
+
+    ++stats_.events;
+    lastEvent_ = std::chrono::steady_clock::now();
+    wake_.notify_all();
+}
+
+void SyncMonitor::onModelRenamed(ProMdl model, const std::string& oldName, const std::string& newName) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    enqueueLocked(model, oldName, newName);
+}
+
+void SyncMonitor::onModelSaved(ProMdl model, const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto known = knownNames_.find(model);
+    std::string previousName = known != knownNames_.end() ? known->second : std::string();
+    enqueueLocked(model, previousName, name);
+}
+
+void SyncMonitor::onModelErased(ProMdl model) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    knownNames_.erase(model);
+}
+
+size_t SyncMonitor::dispatchWarnings() {
+    std::vector<BarcodeInstance> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ready.swap(warnings_);
+        stats_.dispatched += ready.size();
+    }
+    for (const auto& instance : ready) {
+        checker_.displayWarning(instance, nullptr);
+    }
+    return ready.size();
+}
+
+void SyncMonitor::queueWarningsLocked(std::vector<BarcodeInstance>& warnings) {
+    for (auto& warning : warnings) {
+        // A newer check of the same barcode replaces the queued warning
+        auto same = std::find_if(warnings_.begin(), warnings_.end(), [&](const BarcodeInstance& queued) {
+            return queued.drawingPath == warning.drawingPath && queued.sheet == warning.sheet &&
+                   queued.imagePath == warning.imagePath;
+        });
+        if (same != warnings_.end()) {
+            *same = std::move(warning);
+            continue;
+        }
+        if (warnings_.size() >= MAX_PENDING_WARNINGS) {
+            // Nobody has dispatched for a while; keep the newest
+            warnings_.erase(warnings_.begin());
+            ++stats_.dropped;
+        }
+        warnings_.push_back(std::move(warning));
+    }
+}
+
+size_t SyncMonitor::pendingWarnings() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return warnings_.size();
+}
+
+size_t SyncMonitor::pendingModels() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+bool SyncMonitor::waitIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return idle_.wait_for(lock, timeout, [this]() { return pending_.empty() && !busy_; });
+}
+
+SyncMonitorStats SyncMonitor::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void SyncMonitor::verify(const ChangeMap& changes, SyncMonitorStats& pass,
+                         std::vector<BarcodeInstance>& warnings) {
+    TRACE_SCOPE("sync", "event_pass");
+    for (const auto& entry : changes) {
+        const PendingChange& change = entry.second;
+        if (change.currentName.empty()) {
+            continue;
+        }
+        ++pass.modelsChecked;
+
+        // Barcodes still carrying an earlier name, plus those already
+        // carrying the current one (a rename back clears their warning)
+        std::vector<std::string> names = change.previousNames;
+        names.erase(std::remove(names.begin(), names.end(), change.currentName), names.end());
+        names.push_back(change.currentName);
+
+        for (const auto& name : names) {
+            std::string payload = codec_.encodeSpecialChars(name);
+            for (const auto& location : index_.lookup(payload)) {
+                BarcodeInstance instance;
+                instance.imagePath = location.imagePath;
+                instance.encodedData = payload;
+                instance.decodedData = name;
+                instance.drawingPath = location.drawingPath;
+                instance.sheet = location.sheet;
+                instance.posX = location.posX;
+                instance.posY = location.posY;
+
+                SyncCheckResult result = checker_.checkSync(change.currentName, instance);
+                ++pass.barcodesChecked;
+                if (result.needsUpdate()) {
+                    ++pass.outOfSync;
+                    warnings.push_back(std::move(instance));
+                }
+            }
+        }
+    }
+}
+
+void SyncMonitor::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (!pending_.empty()) {
+            // Let a burst of renames/saves settle into one pass
+            auto due = lastEvent_ + debounce_;
+            if (std::chrono::steady_clock::now() < due) {
+                wake_.wait_until(lock, due);
+                continue;
+            }
+
+            ChangeMap changes;
+            changes.swap(pending_);
+            busy_ = true;
+            lock.unlock();
+            SyncMonitorStats pass;
+            std::vector<BarcodeInstance> warnings;
+            verify(changes, pass, warnings);
+            lock.lock();
+            busy_ = false;
+
+            queueWarningsLocked(warnings);
+
+            ++stats_.passes;
+            stats_.modelsChecked += pass.modelsChecked;
+            stats_.barcodesChecked += pass.barcodesChecked;
+            stats_.outOfSync += pass.outOfSync;
+            BLOG_VERBOSE("Sync pass: {} models, {} barcodes, {} out of sync",
+                         pass.modelsChecked, pass.barcodesChecked, pass.outOfSync);
+            continue;
+        }
+
+        idle_.notify_all();
+        wake_.wait(lock);
+    }
+    idle_.notify_all();
+}
+
+} // namespace creo_barcode
@@ -0,0 +1,102 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Implementation of the fixed-size worker pool
+ */
+
+#include "thread_pool.h"
+#include <algorithm>
+
+namespace creo_barcode {
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    workers_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+        workerIds_.push_back(workers_.back().get_id());
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    shutdown();
+}
+
+ThreadPool& ThreadPool::shared() {
+    // Leaked like the other singletons; shutdownShared() joins the workers
+    static ThreadPool* instance = nullptr;
+    static std::once_flag flag;
+    std::call_once(flag, []() {
+        instance = new ThreadPool();
+    });
+    return *instance;
+}
+
+void ThreadPool::shutdownShared() {
+    shared().shutdown();
+}
+
+bool ThreadPool::submit(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return false;
+        }
+        tasks_.push_back(std::move(task));
+    }
+    wakeWorkers_.notify_one();
+    return true;
+}
+
+void ThreadPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    wakeWorkers_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+size_t ThreadPool::pendingTasks() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+}
+
+bool ThreadPool::isWorkerThread() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::find(workerIds_.begin(), workerIds_.end(), std::this_thread::get_id()) != workerIds_.end();
+}
+
+void ThreadPool::workerLoop() {
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wakeWorkers_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            // Drain the queue before exiting so submitted work is never lost
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        try {
+            task();
+        } catch (...) {
+            // A failing task must not take the worker (and the host) down
+        }
+    }
+}
+
+} // namespace creo_barcode
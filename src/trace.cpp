@@ -0,0 +1,248 @@
+/**
+ * @file trace.cpp
+ * @brief Implementation of timeline tracing and Chrome trace export
+ */
+
+#include "trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+namespace creo_barcode {
+
+namespace {
+
+void writeJsonString(std::ostream& out, std::string_view value) {
+    out << '"';
+    for (char c : value) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    out << escaped;
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+// Chrome trace timestamps are microseconds; keep nanosecond precision
+void writeMicros(std::ostream& out, uint64_t nanos) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03u",
+                  static_cast<unsigned long long>(nanos / 1000), static_cast<unsigned>(nanos % 1000));
+    out << text;
+}
+
+} // anonymous namespace
+
+namespace trace_detail {
+
+uint64_t nowNanos() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace trace_detail
+
+// Owns the calling thread's buffer; hands its events to the tracer on thread exit
+struct TracerThreadHolder {
+    Tracer::ThreadBuffer* buffer = nullptr;
+
+    ~TracerThreadHolder() {
+        if (buffer) {
+            Tracer::getInstance().retireBuffer(buffer);
+        }
+    }
+};
+
+Tracer& Tracer::getInstance() {
+    // Never destroyed, so exiting threads can always retire their buffers
+    static Tracer* instance = nullptr;
+    static std::once_flag flag;
+    std::call_once(flag, []() {
+        instance = new Tracer();
+    });
+    return *instance;
+}
+
+std::string Tracer::defaultPath() {
+#ifdef _WIN32
+    const char* temp = std::getenv("TEMP");
+    if (temp) {
+        return std::string(temp) + "\\creo_barcode_trace.json";
+    }
+    return "creo_barcode_trace.json";
+#else
+    return "/tmp/creo_barcode_trace.json";
+#endif
+}
+
+Tracer::ThreadBuffer& Tracer::localBuffer() {
+    thread_local TracerThreadHolder holder;
+    if (!holder.buffer) {
+        holder.buffer = new ThreadBuffer();
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        holder.buffer->threadIndex = nextThreadIndex_++;
+        buffers_.push_back(holder.buffer);
+    }
+    return *holder.buffer;
+}
+
+void Tracer::retireBuffer(ThreadBuffer* buffer) {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    buffers_.erase(std::remove(buffers_.begin(), buffers_.end(), buffer), buffers_.end());
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        retiredEvents_.insert(retiredEvents_.end(), buffer->events.begin(), buffer->events.end());
+        if (!buffer->threadName.empty()) {
+            retiredThreadNames_.emplace_back(buffer->threadIndex, buffer->threadName);
+        }
+    }
+    delete buffer;
+}
+
+void Tracer::start() {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    for (auto* buffer : buffers_) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->events.clear();
+    }
+    retiredEvents_.clear();
+    retiredThreadNames_.clear();
+    dropped_.store(0, std::memory_order_relaxed);
+    epochNanos_.store(trace_detail::nowNanos(), std::memory_order_relaxed);
+    trace_detail::enabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::stop() {
+    trace_detail::enabled.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::setCurrentThreadName(const std::string& name) {
+    ThreadBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.threadName = name;
+}
+
+void Tracer::record(const char* category, const char* name, InternedString detail,
+                    uint64_t startNanos, uint64_t endNanos) {
+    uint64_t epoch = epochNanos_.load(std::memory_order_relaxed);
+    // Scope opened before the current start(); it belongs to no trace
+    if (startNanos < epoch) {
+        return;
+    }
+
+    ThreadBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.events.size() >= MAX_EVENTS_PER_THREAD) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer.events.push_back(TraceEvent{category, name, detail, startNanos - epoch,
+                                       endNanos - startNanos, buffer.threadIndex});
+}
+
+std::vector<TraceEvent> Tracer::collectEvents() {
+    std::vector<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        events = retiredEvents_;
+        for (auto* buffer : buffers_) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            events.insert(events.end(), buffer->events.begin(), buffer->events.end());
+        }
+    }
+    std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+        return a.startNanos < b.startNanos;
+    });
+    return events;
+}
+
+bool Tracer::exportChromeTrace(const std::string& path) {
+    std::vector<TraceEvent> events = collectEvents();
+    std::vector<std::pair<uint32_t, std::string>> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        threadNames = retiredThreadNames_;
+        for (auto* buffer : buffers_) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            if (!buffer->threadName.empty()) {
+                threadNames.emplace_back(buffer->threadIndex, buffer->threadName);
+            }
+        }
+    }
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::trunc);
+        if (!out.is_open()) {
+            setError(ErrorCode::CONFIG_SAVE_FAILED, "Cannot write trace file", tempPath);
+            return false;
+        }
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        out << "{\"ph\":\"M\",\"pid\":1,\"tid\":0,\"name\":\"process_name\",\"args\":{\"name\":\"creo_barcode\"}}";
+        for (const auto& thread : threadNames) {
+            out << ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.first
+                << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+            writeJsonString(out, thread.second);
+            out << "}}";
+        }
+        for (const auto& event : events) {
+            out << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadIndex << ",\"cat\":";
+            writeJsonString(out, event.category);
+            out << ",\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"ts\":";
+            writeMicros(out, event.startNanos);
+            out << ",\"dur\":";
+            writeMicros(out, event.durationNanos);
+            if (!event.detail.empty()) {
+                out << ",\"args\":{\"detail\":";
+                writeJsonString(out, event.detail.view());
+                out << "}";
+            }
+            out << "}";
+        }
+        out << "\n]}\n";
+
+        if (!out.good()) {
+            setError(ErrorCode::CONFIG_SAVE_FAILED, "Failed writing trace file", tempPath);
+            return false;
+        }
+    }
+
+    // Replace in one step so a viewer never sees a half-written file
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        setError(ErrorCode::CONFIG_SAVE_FAILED, "Cannot replace trace file", ec.message());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+void Tracer::setError(ErrorCode code, const std::string& message, const std::string& details) {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    lastError_ = ErrorInfo(code, message, details);
+}
+
+ErrorInfo Tracer::getLastError() const {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    return lastError_;
+}
+
+} // namespace creo_barcode
@@ -0,0 +1,463 @@
+/**
+ * @file utf_transcode.cpp
+ * @brief UTF-8 <-> UTF-16/wide transcoding with an ASCII fast path
+ *
+ * The converters walk the input in 16-unit blocks. A block that is pure
+ * ASCII is widened or narrowed with vector instructions in one step; any
+ * other block is decoded character by character before the next block is
+ * tried, so mostly-ASCII paths stay on the fast path and text in other
+ * scripts pays one failed check per 16 units.
+ */
+
+#include "utf_transcode.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTF_TRANSCODE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define UTF_TRANSCODE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace creo_barcode {
+namespace utf {
+
+namespace {
+
+constexpr size_t BLOCK = 16;
+constexpr char32_t REPLACEMENT = 0xFFFD;
+
+template <typename CharT>
+constexpr bool isUtf16 = sizeof(CharT) == 2;
+
+// ============================================================================
+// ASCII blocks
+// ============================================================================
+
+#if UTF_TRANSCODE_SSE2
+
+bool asciiBlock(const char* in) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    return _mm_movemask_epi8(bytes) == 0;
+}
+
+template <typename CharT>
+void widenBlock(const char* in, CharT* out) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    __m128i low = _mm_unpacklo_epi8(bytes, zero);
+    __m128i high = _mm_unpackhi_epi8(bytes, zero);
+    __m128i* dst = reinterpret_cast<__m128i*>(out);
+    if constexpr (isUtf16<CharT>) {
+        _mm_storeu_si128(dst, low);
+        _mm_storeu_si128(dst + 1, high);
+    } else {
+        _mm_storeu_si128(dst, _mm_unpacklo_epi16(low, zero));
+        _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(low, zero));
+        _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(high, zero));
+        _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(high, zero));
+    }
+}
+
+template <typename CharT>
+bool narrowBlock(const CharT* in, char* out) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i* src = reinterpret_cast<const __m128i*>(in);
+    __m128i packed;
+    if constexpr (isUtf16<CharT>) {
+        __m128i a = _mm_loadu_si128(src);
+        __m128i b = _mm_loadu_si128(src + 1);
+        __m128i high = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16(static_cast<short>(0xFF80)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(high, zero)) != 0xFFFF) {
+            return false;
+        }
+        packed = _mm_packus_epi16(a, b);
+    } else {
+        __m128i a = _mm_loadu_si128(src);
+        __m128i b = _mm_loadu_si128(src + 1);
+        __m128i c = _mm_loadu_si128(src + 2);
+        __m128i d = _mm_loadu_si128(src + 3);
+        __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+        __m128i high = _mm_and_si128(any, _mm_set1_epi32(static_cast<int>(0xFFFFFF80u)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(high, zero)) != 0xFFFF) {
+            return false;
+        }
+        packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+    return true;
+}
+
+#elif UTF_TRANSCODE_NEON
+
+bool asciiBlock(const char* in) {
+    return vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(in))) < 0x80;
+}
+
+template <typename CharT>
+void widenBlock(const char* in, CharT* out) {
+    uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(in));
+    uint16x8_t low = vmovl_u8(vget_low_u8(bytes));
+    uint16x8_t high = vmovl_u8(vget_high_u8(bytes));
+    if constexpr (isUtf16<CharT>) {
+        uint16_t* dst = reinterpret_cast<uint16_t*>(out);
+        vst1q_u16(dst, low);
+        vst1q_u16(dst + 8, high);
+    } else {
+        uint32_t* dst = reinterpret_cast<uint32_t*>(out);
+        vst1q_u32(dst, vmovl_u16(vget_low_u16(low)));
+        vst1q_u32(dst + 4, vmovl_u16(vget_high_u16(low)));
+        vst1q_u32(dst + 8, vmovl_u16(vget_low_u16(high)));
+        vst1q_u32(dst + 12, vmovl_u16(vget_high_u16(high)));
+    }
+}
+
+template <typename CharT>
+bool narrowBlock(const CharT* in, char* out) {
+    uint8x16_t packed;
+    if constexpr (isUtf16<CharT>) {
+        const uint16_t* src = reinterpret_cast<const uint16_t*>(in);
+        uint16x8_t a = vld1q_u16(src);
+        uint16x8_t b = vld1q_u16(src + 8);
+        if (vmaxvq_u16(vorrq_u16(a, b)) >= 0x80) {
+            return false;
+        }
+        packed = vcombine_u8(vmovn_u16(a), vmovn_u16(b));
+    } else {
+        const uint32_t* src = reinterpret_cast<const uint32_t*>(in);
+        uint32x4_t a = vld1q_u32(src);
+        uint32x4_t b = vld1q_u32(src + 4);
+        uint32x4_t c = vld1q_u32(src + 8);
+        uint32x4_t d = vld1q_u32(src + 12);
+        if (vmaxvq_u32(vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d))) >= 0x80) {
+            return false;
+        }
+        uint16x8_t low = vcombine_u16(vmovn_u32(a), vmovn_u32(b));
+        uint16x8_t high = vcombine_u16(vmovn_u32(c), vmovn_u32(d));
+        packed = vcombine_u8(vmovn_u16(low), vmovn_u16(high));
+    }
+    vst1q_u8(reinterpret_cast<uint8_t*>(out), packed);
+    return true;
+}
+
+#else
+
+bool asciiBlock(const char* in) {
+    uint64_t a, b;
+    std::memcpy(&a, in, sizeof(a));
+    std::memcpy(&b, in + 8, sizeof(b));
+    return ((a | b) & 0x8080808080808080ULL) == 0;
+}
+
+template <typename CharT>
+void widenBlock(const char* in, CharT* out) {
+    for (size_t i = 0; i < BLOCK; ++i) {
+        out[i] = static_cast<CharT>(static_cast<unsigned char>(in[i]));
+    }
+}
+
+template <typename CharT>
+bool narrowBlock(const CharT* in, char* out) {
+    uint32_t any = 0;
+    for (size_t i = 0; i < BLOCK; ++i) {
+        any |= static_cast<uint32_t>(in[i]);
+    }
+    if (any >= 0x80) {
+        return false;
+    }
+    for (size_t i = 0; i < BLOCK; ++i) {
+        out[i] = static_cast<char>(in[i]);
+    }
+    return true;
+}
+
+#endif
+
+// ============================================================================
+// Scalar characters
+// ============================================================================
+
+// Decode the character at in[i] and advance i past it. An invalid sequence
+// yields REPLACEMENT and consumes its maximal valid prefix (at least 1 byte).
+char32_t decodeUtf8(const unsigned char* in, size_t length, size_t& i) {
+    unsigned char lead = in[i];
+    if (lead < 0x80) {
+        ++i;
+        return lead;
+    }
+
+    size_t trailing;
+    char32_t cp;
+    unsigned char lower = 0x80;
+    unsigned char upper = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        trailing = 1;
+        cp = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        trailing = 2;
+        cp = lead & 0x0F;
+        if (lead == 0xE0) {
+            lower = 0xA0;       // overlong
+        } else if (lead == 0xED) {
+            upper = 0x9F;       // surrogates
+        }
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        trailing = 3;
+        cp = lead & 0x07;
+        if (lead == 0xF0) {
+            lower = 0x90;       // overlong
+        } else if (lead == 0xF4) {
+            upper = 0x8F;       // above U+10FFFF
+        }
+    } else {
+        ++i;
+        return REPLACEMENT;
+    }
+
+    size_t pos = i + 1;
+    for (size_t k = 0; k < trailing; ++k, ++pos) {
+        if (pos >= length || in[pos] < lower || in[pos] > upper) {
+            i = pos;
+            return REPLACEMENT;
+        }
+        cp = (cp << 6) | (in[pos] & 0x3F);
+        lower = 0x80;
+        upper = 0xBF;
+    }
+    i = pos;
+    return cp;
+}
+
+template <typename CharT>
+char32_t decodeWide(const CharT* in, size_t length, size_t& i) {
+    if constexpr (isUtf16<CharT>) {
+        char32_t unit = static_cast<char16_t>(in[i]);
+        ++i;
+        if (unit < 0xD800 || unit > 0xDFFF) {
+            return unit;
+        }
+        if (unit <= 0xDBFF && i < length) {
+            char32_t low = static_cast<char16_t>(in[i]);
+            if (low >= 0xDC00 && low <= 0xDFFF) {
+                ++i;
+                return 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+            }
+        }
+        return REPLACEMENT;
+    } else {
+        char32_t cp = static_cast<char32_t>(in[i]);
+        ++i;
+        if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+            return REPLACEMENT;
+        }
+        return cp;
+    }
+}
+
+template <typename CharT>
+size_t wideUnits(char32_t cp) {
+    return (isUtf16<CharT> && cp > 0xFFFF) ? 2 : 1;
+}
+
+template <typename CharT>
+void putWide(CharT* out, char32_t cp) {
+    if (isUtf16<CharT> && cp > 0xFFFF) {
+        cp -= 0x10000;
+        out[0] = static_cast<CharT>(0xD800 + (cp >> 10));
+        out[1] = static_cast<CharT>(0xDC00 + (cp & 0x3FF));
+    } else {
+        out[0] = static_cast<CharT>(cp);
+    }
+}
+
+size_t utf8Units(char32_t cp) {
+    if (cp < 0x80) return 1;
+    if (cp < 0x800) return 2;
+    if (cp < 0x10000) return 3;
+    return 4;
+}
+
+void putUtf8(char* out, char32_t cp) {
+    if (cp < 0x80) {
+        out[0] = static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (cp >> 6));
+        out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (cp >> 12));
+        out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out[0] = static_cast<char>(0xF0 | (cp >> 18));
+        out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// ============================================================================
+// Converters
+// ============================================================================
+
+template <typename CharT>
+size_t countWide(const char* utf8, size_t length) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(utf8);
+    size_t count = 0;
+    size_t i = 0;
+    while (i < length) {
+        if (length - i >= BLOCK && asciiBlock(utf8 + i)) {
+            i += BLOCK;
+            count += BLOCK;
+            continue;
+        }
+        size_t blockEnd = std::min(i + BLOCK, length);
+        while (i < blockEnd) {
+            count += wideUnits<CharT>(decodeUtf8(bytes, length, i));
+        }
+    }
+    return count;
+}
+
+template <typename CharT>
+TranscodeResult convertToWide(const char* utf8, size_t length, CharT* out, size_t capacity) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(utf8);
+    TranscodeResult result;
+    size_t i = 0;
+    size_t o = 0;
+    while (i < length) {
+        if (length - i >= BLOCK && capacity - o >= BLOCK && asciiBlock(utf8 + i)) {
+            widenBlock(utf8 + i, out + o);
+            i += BLOCK;
+            o += BLOCK;
+            continue;
+        }
+        size_t blockEnd = std::min(i + BLOCK, length);
+        while (i < blockEnd) {
+            size_t start = i;
+            char32_t cp = decodeUtf8(bytes, length, i);
+            size_t units = wideUnits<CharT>(cp);
+            if (capacity - o < units) {
+                result.status = TranscodeStatus::OUTPUT_TOO_SMALL;
+                result.read = start;
+                result.written = o;
+                return result;
+            }
+            putWide(out + o, cp);
+            o += units;
+        }
+    }
+    result.read = i;
+    result.written = o;
+    return result;
+}
+
+template <typename CharT>
+size_t countUtf8(const CharT* in, size_t length) {
+    char scratch[BLOCK];
+    size_t count = 0;
+    size_t i = 0;
+    while (i < length) {
+        if (length - i >= BLOCK && narrowBlock(in + i, scratch)) {
+            i += BLOCK;
+            count += BLOCK;
+            continue;
+        }
+        size_t blockEnd = std::min(i + BLOCK, length);
+        while (i < blockEnd) {
+            count += utf8Units(decodeWide(in, length, i));
+        }
+    }
+    return count;
+}
+
+template <typename CharT>
+TranscodeResult convertToUtf8(const CharT* in, size_t length, char* out, size_t capacity) {
+    TranscodeResult result;
+    size_t i = 0;
+    size_t o = 0;
+    while (i < length) {
+        if (length - i >= BLOCK && capacity - o >= BLOCK && narrowBlock(in + i, out + o)) {
+            i += BLOCK;
+            o += BLOCK;
+            continue;
+        }
+        size_t blockEnd = std::min(i + BLOCK, length);
+        while (i < blockEnd) {
+            size_t start = i;
+            char32_t cp = decodeWide(in, length, i);
+            size_t units = utf8Units(cp);
+            if (capacity - o < units) {
+                result.status = TranscodeStatus::OUTPUT_TOO_SMALL;
+                result.read = start;
+                result.written = o;
+                return result;
+            }
+            putUtf8(out + o, cp);
+            o += units;
+        }
+    }
+    result.read = i;
+    result.written = o;
+    return result;
+}
+
+} // anonymous namespace
+
+size_t utf16Length(const char* utf8, size_t length) {
+    return countWide<char16_t>(utf8, length);
+}
+
+size_t utf8Length(const char16_t* utf16, size_t length) {
+    return countUtf8(utf16, length);
+}
+
+TranscodeResult utf8ToUtf16(const char* utf8, size_t length, char16_t* out, size_t capacity) {
+    return convertToWide(utf8, length, out, capacity);
+}
+
+TranscodeResult utf16ToUtf8(const char16_t* utf16, size_t length, char* out, size_t capacity) {
+    return convertToUtf8(utf16, length, out, capacity);
+}
+
+size_t wideLength(const char* utf8, size_t length) {
+    return countWide<wchar_t>(utf8, length);
+}
+
+size_t utf8LengthFromWide(const wchar_t* wide, size_t length) {
+    return countUtf8(wide, length);
+}
+
+TranscodeResult utf8ToWide(const char* utf8, size_t length, wchar_t* out, size_t capacity) {
+    return convertToWide(utf8, length, out, capacity);
+}
+
+TranscodeResult wideToUtf8(const wchar_t* wide, size_t length, char* out, size_t capacity) {
+    return convertToUtf8(wide, length, out, capacity);
+}
+
+void utf8ToWide(std::string_view utf8, std::wstring& out) {
+    // Every input byte produces at most one output unit
+    out.resize(utf8.size());
+    TranscodeResult result = utf8ToWide(utf8.data(), utf8.size(), out.data(), out.size());
+    out.resize(result.written);
+}
+
+void wideToUtf8(std::wstring_view wide, std::string& out) {
+    // Size for ASCII first; only text that does not fit is measured
+    out.resize(wide.size());
+    TranscodeResult result = wideToUtf8(wide.data(), wide.size(), out.data(), out.size());
+    if (!result.ok()) {
+        size_t rest = utf8LengthFromWide(wide.data() + result.read, wide.size() - result.read);
+        out.resize(result.written + rest);
+        TranscodeResult tail = wideToUtf8(wide.data() + result.read, wide.size() - result.read,
+                                          out.data() + result.written, rest);
+        result.written += tail.written;
+    }
+    out.resize(result.written);
+}
+
+} // namespace utf
+} // namespace creo_barcode
@@ -0,0 +1,33 @@
+/**
+ * @file zlib_compress.cpp
+ * @brief stb_image_write implementation and the zlib wrapper around it
+ */
+
+#include "zlib_compress.h"
+#include <climits>
+#include <cstdlib>
+
+// The only definition in the plugin; BarcodeGenerator includes the header
+// for the PNG writer declarations
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+namespace creo_barcode {
+
+bool zlibCompress(const unsigned char* data, size_t size, std::vector<unsigned char>& out, int quality) {
+    if (size > static_cast<size_t>(INT_MAX)) {
+        return false;
+    }
+    int length = 0;
+    // stb does not modify the input despite the non-const parameter
+    unsigned char* stream = stbi_zlib_compress(const_cast<unsigned char*>(data), static_cast<int>(size),
+                                               &length, quality);
+    if (!stream) {
+        return false;
+    }
+    out.assign(stream, stream + length);
+    STBIW_FREE(stream);
+    return true;
+}
+
+} // namespace creo_barcode
@@ -13,10 +13,12 @@
 #include "version_check.h"
 #include "batch_processor.h"
 #include "creo_com_bridge.h"
+#include "utf_transcode.h"
 #include <filesystem>
 #include <fstream>
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 namespace creo_barcode {
 namespace testing {
@@ -407,6 +409,146 @@ RC_GTEST_FIXTURE_PROP(PropertyTestFixture, Property3_COM_EmptyStringRoundTrip, (
 
 #endif // _WIN32
 
+// =============================================================================
+// Property 3 (Transcoder): UTF-8 <-> UTF-16/wide conversion on every platform
+// **Validates: Requirements 4.3**
+//
+// The COM bridge converts through utf_transcode, which is portable, so the
+// round-trip properties are checked on Linux as well.
+// =============================================================================
+
+namespace {
+
+// Unicode scalar values, weighted towards ASCII runs so the vector fast
+// path and the block boundaries around non-ASCII text are both exercised
+rc::Gen<std::vector<char32_t>> genCodePoints() {
+    return rc::gen::container<std::vector<char32_t>>(
+        rc::gen::weightedOneOf<char32_t>({
+            {6, rc::gen::inRange<char32_t>(0x20, 0x7F)},
+            {1, rc::gen::inRange<char32_t>(0x80, 0x800)},
+            {1, rc::gen::inRange<char32_t>(0x4E00, 0x9FFF)},
+            {1, rc::gen::inRange<char32_t>(0xE000, 0x10000)},
+            {1, rc::gen::inRange<char32_t>(0x10000, 0x110000)}
+        })
+    );
+}
+
+// Straightforward reference encoder
+std::string encodeUtf8(const std::vector<char32_t>& codePoints) {
+    std::string out;
+    for (char32_t cp : codePoints) {
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+    return out;
+}
+
+size_t utf16Units(const std::vector<char32_t>& codePoints) {
+    size_t units = 0;
+    for (char32_t cp : codePoints) {
+        units += cp > 0xFFFF ? 2 : 1;
+    }
+    return units;
+}
+
+} // anonymous namespace
+
+// Valid UTF-8 survives UTF-8 -> UTF-16 -> UTF-8, and the length queries
+// agree with what the converters write
+RC_GTEST_FIXTURE_PROP(PropertyTestFixture, Property3_UTF_ValidTextRoundTrip, ()) {
+    std::vector<char32_t> codePoints = *genCodePoints();
+    std::string utf8 = encodeUtf8(codePoints);
+
+    std::u16string utf16(utf8.size(), u'\0');
+    utf::TranscodeResult toWide = utf::utf8ToUtf16(utf8.data(), utf8.size(), utf16.data(), utf16.size());
+    RC_ASSERT(toWide.ok());
+    RC_ASSERT(toWide.read == utf8.size());
+    RC_ASSERT(toWide.written == utf16Units(codePoints));
+    RC_ASSERT(utf::utf16Length(utf8.data(), utf8.size()) == toWide.written);
+    utf16.resize(toWide.written);
+
+    std::string back(utf16.size() * 3, '\0');
+    utf::TranscodeResult toUtf8 = utf::utf16ToUtf8(utf16.data(), utf16.size(), back.data(), back.size());
+    RC_ASSERT(toUtf8.ok());
+    RC_ASSERT(utf::utf8Length(utf16.data(), utf16.size()) == toUtf8.written);
+    back.resize(toUtf8.written);
+    RC_ASSERT(back == utf8);
+}
+
+// The same holds for wchar_t (UTF-16 on Windows, UTF-32 elsewhere) and
+// for the StringUtils wrappers used at the COM boundary
+RC_GTEST_FIXTURE_PROP(PropertyTestFixture, Property3_UTF_WideRoundTrip, ()) {
+    std::vector<char32_t> codePoints = *genCodePoints();
+    std::string utf8 = encodeUtf8(codePoints);
+
+    std::wstring wide = StringUtils::utf8ToWstring(utf8);
+    RC_ASSERT(wide.size() == (sizeof(wchar_t) == 2 ? utf16Units(codePoints) : codePoints.size()));
+    RC_ASSERT(utf::wideLength(utf8.data(), utf8.size()) == wide.size());
+    RC_ASSERT(utf::utf8LengthFromWide(wide.data(), wide.size()) == utf8.size());
+    RC_ASSERT(StringUtils::wstringToUtf8(wide) == utf8);
+}
+
+// Arbitrary bytes never overflow a buffer of one unit per byte, and the
+// sanitized output is valid: converting it again changes nothing
+RC_GTEST_FIXTURE_PROP(PropertyTestFixture, Property3_UTF_ArbitraryBytesAreSanitized, ()) {
+    std::string bytes = *rc::gen::arbitrary<std::string>();
+
+    std::u16string utf16(bytes.size(), u'\0');
+    utf::TranscodeResult result = utf::utf8ToUtf16(bytes.data(), bytes.size(), utf16.data(), utf16.size());
+    RC_ASSERT(result.ok());
+    RC_ASSERT(result.written <= bytes.size());
+    RC_ASSERT(utf::utf16Length(bytes.data(), bytes.size()) == result.written);
+    utf16.resize(result.written);
+
+    std::string clean(utf16.size() * 3, '\0');
+    clean.resize(utf::utf16ToUtf8(utf16.data(), utf16.size(), clean.data(), clean.size()).written);
+
+    std::u16string again(clean.size(), u'\0');
+    again.resize(utf::utf8ToUtf16(clean.data(), clean.size(), again.data(), again.size()).written);
+    RC_ASSERT(again == utf16);
+}
+
+// A short output buffer yields a prefix of the full conversion that ends on
+// a character boundary, and resuming from read completes it
+RC_GTEST_FIXTURE_PROP(PropertyTestFixture, Property3_UTF_TruncationIsResumablePrefix, ()) {
+    std::vector<char32_t> codePoints = *genCodePoints();
+    std::string utf8 = encodeUtf8(codePoints);
+    size_t capacity = *rc::gen::inRange<size_t>(0, utf8.size() + 1);
+
+    std::u16string head(capacity, u'\0');
+    utf::TranscodeResult first = utf::utf8ToUtf16(utf8.data(), utf8.size(), head.data(), capacity);
+    RC_ASSERT(first.written <= capacity);
+    RC_ASSERT(first.ok() == (first.read == utf8.size()));
+    if (first.read < utf8.size()) {
+        // Never split a sequence: the next byte starts a character
+        RC_ASSERT((static_cast<unsigned char>(utf8[first.read]) & 0xC0) != 0x80);
+    }
+    head.resize(first.written);
+
+    std::u16string tail(utf8.size() - first.read, u'\0');
+    utf::TranscodeResult rest = utf::utf8ToUtf16(utf8.data() + first.read, utf8.size() - first.read,
+                                                 tail.data(), tail.size());
+    RC_ASSERT(rest.ok());
+    tail.resize(rest.written);
+
+    std::u16string whole(utf8.size(), u'\0');
+    whole.resize(utf::utf8ToUtf16(utf8.data(), utf8.size(), whole.data(), whole.size()).written);
+    RC_ASSERT(head + tail == whole);
+}
+
 // =============================================================================
 // Property 2 (COM Bridge): 文件验证与错误报告 (File Validation and Error Reporting)
 // **Feature: barcode-image-insertion, Property 2: 文件验证与错误报告**
@@ -607,15 +749,18 @@ RC_GTEST_FIXTURE_PROP(PropertyTestFixture, Property2_COM_ValidFilePassesValidati
     std::string tempFileName = "test_valid_" + std::to_string(std::hash<std::string>{}(ext)) + ext;
     std::filesystem::path tempFilePath = tempDir / tempFileName;
     
-    // Create a minimal valid image file (just needs to exist and have content)
+    // Create a minimal valid image file: the format is sniffed from the
+    // leading magic bytes, so each extension gets its format's signature
     {
         std::ofstream ofs(tempFilePath, std::ios::binary);
-        // Write minimal PNG header for .png files, or just dummy content for others
         if (ext == ".png") {
-            // Minimal PNG signature
             unsigned char pngHeader[] = {0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A};
             ofs.write(reinterpret_cast<char*>(pngHeader), sizeof(pngHeader));
+        } else if (ext == ".bmp") {
+            ofs << "BM dummy image content";
         } else {
+            unsigned char jpegHeader[] = {0xFF, 0xD8, 0xFF, 0xE0};
+            ofs.write(reinterpret_cast<char*>(jpegHeader), sizeof(jpegHeader));
             ofs << "dummy image content";
         }
     }
@@ -943,7 +1088,9 @@ rc::Gen<PluginConfig> genPluginConfig() {
         rc::gen::set(&PluginConfig::defaultShowText, rc::gen::arbitrary<bool>()),
         rc::gen::set(&PluginConfig::outputDirectory, genOutputDirectory()),
         rc::gen::set(&PluginConfig::defaultDpi, genConfigDpi()),
-        rc::gen::set(&PluginConfig::recentFiles, genRecentFiles())
+        rc::gen::set(&PluginConfig::recentFiles, genRecentFiles()),
+        rc::gen::set(&PluginConfig::enableTracing, rc::gen::arbitrary<bool>()),
+        rc::gen::set(&PluginConfig::speculativeGeneration, rc::gen::arbitrary<bool>())
     );
 }
 
@@ -986,6 +1133,8 @@ RC_GTEST_FIXTURE_PROP(PropertyTestFixture, Property7_ConfigSerializationRoundTri
     RC_ASSERT(deserializedConfig.outputDirectory == originalConfig.outputDirectory);
     RC_ASSERT(deserializedConfig.defaultDpi == originalConfig.defaultDpi);
     RC_ASSERT(deserializedConfig.recentFiles == originalConfig.recentFiles);
+    RC_ASSERT(deserializedConfig.enableTracing == originalConfig.enableTracing);
+    RC_ASSERT(deserializedConfig.speculativeGeneration == originalConfig.speculativeGeneration);
     
     // Use the equality operator for final verification
     RC_ASSERT(deserializedConfig == originalConfig);
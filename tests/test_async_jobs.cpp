@@ -0,0 +1,197 @@
+/**
+ * @file test_async_jobs.cpp
+ * @brief Unit tests for AsyncJobTable
+ */
+
+#include <gtest/gtest.h>
+#include "async_jobs.h"
+#include <atomic>
+#include <future>
+#include <thread>
+
+using namespace creo_barcode;
+
+namespace {
+
+AsyncJobTable::Work succeedWith(const std::string& value) {
+    return [value](std::string& result, std::string&) {
+        result = value;
+        return true;
+    };
+}
+
+} // anonymous namespace
+
+TEST(AsyncJobTableTest, WaitReturnsResult) {
+    ThreadPool pool(2);
+    AsyncJobTable jobs(pool);
+
+    JobHandle job = jobs.submit(succeedWith("PART_001"));
+    ASSERT_NE(job, 0u);
+
+    JobState state;
+    ASSERT_TRUE(jobs.wait(job, -1, state));
+    EXPECT_EQ(state, JobState::SUCCEEDED);
+
+    std::string result;
+    std::string error;
+    ASSERT_TRUE(jobs.getResult(job, result, error));
+    EXPECT_EQ(result, "PART_001");
+    EXPECT_TRUE(error.empty());
+    EXPECT_TRUE(jobs.release(job));
+}
+
+TEST(AsyncJobTableTest, FailuresAndExceptionsReportErrors) {
+    ThreadPool pool(1);
+    AsyncJobTable jobs(pool);
+
+    JobHandle failed = jobs.submit([](std::string&, std::string& error) {
+        error = "Invalid dimensions";
+        return false;
+    });
+    JobHandle threw = jobs.submit([](std::string&, std::string&) -> bool {
+        throw std::runtime_error("encoder crashed");
+    });
+
+    JobState state;
+    std::string result;
+    std::string error;
+    ASSERT_TRUE(jobs.wait(failed, -1, state));
+    EXPECT_EQ(state, JobState::FAILED);
+    ASSERT_TRUE(jobs.getResult(failed, result, error));
+    EXPECT_EQ(error, "Invalid dimensions");
+
+    ASSERT_TRUE(jobs.wait(threw, -1, state));
+    EXPECT_EQ(state, JobState::FAILED);
+    ASSERT_TRUE(jobs.getResult(threw, result, error));
+    EXPECT_EQ(error, "encoder crashed");
+}
+
+TEST(AsyncJobTableTest, PollAndTimeoutWhileRunning) {
+    ThreadPool pool(1);
+    AsyncJobTable jobs(pool);
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+
+    JobHandle job = jobs.submit([opened](std::string&, std::string&) {
+        opened.wait();
+        return true;
+    });
+
+    JobState state;
+    ASSERT_TRUE(jobs.wait(job, 20, state));
+    EXPECT_TRUE(state == JobState::PENDING || state == JobState::RUNNING);
+    std::string result;
+    std::string error;
+    EXPECT_FALSE(jobs.getResult(job, result, error));
+
+    gate.set_value();
+    ASSERT_TRUE(jobs.wait(job, -1, state));
+    EXPECT_EQ(state, JobState::SUCCEEDED);
+    ASSERT_TRUE(jobs.poll(job, state));
+    EXPECT_EQ(state, JobState::SUCCEEDED);
+}
+
+TEST(AsyncJobTableTest, ReleasedHandlesAreRejectedAndSlotsReused) {
+    ThreadPool pool(1);
+    AsyncJobTable jobs(pool);
+
+    JobHandle first = jobs.submit(succeedWith("a"));
+    JobState state;
+    jobs.wait(first, -1, state);
+    ASSERT_TRUE(jobs.release(first));
+    EXPECT_FALSE(jobs.release(first));
+    EXPECT_FALSE(jobs.poll(first, state));
+    EXPECT_FALSE(jobs.poll(0, state));
+    EXPECT_FALSE(jobs.poll(0xDEADBEEF00000007ull, state));
+
+    // Same slot, new generation: the stale handle must not alias it
+    JobHandle second = jobs.submit(succeedWith("b"));
+    EXPECT_NE(second, first);
+    EXPECT_EQ(jobs.slotCount(), 1u);
+    EXPECT_FALSE(jobs.poll(first, state));
+    ASSERT_TRUE(jobs.wait(second, -1, state));
+    jobs.release(second);
+
+    for (int i = 0; i < 100; ++i) {
+        JobHandle job = jobs.submit(succeedWith("c"));
+        jobs.wait(job, -1, state);
+        jobs.release(job);
+    }
+    EXPECT_EQ(jobs.slotCount(), 1u);
+    EXPECT_EQ(jobs.liveJobs(), 0u);
+}
+
+TEST(AsyncJobTableTest, ReleaseBeforeCompletionRecyclesLater) {
+    ThreadPool pool(1);
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+    std::atomic<bool> callbackRan{false};
+    {
+        AsyncJobTable jobs(pool);
+        JobHandle job = jobs.submit([opened](std::string&, std::string&) {
+            opened.wait();
+            return true;
+        }, [&callbackRan](JobHandle, JobState) { callbackRan = true; });
+
+        ASSERT_TRUE(jobs.release(job));
+        JobState state;
+        EXPECT_FALSE(jobs.poll(job, state));
+        EXPECT_EQ(jobs.liveJobs(), 1u);
+
+        gate.set_value();
+        // Destructor waits for the job and its callback
+    }
+    EXPECT_TRUE(callbackRan.load());
+}
+
+TEST(AsyncJobTableTest, WorkerCallbacksRunOnPoolThreads) {
+    ThreadPool pool(2);
+    AsyncJobTable jobs(pool);
+    std::promise<std::pair<JobState, bool>> called;
+
+    JobHandle job = jobs.submit(succeedWith("x"), [&](JobHandle, JobState state) {
+        called.set_value({state, pool.isWorkerThread()});
+    });
+
+    auto outcome = called.get_future().get();
+    EXPECT_EQ(outcome.first, JobState::SUCCEEDED);
+    EXPECT_TRUE(outcome.second);
+    jobs.release(job);
+}
+
+TEST(AsyncJobTableTest, DispatchedCallbacksRunOnCallerThread) {
+    ThreadPool pool(2);
+    AsyncJobTable jobs(pool);
+    std::thread::id caller = std::this_thread::get_id();
+    std::atomic<int> calls{0};
+    std::atomic<bool> onCaller{true};
+
+    std::vector<JobHandle> handles;
+    for (int i = 0; i < 10; ++i) {
+        handles.push_back(jobs.submit(succeedWith("y"), [&](JobHandle, JobState) {
+            calls.fetch_add(1);
+            if (std::this_thread::get_id() != caller) {
+                onCaller = false;
+            }
+        }, CallbackMode::DISPATCHED));
+    }
+
+    JobState state;
+    for (JobHandle job : handles) {
+        jobs.wait(job, -1, state);
+    }
+    EXPECT_EQ(calls.load(), 0);
+    EXPECT_EQ(jobs.dispatchCompletions(), 10u);
+    EXPECT_EQ(calls.load(), 10);
+    EXPECT_TRUE(onCaller.load());
+    EXPECT_EQ(jobs.dispatchCompletions(), 0u);
+}
+
+TEST(AsyncJobTableTest, SubmitAfterPoolShutdownFails) {
+    ThreadPool pool(1);
+    AsyncJobTable jobs(pool);
+    pool.shutdown();
+    EXPECT_EQ(jobs.submit(succeedWith("z")), 0u);
+    EXPECT_EQ(jobs.liveJobs(), 0u);
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include "barcode_generator.h"
+#include "image_validator.h"
+#include "render_cache.h"
+#include "plugin_stats.h"
 #include <filesystem>
 
 namespace creo_barcode {
@@ -121,6 +124,19 @@ TEST_F(BarcodeGeneratorTest, GenerateCode128CreatesFile) {
     EXPECT_TRUE(std::filesystem::exists(outputPath));
 }
 
+TEST_F(BarcodeGeneratorTest, GeneratedFileIsPrevalidated) {
+    BarcodeConfig config;
+    std::string outputPath = (testDir_ / "prevalidated.png").string();
+    ASSERT_TRUE(generator_.generate("TEST123", config, outputPath));
+
+    ImageCheck check = ImageValidator::global().validate(outputPath);
+    EXPECT_TRUE(check.ok());
+    EXPECT_TRUE(check.cached);
+    EXPECT_EQ(check.format, ImageFormat::PNG);
+    EXPECT_EQ(check.size, std::filesystem::file_size(outputPath));
+    ImageValidator::global().forget(outputPath);
+}
+
 TEST_F(BarcodeGeneratorTest, GenerateCode39CreatesFile) {
     BarcodeConfig config;
     config.type = BarcodeType::CODE_39;
@@ -200,6 +216,161 @@ TEST_F(BarcodeGeneratorTest, GeneratedQRCodeIsDecodable) {
     EXPECT_EQ(decoded.value(), testData);
 }
 
+// ============================================================================
+// In-Memory Render / Decode Tests
+// ============================================================================
+
+TEST_F(BarcodeGeneratorTest, RenderGrayRoundTripsThroughDecodePixels) {
+    BarcodeConfig config;
+    config.type = BarcodeType::QR_CODE;
+    config.width = 200;
+    config.height = 200;
+    std::vector<uint8_t> pixels;
+    
+    ASSERT_TRUE(generator_.renderGray("PART-MEM-001", config, pixels));
+    ASSERT_EQ(pixels.size(), 200u * 200u);
+    
+    auto decoded = generator_.decodePixels(pixels.data(), 200, 200, 0, 1);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded.value(), "PART-MEM-001");
+}
+
+TEST_F(BarcodeGeneratorTest, DecodePixelsHonoursStrideAndChannels) {
+    BarcodeConfig config;
+    config.type = BarcodeType::CODE_128;
+    config.width = 240;
+    config.height = 80;
+    std::vector<uint8_t> gray;
+    ASSERT_TRUE(generator_.renderGray("STRIDE42", config, gray));
+    
+    // RGBA rows padded to a 1024-byte stride
+    const int stride = 1024;
+    std::vector<uint8_t> rgba(stride * config.height, 0xAB);
+    for (int y = 0; y < config.height; ++y) {
+        for (int x = 0; x < config.width; ++x) {
+            uint8_t v = gray[y * config.width + x];
+            uint8_t* px = &rgba[y * stride + x * 4];
+            px[0] = px[1] = px[2] = v;
+            px[3] = 255;
+        }
+    }
+    
+    auto decoded = generator_.decodePixels(rgba.data(), config.width, config.height, stride, 4);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded.value(), "STRIDE42");
+    
+    EXPECT_FALSE(generator_.decodePixels(rgba.data(), config.width, config.height, 100, 4).has_value());
+    EXPECT_FALSE(generator_.decodePixels(rgba.data(), config.width, config.height, 0, 2).has_value());
+}
+
+TEST_F(BarcodeGeneratorTest, RenderPngMatchesFileOutput) {
+    BarcodeConfig config;
+    config.type = BarcodeType::CODE_128;
+    std::string outputPath = (testDir_ / "memory_match.png").string();
+    std::vector<uint8_t> png;
+    
+    ASSERT_TRUE(generator_.renderPng("PART-PNG", config, png));
+    ASSERT_TRUE(generator_.generate("PART-PNG", config, outputPath));
+    
+    ASSERT_GT(png.size(), 8u);
+    EXPECT_EQ(png[0], 0x89);
+    EXPECT_EQ(png[1], 'P');
+    EXPECT_EQ(png.size(), std::filesystem::file_size(outputPath));
+    
+    auto decoded = generator_.decodeImageData(png.data(), png.size());
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded.value(), "PART-PNG");
+}
+
+TEST_F(BarcodeGeneratorTest, DecodeImageDataRejectsGarbage) {
+    const uint8_t garbage[] = {'n', 'o', 't', ' ', 'a', 'n', ' ', 'i', 'm', 'a', 'g', 'e'};
+    EXPECT_FALSE(generator_.decodeImageData(garbage, sizeof(garbage)).has_value());
+    EXPECT_EQ(generator_.getLastError().code, ErrorCode::DECODE_FAILED);
+    EXPECT_FALSE(generator_.decodeImageData(nullptr, 0).has_value());
+}
+
+TEST_F(BarcodeGeneratorTest, RenderRejectsInvalidInput) {
+    BarcodeConfig config;
+    std::vector<uint8_t> out;
+    EXPECT_FALSE(generator_.renderPng("", config, out));
+    config.width = 0;
+    EXPECT_FALSE(generator_.renderGray("DATA", config, out));
+    EXPECT_EQ(generator_.getLastError().code, ErrorCode::INVALID_SIZE);
+}
+
+TEST_F(BarcodeGeneratorTest, RenderCacheHitsAreCounted) {
+    RenderCache cache;
+    generator_.setRenderCache(&cache);
+    BarcodeConfig config;
+    std::vector<uint8_t> first;
+    std::vector<uint8_t> second;
+    uint64_t before = PluginStats::global().snapshot().cacheHits;
+    
+    ASSERT_TRUE(generator_.renderGray("CACHED-1", config, first));
+    EXPECT_EQ(PluginStats::global().snapshot().cacheHits, before);
+    ASSERT_TRUE(generator_.renderGray("CACHED-1", config, second));
+    EXPECT_EQ(PluginStats::global().snapshot().cacheHits, before + 1);
+    EXPECT_EQ(first, second);
+}
+
+TEST_F(BarcodeGeneratorTest, FailureDetailsAreKeptInline) {
+    const uint8_t pixels[4] = {0, 0, 0, 0};
+    EXPECT_FALSE(generator_.decodePixels(pixels, 2, 2, 0, 2).has_value());
+    EXPECT_EQ(generator_.lastError().code(), ErrorCode::INVALID_DATA);
+    EXPECT_STREQ(generator_.lastError().message(), "Unsupported channel count");
+    EXPECT_EQ(generator_.lastError().detail(), "2");
+
+    ErrorInfo info = generator_.getLastError();
+    EXPECT_EQ(info.message, "Unsupported channel count");
+    EXPECT_EQ(info.details, "2");
+}
+
+// ============================================================================
+// Async API Tests
+// ============================================================================
+
+TEST_F(BarcodeGeneratorTest, AsyncGenerateThenDecodePipeline) {
+    BarcodeConfig config;
+    config.type = BarcodeType::QR_CODE;
+    config.width = 200;
+    config.height = 200;
+    
+    std::vector<std::future<Result<void>>> generated;
+    for (int i = 0; i < 16; ++i) {
+        std::string path = (testDir_ / ("async_" + std::to_string(i) + ".png")).string();
+        generated.push_back(generator_.generateAsync("ASYNC-" + std::to_string(i), config, path));
+    }
+    for (auto& future : generated) {
+        Result<void> result = future.get();
+        EXPECT_TRUE(result.ok()) << result.error().message();
+    }
+    
+    std::vector<std::future<Result<std::string>>> decoded;
+    for (int i = 0; i < 16; ++i) {
+        decoded.push_back(generator_.decodeAsync((testDir_ / ("async_" + std::to_string(i) + ".png")).string()));
+    }
+    for (int i = 0; i < 16; ++i) {
+        Result<std::string> result = decoded[i].get();
+        ASSERT_TRUE(result.ok()) << result.error().message();
+        EXPECT_EQ(result.value(), "ASYNC-" + std::to_string(i));
+    }
+}
+
+TEST_F(BarcodeGeneratorTest, AsyncErrorsDoNotTouchLastError) {
+    BarcodeConfig config;
+    config.width = 0;
+    
+    Result<void> generated = generator_.generateAsync("DATA", config, (testDir_ / "bad.png").string()).get();
+    EXPECT_FALSE(generated.ok());
+    EXPECT_EQ(generated.error().code(), ErrorCode::INVALID_SIZE);
+    
+    Result<std::string> decoded = generator_.decodeAsync((testDir_ / "missing.png").string()).get();
+    EXPECT_FALSE(decoded.ok());
+    EXPECT_EQ(decoded.error().code(), ErrorCode::FILE_NOT_FOUND);
+    
+    EXPECT_TRUE(generator_.getLastError().isSuccess());
+}
+
 // ============================================================================
 // Utility Function Tests
 // ============================================================================
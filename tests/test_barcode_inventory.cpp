@@ -0,0 +1,243 @@
+/**
+ * @file test_barcode_inventory.cpp
+ * @brief Unit tests for the columnar BarcodeInventory
+ */
+
+#include <gtest/gtest.h>
+#include "barcode_inventory.h"
+#include <filesystem>
+#include <fstream>
+
+using namespace creo_barcode;
+
+namespace {
+
+BarcodeInstance makeInstance(const std::string& part, const std::string& drawing, int sheet,
+                             BarcodeType type = BarcodeType::CODE_128) {
+    BarcodeInstance instance;
+    instance.imagePath = "C:/work/output/barcodes/" + part + ".png";
+    instance.encodedData = part;
+    instance.decodedData = part;
+    instance.type = type;
+    instance.posX = 12.5;
+    instance.posY = 40.25;
+    instance.timestamp = "2024-05-01T08:30:00";
+    instance.drawingPath = drawing;
+    instance.sheet = sheet;
+    return instance;
+}
+
+size_t heapBytes(const std::string& s) {
+    // Strings within the small-string buffer do not allocate
+    return s.capacity() > 15 ? s.capacity() + 1 : 0;
+}
+
+} // anonymous namespace
+
+class BarcodeInventoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir_ = std::filesystem::temp_directory_path() / "barcode_inventory_test";
+        std::filesystem::create_directories(testDir_);
+        inventoryPath_ = (testDir_ / "inventory.bin").string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir_);
+    }
+
+    std::filesystem::path testDir_;
+    std::string inventoryPath_;
+    BarcodeInventory inventory_;
+};
+
+TEST_F(BarcodeInventoryTest, AddAndReadBack) {
+    BarcodeInstance instance = makeInstance("PART_001", "C:/work/a.drw", 2, BarcodeType::QR_CODE);
+    size_t row = inventory_.add(instance, SyncStatus::OUT_OF_SYNC, "PART_002");
+
+    EXPECT_EQ(row, 0u);
+    EXPECT_EQ(inventory_.size(), 1u);
+    EXPECT_EQ(inventory_.drawingPathAt(0), "C:/work/a.drw");
+    EXPECT_EQ(inventory_.partNameAt(0), "PART_002");
+    EXPECT_EQ(inventory_.statusAt(0), SyncStatus::OUT_OF_SYNC);
+    EXPECT_EQ(inventory_.typeAt(0), BarcodeType::QR_CODE);
+
+    BarcodeInstance restored = inventory_.instanceAt(0);
+    EXPECT_EQ(restored.imagePath, instance.imagePath);
+    EXPECT_EQ(restored.decodedData, "PART_001");
+    EXPECT_EQ(restored.timestamp, instance.timestamp);
+    EXPECT_EQ(restored.sheet, 2);
+    EXPECT_DOUBLE_EQ(restored.posX, 12.5);
+    EXPECT_DOUBLE_EQ(restored.posY, 40.25);
+}
+
+TEST_F(BarcodeInventoryTest, StringsAreInterned) {
+    for (int i = 0; i < 100; ++i) {
+        inventory_.add(makeInstance("PART_001", "C:/work/a.drw", 1));
+    }
+    // drawing, image, payload, empty part name, timestamp
+    EXPECT_EQ(inventory_.stringCount(), 5u);
+}
+
+TEST_F(BarcodeInventoryTest, FiltersByColumn) {
+    for (int i = 0; i < 1000; ++i) {
+        BarcodeType type = (i % 3 == 0) ? BarcodeType::QR_CODE : BarcodeType::CODE_128;
+        SyncStatus status = (i % 10 == 0) ? SyncStatus::OUT_OF_SYNC : SyncStatus::IN_SYNC;
+        inventory_.add(makeInstance("PART_" + std::to_string(i), "d" + std::to_string(i % 4) + ".drw",
+                                    i % 5, type), status);
+    }
+
+    auto outOfSync = inventory_.filterByStatus(SyncStatus::OUT_OF_SYNC);
+    ASSERT_EQ(outOfSync.size(), 100u);
+    EXPECT_EQ(outOfSync[1], 10u);
+
+    auto qr = inventory_.filterByType(BarcodeType::QR_CODE);
+    EXPECT_EQ(qr.size(), 334u);
+
+    auto sheet3 = inventory_.filterBySheet(3);
+    EXPECT_EQ(sheet3.size(), 200u);
+
+    // Chained: out of sync QR codes (multiples of 30)
+    auto qrOutOfSync = inventory_.filterByType(BarcodeType::QR_CODE, &outOfSync);
+    EXPECT_EQ(qrOutOfSync.size(), 34u);
+    for (uint32_t row : qrOutOfSync) {
+        EXPECT_EQ(row % 30, 0u);
+    }
+
+    auto drawing2 = inventory_.filterByDrawing("d2.drw");
+    EXPECT_EQ(drawing2.size(), 250u);
+    EXPECT_TRUE(inventory_.filterByDrawing("missing.drw").empty());
+}
+
+TEST_F(BarcodeInventoryTest, FilterHandlesUnalignedTail) {
+    // Sizes that are not multiples of the SIMD block width
+    for (int i = 0; i < 37; ++i) {
+        inventory_.add(makeInstance("P", "a.drw", i == 36 ? 9 : 1),
+                       i == 36 ? SyncStatus::DECODE_ERROR : SyncStatus::IN_SYNC);
+    }
+    EXPECT_EQ(inventory_.filterByStatus(SyncStatus::DECODE_ERROR), InventorySelection{36});
+    EXPECT_EQ(inventory_.filterBySheet(9), InventorySelection{36});
+}
+
+TEST_F(BarcodeInventoryTest, CountByStatus) {
+    inventory_.add(makeInstance("A", "a.drw", 1), SyncStatus::IN_SYNC);
+    inventory_.add(makeInstance("B", "a.drw", 1), SyncStatus::IN_SYNC);
+    inventory_.add(makeInstance("C", "a.drw", 1), SyncStatus::BARCODE_NOT_FOUND);
+
+    auto counts = inventory_.countByStatus();
+    EXPECT_EQ(counts[static_cast<size_t>(SyncStatus::IN_SYNC)], 2u);
+    EXPECT_EQ(counts[static_cast<size_t>(SyncStatus::BARCODE_NOT_FOUND)], 1u);
+    EXPECT_EQ(counts[static_cast<size_t>(SyncStatus::OUT_OF_SYNC)], 0u);
+
+    std::string summary = inventory_.getSummary();
+    EXPECT_NE(summary.find("Total barcodes: 3"), std::string::npos);
+}
+
+TEST_F(BarcodeInventoryTest, SaveAndLoadRoundTrip) {
+    for (int i = 0; i < 500; ++i) {
+        inventory_.add(makeInstance("PART_" + std::to_string(i % 50), "d" + std::to_string(i % 7) + ".drw",
+                                    i % 3), static_cast<SyncStatus>(i % BarcodeInventory::STATUS_COUNT));
+    }
+    ASSERT_TRUE(inventory_.save(inventoryPath_));
+
+    BarcodeInventory loaded;
+    ASSERT_TRUE(loaded.load(inventoryPath_));
+    ASSERT_EQ(loaded.size(), inventory_.size());
+    EXPECT_EQ(loaded.stringCount(), inventory_.stringCount());
+    for (size_t row = 0; row < loaded.size(); row += 37) {
+        EXPECT_EQ(loaded.drawingPathAt(row), inventory_.drawingPathAt(row));
+        EXPECT_EQ(loaded.encodedDataAt(row), inventory_.encodedDataAt(row));
+        EXPECT_EQ(loaded.statusAt(row), inventory_.statusAt(row));
+        EXPECT_EQ(loaded.sheetAt(row), inventory_.sheetAt(row));
+    }
+
+    // Interning keeps working after a load
+    size_t before = loaded.stringCount();
+    loaded.add(makeInstance("PART_1", "d1.drw", 0));
+    EXPECT_EQ(loaded.stringCount(), before);
+    EXPECT_EQ(loaded.filterByDrawing("d1.drw").size(), inventory_.filterByDrawing("d1.drw").size() + 1);
+}
+
+TEST_F(BarcodeInventoryTest, LoadRejectsInvalidFile) {
+    EXPECT_FALSE(inventory_.load((testDir_ / "missing.bin").string()));
+    EXPECT_EQ(inventory_.getLastError().code, ErrorCode::FILE_NOT_FOUND);
+
+    std::ofstream(inventoryPath_) << "this is not an inventory file at all";
+    EXPECT_FALSE(inventory_.load(inventoryPath_));
+    EXPECT_EQ(inventory_.getLastError().code, ErrorCode::INVALID_DATA);
+
+    // Truncated valid file
+    BarcodeInventory source;
+    source.add(makeInstance("A", "a.drw", 1));
+    ASSERT_TRUE(source.save(inventoryPath_));
+    std::filesystem::resize_file(inventoryPath_, std::filesystem::file_size(inventoryPath_) - 1);
+    EXPECT_FALSE(inventory_.load(inventoryPath_));
+}
+
+TEST_F(BarcodeInventoryTest, MemoryIsAnOrderOfMagnitudeSmaller) {
+    // A typical audit: 2000 parts, each placed on 50 drawings
+    const int parts = 2000;
+    const int drawingsPerPart = 50;
+    inventory_.reserve(parts * drawingsPerPart);
+
+    size_t rowBaseline = 0;
+    for (int d = 0; d < drawingsPerPart; ++d) {
+        std::string drawing = "C:/work/project/drawings/assembly_" + std::to_string(d) + ".drw";
+        for (int p = 0; p < parts; ++p) {
+            std::string part = "PART_" + std::to_string(100000 + p);
+            BarcodeInstance instance = makeInstance(part, drawing, 1);
+
+            SyncCheckResult result;
+            result.status = SyncStatus::IN_SYNC;
+            result.currentPartName = part;
+            result.barcodeData = part;
+            result.message = DataSyncChecker::getStatusMessage(result.status);
+
+            inventory_.add(instance, result);
+
+            rowBaseline += sizeof(BarcodeInstance) + sizeof(SyncCheckResult) +
+                           heapBytes(instance.imagePath) + heapBytes(instance.encodedData) +
+                           heapBytes(instance.decodedData) + heapBytes(instance.timestamp) +
+                           heapBytes(instance.drawingPath) + heapBytes(result.currentPartName) +
+                           heapBytes(result.barcodeData) + heapBytes(result.message);
+        }
+    }
+
+    EXPECT_EQ(inventory_.size(), static_cast<size_t>(parts * drawingsPerPart));
+    EXPECT_LT(inventory_.memoryBytes() * 10, rowBaseline);
+}
+
+TEST_F(BarcodeInventoryTest, SyncCheckerKeepsLatestResultPerBarcode) {
+    DataSyncChecker checker;
+    checker.setInventory(&inventory_);
+
+    checker.checkSync("PART_001", makeInstance("PART_001", "a.drw", 1));
+    checker.checkSync("PART_NEW", makeInstance("PART_001", "a.drw", 1));
+    checker.checkSync("PART_001", makeInstance("PART_001", "a.drw", 2));
+
+    ASSERT_EQ(inventory_.size(), 2u);
+    EXPECT_EQ(inventory_.statusAt(0), SyncStatus::OUT_OF_SYNC);
+    EXPECT_EQ(inventory_.partNameAt(0), "PART_NEW");
+    EXPECT_EQ(inventory_.statusAt(1), SyncStatus::IN_SYNC);
+    EXPECT_EQ(inventory_.countByStatus()[static_cast<size_t>(SyncStatus::OUT_OF_SYNC)], 1u);
+}
+
+TEST_F(BarcodeInventoryTest, UpsertMatchesRowsOfALoadedInventory) {
+    SyncCheckResult inSync;
+    inSync.status = SyncStatus::IN_SYNC;
+    inSync.currentPartName = "PART_A";
+    inventory_.upsert(makeInstance("PART_A", "a.drw", 1), inSync);
+    inventory_.upsert(makeInstance("PART_B", "a.drw", 1), inSync);
+    ASSERT_TRUE(inventory_.save(inventoryPath_));
+
+    BarcodeInventory loaded;
+    ASSERT_TRUE(loaded.load(inventoryPath_));
+    SyncCheckResult renamed;
+    renamed.status = SyncStatus::OUT_OF_SYNC;
+    renamed.currentPartName = "PART_A2";
+    EXPECT_EQ(loaded.upsert(makeInstance("PART_A", "a.drw", 1), renamed), 0u);
+    ASSERT_EQ(loaded.size(), 2u);
+    EXPECT_EQ(loaded.statusAt(0), SyncStatus::OUT_OF_SYNC);
+    EXPECT_EQ(loaded.partNameAt(0), "PART_A2");
+    EXPECT_EQ(loaded.statusAt(1), SyncStatus::IN_SYNC);
+}
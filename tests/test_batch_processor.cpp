@@ -2,6 +2,9 @@
 #include "batch_processor.h"
 #include <filesystem>
 #include <fstream>
+#include <thread>
+#include <chrono>
+#include <atomic>
 
 namespace creo_barcode {
 namespace testing {
@@ -225,5 +228,161 @@ TEST_F(BatchProcessorTest, AllFilesFailScenario) {
     EXPECT_NE(summary.find("Failed: 2"), std::string::npos);
 }
 
+
+TEST_F(BatchProcessorTest, OpenQueueProcessesFilesAddedDuringProcessing) {
+    std::string file1 = (testDir_ / "early.drw").string();
+    std::string file2 = (testDir_ / "late.drw").string();
+    std::ofstream(file1).close();
+    std::ofstream(file2).close();
+    
+    processor_.openQueue();
+    processor_.addFile(file1);
+    std::thread producer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        processor_.addFiles({file2});
+        processor_.closeQueue();
+    });
+    
+    BarcodeConfig config;
+    auto results = processor_.process(config);
+    producer.join();
+    
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0].filePath, file1);
+    EXPECT_EQ(results[1].filePath, file2);
+    EXPECT_FALSE(processor_.isQueueOpen());
+}
+
+TEST_F(BatchProcessorTest, ProcessDirectoriesFindsDrawingsRecursively) {
+    std::filesystem::create_directories(testDir_ / "a" / "b");
+    std::ofstream(testDir_ / "top.drw").close();
+    std::ofstream(testDir_ / "a" / "mid.DRW").close();
+    std::ofstream(testDir_ / "a" / "b" / "deep.drw.3").close();
+    std::ofstream(testDir_ / "a" / "b" / "part.prt").close();
+    
+    ScanOptions options;
+    options.patterns = {"*.drw", "*.drw.*"};
+    ScanStats stats;
+    BarcodeConfig config;
+    auto results = processor_.processDirectories({testDir_.string()}, options, config, nullptr, &stats);
+    
+    EXPECT_EQ(results.size(), 3);
+    for (const auto& result : results) {
+        EXPECT_TRUE(result.success) << result.filePath;
+    }
+    EXPECT_EQ(stats.directories, 3u);
+    EXPECT_EQ(stats.filesMatched, 3u);
+    EXPECT_EQ(stats.filesSkipped, 1u);
+}
+
+TEST_F(BatchProcessorTest, ThrowingProgressCallbackStopsHelperThreads) {
+    std::ofstream(testDir_ / "a.drw").close();
+    std::ofstream(testDir_ / "b.drw").close();
+    auto throwing = [](int, int) { throw std::runtime_error("progress failed"); };
+    BarcodeConfig config;
+    
+    // The feeder is still waiting on the open queue when the callback throws
+    processor_.openQueue();
+    processor_.addFile((testDir_ / "a.drw").string());
+    EXPECT_THROW(processor_.process(config, throwing), std::runtime_error);
+    processor_.closeQueue();
+    processor_.clear();
+    
+    ScanOptions options;
+    options.patterns = {"*.drw"};
+    EXPECT_THROW(processor_.processDirectories({testDir_.string()}, options, config, throwing),
+                 std::runtime_error);
+    EXPECT_FALSE(processor_.isQueueOpen());
+}
+
+TEST_F(BatchProcessorTest, StagesRunWithSeparateLimitsAndKeepQueueOrder) {
+    std::vector<std::string> files;
+    for (int i = 0; i < 40; ++i) {
+        files.push_back("drawing_" + std::to_string(i) + ".drw");
+    }
+    processor_.addFiles(files);
+    
+    std::atomic<int> writing{0};
+    std::atomic<int> writePeak{0};
+    processor_.setConcurrencyLimits(4, 2);
+    processor_.setRenderStage([](const std::string& file, std::string& error) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (file == "drawing_7.drw") {
+            error = "render failed";
+            return false;
+        }
+        return true;
+    });
+    processor_.setWriteStage([&](const std::string&, std::string&) {
+        int now = ++writing;
+        int seen = writePeak.load();
+        while (now > seen && !writePeak.compare_exchange_weak(seen, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        --writing;
+        return true;
+    });
+    
+    BarcodeConfig config;
+    auto results = processor_.process(config);
+    
+    ASSERT_EQ(results.size(), files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        EXPECT_EQ(results[i].filePath, files[i]);
+        EXPECT_EQ(results[i].success, i != 7);
+    }
+    EXPECT_EQ(results[7].errorMessage, "render failed");
+    EXPECT_LE(writePeak.load(), 2);
+    
+    const BatchTuning& tuning = processor_.getLastTuning();
+    EXPECT_FALSE(tuning.environment.empty());
+    EXPECT_LE(tuning.render.peak, 4u);
+    EXPECT_GE(tuning.render.peak, 1u);
+    EXPECT_LE(tuning.write.peak, 2u);
+    EXPECT_LE(tuning.write.settled, 2u);
+}
+
+TEST_F(BatchProcessorTest, TimingHistorySeedsTheNextRun) {
+    std::string file = (testDir_ / "a.drw").string();
+    std::ofstream(file).close();
+    
+    TimingHistory history;
+    processor_.setTimingHistory(&history);
+    processor_.setConcurrencyLimits(8, 8);
+    processor_.addFile(file);
+    BarcodeConfig config;
+    processor_.process(config);
+    
+    EXPECT_FALSE(processor_.getLastTuning().write.fromHistory);
+    EnvironmentTiming stored;
+    ASSERT_TRUE(history.find(processor_.getLastTuning().environment, stored));
+    EXPECT_EQ(stored.write.concurrency, BatchProcessor::DEFAULT_INITIAL_WRITE_WORKERS);
+    EXPECT_EQ(stored.render.concurrency, 0u);
+    
+    // Pretend an earlier run on this share settled on two writers
+    stored.write.concurrency = 2;
+    history.clear();
+    history.record(processor_.getLastTuning().environment, stored);
+    processor_.process(config);
+    
+    EXPECT_TRUE(processor_.getLastTuning().write.fromHistory);
+    EXPECT_EQ(processor_.getLastTuning().write.initial, 2u);
+}
+
+TEST_F(BatchProcessorTest, SummaryReportsChosenConcurrency) {
+    std::string file = (testDir_ / "a.drw").string();
+    std::ofstream(file).close();
+    processor_.addFile(file);
+    
+    BarcodeConfig config;
+    auto results = processor_.process(config);
+    std::string summary = BatchProcessor::getSummary(results, &processor_.getLastTuning());
+    
+    EXPECT_NE(summary.find("Concurrency ("), std::string::npos);
+    EXPECT_NE(summary.find("Write: "), std::string::npos);
+    EXPECT_EQ(summary.find("Render: "), std::string::npos);     // No render stage set
+    EXPECT_EQ(BatchProcessor::getSummary(results).find("Concurrency"), std::string::npos);
+}
+
 } // namespace testing
 } // namespace creo_barcode
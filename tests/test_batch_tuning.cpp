@@ -0,0 +1,157 @@
+/**
+ * @file test_batch_tuning.cpp
+ * @brief Unit tests for ConcurrencyTuner and TimingHistory
+ */
+
+#include <gtest/gtest.h>
+#include "batch_tuning.h"
+#include <filesystem>
+#include <fstream>
+
+using namespace creo_barcode;
+
+TEST(ConcurrencyTunerTest, InitialLimitIsClamped) {
+    EXPECT_EQ(ConcurrencyTuner(0, 1, 8).limit(), 1u);
+    EXPECT_EQ(ConcurrencyTuner(20, 1, 8).limit(), 8u);
+    EXPECT_EQ(ConcurrencyTuner(4, 1, 8).limit(), 4u);
+}
+
+TEST(ConcurrencyTunerTest, HealthyWindowsAddOneWorkerEach) {
+    ConcurrencyTuner tuner(2, 1, 5);
+    double throughput = 100.0;
+    for (int i = 0; i < 10; ++i) {
+        tuner.observeWindow(throughput, 1000.0);
+        throughput += 50.0;
+    }
+    EXPECT_EQ(tuner.limit(), 5u);
+    EXPECT_EQ(tuner.increases(), 3u);
+    EXPECT_EQ(tuner.decreases(), 0u);
+}
+
+TEST(ConcurrencyTunerTest, LatencySpikeHalvesTheLimit) {
+    ConcurrencyTuner tuner(8, 1, 16);
+    tuner.observeWindow(100.0, 1000.0);
+    EXPECT_EQ(tuner.limit(), 9u);
+
+    tuner.observeWindow(100.0, 1000.0 * ConcurrencyTuner::LATENCY_TOLERANCE * 2);
+    EXPECT_EQ(tuner.limit(), 4u);
+    EXPECT_EQ(tuner.decreases(), 1u);
+}
+
+TEST(ConcurrencyTunerTest, ThroughputDropAfterIncreaseHalvesTheLimit) {
+    ConcurrencyTuner tuner(4, 1, 16);
+    tuner.observeWindow(200.0, 1000.0);     // 4 -> 5
+    tuner.observeWindow(120.0, 1100.0);     // Raised and got slower: 5 -> 2
+    EXPECT_EQ(tuner.limit(), 2u);
+}
+
+TEST(ConcurrencyTunerTest, NeverDropsBelowMinimum) {
+    ConcurrencyTuner tuner(2, 2, 8);
+    tuner.observeWindow(100.0, 1000.0);
+    tuner.observeWindow(100.0, 100000.0);
+    tuner.observeWindow(100.0, 1000000.0);
+    EXPECT_EQ(tuner.limit(), 2u);
+}
+
+TEST(ConcurrencyTunerTest, RecordGroupsItemsIntoWindows) {
+    ConcurrencyTuner tuner(2, 1, 8);
+    for (int i = 0; i < 3; ++i) {
+        tuner.record(std::chrono::microseconds(500));
+    }
+    EXPECT_EQ(tuner.limit(), 2u);   // Window of four not yet full
+
+    tuner.record(std::chrono::microseconds(500));
+    EXPECT_EQ(tuner.limit(), 3u);
+    EXPECT_EQ(tuner.items(), 4u);
+    EXPECT_DOUBLE_EQ(tuner.meanLatencyUs(), 500.0);
+    EXPECT_GT(tuner.throughput(), 0.0);
+}
+
+class TimingHistoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir_ = std::filesystem::temp_directory_path() / "timing_history_test";
+        std::filesystem::create_directories(testDir_);
+        path_ = (testDir_ / "timings.json").string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir_);
+    }
+
+    static EnvironmentTiming timing(size_t render, size_t write, double latencyUs) {
+        EnvironmentTiming run;
+        run.render.concurrency = render;
+        run.render.meanLatencyUs = latencyUs;
+        run.render.throughput = 100.0;
+        run.write.concurrency = write;
+        run.write.meanLatencyUs = latencyUs * 10;
+        run.write.throughput = 20.0;
+        return run;
+    }
+
+    std::filesystem::path testDir_;
+    std::string path_;
+};
+
+TEST_F(TimingHistoryTest, RecordKeepsLatestConcurrencyAndSmoothsTimings) {
+    TimingHistory history;
+    history.record("host|share", timing(8, 4, 1000.0));
+    history.record("host|share", timing(6, 3, 2000.0));
+
+    EnvironmentTiming stored;
+    ASSERT_TRUE(history.find("host|share", stored));
+    EXPECT_EQ(stored.render.concurrency, 6u);
+    EXPECT_EQ(stored.write.concurrency, 3u);
+    EXPECT_EQ(stored.render.runs, 2u);
+    EXPECT_GT(stored.render.meanLatencyUs, 1000.0);
+    EXPECT_LT(stored.render.meanLatencyUs, 2000.0);
+    EXPECT_FALSE(history.find("host|other", stored));
+}
+
+TEST_F(TimingHistoryTest, UnusedStageKeepsItsHistory) {
+    TimingHistory history;
+    history.record("env", timing(8, 4, 1000.0));
+    EnvironmentTiming writeOnly = timing(0, 2, 1000.0);
+    history.record("env", writeOnly);
+
+    EnvironmentTiming stored;
+    ASSERT_TRUE(history.find("env", stored));
+    EXPECT_EQ(stored.render.concurrency, 8u);
+    EXPECT_EQ(stored.render.runs, 1u);
+    EXPECT_EQ(stored.write.concurrency, 2u);
+}
+
+TEST_F(TimingHistoryTest, SaveAndLoadRoundTrip) {
+    TimingHistory history;
+    history.record("a|\\\\server\\vault", timing(8, 4, 1000.0));
+    history.record("b|c:", timing(2, 12, 500.0));
+    ASSERT_TRUE(history.save(path_));
+
+    TimingHistory loaded;
+    ASSERT_TRUE(loaded.load(path_));
+    EXPECT_EQ(loaded.size(), 2u);
+    EnvironmentTiming stored;
+    ASSERT_TRUE(loaded.find("b|c:", stored));
+    EXPECT_EQ(stored.write.concurrency, 12u);
+    EXPECT_DOUBLE_EQ(stored.render.meanLatencyUs, 500.0);
+    EXPECT_FALSE(std::filesystem::exists(path_ + ".tmp"));
+}
+
+TEST_F(TimingHistoryTest, LoadReportsMissingAndInvalidFiles) {
+    TimingHistory history;
+    EXPECT_FALSE(history.load((testDir_ / "missing.json").string()));
+    EXPECT_EQ(history.getLastError().code, ErrorCode::FILE_NOT_FOUND);
+
+    std::ofstream(path_) << "{ not json";
+    EXPECT_FALSE(history.load(path_));
+    EXPECT_EQ(history.getLastError().code, ErrorCode::CONFIG_LOAD_FAILED);
+}
+
+TEST_F(TimingHistoryTest, EnvironmentKeySeparatesShares) {
+    std::string vault = TimingHistory::environmentKey("\\\\server\\vault\\a.drw");
+    std::string other = TimingHistory::environmentKey("\\\\server\\other\\a.drw");
+    EXPECT_NE(vault, other);
+    EXPECT_NE(vault.find("|\\\\server\\vault"), std::string::npos);
+    EXPECT_EQ(vault, TimingHistory::environmentKey("\\\\SERVER\\Vault\\sub\\b.drw"));
+}
@@ -0,0 +1,194 @@
+/**
+ * @file test_binary_log.cpp
+ * @brief Unit tests for BinaryLog and BinaryLogDecoder
+ */
+
+#include <gtest/gtest.h>
+#include "binary_log.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <thread>
+
+using namespace creo_barcode;
+
+namespace {
+
+std::string tempLogPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("creo_blog_test_" + name + ".blog")).string();
+}
+
+std::vector<DecodedLogEvent> decodeAll(const std::string& path) {
+    std::vector<DecodedLogEvent> events;
+    BinaryLogDecoder decoder;
+    EXPECT_TRUE(decoder.open(path));
+    DecodedLogEvent event;
+    while (decoder.next(event)) {
+        events.push_back(event);
+    }
+    EXPECT_TRUE(decoder.getLastError().isSuccess()) << decoder.getLastError().details;
+    return events;
+}
+
+void logPosition(int i, double x) {
+    BLOG_INFO("Image {} position: {}", i, x);
+}
+
+} // anonymous namespace
+
+TEST(BinaryLogTest, RoundTripsArgumentTypes) {
+    std::string path = tempLogPath("roundtrip");
+    BinaryLog& log = BinaryLog::getInstance();
+    ASSERT_TRUE(log.open(path));
+
+    std::string imagePath = "C:\\out\\PART_001.png";
+    BLOG_INFO("Inserting image: {}", imagePath);
+    BLOG_WARNING("Size: {} x {} ok={}", 25.5, 10.0, true);
+    BLOG_ERROR("code={} count={} name={}", ErrorCode::INVALID_DATA, size_t(42), "literal");
+    BLOG_INFO("negative {}", -7);
+    log.close();
+
+    auto events = decodeAll(path);
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_EQ(events[0].message, "Inserting image: C:\\out\\PART_001.png");
+    EXPECT_EQ(events[0].level, LogLevel::INFO);
+    EXPECT_EQ(events[1].message, "Size: 25.500000 x 10.000000 ok=true");
+    EXPECT_EQ(events[1].level, LogLevel::WARNING);
+    EXPECT_EQ(events[2].message, "code=" + std::to_string(static_cast<int>(ErrorCode::INVALID_DATA)) +
+                                 " count=42 name=literal");
+    EXPECT_EQ(events[2].level, LogLevel::ERR);
+    EXPECT_EQ(events[3].message, "negative -7");
+    EXPECT_NE(events[0].file.find("test_binary_log.cpp"), std::string::npos);
+    EXPECT_GT(events[0].line, 0);
+
+    std::string text = BinaryLogDecoder::formatEvent(events[2]);
+    EXPECT_NE(text.find("[ERROR]"), std::string::npos);
+    EXPECT_NE(text.find("(test_binary_log.cpp:"), std::string::npos);
+
+    std::filesystem::remove(path);
+}
+
+TEST(BinaryLogTest, DisabledLogWritesNothing) {
+    std::string path = tempLogPath("disabled");
+    BinaryLog& log = BinaryLog::getInstance();
+    ASSERT_TRUE(log.open(path));
+    log.close();
+    uint64_t before = std::filesystem::file_size(path);
+
+    BLOG_INFO("dropped {}", 1);
+    log.flush();
+
+    EXPECT_FALSE(log.isEnabled());
+    EXPECT_EQ(std::filesystem::file_size(path), before);
+    EXPECT_TRUE(decodeAll(path).empty());
+    std::filesystem::remove(path);
+}
+
+TEST(BinaryLogTest, FormatIsStoredOncePerSite) {
+    std::string path = tempLogPath("formats");
+    BinaryLog& log = BinaryLog::getInstance();
+    ASSERT_TRUE(log.open(path));
+    for (int i = 0; i < 100; ++i) {
+        logPosition(i, i * 0.5);
+    }
+    log.close();
+
+    std::ifstream file(path, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    size_t occurrences = 0;
+    for (size_t pos = content.find("Image {} position"); pos != std::string::npos;
+         pos = content.find("Image {} position", pos + 1)) {
+        ++occurrences;
+    }
+    EXPECT_EQ(occurrences, 1u);
+
+    auto events = decodeAll(path);
+    ASSERT_EQ(events.size(), 100u);
+    EXPECT_EQ(events[99].message, "Image 99 position: 49.500000");
+    std::filesystem::remove(path);
+}
+
+TEST(BinaryLogTest, SitesRegisteredBeforeReopenAreRewritten) {
+    std::string first = tempLogPath("reopen_a");
+    std::string second = tempLogPath("reopen_b");
+    BinaryLog& log = BinaryLog::getInstance();
+
+    ASSERT_TRUE(log.open(first));
+    logPosition(1, 1.0);
+    log.close();
+
+    ASSERT_TRUE(log.open(second));
+    logPosition(2, 2.0);
+    log.close();
+
+    auto events = decodeAll(second);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].message, "Image 2 position: 2.000000");
+    std::filesystem::remove(first);
+    std::filesystem::remove(second);
+}
+
+TEST(BinaryLogTest, ConcurrentWritersAreAllFlushed) {
+    std::string path = tempLogPath("threads");
+    BinaryLog& log = BinaryLog::getInstance();
+    ASSERT_TRUE(log.open(path));
+
+    const int threads = 4;
+    const int perThread = 5000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([t]() {
+            for (int i = 0; i < perThread; ++i) {
+                BLOG_INFO("worker {} event {}", t, i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    log.close();
+
+    auto events = decodeAll(path);
+    ASSERT_EQ(events.size(), static_cast<size_t>(threads * perThread));
+    std::set<uint32_t> threadIndices;
+    for (const auto& event : events) {
+        threadIndices.insert(event.threadIndex);
+    }
+    EXPECT_EQ(threadIndices.size(), static_cast<size_t>(threads));
+    std::filesystem::remove(path);
+}
+
+TEST(BinaryLogTest, DecoderRejectsOtherFiles) {
+    std::string path = tempLogPath("invalid");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "plain text log line";
+    }
+    BinaryLogDecoder decoder;
+    EXPECT_FALSE(decoder.open(path));
+    EXPECT_EQ(decoder.getLastError().code, ErrorCode::INVALID_DATA);
+    EXPECT_FALSE(decoder.open(tempLogPath("missing")));
+    EXPECT_EQ(decoder.getLastError().code, ErrorCode::FILE_NOT_FOUND);
+    std::filesystem::remove(path);
+}
+
+TEST(BinaryLogTest, HotPathCost) {
+    std::string path = tempLogPath("perf");
+    BinaryLog& log = BinaryLog::getInstance();
+    ASSERT_TRUE(log.open(path));
+
+    const int events = 200000;
+    std::string imagePath = "C:\\out\\PART_001.png";
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < events; ++i) {
+        BLOG_INFO("Inserting image {} at ({}, {}): {}", i, 10.0, 20.0, imagePath);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    log.close();
+
+    double nsPerEvent = std::chrono::duration<double, std::nano>(elapsed).count() / events;
+    RecordProperty("ns_per_event", std::to_string(nsPerEvent));
+    EXPECT_EQ(decodeAll(path).size(), static_cast<size_t>(events));
+    std::filesystem::remove(path);
+}
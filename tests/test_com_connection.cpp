@@ -0,0 +1,306 @@
+/**
+ * @file test_com_connection.cpp
+ * @brief Unit tests for the COM link circuit breaker and connection manager
+ */
+
+#include <gtest/gtest.h>
+#include "com_connection.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace creo_barcode;
+using namespace std::chrono_literals;
+
+namespace {
+
+class FakeClock {
+public:
+    std::chrono::steady_clock::time_point now() const { return now_; }
+    void advance(std::chrono::milliseconds delta) { now_ += delta; }
+
+    CircuitBreaker::Clock source() {
+        return [this]() { return now(); };
+    }
+
+private:
+    std::chrono::steady_clock::time_point now_{std::chrono::seconds(1000)};
+};
+
+// Stands in for the Creo AsyncConnection: the test decides whether Creo is up
+class FakeComConnection : public ComConnection {
+public:
+    bool connect() override {
+        ++connectCalls;
+        connected = creoRunning.load();
+        return connected;
+    }
+
+    void disconnect() override {
+        ++disconnectCalls;
+        connected = false;
+    }
+
+    bool probe() override {
+        ++probeCalls;
+        return creoRunning.load();
+    }
+
+    std::atomic<bool> creoRunning{true};
+    std::atomic<int> connectCalls{0};
+    std::atomic<int> disconnectCalls{0};
+    std::atomic<int> probeCalls{0};
+    bool connected = false;
+};
+
+CircuitBreakerConfig inlineConfig() {
+    CircuitBreakerConfig config;
+    config.failureThreshold = 3;
+    config.initialBackoff = 100ms;
+    config.maxBackoff = 1000ms;
+    config.backoffMultiplier = 2.0;
+    config.backgroundReconnect = false;
+    return config;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// CircuitBreaker
+// ============================================================================
+
+TEST(CircuitBreakerTest, OpensAfterThresholdFailures) {
+    FakeClock clock;
+    CircuitBreaker breaker(inlineConfig(), clock.source());
+
+    breaker.recordFailure();
+    breaker.recordFailure();
+    EXPECT_EQ(breaker.state(), CircuitState::CLOSED);
+    EXPECT_TRUE(breaker.allowRequest());
+
+    breaker.recordFailure();
+    EXPECT_EQ(breaker.state(), CircuitState::OPEN);
+    EXPECT_FALSE(breaker.allowRequest());
+    EXPECT_EQ(breaker.retryAt(), clock.now() + 100ms);
+}
+
+TEST(CircuitBreakerTest, SuccessResetsFailureCount) {
+    FakeClock clock;
+    CircuitBreaker breaker(inlineConfig(), clock.source());
+    breaker.recordFailure();
+    breaker.recordFailure();
+    breaker.recordSuccess();
+    breaker.recordFailure();
+    breaker.recordFailure();
+    EXPECT_EQ(breaker.state(), CircuitState::CLOSED);
+    EXPECT_EQ(breaker.consecutiveFailures(), 2);
+}
+
+TEST(CircuitBreakerTest, HalfOpenAllowsSingleTrial) {
+    FakeClock clock;
+    CircuitBreaker breaker(inlineConfig(), clock.source());
+    for (int i = 0; i < 3; ++i) {
+        breaker.recordFailure();
+    }
+
+    EXPECT_FALSE(breaker.probeDue());
+    clock.advance(100ms);
+    EXPECT_TRUE(breaker.probeDue());
+
+    breaker.enterHalfOpen();
+    EXPECT_EQ(breaker.state(), CircuitState::HALF_OPEN);
+    EXPECT_TRUE(breaker.allowRequest());
+    EXPECT_FALSE(breaker.allowRequest());
+
+    breaker.recordSuccess();
+    EXPECT_EQ(breaker.state(), CircuitState::CLOSED);
+    EXPECT_TRUE(breaker.allowRequest());
+}
+
+TEST(CircuitBreakerTest, FailedTrialBacksOffExponentiallyUpToCap) {
+    FakeClock clock;
+    CircuitBreaker breaker(inlineConfig(), clock.source());
+    for (int i = 0; i < 3; ++i) {
+        breaker.recordFailure();
+    }
+    EXPECT_EQ(breaker.currentBackoff(), 100ms);
+
+    std::chrono::milliseconds expected[] = {200ms, 400ms, 800ms, 1000ms, 1000ms};
+    for (auto backoff : expected) {
+        clock.advance(breaker.currentBackoff());
+        breaker.enterHalfOpen();
+        ASSERT_TRUE(breaker.allowRequest());
+        breaker.recordFailure();
+        EXPECT_EQ(breaker.state(), CircuitState::OPEN);
+        EXPECT_EQ(breaker.currentBackoff(), backoff);
+    }
+
+    // A later success starts the backoff over
+    clock.advance(breaker.currentBackoff());
+    breaker.enterHalfOpen();
+    breaker.recordSuccess();
+    for (int i = 0; i < 3; ++i) {
+        breaker.recordFailure();
+    }
+    EXPECT_EQ(breaker.currentBackoff(), 100ms);
+}
+
+// ============================================================================
+// ComConnectionManager
+// ============================================================================
+
+TEST(ComConnectionManagerTest, ConnectsOnceAndReusesHandles) {
+    FakeClock clock;
+    auto fake = std::make_unique<FakeComConnection>();
+    FakeComConnection* link = fake.get();
+    ComConnectionManager manager(std::move(fake), inlineConfig(), clock.source());
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(manager.acquire());
+        manager.reportSuccess();
+    }
+    EXPECT_EQ(link->connectCalls.load(), 1);
+    EXPECT_TRUE(manager.isConnected());
+    EXPECT_EQ(manager.stats().requests, 10u);
+}
+
+TEST(ComConnectionManagerTest, BrokenLinkShortCircuitsRequests) {
+    FakeClock clock;
+    auto fake = std::make_unique<FakeComConnection>();
+    FakeComConnection* link = fake.get();
+    link->creoRunning = false;
+    ComConnectionManager manager(std::move(fake), inlineConfig(), clock.source());
+
+    // K failed connects open the breaker; the rest cost nothing
+    for (int i = 0; i < 500; ++i) {
+        EXPECT_FALSE(manager.acquire());
+    }
+    EXPECT_EQ(link->connectCalls.load(), 3);
+    EXPECT_EQ(manager.state(), CircuitState::OPEN);
+    EXPECT_TRUE(manager.isOpen());
+
+    ComLinkStats stats = manager.stats();
+    EXPECT_EQ(stats.requests, 500u);
+    EXPECT_EQ(stats.rejected, 497u);
+    EXPECT_EQ(stats.failures, 3u);
+}
+
+TEST(ComConnectionManagerTest, ReportedFailureDropsCachedHandles) {
+    FakeClock clock;
+    auto fake = std::make_unique<FakeComConnection>();
+    FakeComConnection* link = fake.get();
+    ComConnectionManager manager(std::move(fake), inlineConfig(), clock.source());
+
+    ASSERT_TRUE(manager.acquire());
+    manager.reportFailure();
+    EXPECT_FALSE(manager.isConnected());
+    EXPECT_EQ(link->disconnectCalls.load(), 1);
+    EXPECT_EQ(manager.state(), CircuitState::CLOSED);
+
+    // Below the threshold the next request reconnects
+    ASSERT_TRUE(manager.acquire());
+    EXPECT_EQ(link->connectCalls.load(), 2);
+}
+
+TEST(ComConnectionManagerTest, InlineTrialAfterBackoffRecovers) {
+    FakeClock clock;
+    auto fake = std::make_unique<FakeComConnection>();
+    FakeComConnection* link = fake.get();
+    link->creoRunning = false;
+    ComConnectionManager manager(std::move(fake), inlineConfig(), clock.source());
+    for (int i = 0; i < 3; ++i) {
+        manager.acquire();
+    }
+    ASSERT_EQ(manager.state(), CircuitState::OPEN);
+
+    link->creoRunning = true;
+    EXPECT_FALSE(manager.acquire());    // still backing off
+
+    clock.advance(100ms);
+    EXPECT_FALSE(manager.isOpen());
+    ASSERT_TRUE(manager.acquire());     // the trial
+    EXPECT_EQ(manager.state(), CircuitState::HALF_OPEN);
+    manager.reportSuccess();
+    EXPECT_EQ(manager.state(), CircuitState::CLOSED);
+    EXPECT_EQ(link->probeCalls.load(), 0);
+}
+
+TEST(ComConnectionManagerTest, ProbeMovesToHalfOpenOnlyWhenReachable) {
+    FakeClock clock;
+    auto fake = std::make_unique<FakeComConnection>();
+    FakeComConnection* link = fake.get();
+    link->creoRunning = false;
+    ComConnectionManager manager(std::move(fake), inlineConfig(), clock.source());
+    for (int i = 0; i < 3; ++i) {
+        manager.acquire();
+    }
+
+    EXPECT_FALSE(manager.pollReconnect());  // not due yet
+    clock.advance(100ms);
+    EXPECT_TRUE(manager.pollReconnect());   // Creo still down
+    EXPECT_EQ(manager.state(), CircuitState::OPEN);
+
+    link->creoRunning = true;
+    clock.advance(200ms);
+    EXPECT_TRUE(manager.pollReconnect());
+    EXPECT_EQ(manager.state(), CircuitState::HALF_OPEN);
+    EXPECT_EQ(link->probeCalls.load(), 2);
+
+    ASSERT_TRUE(manager.acquire());
+    EXPECT_FALSE(manager.acquire());        // only one trial at a time
+    manager.reportSuccess();
+    EXPECT_TRUE(manager.acquire());
+}
+
+TEST(ComConnectionManagerTest, ResetClosesBreaker) {
+    FakeClock clock;
+    auto fake = std::make_unique<FakeComConnection>();
+    FakeComConnection* link = fake.get();
+    link->creoRunning = false;
+    ComConnectionManager manager(std::move(fake), inlineConfig(), clock.source());
+    for (int i = 0; i < 3; ++i) {
+        manager.acquire();
+    }
+    manager.reset();
+    EXPECT_EQ(manager.state(), CircuitState::CLOSED);
+    link->creoRunning = true;
+    EXPECT_TRUE(manager.acquire());
+}
+
+TEST(ComConnectionManagerTest, BackgroundWorkerReconnects) {
+    CircuitBreakerConfig config = inlineConfig();
+    config.initialBackoff = 5ms;
+    config.maxBackoff = 20ms;
+    config.backgroundReconnect = true;
+
+    auto fake = std::make_unique<FakeComConnection>();
+    FakeComConnection* link = fake.get();
+    link->creoRunning = false;
+    ComConnectionManager manager(std::move(fake), config);
+    for (int i = 0; i < 3; ++i) {
+        manager.acquire();
+    }
+    ASSERT_EQ(manager.state(), CircuitState::OPEN);
+
+    // Callers are rejected while the worker probes in the background
+    EXPECT_FALSE(manager.acquire());
+    link->creoRunning = true;
+
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (manager.state() == CircuitState::OPEN && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(manager.state(), CircuitState::HALF_OPEN);
+    EXPECT_GE(link->probeCalls.load(), 1);
+
+    ASSERT_TRUE(manager.acquire());
+    manager.reportSuccess();
+    EXPECT_EQ(manager.state(), CircuitState::CLOSED);
+}
+
+TEST(ComConnectionManagerTest, StateNames) {
+    EXPECT_STREQ(circuitStateName(CircuitState::CLOSED), "closed");
+    EXPECT_STREQ(circuitStateName(CircuitState::OPEN), "open");
+    EXPECT_STREQ(circuitStateName(CircuitState::HALF_OPEN), "half-open");
+}
@@ -110,6 +110,8 @@ TEST_F(ConfigManagerTest, SaveConfigPreservesAllFields) {
     config.defaultDpi = 600;
     config.outputDirectory = "/test/output";
     config.recentFiles = {"a.drw", "b.drw", "c.drw"};
+    config.enableTracing = true;
+    config.speculativeGeneration = true;
     
     manager_.setConfig(config);
     
@@ -128,6 +130,8 @@ TEST_F(ConfigManagerTest, SaveConfigPreservesAllFields) {
     EXPECT_EQ(loaded.outputDirectory, "/test/output");
     EXPECT_EQ(loaded.recentFiles.size(), 3);
     EXPECT_EQ(loaded.recentFiles[0], "a.drw");
+    EXPECT_TRUE(loaded.enableTracing);
+    EXPECT_TRUE(loaded.speculativeGeneration);
 }
 
 TEST_F(ConfigManagerTest, DeserializeHandlesEmptyJson) {
@@ -205,6 +209,8 @@ TEST_F(ConfigManagerTest, DefaultConfigValues) {
     EXPECT_TRUE(config.defaultShowText);
     EXPECT_EQ(config.defaultDpi, 300);
     EXPECT_TRUE(config.recentFiles.empty());
+    EXPECT_FALSE(config.enableTracing);
+    EXPECT_FALSE(config.speculativeGeneration);
 }
 
 TEST_F(ConfigManagerTest, SaveConfigToInvalidPath) {
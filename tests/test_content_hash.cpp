@@ -0,0 +1,194 @@
+/**
+ * @file test_content_hash.cpp
+ * @brief Unit tests for the content hashing utilities
+ */
+
+#include <gtest/gtest.h>
+#include "content_hash.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace creo_barcode;
+
+namespace {
+
+std::vector<unsigned char> randomBytes(size_t size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<unsigned char> bytes(size);
+    for (auto& b : bytes) {
+        b = static_cast<unsigned char>(rng());
+    }
+    return bytes;
+}
+
+int popcount64(uint64_t x) {
+    int count = 0;
+    while (x) {
+        x &= x - 1;
+        ++count;
+    }
+    return count;
+}
+
+} // anonymous namespace
+
+TEST(ContentHashTest, DeterministicAndSeeded) {
+    EXPECT_EQ(hash64("PART_001"), hash64("PART_001"));
+    EXPECT_NE(hash64("PART_001"), hash64("PART_002"));
+    EXPECT_NE(hash64("PART_001", 1), hash64("PART_001", 2));
+    EXPECT_NE(hash64(""), hash64(std::string(1, '\0')));
+    EXPECT_EQ(hash64("abc"), hash128("abc").low);
+}
+
+TEST(ContentHashTest, ZeroPaddingDoesNotCollide) {
+    // The tail is zero-padded internally; the length must disambiguate
+    std::set<uint64_t> seen;
+    for (size_t len = 0; len <= 130; ++len) {
+        EXPECT_TRUE(seen.insert(hash64(std::string(len, '\0'))).second) << "length " << len;
+    }
+}
+
+TEST(ContentHashTest, StreamingMatchesOneShot) {
+    auto data = randomBytes(5000, 42);
+    std::mt19937 rng(7);
+
+    for (size_t size : {0u, 1u, 63u, 64u, 65u, 127u, 128u, 1023u, 1024u, 1025u, 5000u}) {
+        Hash128 expected = hashBytes128(data.data(), size);
+
+        ContentHasher hasher;
+        size_t offset = 0;
+        while (offset < size) {
+            size_t chunk = std::min<size_t>(size - offset, rng() % 200);
+            hasher.update(data.data() + offset, chunk);
+            offset += chunk;
+        }
+        EXPECT_EQ(hasher.finish(), expected) << "size " << size;
+    }
+}
+
+TEST(ContentHashTest, SimdMatchesPortable) {
+    auto data = randomBytes(4096 + 17, 1234);
+    for (size_t size = 0; size <= data.size(); size += 37) {
+        ContentHasher portable = ContentHasher::portable(99);
+        portable.update(data.data(), size);
+        EXPECT_EQ(hashBytes128(data.data(), size, 99), portable.finish()) << "size " << size;
+    }
+}
+
+TEST(ContentHashTest, ResetStartsOver) {
+    ContentHasher hasher(5);
+    hasher.update("something else");
+    hasher.reset();
+    hasher.update("PART_001");
+    EXPECT_EQ(hasher.finish(), hash128("PART_001", 5));
+}
+
+TEST(ContentHashTest, SingleBitFlipAvalanches) {
+    auto data = randomBytes(256, 3);
+    uint64_t base = hashBytes64(data.data(), data.size());
+
+    int totalChanged = 0;
+    int flips = 0;
+    for (size_t byte = 0; byte < data.size(); byte += 7) {
+        for (int bit = 0; bit < 8; ++bit) {
+            data[byte] ^= static_cast<unsigned char>(1 << bit);
+            totalChanged += popcount64(base ^ hashBytes64(data.data(), data.size()));
+            data[byte] ^= static_cast<unsigned char>(1 << bit);
+            ++flips;
+        }
+    }
+
+    double average = static_cast<double>(totalChanged) / flips;
+    EXPECT_GT(average, 28.0);
+    EXPECT_LT(average, 36.0);
+}
+
+TEST(ContentHashTest, HexFormatting) {
+    Hash128 hash;
+    hash.high = 0x0123456789abcdefULL;
+    hash.low = 0xfedcba9876543210ULL;
+    EXPECT_EQ(hash.toHex(), "0123456789abcdeffedcba9876543210");
+}
+
+TEST(ContentHashTest, HashFileMatchesContents) {
+    auto dir = std::filesystem::temp_directory_path() / "content_hash_test";
+    std::filesystem::create_directories(dir);
+    auto data = randomBytes(100000, 11);
+
+    std::string path = (dir / "image.png").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+    std::string emptyPath = (dir / "empty.png").string();
+    std::ofstream(emptyPath).close();
+
+    auto fileHash = hashFile(path);
+    ASSERT_TRUE(fileHash.has_value());
+    EXPECT_EQ(*fileHash, hashBytes128(data.data(), data.size()));
+
+    auto emptyHash = hashFile(emptyPath);
+    ASSERT_TRUE(emptyHash.has_value());
+    EXPECT_EQ(*emptyHash, hash128(""));
+
+    EXPECT_FALSE(hashFile((dir / "missing.png").string()).has_value());
+    std::filesystem::remove_all(dir);
+}
+
+TEST(ContentHashTest, ConfigHashIgnoresIrrelevantFields) {
+    BarcodeConfig qr;
+    qr.type = BarcodeType::QR_CODE;
+    BarcodeConfig qrNoText = qr;
+    qrNoText.showText = !qr.showText;
+    BarcodeConfig qrOtherDpi = qr;
+    qrOtherDpi.dpi = 600;
+
+    EXPECT_EQ(hashBarcodeConfig(qr), hashBarcodeConfig(qrNoText));
+    EXPECT_EQ(hashBarcodeConfig(qr), hashBarcodeConfig(qrOtherDpi));
+
+    BarcodeConfig dm = qr;
+    dm.type = BarcodeType::DATA_MATRIX;
+    BarcodeConfig dmNoText = dm;
+    dmNoText.showText = !dm.showText;
+    EXPECT_EQ(hashBarcodeConfig(dm), hashBarcodeConfig(dmNoText));
+    EXPECT_NE(hashBarcodeConfig(qr), hashBarcodeConfig(dm));
+}
+
+TEST(ContentHashTest, ConfigHashTracksRelevantFields) {
+    BarcodeConfig code128;
+    BarcodeConfig noText = code128;
+    noText.showText = !code128.showText;
+    BarcodeConfig wider = code128;
+    wider.width += 1;
+    BarcodeConfig taller = code128;
+    taller.height += 1;
+    BarcodeConfig margin = code128;
+    margin.margin += 1;
+
+    uint64_t base = hashBarcodeConfig(code128);
+    EXPECT_NE(base, hashBarcodeConfig(noText));
+    EXPECT_NE(base, hashBarcodeConfig(wider));
+    EXPECT_NE(base, hashBarcodeConfig(taller));
+    EXPECT_NE(base, hashBarcodeConfig(margin));
+}
+
+TEST(ContentHashTest, ReportsThroughput) {
+    auto data = randomBytes(32 * 1024 * 1024, 5);
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t sink = 0;
+    const int rounds = 4;
+    for (int i = 0; i < rounds; ++i) {
+        sink ^= hashBytes64(data.data(), data.size(), static_cast<uint64_t>(i));
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double gbPerSecond = (static_cast<double>(data.size()) * rounds / 1e9) / elapsed.count();
+    RecordProperty("hash64_gb_per_s", std::to_string(gbPerSecond));
+    RecordProperty("simd", ContentHasher::simdEnabled() ? "sse2" : "none");
+    EXPECT_NE(sink, 0u);
+}
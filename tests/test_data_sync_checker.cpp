@@ -11,6 +11,7 @@
 #include <gtest/gtest.h>
 #include "data_sync_checker.h"
 #include "barcode_generator.h"
+#include "barcode_inventory.h"
 
 using namespace creo_barcode;
 
@@ -258,3 +259,31 @@ TEST_F(DataSyncCheckerTest, SyncCheckResult_HelperMethods) {
     EXPECT_FALSE(result.isInSync());
     EXPECT_FALSE(result.needsUpdate());
 }
+
+// Test: Async checks overlap safely on one checker and record every row
+TEST_F(DataSyncCheckerTest, CheckSyncAsync_ConcurrentChecksRecordAllRows) {
+    BarcodeInventory inventory;
+    checker->setInventory(&inventory);
+    
+    std::vector<std::future<Result<SyncCheckResult>>> futures;
+    for (int i = 0; i < 200; ++i) {
+        BarcodeInstance instance;
+        instance.imagePath = "barcode_" + std::to_string(i) + ".png";
+        instance.decodedData = "PART_" + std::to_string(i);
+        std::string partName = (i % 4 == 0) ? "RENAMED_" + std::to_string(i) : instance.decodedData;
+        futures.push_back(checker->checkSyncAsync(partName, instance));
+    }
+    
+    int outOfSync = 0;
+    for (auto& future : futures) {
+        Result<SyncCheckResult> result = future.get();
+        ASSERT_TRUE(result.ok()) << result.error().message();
+        if (result.value().needsUpdate()) {
+            ++outOfSync;
+        }
+    }
+    
+    EXPECT_EQ(outOfSync, 50);
+    EXPECT_EQ(inventory.size(), 200u);
+    EXPECT_EQ(inventory.countByStatus()[static_cast<size_t>(SyncStatus::OUT_OF_SYNC)], 50u);
+}
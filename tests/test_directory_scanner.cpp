@@ -0,0 +1,180 @@
+/**
+ * @file test_directory_scanner.cpp
+ * @brief Unit tests for NameFilter and DirectoryScanner
+ */
+
+#include <gtest/gtest.h>
+#include "directory_scanner.h"
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace creo_barcode;
+
+namespace {
+
+class DirectoryScannerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir_ = std::filesystem::temp_directory_path() / "directory_scanner_test";
+        std::filesystem::remove_all(testDir_);
+        std::filesystem::create_directories(testDir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir_);
+    }
+
+    void touch(const std::filesystem::path& relative) {
+        std::filesystem::create_directories((testDir_ / relative).parent_path());
+        std::ofstream(testDir_ / relative).close();
+    }
+
+    std::vector<std::string> scanAll(DirectoryScanner& scanner, const std::vector<std::string>& roots) {
+        std::mutex mutex;
+        std::vector<std::string> found;
+        scanner.scan(roots, [&](std::vector<std::string>&& paths) {
+            std::lock_guard<std::mutex> lock(mutex);
+            found.insert(found.end(), paths.begin(), paths.end());
+        });
+        std::sort(found.begin(), found.end());
+        return found;
+    }
+
+    std::filesystem::path testDir_;
+};
+
+} // anonymous namespace
+
+TEST(NameFilterTest, EmptyFilterMatchesEverything) {
+    NameFilter filter;
+    EXPECT_TRUE(filter.matchesAll());
+    EXPECT_TRUE(filter.matches("anything.txt"));
+}
+
+TEST(NameFilterTest, ExtensionPatternsAreCaseInsensitive) {
+    NameFilter filter({"*.drw", "*.PRT"});
+    EXPECT_TRUE(filter.matches("a.drw"));
+    EXPECT_TRUE(filter.matches("A.DRW"));
+    EXPECT_TRUE(filter.matches("bracket.prt"));
+    EXPECT_FALSE(filter.matches("a.drw.2"));
+    EXPECT_FALSE(filter.matches("drw"));
+    EXPECT_FALSE(filter.matches("a.asm"));
+}
+
+TEST(NameFilterTest, WildcardPatterns) {
+    NameFilter filter({"*.drw.*", "part_??.asm"});
+    EXPECT_TRUE(filter.matches("a.drw.1"));
+    EXPECT_TRUE(filter.matches("a.drw.12"));
+    EXPECT_FALSE(filter.matches("a.drw"));
+    EXPECT_TRUE(filter.matches("PART_07.asm"));
+    EXPECT_FALSE(filter.matches("part_7.asm"));
+}
+
+TEST(NameFilterTest, MultiDotPatterns) {
+    NameFilter filter({"*.drw.1", "*.tar.gz"});
+    EXPECT_TRUE(filter.matches("part.drw.1"));
+    EXPECT_TRUE(filter.matches("PART.DRW.1"));
+    EXPECT_TRUE(filter.matches("logs.tar.gz"));
+    EXPECT_FALSE(filter.matches("part.drw.2"));
+    EXPECT_FALSE(filter.matches("part.1"));
+    EXPECT_FALSE(filter.matches("logs.gz"));
+}
+
+TEST(DirectoryScannerShareTest, SharesFromPaths) {
+    EXPECT_EQ(DirectoryScanner::shareOf("\\\\Server\\Vault\\drawings"), "\\\\server\\vault");
+    EXPECT_EQ(DirectoryScanner::shareOf("//server/vault/a/b"), "\\\\server\\vault");
+    EXPECT_EQ(DirectoryScanner::shareOf("\\\\server\\vault"), "\\\\server\\vault");
+    EXPECT_EQ(DirectoryScanner::shareOf("C:\\work"), "c:");
+    EXPECT_NE(DirectoryScanner::shareOf("\\\\server\\vault\\a"),
+              DirectoryScanner::shareOf("\\\\server\\other\\a"));
+}
+
+TEST_F(DirectoryScannerTest, FindsMatchingFilesRecursively) {
+    touch("top.drw");
+    touch("a/one.drw");
+    touch("a/b/c/two.drw");
+    touch("a/b/skip.prt");
+
+    ScanOptions options;
+    options.patterns = {"*.drw"};
+    DirectoryScanner scanner(options);
+    auto found = scanAll(scanner, {testDir_.string()});
+
+    ASSERT_EQ(found.size(), 3u);
+    EXPECT_EQ(std::filesystem::path(found[2]).filename(), "top.drw");
+    ScanStats stats = scanner.stats();
+    EXPECT_EQ(stats.directories, 4u);
+    EXPECT_EQ(stats.filesMatched, 3u);
+    EXPECT_EQ(stats.filesSkipped, 1u);
+    EXPECT_EQ(stats.unreadable, 0u);
+    EXPECT_EQ(stats.shares, 1u);
+}
+
+TEST_F(DirectoryScannerTest, MaxDepthLimitsRecursion) {
+    touch("l0.drw");
+    touch("a/l1.drw");
+    touch("a/b/l2.drw");
+
+    ScanOptions options;
+    options.maxDepth = 1;
+    DirectoryScanner scanner(options);
+    EXPECT_EQ(scanAll(scanner, {testDir_.string()}).size(), 2u);
+}
+
+TEST_F(DirectoryScannerTest, MissingRootsAreCountedAndReported) {
+    DirectoryScanner scanner;
+    EXPECT_TRUE(scanAll(scanner, {(testDir_ / "missing").string()}).empty());
+    EXPECT_EQ(scanner.stats().unreadable, 1u);
+    EXPECT_EQ(scanner.getLastError().code, ErrorCode::FILE_NOT_FOUND);
+
+    touch("x/found.drw");
+    auto found = scanAll(scanner, {(testDir_ / "missing").string(), (testDir_ / "x").string()});
+    EXPECT_EQ(found.size(), 1u);
+    EXPECT_TRUE(scanner.getLastError().code == ErrorCode::SUCCESS);
+}
+
+TEST_F(DirectoryScannerTest, ConcurrencyPerShareIsBounded) {
+    for (int i = 0; i < 24; ++i) {
+        touch("d" + std::to_string(i) + "/f.drw");
+    }
+
+    ScanOptions options;
+    options.maxThreads = 8;
+    options.maxPerShare = 2;
+    DirectoryScanner scanner(options);
+    std::atomic<int> inSink{0};
+    std::atomic<int> peak{0};
+    scanner.scan({testDir_.string()}, [&](std::vector<std::string>&&) {
+        int now = ++inSink;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        --inSink;
+    });
+
+    EXPECT_LE(peak.load(), 2);
+    EXPECT_EQ(scanner.stats().filesMatched, 24u);
+    EXPECT_EQ(scanner.stats().threads, 2u);
+}
+
+TEST_F(DirectoryScannerTest, CancelStopsTheWalk) {
+    for (int i = 0; i < 50; ++i) {
+        touch("d" + std::to_string(i) + "/f.drw");
+    }
+
+    ScanOptions options;
+    options.maxPerShare = 1;
+    DirectoryScanner scanner(options);
+    size_t batches = 0;
+    scanner.scan({testDir_.string()}, [&](std::vector<std::string>&&) {
+        ++batches;
+        scanner.cancel();
+    });
+
+    EXPECT_EQ(batches, 1u);
+    EXPECT_LT(scanner.stats().directories, 51u);
+}
@@ -0,0 +1,225 @@
+/**
+ * @file test_directory_watcher.cpp
+ * @brief Unit tests for DirectoryWatcher and ImageInventory
+ */
+
+#include <gtest/gtest.h>
+#include "directory_watcher.h"
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <condition_variable>
+#include <map>
+
+using namespace creo_barcode;
+using namespace std::chrono_literals;
+
+namespace {
+
+class DirectoryWatcherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir_ = std::filesystem::temp_directory_path() / "directory_watcher_test";
+        std::filesystem::remove_all(testDir_);
+        std::filesystem::create_directories(testDir_);
+        if (!DirectoryWatcher::isSupported()) {
+            GTEST_SKIP() << "No native change notifications on this platform";
+        }
+    }
+
+    void TearDown() override {
+        watcher_.stop();
+        std::filesystem::remove_all(testDir_);
+    }
+
+    std::string pathOf(const std::string& name) const {
+        return (testDir_ / name).string();
+    }
+
+    void writeFile(const std::string& name, const std::string& content) {
+        std::ofstream out(testDir_ / name, std::ios::binary | std::ios::trunc);
+        out << content;
+    }
+
+    bool startWatching() {
+        return watcher_.start(testDir_.string(), [this](const std::vector<FileChange>& changes) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& change : changes) {
+                changes_[change.path] = change.kind;
+            }
+            changed_.notify_all();
+        }, 20ms);
+    }
+
+    // Waits until the path has been reported, then returns its last kind
+    bool waitFor(const std::string& name, FileChangeKind& kind) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        std::string path = pathOf(name);
+        bool seen = changed_.wait_for(lock, 5s, [&]() { return changes_.count(path) != 0; });
+        if (seen) {
+            kind = changes_[path];
+            changes_.erase(path);
+        }
+        return seen;
+    }
+
+    size_t reportedCount() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return changes_.size();
+    }
+
+    std::filesystem::path testDir_;
+    DirectoryWatcher watcher_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::map<std::string, FileChangeKind> changes_;
+};
+
+} // anonymous namespace
+
+TEST(DirectoryWatcherNameTest, RecognisesImageExtensions) {
+    EXPECT_TRUE(DirectoryWatcher::isImageName("a.png"));
+    EXPECT_TRUE(DirectoryWatcher::isImageName("A.PNG"));
+    EXPECT_TRUE(DirectoryWatcher::isImageName("photo.jpeg"));
+    EXPECT_TRUE(DirectoryWatcher::isImageName("photo.JPG"));
+    EXPECT_TRUE(DirectoryWatcher::isImageName("scan.bmp"));
+    EXPECT_FALSE(DirectoryWatcher::isImageName("notes.txt"));
+    EXPECT_FALSE(DirectoryWatcher::isImageName("png"));
+    EXPECT_FALSE(DirectoryWatcher::isImageName(".png"));
+    EXPECT_FALSE(DirectoryWatcher::isImageName("a.png.tmp"));
+}
+
+TEST_F(DirectoryWatcherTest, StartSeedsInventoryWithImagesOnly) {
+    writeFile("a.png", "aaa");
+    writeFile("b.jpg", "bb");
+    writeFile("notes.txt", "x");
+    std::filesystem::create_directories(testDir_ / "sub.png");
+
+    ASSERT_TRUE(startWatching());
+    EXPECT_TRUE(watcher_.isRunning());
+    EXPECT_EQ(watcher_.inventory().size(), 2u);
+
+    ImageFileInfo info;
+    ASSERT_TRUE(watcher_.inventory().find(pathOf("a.png"), info));
+    EXPECT_EQ(info.size, 3u);
+    EXPECT_FALSE(watcher_.inventory().contains(pathOf("notes.txt")));
+}
+
+TEST_F(DirectoryWatcherTest, StartFailsForMissingDirectory) {
+    EXPECT_FALSE(watcher_.start((testDir_ / "missing").string()));
+    EXPECT_FALSE(watcher_.isRunning());
+    EXPECT_EQ(watcher_.getLastError().code, ErrorCode::FILE_NOT_FOUND);
+}
+
+TEST_F(DirectoryWatcherTest, ReportsAddModifyAndRemove) {
+    ASSERT_TRUE(startWatching());
+    FileChangeKind kind;
+
+    writeFile("a.png", "1");
+    ASSERT_TRUE(waitFor("a.png", kind));
+    EXPECT_EQ(kind, FileChangeKind::ADDED);
+    EXPECT_TRUE(watcher_.inventory().contains(pathOf("a.png")));
+
+    writeFile("a.png", "longer");
+    ASSERT_TRUE(waitFor("a.png", kind));
+    EXPECT_EQ(kind, FileChangeKind::MODIFIED);
+    ImageFileInfo info;
+    ASSERT_TRUE(watcher_.inventory().find(pathOf("a.png"), info));
+    EXPECT_EQ(info.size, 6u);
+
+    std::filesystem::remove(testDir_ / "a.png");
+    ASSERT_TRUE(waitFor("a.png", kind));
+    EXPECT_EQ(kind, FileChangeKind::REMOVED);
+    EXPECT_FALSE(watcher_.inventory().contains(pathOf("a.png")));
+}
+
+TEST_F(DirectoryWatcherTest, RenameReportsBothNames) {
+    writeFile("old.png", "data");
+    ASSERT_TRUE(startWatching());
+
+    std::filesystem::rename(testDir_ / "old.png", testDir_ / "new.png");
+    FileChangeKind kind;
+    ASSERT_TRUE(waitFor("new.png", kind));
+    EXPECT_EQ(kind, FileChangeKind::ADDED);
+    ASSERT_TRUE(waitFor("old.png", kind));
+    EXPECT_EQ(kind, FileChangeKind::REMOVED);
+    EXPECT_EQ(watcher_.inventory().size(), 1u);
+}
+
+TEST_F(DirectoryWatcherTest, NonImageFilesAreIgnored) {
+    ASSERT_TRUE(startWatching());
+
+    writeFile("notes.txt", "x");
+    writeFile("marker.png", "m");
+    FileChangeKind kind;
+    ASSERT_TRUE(waitFor("marker.png", kind));
+
+    EXPECT_EQ(reportedCount(), 0u);
+    EXPECT_EQ(watcher_.inventory().size(), 1u);
+}
+
+TEST_F(DirectoryWatcherTest, LargeDirectoryIsNotRescannedOnChange) {
+    const int fileCount = 5000;
+    for (int i = 0; i < fileCount; ++i) {
+        writeFile("img_" + std::to_string(i) + ".png", "x");
+    }
+    ASSERT_TRUE(startWatching());
+    ASSERT_EQ(watcher_.inventory().size(), static_cast<size_t>(fileCount));
+
+    writeFile("img_42.png", "changed");
+    FileChangeKind kind;
+    ASSERT_TRUE(waitFor("img_42.png", kind));
+    EXPECT_EQ(kind, FileChangeKind::MODIFIED);
+
+    DirectoryWatcherStats stats = watcher_.stats();
+    EXPECT_EQ(stats.rescans, 0u);
+    EXPECT_EQ(stats.changes, 1u);
+    EXPECT_EQ(watcher_.inventory().size(), static_cast<size_t>(fileCount));
+}
+
+TEST_F(DirectoryWatcherTest, RescanReconcilesInventory) {
+    writeFile("keep.png", "k");
+    writeFile("gone.png", "g");
+    ASSERT_TRUE(startWatching());
+    watcher_.stop();
+
+    // Changes made while not watching are only found by a rescan
+    std::filesystem::remove(testDir_ / "gone.png");
+    writeFile("fresh.bmp", "f");
+    watcher_.rescan();
+
+    FileChangeKind kind;
+    ASSERT_TRUE(waitFor("gone.png", kind));
+    EXPECT_EQ(kind, FileChangeKind::REMOVED);
+    ASSERT_TRUE(waitFor("fresh.bmp", kind));
+    EXPECT_EQ(kind, FileChangeKind::ADDED);
+    EXPECT_EQ(reportedCount(), 0u);
+    EXPECT_EQ(watcher_.inventory().size(), 2u);
+    EXPECT_EQ(watcher_.stats().rescans, 1u);
+}
+
+TEST_F(DirectoryWatcherTest, UnreadableDirectoryReportsNoRemovals) {
+    writeFile("a.png", "a");
+    writeFile("b.jpg", "b");
+    ASSERT_TRUE(startWatching());
+    watcher_.stop();
+
+    // Moved away rather than chmod'ed, which would not stop root
+    std::filesystem::path moved = testDir_.string() + "_moved";
+    std::filesystem::remove_all(moved);
+    std::filesystem::rename(testDir_, moved);
+    watcher_.rescan();
+    std::filesystem::rename(moved, testDir_);
+
+    EXPECT_EQ(reportedCount(), 0u);
+    EXPECT_EQ(watcher_.inventory().size(), 2u);
+    EXPECT_TRUE(watcher_.inventory().contains(pathOf("a.png")));
+    EXPECT_EQ(watcher_.stats().rescans, 0u);
+}
+
+TEST_F(DirectoryWatcherTest, StopIsIdempotent) {
+    ASSERT_TRUE(startWatching());
+    watcher_.stop();
+    watcher_.stop();
+    EXPECT_FALSE(watcher_.isRunning());
+}
@@ -0,0 +1,157 @@
+/**
+ * @file test_edit_transaction.cpp
+ * @brief Unit tests for deferred repaint and drawing edit transactions
+ */
+
+#include <gtest/gtest.h>
+#include "edit_transaction.h"
+#include "drawing_interface.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace creo_barcode {
+namespace testing {
+
+// Simulation hooks from drawing_interface.cpp
+void setSimulatedDrawingState(ProDrawing drawing, ProMdl model,
+                              ModelType modelType, const std::string& partName);
+uint64_t simulatedRepaintCount();
+void resetSimulatedState();
+
+TEST(RepaintBatcherTest, RefreshesImmediatelyOutsideTransaction) {
+    int refreshes = 0;
+    RepaintBatcher batcher([&]() { ++refreshes; return true; });
+
+    EXPECT_TRUE(batcher.modified());
+    EXPECT_TRUE(batcher.modified());
+    EXPECT_EQ(refreshes, 2);
+    EXPECT_EQ(batcher.refreshes(), 2u);
+    EXPECT_FALSE(batcher.pending());
+}
+
+TEST(RepaintBatcherTest, TransactionCoalescesIntoOneRefresh) {
+    int refreshes = 0;
+    RepaintBatcher batcher([&]() { ++refreshes; return true; });
+
+    {
+        DrawingEditTransaction edit(batcher);
+        for (int i = 0; i < 50; ++i) {
+            batcher.modified();
+        }
+        EXPECT_EQ(refreshes, 0);
+        EXPECT_TRUE(batcher.pending());
+    }
+    EXPECT_EQ(refreshes, 1);
+    EXPECT_EQ(batcher.modifications(), 50u);
+    EXPECT_FALSE(batcher.inTransaction());
+}
+
+TEST(RepaintBatcherTest, NestedScopesRefreshAtOutermostEnd) {
+    int refreshes = 0;
+    RepaintBatcher batcher([&]() { ++refreshes; return true; });
+
+    {
+        DrawingEditTransaction outer(batcher);
+        {
+            DrawingEditTransaction inner(batcher);
+            batcher.modified();
+            EXPECT_EQ(batcher.depth(), 2);
+        }
+        EXPECT_EQ(refreshes, 0);
+        batcher.modified();
+    }
+    EXPECT_EQ(refreshes, 1);
+}
+
+TEST(RepaintBatcherTest, EmptyTransactionDoesNotRefresh) {
+    int refreshes = 0;
+    RepaintBatcher batcher([&]() { ++refreshes; return true; });
+    {
+        DrawingEditTransaction edit(batcher);
+    }
+    EXPECT_EQ(refreshes, 0);
+}
+
+TEST(RepaintBatcherTest, CommitIsIdempotentAndReportsRefreshFailure) {
+    RepaintBatcher batcher([]() { return false; });
+    DrawingEditTransaction edit(batcher);
+    batcher.modified();
+    EXPECT_FALSE(edit.commit());
+    EXPECT_TRUE(edit.commit());
+    EXPECT_FALSE(batcher.inTransaction());
+}
+
+TEST(RepaintBatcherTest, ExceptionStillRefreshes) {
+    int refreshes = 0;
+    RepaintBatcher batcher([&]() { ++refreshes; return true; });
+    try {
+        DrawingEditTransaction edit(batcher);
+        batcher.modified();
+        throw std::runtime_error("insert failed");
+    } catch (const std::runtime_error&) {
+    }
+    EXPECT_EQ(refreshes, 1);
+    EXPECT_FALSE(batcher.inTransaction());
+}
+
+TEST(RepaintBatcherTest, UnbalancedEndIsIgnored) {
+    RepaintBatcher batcher(nullptr);
+    EXPECT_TRUE(batcher.end());
+    EXPECT_EQ(batcher.depth(), 0);
+    EXPECT_TRUE(batcher.modified());
+}
+
+class DrawingEditTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        resetSimulatedState();
+        setSimulatedDrawingState(&drawingHandle_, &drawingHandle_, ModelType::PART, "PART-1");
+        imagePath_ = (std::filesystem::temp_directory_path() / "edit_txn_barcode.png").string();
+        std::ofstream(imagePath_) << "png";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(imagePath_);
+        resetSimulatedState();
+    }
+
+    int drawingHandle_ = 0;
+    std::string imagePath_;
+    DrawingInterface drawing_;
+};
+
+TEST_F(DrawingEditTest, EachInsertRepaintsWithoutTransaction) {
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(drawing_.insertImage(&drawingHandle_, imagePath_, Position(10.0 * i, 10.0), Size(20, 20)),
+                  PRO_TK_NO_ERROR);
+    }
+    EXPECT_EQ(simulatedRepaintCount(), 5u);
+}
+
+TEST_F(DrawingEditTest, TransactionRepaintsOnceForManyEdits) {
+    {
+        DrawingEditTransaction edit(drawing_.repaintBatcher());
+        for (int i = 0; i < 20; ++i) {
+            ASSERT_EQ(drawing_.insertImage(&drawingHandle_, imagePath_, Position(5.0 * i, 10.0), Size(20, 20)),
+                      PRO_TK_NO_ERROR);
+            ASSERT_EQ(drawing_.createSymbolInstance(&drawingHandle_, "BARCODE_FRAME", Position(5.0 * i, 40.0)),
+                      PRO_TK_NO_ERROR);
+        }
+        EXPECT_EQ(simulatedRepaintCount(), 0u);
+    }
+    EXPECT_EQ(simulatedRepaintCount(), 1u);
+}
+
+TEST_F(DrawingEditTest, FailedEditsDoNotRepaint) {
+    {
+        DrawingEditTransaction edit(drawing_.repaintBatcher());
+        EXPECT_NE(drawing_.insertImage(&drawingHandle_, "", Position(0, 0), Size(20, 20)), PRO_TK_NO_ERROR);
+        EXPECT_NE(drawing_.insertImage(&drawingHandle_, imagePath_, Position(5000, 0), Size(20, 20)),
+                  PRO_TK_NO_ERROR);
+    }
+    EXPECT_EQ(simulatedRepaintCount(), 0u);
+}
+
+} // namespace testing
+} // namespace creo_barcode
@@ -0,0 +1,124 @@
+/**
+ * @file test_flight_recorder.cpp
+ * @brief Unit tests for FlightRecorder
+ */
+
+#include <gtest/gtest.h>
+#include "flight_recorder.h"
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace creo_barcode;
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("creo_flight_test_" + name)).string();
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+} // anonymous namespace
+
+TEST(FlightRecorderTest, KeepsNewestEventsInOrder) {
+    FlightRecorder recorder(4);
+    for (int i = 1; i <= 10; ++i) {
+        recorder.record(LogLevel::INFO, "event " + std::to_string(i));
+    }
+
+    auto records = recorder.snapshot();
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_EQ(records.front().message, "event 7");
+    EXPECT_EQ(records.back().message, "event 10");
+    EXPECT_EQ(records.back().sequence, 10u);
+    EXPECT_EQ(recorder.recordedCount(), 10u);
+
+    auto newer = recorder.snapshot(8);
+    ASSERT_EQ(newer.size(), 2u);
+    EXPECT_EQ(newer[0].message, "event 9");
+}
+
+TEST(FlightRecorderTest, TruncatesLongMessages) {
+    FlightRecorder recorder(2);
+    std::string longMessage(FlightRecorder::MESSAGE_CAPACITY * 2, 'x');
+    recorder.record(LogLevel::WARNING, longMessage);
+
+    auto records = recorder.snapshot();
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].message.size(), FlightRecorder::MESSAGE_CAPACITY - 1);
+    EXPECT_EQ(records[0].level, LogLevel::WARNING);
+}
+
+TEST(FlightRecorderTest, DumpWritesOnlyNewEvents) {
+    std::string path = tempPath("dump.log");
+    std::filesystem::remove(path);
+    FlightRecorder recorder(3);
+
+    recorder.record(LogLevel::INFO, "first");
+    EXPECT_EQ(recorder.dumpNew(path, "one"), 1u);
+    EXPECT_EQ(recorder.dumpNew(path, "nothing new"), 0u);
+
+    for (int i = 0; i < 5; ++i) {
+        recorder.record(LogLevel::INFO, "burst " + std::to_string(i));
+    }
+    EXPECT_EQ(recorder.dumpNew(path, "two"), 3u);
+
+    std::string content = readFile(path);
+    EXPECT_NE(content.find("dump: one (1 events) ==="), std::string::npos);
+    EXPECT_EQ(content.find("nothing new"), std::string::npos);
+    EXPECT_NE(content.find("dump: two (3 events, 2 older events overwritten)"), std::string::npos);
+    EXPECT_NE(content.find("[INFO] burst 4"), std::string::npos);
+    EXPECT_EQ(content.find("burst 1"), std::string::npos);
+    std::filesystem::remove(path);
+}
+
+TEST(FlightRecorderTest, ConcurrentWritersKeepDistinctSequences) {
+    FlightRecorder recorder(64);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&recorder, t]() {
+            for (int i = 0; i < 10000; ++i) {
+                recorder.record(LogLevel::INFO, "worker " + std::to_string(t));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    auto records = recorder.snapshot();
+    ASSERT_EQ(records.size(), 64u);
+    EXPECT_EQ(records.back().sequence, 40000u);
+    for (size_t i = 1; i < records.size(); ++i) {
+        EXPECT_EQ(records[i].sequence, records[i - 1].sequence + 1);
+    }
+}
+
+#ifndef _WIN32
+TEST(FlightRecorderDeathTest, CrashHandlerDumpsRing) {
+    std::string path = tempPath("crash.log");
+    std::filesystem::remove(path);
+
+    EXPECT_DEATH({
+        FlightRecorder recorder(8);
+        FlightRecorder::installCrashHandler(&recorder, path);
+        recorder.record(LogLevel::INFO, "opening drawing");
+        recorder.record(LogLevel::WARNING, "about to crash");
+        std::raise(SIGSEGV);
+    }, "");
+
+    std::string content = readFile(path);
+    EXPECT_NE(content.find("=== Flight recorder dump: crash ==="), std::string::npos);
+    EXPECT_NE(content.find("#1 "), std::string::npos);
+    EXPECT_NE(content.find("WARNING about to crash"), std::string::npos);
+    std::filesystem::remove(path);
+}
+#endif
@@ -0,0 +1,175 @@
+/**
+ * @file test_generated_barcode_filter.cpp
+ * @brief Unit tests for GeneratedBarcodeFilter
+ */
+
+#include <gtest/gtest.h>
+#include "generated_barcode_filter.h"
+#include "barcode_generator.h"
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace creo_barcode;
+
+class GeneratedBarcodeFilterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir_ = std::filesystem::temp_directory_path() / "generated_filter_test";
+        std::filesystem::create_directories(testDir_);
+        filterPath_ = (testDir_ / "filter.bin").string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir_);
+    }
+
+    std::filesystem::path testDir_;
+    std::string filterPath_;
+    BarcodeConfig config_;
+};
+
+TEST_F(GeneratedBarcodeFilterTest, EmptyFilterContainsNothing) {
+    GeneratedBarcodeFilter filter(1000);
+    EXPECT_FALSE(filter.mightContain("PART_001", config_));
+    EXPECT_EQ(filter.itemCount(), 0u);
+    EXPECT_DOUBLE_EQ(filter.estimatedFalsePositiveRate(), 0.0);
+}
+
+TEST_F(GeneratedBarcodeFilterTest, NoFalseNegatives) {
+    GeneratedBarcodeFilter filter(5000);
+    for (int i = 0; i < 5000; ++i) {
+        filter.add("PART_" + std::to_string(i), config_);
+    }
+    for (int i = 0; i < 5000; ++i) {
+        EXPECT_TRUE(filter.mightContain("PART_" + std::to_string(i), config_));
+    }
+}
+
+TEST_F(GeneratedBarcodeFilterTest, FalsePositiveRateNearTarget) {
+    const size_t items = 10000;
+    GeneratedBarcodeFilter filter(items, 0.01);
+    for (size_t i = 0; i < items; ++i) {
+        filter.add("PART_" + std::to_string(i), config_);
+    }
+
+    size_t falsePositives = 0;
+    const size_t probes = 20000;
+    for (size_t i = 0; i < probes; ++i) {
+        if (filter.mightContain("OTHER_" + std::to_string(i), config_)) {
+            ++falsePositives;
+        }
+    }
+
+    double measured = static_cast<double>(falsePositives) / probes;
+    EXPECT_LT(measured, 0.02);
+    EXPECT_NEAR(filter.estimatedFalsePositiveRate(), 0.01, 0.005);
+}
+
+TEST_F(GeneratedBarcodeFilterTest, SizingMatchesTargetRate) {
+    GeneratedBarcodeFilter filter(100000, 0.01);
+    // ~9.6 bits per item and 7 hash functions for a 1% target
+    EXPECT_GE(filter.bitCount(), 958000u);
+    EXPECT_LE(filter.memoryBytes(), 120000u + 64u);
+    EXPECT_EQ(filter.hashCount(), 7u);
+}
+
+TEST_F(GeneratedBarcodeFilterTest, ConfigChangeIsAMiss) {
+    GeneratedBarcodeFilter filter(1000);
+    filter.add("PART_001", config_);
+
+    BarcodeConfig resized = config_;
+    resized.width = config_.width * 2;
+    BarcodeConfig retyped = config_;
+    retyped.type = BarcodeType::QR_CODE;
+
+    EXPECT_TRUE(filter.mightContain("PART_001", config_));
+    EXPECT_FALSE(filter.mightContain("PART_001", resized));
+    EXPECT_FALSE(filter.mightContain("PART_001", retyped));
+}
+
+TEST_F(GeneratedBarcodeFilterTest, SaveAndLoadRoundTrip) {
+    GeneratedBarcodeFilter filter(2000);
+    for (int i = 0; i < 500; ++i) {
+        filter.add("PART_" + std::to_string(i), config_);
+    }
+    ASSERT_TRUE(filter.save(filterPath_));
+
+    // Loaded filter keeps the saved size, not the constructor size
+    GeneratedBarcodeFilter loaded(10);
+    ASSERT_TRUE(loaded.load(filterPath_));
+    EXPECT_EQ(loaded.bitCount(), filter.bitCount());
+    EXPECT_EQ(loaded.hashCount(), filter.hashCount());
+    EXPECT_EQ(loaded.itemCount(), 500u);
+    for (int i = 0; i < 500; ++i) {
+        EXPECT_TRUE(loaded.mightContain("PART_" + std::to_string(i), config_));
+    }
+    EXPECT_FALSE(std::filesystem::exists(filterPath_ + ".tmp"));
+}
+
+TEST_F(GeneratedBarcodeFilterTest, LoadRejectsInvalidFile) {
+    GeneratedBarcodeFilter filter(100);
+    EXPECT_FALSE(filter.load((testDir_ / "missing.bin").string()));
+    EXPECT_EQ(filter.getLastError().code, ErrorCode::FILE_NOT_FOUND);
+
+    std::ofstream(filterPath_) << "definitely not a bloom filter";
+    EXPECT_FALSE(filter.load(filterPath_));
+    EXPECT_EQ(filter.getLastError().code, ErrorCode::INVALID_DATA);
+}
+
+TEST_F(GeneratedBarcodeFilterTest, LoadRejectsWordCountBeyondFile) {
+    GeneratedBarcodeFilter saved(100);
+    ASSERT_TRUE(saved.save(filterPath_));
+
+    // Header claims far more words than the file holds
+    {
+        std::fstream file(filterPath_, std::ios::binary | std::ios::in | std::ios::out);
+        uint64_t wordCount = uint64_t(1) << 40;
+        file.seekp(16);
+        file.write(reinterpret_cast<const char*>(&wordCount), sizeof(wordCount));
+    }
+    GeneratedBarcodeFilter filter(100);
+    size_t bits = filter.bitCount();
+    EXPECT_FALSE(filter.load(filterPath_));
+    EXPECT_EQ(filter.getLastError().code, ErrorCode::INVALID_DATA);
+    EXPECT_EQ(filter.bitCount(), bits);
+
+    // Truncated bit array
+    ASSERT_TRUE(saved.save(filterPath_));
+    std::filesystem::resize_file(filterPath_, std::filesystem::file_size(filterPath_) - 8);
+    EXPECT_FALSE(filter.load(filterPath_));
+    EXPECT_EQ(filter.getLastError().code, ErrorCode::INVALID_DATA);
+}
+
+TEST_F(GeneratedBarcodeFilterTest, ConcurrentAdds) {
+    GeneratedBarcodeFilter filter(8000);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&filter, t, this]() {
+            for (int i = 0; i < 2000; ++i) {
+                filter.add("T" + std::to_string(t) + "_" + std::to_string(i), config_);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(filter.itemCount(), 8000u);
+    for (int t = 0; t < 4; ++t) {
+        for (int i = 0; i < 2000; ++i) {
+            ASSERT_TRUE(filter.mightContain("T" + std::to_string(t) + "_" + std::to_string(i), config_));
+        }
+    }
+}
+
+TEST_F(GeneratedBarcodeFilterTest, GeneratorRecordsSuccessfulGeneration) {
+    GeneratedBarcodeFilter filter(100);
+    BarcodeGenerator generator;
+    generator.setGeneratedFilter(&filter);
+
+    std::string output = (testDir_ / "part.png").string();
+    ASSERT_TRUE(generator.generate("PART_XYZ", config_, output));
+    EXPECT_TRUE(filter.mightContain("PART_XYZ", config_));
+    EXPECT_EQ(filter.itemCount(), 1u);
+}
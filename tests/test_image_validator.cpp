@@ -0,0 +1,137 @@
+/**
+ * @file test_image_validator.cpp
+ * @brief Unit tests for ImageValidator and format sniffing
+ */
+
+#include <gtest/gtest.h>
+#include "image_validator.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace creo_barcode;
+
+namespace {
+
+const std::vector<uint8_t> PNG_BYTES = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A, 0, 0, 0, 13};
+const std::vector<uint8_t> JPEG_BYTES = {0xFF, 0xD8, 0xFF, 0xE0, 0, 16, 'J', 'F', 'I', 'F'};
+const std::vector<uint8_t> BMP_BYTES = {'B', 'M', 0x36, 0, 0, 0, 0, 0};
+
+class ImageValidatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir_ = std::filesystem::temp_directory_path() / "image_validator_test";
+        std::filesystem::create_directories(testDir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir_);
+    }
+
+    std::string writeFile(const std::string& name, const std::vector<uint8_t>& bytes) {
+        std::filesystem::path path = testDir_ / name;
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return path.string();
+    }
+
+    std::filesystem::path testDir_;
+    ImageValidator validator_;
+};
+
+} // anonymous namespace
+
+TEST(ImageFormatTest, SniffsMagicBytes) {
+    EXPECT_EQ(sniffImageFormat(PNG_BYTES.data(), PNG_BYTES.size()), ImageFormat::PNG);
+    EXPECT_EQ(sniffImageFormat(JPEG_BYTES.data(), JPEG_BYTES.size()), ImageFormat::JPEG);
+    EXPECT_EQ(sniffImageFormat(BMP_BYTES.data(), BMP_BYTES.size()), ImageFormat::BMP);
+
+    const uint8_t gif[] = {'G', 'I', 'F', '8', '9', 'a'};
+    EXPECT_EQ(sniffImageFormat(gif, sizeof(gif)), ImageFormat::UNKNOWN);
+    // A truncated PNG signature is not a PNG
+    EXPECT_EQ(sniffImageFormat(PNG_BYTES.data(), 4), ImageFormat::UNKNOWN);
+    EXPECT_EQ(sniffImageFormat(nullptr, 0), ImageFormat::UNKNOWN);
+}
+
+TEST_F(ImageValidatorTest, AcceptsSupportedFormats) {
+    ImageCheck png = validator_.validate(writeFile("a.png", PNG_BYTES));
+    EXPECT_TRUE(png.ok());
+    EXPECT_EQ(png.format, ImageFormat::PNG);
+    EXPECT_EQ(png.size, PNG_BYTES.size());
+    EXPECT_FALSE(png.cached);
+
+    EXPECT_EQ(validator_.validate(writeFile("b.jpg", JPEG_BYTES)).format, ImageFormat::JPEG);
+    EXPECT_EQ(validator_.validate(writeFile("c.bmp", BMP_BYTES)).format, ImageFormat::BMP);
+}
+
+TEST_F(ImageValidatorTest, FormatComesFromContentNotExtension) {
+    // A PNG saved with the wrong extension is still a PNG
+    ImageCheck misnamed = validator_.validate(writeFile("barcode.dat", PNG_BYTES));
+    EXPECT_TRUE(misnamed.ok());
+    EXPECT_EQ(misnamed.format, ImageFormat::PNG);
+
+    // And text named .png is rejected
+    std::vector<uint8_t> text = {'n', 'o', 't', ' ', 'a', 'n', ' ', 'i', 'm', 'a', 'g', 'e'};
+    EXPECT_EQ(validator_.validate(writeFile("fake.png", text)).verdict, ImageVerdict::UNSUPPORTED_FORMAT);
+}
+
+TEST_F(ImageValidatorTest, ReportsFilesystemProblems) {
+    EXPECT_EQ(validator_.validate("").verdict, ImageVerdict::EMPTY_PATH);
+    EXPECT_EQ(validator_.validate((testDir_ / "missing.png").string()).verdict, ImageVerdict::NOT_FOUND);
+    EXPECT_EQ(validator_.validate((testDir_ / "no_dir" / "x.png").string()).verdict, ImageVerdict::NOT_FOUND);
+    EXPECT_EQ(validator_.validate(testDir_.string()).verdict, ImageVerdict::NOT_REGULAR_FILE);
+    EXPECT_EQ(validator_.validate(writeFile("empty.png", {})).verdict, ImageVerdict::EMPTY_FILE);
+}
+
+TEST_F(ImageValidatorTest, GeneratedFilesSkipTheDisk) {
+    std::string path = writeFile("generated.png", PNG_BYTES);
+    validator_.markGenerated(path, ImageFormat::PNG, PNG_BYTES.size());
+    EXPECT_EQ(validator_.cachedCount(), 1u);
+
+    // The cache trusts our own writes; it does not look at the file again
+    std::filesystem::remove(path);
+    ImageCheck check = validator_.validate(path);
+    EXPECT_TRUE(check.ok());
+    EXPECT_TRUE(check.cached);
+    EXPECT_EQ(check.size, PNG_BYTES.size());
+
+    validator_.forget(path);
+    EXPECT_EQ(validator_.validate(path).verdict, ImageVerdict::NOT_FOUND);
+    EXPECT_EQ(validator_.cachedCount(), 0u);
+}
+
+TEST_F(ImageValidatorTest, IgnoresUnusableGeneratedEntries) {
+    validator_.markGenerated("", ImageFormat::PNG, 10);
+    validator_.markGenerated("x.png", ImageFormat::UNKNOWN, 10);
+    validator_.markGenerated("y.png", ImageFormat::PNG, 0);
+    EXPECT_EQ(validator_.cachedCount(), 0u);
+}
+
+TEST_F(ImageValidatorTest, CacheIsBounded) {
+    for (size_t i = 0; i < ImageValidator::MAX_CACHED + 10; ++i) {
+        validator_.markGenerated("gen_" + std::to_string(i) + ".png", ImageFormat::PNG, 100);
+    }
+    EXPECT_LE(validator_.cachedCount(), ImageValidator::MAX_CACHED);
+    EXPECT_GT(validator_.cachedCount(), 0u);
+}
+
+TEST_F(ImageValidatorTest, BatchOfGeneratedFilesIsCheap) {
+    std::vector<std::string> paths;
+    for (int i = 0; i < 500; ++i) {
+        paths.push_back((testDir_ / ("batch_" + std::to_string(i) + ".png")).string());
+        validator_.markGenerated(paths.back(), ImageFormat::PNG, 1024);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t valid = 0;
+    for (const auto& path : paths) {
+        valid += validator_.validate(path).ok() ? 1 : 0;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(valid, paths.size());
+    RecordProperty("batch_500_validate_us",
+                   static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+}
@@ -0,0 +1,79 @@
+/**
+ * @file test_intern_cache.cpp
+ * @brief Unit tests for InternCache
+ */
+
+#include <gtest/gtest.h>
+#include "intern_cache.h"
+#include "utf_transcode.h"
+#include <string>
+
+using namespace creo_barcode;
+
+TEST(InternCacheTest, MissThenHit) {
+    InternCache<std::wstring> cache;
+    EXPECT_EQ(cache.find("C:/out/a.png"), nullptr);
+
+    const std::wstring& stored = cache.insert("C:/out/a.png", L"C:/out/a.png");
+    const std::wstring* found = cache.find("C:/out/a.png");
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found, &stored);
+    EXPECT_EQ(*found, L"C:/out/a.png");
+    EXPECT_EQ(cache.hits(), 1u);
+    EXPECT_EQ(cache.misses(), 1u);
+}
+
+TEST(InternCacheTest, RepeatedPathsConvertOnce) {
+    InternCache<std::wstring> cache;
+    int conversions = 0;
+    auto intern = [&](const std::string& path) -> const std::wstring& {
+        if (const std::wstring* cached = cache.find(path)) {
+            return *cached;
+        }
+        ++conversions;
+        std::wstring wide;
+        utf::utf8ToWide(path, wide);
+        return cache.insert(path, std::move(wide));
+    };
+
+    for (int round = 0; round < 100; ++round) {
+        EXPECT_EQ(intern("/out/\xC3\xA9tiquette.png"), L"/out/\u00E9tiquette.png");
+        EXPECT_EQ(intern("/out/plain.png"), L"/out/plain.png");
+    }
+    EXPECT_EQ(conversions, 2);
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(InternCacheTest, InsertReplacesExistingValue) {
+    InternCache<int> cache;
+    cache.insert("key", 1);
+    cache.insert("key", 2);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(*cache.find("key"), 2);
+}
+
+TEST(InternCacheTest, StartsOverWhenFull) {
+    InternCache<int> cache(4);
+    for (int i = 0; i < 4; ++i) {
+        cache.insert("k" + std::to_string(i), i);
+    }
+    EXPECT_EQ(cache.size(), 4u);
+
+    // Updating a present key never evicts
+    cache.insert("k0", 10);
+    EXPECT_EQ(cache.size(), 4u);
+
+    const int& fresh = cache.insert("k4", 4);
+    EXPECT_EQ(fresh, 4);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.find("k0"), nullptr);
+}
+
+TEST(InternCacheTest, ZeroCapacityStillHoldsOneEntry) {
+    InternCache<int> cache(0);
+    EXPECT_EQ(cache.capacity(), 1u);
+    cache.insert("a", 1);
+    EXPECT_EQ(*cache.find("a"), 1);
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+}
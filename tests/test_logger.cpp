@@ -0,0 +1,223 @@
+/**
+ * @file test_logger.cpp
+ * @brief Unit tests for log level filtering and the text Logger
+ */
+
+#include <gtest/gtest.h>
+#include "logger.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+using namespace creo_barcode;
+
+namespace {
+
+// Turns the flight recorder off (so only the file threshold applies) and
+// restores both thresholds after each test
+class LoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        savedLevel_ = getLogLevel();
+        savedRecorderLevel_ = getFlightRecorderLevel();
+        setFlightRecorderLevel(LogLevel::OFF);
+    }
+    void TearDown() override {
+        setLogLevel(savedLevel_);
+        setFlightRecorderLevel(savedRecorderLevel_);
+    }
+
+    LogLevel savedLevel_ = LogLevel::INFO;
+    LogLevel savedRecorderLevel_ = LogLevel::INFO;
+};
+
+// Gives the Logger its own directory and restores the defaults afterwards
+class LoggerFileTest : public LoggerTest {
+protected:
+    void SetUp() override {
+        LoggerTest::SetUp();
+        dir_ = std::filesystem::temp_directory_path() / "creo_logger_file_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+        savedPath_ = Logger::getInstance().getLogFilePath();
+        Logger::getInstance().setLogFilePath((dir_ / "plugin.log").string());
+    }
+    void TearDown() override {
+        Logger& logger = Logger::getInstance();
+        logger.shutdown();
+        logger.setRotationPolicy(LogRotationPolicy());
+        logger.setLogFilePath(savedPath_);
+        std::filesystem::remove_all(dir_);
+        LoggerTest::TearDown();
+    }
+
+    std::string readFile(const std::string& name) {
+        std::ifstream file(dir_ / name, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    std::filesystem::path dir_;
+    std::string savedPath_;
+};
+
+std::string countedMessage(int& evaluations) {
+    ++evaluations;
+    return "message " + std::to_string(evaluations);
+}
+
+} // anonymous namespace
+
+TEST_F(LoggerTest, DisabledLevelDoesNotEvaluateMessage) {
+    int evaluations = 0;
+    setLogLevel(LogLevel::ERR);
+    LOG_INFO(countedMessage(evaluations));
+    LOG_WARNING(countedMessage(evaluations));
+    EXPECT_EQ(evaluations, 0);
+
+    setLogLevel(LogLevel::OFF);
+    LOG_ERROR(countedMessage(evaluations));
+    EXPECT_EQ(evaluations, 0);
+}
+
+TEST_F(LoggerFileTest, EnabledLevelIsWritten) {
+    int evaluations = 0;
+    setLogLevel(LogLevel::WARNING);
+    LOG_INFO("hidden line");
+    LOG_WARNING(countedMessage(evaluations));
+    LOG_ERROR("visible error");
+    Logger::getInstance().flush();
+    EXPECT_EQ(evaluations, 1);
+
+    std::string content = readFile("plugin.log");
+    EXPECT_EQ(content.find("hidden line"), std::string::npos);
+    EXPECT_NE(content.find("[WARNING] message 1"), std::string::npos);
+    EXPECT_NE(content.find("[ERROR] visible error"), std::string::npos);
+}
+
+TEST_F(LoggerTest, ThresholdRoundTrips) {
+    setLogLevel(LogLevel::VERBOSE);
+    EXPECT_EQ(getLogLevel(), LogLevel::VERBOSE);
+    EXPECT_TRUE(isLogLevelEnabled(LogLevel::VERBOSE));
+
+    setLogLevel(LogLevel::WARNING);
+    EXPECT_FALSE(isLogLevelEnabled(LogLevel::INFO));
+    EXPECT_TRUE(isLogLevelEnabled(LogLevel::WARNING));
+    EXPECT_TRUE(isLogLevelEnabled(LogLevel::ERR));
+}
+
+TEST_F(LoggerTest, LevelNamesParse) {
+    LogLevel level = LogLevel::INFO;
+    EXPECT_TRUE(logLevelFromString("ERROR", level));
+    EXPECT_EQ(level, LogLevel::ERR);
+    EXPECT_TRUE(logLevelFromString("VERBOSE", level));
+    EXPECT_EQ(level, LogLevel::VERBOSE);
+    EXPECT_FALSE(logLevelFromString("error", level));
+    EXPECT_FALSE(logLevelFromString("", level));
+    EXPECT_EQ(level, LogLevel::VERBOSE);
+}
+
+TEST_F(LoggerTest, CompiledOutLevelIsSkipped) {
+    int evaluations = 0;
+    setLogLevel(LogLevel::VERBOSE);
+    LOG_VERBOSE(countedMessage(evaluations));
+    EXPECT_EQ(evaluations, kCompiledMinLogLevel <= LogLevel::VERBOSE ? 1 : 0);
+}
+
+TEST_F(LoggerTest, DisabledCallCost) {
+    setLogLevel(LogLevel::ERR);
+    int evaluations = 0;
+    const int calls = 10000000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i) {
+        LOG_INFO(countedMessage(evaluations));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(evaluations, 0);
+    double nsPerCall = std::chrono::duration<double, std::nano>(elapsed).count() / calls;
+    RecordProperty("disabled_ns_per_call", std::to_string(nsPerCall));
+}
+
+TEST_F(LoggerFileTest, RotatesAndCompressesOldSegments) {
+    Logger& logger = Logger::getInstance();
+    LogRotationPolicy policy;
+    policy.maxFileBytes = 4096;
+    policy.maxArchives = 2;
+    logger.setRotationPolicy(policy);
+
+    for (int i = 0; i < 500; ++i) {
+        LOG_WARNING("rotation test line " + std::to_string(i) + " with some padding text");
+    }
+    logger.shutdown();
+
+    EXPECT_LT(std::filesystem::file_size(dir_ / "plugin.log"), policy.maxFileBytes);
+    ASSERT_TRUE(std::filesystem::exists(dir_ / "plugin.log.1.gz"));
+    ASSERT_TRUE(std::filesystem::exists(dir_ / "plugin.log.2.gz"));
+    EXPECT_FALSE(std::filesystem::exists(dir_ / "plugin.log.3.gz"));
+
+    size_t entries = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir_)) {
+        EXPECT_EQ(entry.path().string().find(".rotating."), std::string::npos) << entry.path();
+        ++entries;
+    }
+    EXPECT_EQ(entries, 3u);
+
+    // gzip magic, deflate method, and the uncompressed size in the trailer
+    std::string archive = readFile("plugin.log.1.gz");
+    ASSERT_GT(archive.size(), 18u);
+    EXPECT_EQ(static_cast<unsigned char>(archive[0]), 0x1f);
+    EXPECT_EQ(static_cast<unsigned char>(archive[1]), 0x8b);
+    EXPECT_EQ(archive[2], 8);
+    uint32_t originalSize = 0;
+    std::memcpy(&originalSize, archive.data() + archive.size() - 4, 4);
+    EXPECT_GE(originalSize, policy.maxFileBytes);
+    EXPECT_LT(archive.size(), originalSize / 2);
+}
+
+TEST_F(LoggerFileTest, RotationWithoutCompressionKeepsPlainSegments) {
+    Logger& logger = Logger::getInstance();
+    LogRotationPolicy policy;
+    policy.maxFileBytes = 2048;
+    policy.maxArchives = 3;
+    policy.compress = false;
+    logger.setRotationPolicy(policy);
+
+    for (int i = 0; i < 200; ++i) {
+        LOG_WARNING("plain segment line " + std::to_string(i));
+    }
+    logger.shutdown();
+
+    ASSERT_TRUE(std::filesystem::exists(dir_ / "plugin.log.1"));
+    EXPECT_NE(readFile("plugin.log.1").find("plain segment line"), std::string::npos);
+    EXPECT_FALSE(std::filesystem::exists(dir_ / "plugin.log.4"));
+}
+
+TEST_F(LoggerFileTest, ErrorDumpsRecentEventsBelowFileThreshold) {
+    setLogLevel(LogLevel::WARNING);
+    setFlightRecorderLevel(LogLevel::INFO);
+
+    LOG_INFO("loading drawing A");
+    LOG_INFO("rendering batch 7");
+    LOG_ERROR("write failed");
+    LOG_INFO("retrying batch 7");
+    LOG_ERROR("write failed again");
+    Logger::getInstance().flush();
+
+    std::string log = readFile("plugin.log");
+    EXPECT_EQ(log.find("rendering batch 7"), std::string::npos);
+    EXPECT_NE(log.find("write failed"), std::string::npos);
+
+    // Each dump carries only what happened since the previous one
+    std::string dump = readFile("plugin.log.flight");
+    size_t first = dump.find("=== Flight recorder dump: error: write failed (");
+    size_t second = dump.find("=== Flight recorder dump: error: write failed again");
+    ASSERT_NE(first, std::string::npos);
+    ASSERT_NE(second, std::string::npos);
+    EXPECT_LT(dump.find("rendering batch 7"), second);
+    EXPECT_GT(dump.find("retrying batch 7"), second);
+    EXPECT_EQ(dump.find("rendering batch 7", second), std::string::npos);
+}
@@ -0,0 +1,203 @@
+/**
+ * @file test_payload_index.cpp
+ * @brief Unit tests for PayloadIndex and PayloadIndexView
+ */
+
+#include <gtest/gtest.h>
+#include "payload_index.h"
+#include "data_sync_checker.h"
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <atomic>
+
+using namespace creo_barcode;
+
+class PayloadIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir_ = std::filesystem::temp_directory_path() / "payload_index_test";
+        std::filesystem::create_directories(testDir_);
+        indexPath_ = (testDir_ / "index.bin").string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir_);
+    }
+
+    std::filesystem::path testDir_;
+    std::string indexPath_;
+    PayloadIndex index_;
+};
+
+TEST_F(PayloadIndexTest, AddAndLookup) {
+    index_.add("PART_001", BarcodeLocation("a.drw", 1, 10.0, 20.0, "a.png"));
+    index_.add("PART_001", BarcodeLocation("b.drw", 2, 30.0, 40.0, "b.png"));
+
+    auto locations = index_.lookup("PART_001");
+    ASSERT_EQ(locations.size(), 2u);
+    EXPECT_EQ(locations[0].drawingPath, "a.drw");
+    EXPECT_EQ(locations[1].sheet, 2);
+    EXPECT_TRUE(index_.lookup("PART_002").empty());
+}
+
+TEST_F(PayloadIndexTest, AddSameBarcodeUpdatesPosition) {
+    index_.add("PART_001", BarcodeLocation("a.drw", 1, 10.0, 20.0, "a.png"));
+    index_.add("PART_001", BarcodeLocation("a.drw", 1, 50.0, 60.0, "a.png"));
+
+    auto locations = index_.lookup("PART_001");
+    ASSERT_EQ(locations.size(), 1u);
+    EXPECT_DOUBLE_EQ(locations[0].posX, 50.0);
+    EXPECT_DOUBLE_EQ(locations[0].posY, 60.0);
+}
+
+TEST_F(PayloadIndexTest, FindDrawingsReturnsDistinctDrawings) {
+    index_.add("PART_001", BarcodeLocation("a.drw", 1, 0.0, 0.0, "a1.png"));
+    index_.add("PART_001", BarcodeLocation("a.drw", 2, 0.0, 0.0, "a2.png"));
+    index_.add("PART_001", BarcodeLocation("b.drw", 1, 0.0, 0.0, "b.png"));
+
+    auto drawings = index_.findDrawings("PART_001");
+    EXPECT_EQ(drawings.size(), 2u);
+}
+
+TEST_F(PayloadIndexTest, RenamePayloadMovesLocations) {
+    index_.add("OLD", BarcodeLocation("a.drw", 1, 0.0, 0.0, "a.png"));
+    index_.add("OLD", BarcodeLocation("b.drw", 1, 0.0, 0.0, "b.png"));
+
+    EXPECT_EQ(index_.renamePayload("OLD", "NEW"), 2u);
+    EXPECT_TRUE(index_.lookup("OLD").empty());
+    EXPECT_EQ(index_.lookup("NEW").size(), 2u);
+    EXPECT_EQ(index_.renamePayload("MISSING", "NEW"), 0u);
+}
+
+TEST_F(PayloadIndexTest, RemoveAndRemoveDrawing) {
+    BarcodeLocation a("a.drw", 1, 0.0, 0.0, "a.png");
+    index_.add("P1", a);
+    index_.add("P2", BarcodeLocation("a.drw", 1, 0.0, 0.0, "p2.png"));
+    index_.add("P2", BarcodeLocation("b.drw", 1, 0.0, 0.0, "b.png"));
+
+    EXPECT_TRUE(index_.remove("P1", a));
+    EXPECT_FALSE(index_.remove("P1", a));
+    EXPECT_EQ(index_.removeDrawing("a.drw"), 1u);
+    EXPECT_EQ(index_.size(), 1u);
+    EXPECT_EQ(index_.payloadCount(), 1u);
+}
+
+TEST_F(PayloadIndexTest, RemoveImages) {
+    index_.add("P1", BarcodeLocation("a.drw", 1, 0.0, 0.0, "p1.png"));
+    index_.add("P1", BarcodeLocation("b.drw", 1, 0.0, 0.0, "p1.png"));
+    index_.add("P2", BarcodeLocation("a.drw", 1, 0.0, 0.0, "p2.png"));
+    index_.add("P3", BarcodeLocation("a.drw", 1, 0.0, 0.0, "p3.png"));
+
+    EXPECT_EQ(index_.removeImages({}), 0u);
+    EXPECT_EQ(index_.removeImages({"p1.png", "p2.png", "missing.png"}), 3u);
+    EXPECT_EQ(index_.size(), 1u);
+    EXPECT_TRUE(index_.lookup("P1").empty());
+    EXPECT_EQ(index_.lookup("P3").size(), 1u);
+}
+
+TEST_F(PayloadIndexTest, SaveAndLoadRoundTrip) {
+    index_.add("PART_001", BarcodeLocation("a.drw", 1, 1.5, 2.5, "a.png"));
+    index_.add("PART_002", BarcodeLocation("a.drw", 3, 4.5, 5.5, "c.png"));
+    index_.add("PART_001", BarcodeLocation("b.drw", 2, 3.5, 4.5, "b.png"));
+    ASSERT_TRUE(index_.save(indexPath_));
+
+    PayloadIndex loaded;
+    ASSERT_TRUE(loaded.load(indexPath_));
+    EXPECT_EQ(loaded.size(), 3u);
+
+    auto locations = loaded.lookup("PART_002");
+    ASSERT_EQ(locations.size(), 1u);
+    EXPECT_EQ(locations[0].drawingPath, "a.drw");
+    EXPECT_EQ(locations[0].imagePath, "c.png");
+    EXPECT_EQ(locations[0].sheet, 3);
+    EXPECT_DOUBLE_EQ(locations[0].posX, 4.5);
+}
+
+TEST_F(PayloadIndexTest, MappedViewLooksUpInPlace) {
+    for (int i = 0; i < 1000; ++i) {
+        index_.add("PART_" + std::to_string(i),
+                   BarcodeLocation("drawing_" + std::to_string(i % 50) + ".drw", 1, i, i, "img.png"));
+    }
+    ASSERT_TRUE(index_.save(indexPath_));
+
+    PayloadIndexView view;
+    ASSERT_TRUE(view.open(indexPath_));
+    EXPECT_EQ(view.size(), 1000u);
+
+    auto locations = view.lookup("PART_742");
+    ASSERT_EQ(locations.size(), 1u);
+    EXPECT_EQ(locations[0].drawingPath, "drawing_42.drw");
+    EXPECT_TRUE(view.lookup("PART_1000").empty());
+}
+
+TEST_F(PayloadIndexTest, EmptyIndexSavesAndOpens) {
+    ASSERT_TRUE(index_.save(indexPath_));
+
+    PayloadIndexView view;
+    EXPECT_TRUE(view.open(indexPath_));
+    EXPECT_EQ(view.size(), 0u);
+    EXPECT_TRUE(view.lookup("anything").empty());
+}
+
+TEST_F(PayloadIndexTest, OpenRejectsInvalidFile) {
+    std::ofstream(indexPath_) << "not an index file at all, just some text";
+
+    PayloadIndexView view;
+    EXPECT_FALSE(view.open(indexPath_));
+    EXPECT_EQ(view.getLastError().code, ErrorCode::INVALID_DATA);
+
+    PayloadIndex loaded;
+    EXPECT_FALSE(loaded.load((testDir_ / "missing.bin").string()));
+    EXPECT_EQ(loaded.getLastError().code, ErrorCode::FILE_NOT_FOUND);
+}
+
+TEST_F(PayloadIndexTest, ConcurrentReadersAndWriters) {
+    std::atomic<bool> done{false};
+    std::thread writer([this, &done]() {
+        for (int i = 0; i < 2000; ++i) {
+            index_.add("PART_" + std::to_string(i % 100),
+                       BarcodeLocation("d" + std::to_string(i) + ".drw", 1, 0.0, 0.0, "x.png"));
+        }
+        done = true;
+    });
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([this, &done]() {
+            while (!done) {
+                index_.lookup("PART_7");
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    EXPECT_EQ(index_.size(), 2000u);
+    EXPECT_EQ(index_.lookup("PART_7").size(), 20u);
+}
+
+TEST_F(PayloadIndexTest, SyncCheckRecordsInstanceInIndex) {
+    DataSyncChecker checker;
+    checker.setPayloadIndex(&index_);
+
+    BarcodeInstance instance;
+    instance.decodedData = "PART_001";
+    instance.imagePath = "part.png";
+    instance.drawingPath = "a.drw";
+    instance.sheet = 2;
+    checker.checkSync("PART_001", instance);
+
+    auto locations = index_.lookup("PART_001");
+    ASSERT_EQ(locations.size(), 1u);
+    EXPECT_EQ(locations[0].sheet, 2);
+
+    // Instances without a drawing are not indexed
+    BarcodeInstance unbound;
+    unbound.decodedData = "PART_002";
+    checker.checkSync("PART_002", unbound);
+    EXPECT_TRUE(index_.lookup("PART_002").empty());
+}
@@ -0,0 +1,95 @@
+/**
+ * @file test_plugin_stats.cpp
+ * @brief Unit tests for PluginStats and LatencyHistogram
+ */
+
+#include <gtest/gtest.h>
+#include "plugin_stats.h"
+#include <chrono>
+#include <thread>
+
+using namespace creo_barcode;
+
+TEST(LatencyHistogramTest, BucketsCoverValuesContiguously) {
+    for (size_t i = 0; i + 1 < LatencyHistogram::BUCKET_COUNT; ++i) {
+        EXPECT_EQ(LatencyHistogram::bucketUpperBound(i), LatencyHistogram::bucketLowerBound(i + 1)) << i;
+    }
+    for (uint64_t value : {0ull, 3ull, 4ull, 7ull, 1000ull, 123456789ull, ~0ull >> 1}) {
+        size_t index = LatencyHistogram::bucketIndex(value);
+        ASSERT_LT(index, LatencyHistogram::BUCKET_COUNT);
+        EXPECT_GE(value, LatencyHistogram::bucketLowerBound(index)) << value;
+        EXPECT_LT(value, LatencyHistogram::bucketUpperBound(index)) << value;
+    }
+    EXPECT_EQ(LatencyHistogram::bucketIndex(~0ull), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinBucketError) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.5), 0u);
+
+    // 1..1000 microseconds, uniformly
+    for (uint64_t us = 1; us <= 1000; ++us) {
+        histogram.record(us * 1000);
+    }
+
+    EXPECT_EQ(histogram.count(), 1000u);
+    EXPECT_EQ(histogram.totalNanos(), 500500u * 1000u);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(0.50)), 500000.0, 500000.0 * 0.125);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(0.99)), 990000.0, 990000.0 * 0.125);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.percentile(0.99), 0u);
+}
+
+TEST(PluginStatsTest, CountersAndStagesSnapshot) {
+    PluginStats stats;
+    stats.addBarcodesGenerated(3);
+    stats.addDecodeAttempts(2);
+    stats.addDecodeFailures();
+    stats.addBytesWritten(4096);
+    {
+        StageTimer timer(StatsStage::PNG_WRITE, stats);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    StatsSnapshot snapshot = stats.snapshot();
+    EXPECT_EQ(snapshot.barcodesGenerated, 3u);
+    EXPECT_EQ(snapshot.decodeAttempts, 2u);
+    EXPECT_EQ(snapshot.decodeFailures, 1u);
+    EXPECT_EQ(snapshot.bytesWritten, 4096u);
+    EXPECT_EQ(snapshot.stage(StatsStage::PNG_WRITE).count, 1u);
+    EXPECT_GE(snapshot.stage(StatsStage::PNG_WRITE).totalNanos, 2000000u);
+    EXPECT_GE(snapshot.stage(StatsStage::PNG_WRITE).p50Nanos, 1750000u);
+    EXPECT_EQ(snapshot.stage(StatsStage::DECODE).count, 0u);
+
+    std::string summary = PluginStats::formatSummary(snapshot);
+    EXPECT_NE(summary.find("Barcodes generated: 3"), std::string::npos);
+    EXPECT_NE(summary.find("png_write: 1 calls"), std::string::npos);
+    EXPECT_EQ(summary.find("decode:"), std::string::npos);
+
+    stats.reset();
+    snapshot = stats.snapshot();
+    EXPECT_EQ(snapshot.barcodesGenerated, 0u);
+    EXPECT_EQ(snapshot.stage(StatsStage::PNG_WRITE).count, 0u);
+}
+
+TEST(PluginStatsTest, ConcurrentUpdatesAreNotLost) {
+    PluginStats stats;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&stats]() {
+            for (int i = 0; i < 10000; ++i) {
+                stats.addBarcodesGenerated();
+                stats.recordStage(StatsStage::ENCODE, 1000 + i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    StatsSnapshot snapshot = stats.snapshot();
+    EXPECT_EQ(snapshot.barcodesGenerated, 40000u);
+    EXPECT_EQ(snapshot.stage(StatsStage::ENCODE).count, 40000u);
+}
@@ -0,0 +1,127 @@
+/**
+ * @file test_render_cache.cpp
+ * @brief Unit tests for RenderCache
+ */
+
+#include <gtest/gtest.h>
+#include "render_cache.h"
+#include <thread>
+#include <vector>
+
+using namespace creo_barcode;
+
+namespace {
+
+std::shared_ptr<const RenderedImage> makeImage(int width, int height, uint8_t fill = 0) {
+    auto image = std::make_shared<RenderedImage>();
+    image->width = width;
+    image->height = height;
+    image->pixels.assign(static_cast<size_t>(width) * height, fill);
+    return image;
+}
+
+BarcodeConfig sizedConfig(int width, int height) {
+    BarcodeConfig config;
+    config.width = width;
+    config.height = height;
+    return config;
+}
+
+} // anonymous namespace
+
+TEST(RenderCacheTest, FindReturnsInsertedImage) {
+    RenderCache cache;
+    BarcodeConfig config = sizedConfig(200, 80);
+    EXPECT_EQ(cache.find("PART-1", config), nullptr);
+
+    cache.insert("PART-1", config, makeImage(200, 80, 7));
+    auto found = cache.find("PART-1", config);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->width, 200);
+    EXPECT_EQ(found->pixels[0], 7);
+    EXPECT_EQ(cache.hits(), 1u);
+    EXPECT_EQ(cache.misses(), 1u);
+    EXPECT_EQ(cache.bytes(), 200u * 80u);
+}
+
+TEST(RenderCacheTest, KeyedOnPayloadAndImageAffectingConfig) {
+    RenderCache cache;
+    BarcodeConfig config = sizedConfig(200, 80);
+    cache.insert("PART-1", config, makeImage(200, 80));
+
+    EXPECT_FALSE(cache.contains("PART-2", config));
+    EXPECT_FALSE(cache.contains("PART-1", sizedConfig(201, 80)));
+
+    BarcodeConfig otherType = config;
+    otherType.type = BarcodeType::CODE_39;
+    EXPECT_FALSE(cache.contains("PART-1", otherType));
+
+    // dpi only affects placement, not pixels
+    BarcodeConfig otherDpi = config;
+    otherDpi.dpi = 600;
+    EXPECT_TRUE(cache.contains("PART-1", otherDpi));
+}
+
+TEST(RenderCacheTest, EvictsLeastRecentlyUsedWithinBudget) {
+    RenderCache cache(3 * 100);
+    BarcodeConfig config = sizedConfig(10, 10);
+    cache.insert("a", config, makeImage(10, 10));
+    cache.insert("b", config, makeImage(10, 10));
+    cache.insert("c", config, makeImage(10, 10));
+    ASSERT_NE(cache.find("a", config), nullptr);   // a is now the most recent
+
+    cache.insert("d", config, makeImage(10, 10));
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_TRUE(cache.contains("a", config));
+    EXPECT_FALSE(cache.contains("b", config));
+    EXPECT_LE(cache.bytes(), cache.capacityBytes());
+}
+
+TEST(RenderCacheTest, ReplacingAnEntryKeepsByteCountExact) {
+    RenderCache cache;
+    cache.insert("a", sizedConfig(10, 10), makeImage(10, 10));
+    cache.insert("a", sizedConfig(10, 10), makeImage(10, 10, 1));
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.bytes(), 100u);
+    EXPECT_EQ(cache.find("a", sizedConfig(10, 10))->pixels[0], 1);
+}
+
+TEST(RenderCacheTest, OversizedAndEmptyImagesAreNotKept) {
+    RenderCache cache(50);
+    cache.insert("big", sizedConfig(10, 10), makeImage(10, 10));
+    cache.insert("none", sizedConfig(10, 10), nullptr);
+    cache.insert("empty", sizedConfig(0, 0), makeImage(0, 0));
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.bytes(), 0u);
+}
+
+TEST(RenderCacheTest, EvictedImagesStayValidForHolders) {
+    RenderCache cache(100);
+    cache.insert("a", sizedConfig(10, 10), makeImage(10, 10, 9));
+    auto held = cache.find("a", sizedConfig(10, 10));
+    cache.insert("b", sizedConfig(10, 10), makeImage(10, 10));
+    EXPECT_FALSE(cache.contains("a", sizedConfig(10, 10)));
+    ASSERT_NE(held, nullptr);
+    EXPECT_EQ(held->pixels.size(), 100u);
+    EXPECT_EQ(held->pixels[99], 9);
+}
+
+TEST(RenderCacheTest, ConcurrentUse) {
+    RenderCache cache(64 * 100);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t]() {
+            for (int i = 0; i < 500; ++i) {
+                std::string payload = "P" + std::to_string((i * 7 + t) % 100);
+                if (!cache.find(payload, sizedConfig(10, 10))) {
+                    cache.insert(payload, sizedConfig(10, 10), makeImage(10, 10));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_LE(cache.bytes(), cache.capacityBytes());
+    EXPECT_EQ(cache.hits() + cache.misses(), 2000u);
+}
@@ -0,0 +1,123 @@
+/**
+ * @file test_result.cpp
+ * @brief Unit tests for Result<T> and the compact Error type
+ */
+
+#include <gtest/gtest.h>
+#include "result.h"
+#include <string>
+
+using namespace creo_barcode;
+
+TEST(ResultTest, HoldsValue) {
+    Result<std::string> result(std::string("PART_001"));
+    EXPECT_TRUE(result.ok());
+    EXPECT_TRUE(static_cast<bool>(result));
+    EXPECT_EQ(result.value(), "PART_001");
+    EXPECT_TRUE(result.error().isSuccess());
+}
+
+TEST(ResultTest, HoldsError) {
+    auto result = Result<int>::failure(ErrorCode::DECODE_FAILED, "No barcode found", "a.png");
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::DECODE_FAILED);
+    EXPECT_EQ(result.error().detail(), "a.png");
+    EXPECT_EQ(result.valueOr(-1), -1);
+    EXPECT_THROW(result.value(), std::logic_error);
+}
+
+TEST(ResultTest, VoidResult) {
+    Result<void> success;
+    EXPECT_TRUE(success.ok());
+
+    Result<void> failure(Error(ErrorCode::INVALID_SIZE, "Invalid dimensions"));
+    EXPECT_FALSE(failure.ok());
+    EXPECT_STREQ(failure.error().message(), "Invalid dimensions");
+}
+
+TEST(ResultTest, MovesValueOut) {
+    Result<std::string> result(std::string(1000, 'x'));
+    std::string moved = std::move(result).value();
+    EXPECT_EQ(moved.size(), 1000u);
+}
+
+TEST(ResultTest, ExpectedStyleAccessors) {
+    Result<std::string> result(std::string("PART_001"));
+    EXPECT_TRUE(result.has_value());
+    EXPECT_EQ(*result, "PART_001");
+    EXPECT_EQ(result->size(), 8u);
+}
+
+TEST(ErrorTest, DefaultIsSuccess) {
+    Error error;
+    EXPECT_TRUE(error.isSuccess());
+    EXPECT_STREQ(error.message(), "");
+    EXPECT_TRUE(error.detail().empty());
+}
+
+TEST(ErrorTest, KeepsStaticMessagePointer) {
+    static const char* const message = "No barcode found";
+    Error error(ErrorCode::DECODE_FAILED, message, "scan.png");
+    EXPECT_EQ(error.message(), message);
+    EXPECT_EQ(error.detail(), "scan.png");
+}
+
+TEST(ErrorTest, EmptyDetailWithoutData) {
+    Error error(ErrorCode::INVALID_DATA, "Empty data", std::string_view());
+    EXPECT_TRUE(error.detail().empty());
+    EXPECT_TRUE(error.toErrorInfo().details.empty());
+}
+
+TEST(ErrorTest, TruncatedDetailKeepsTheFileName) {
+    std::string path = "\\\\server\\vault\\projects\\2024\\customer_assemblies\\gearbox_housing\\"
+                       "revisions\\released\\drawings\\barcodes\\GEARBOX_HOUSING_REV_C.png";
+    ASSERT_GT(path.size(), Error::DETAIL_CAPACITY);
+    Error error(ErrorCode::FILE_NOT_FOUND, "Image file not found", path);
+    EXPECT_EQ(error.detail().size(), Error::DETAIL_CAPACITY);
+    EXPECT_EQ(error.detail().substr(0, 3), "...");
+    EXPECT_EQ(error.detail().substr(3), path.substr(path.size() - (Error::DETAIL_CAPACITY - 3)));
+    EXPECT_NE(error.detail().find("GEARBOX_HOUSING_REV_C.png"), std::string_view::npos);
+}
+
+TEST(ErrorTest, TruncatedDetailStartsOnACharacter) {
+    // Two-byte characters: the cut must not start inside one
+    std::string path;
+    for (int i = 0; i < 60; ++i) {
+        path += "\xC3\xA9";
+    }
+    path += ".png";
+    Error error(ErrorCode::FILE_NOT_FOUND, "Image file not found", path);
+    std::string_view tail = error.detail().substr(3);
+    EXPECT_EQ(error.detail().substr(0, 3), "...");
+    EXPECT_NE(static_cast<unsigned char>(tail[0]) & 0xC0, 0x80);
+    EXPECT_EQ(tail, std::string_view(path).substr(path.size() - tail.size()));
+    EXPECT_LE(error.detail().size(), Error::DETAIL_CAPACITY);
+}
+
+TEST(ErrorTest, FormatsDetailInline) {
+    Error error = Error::formatted(ErrorCode::INVALID_DATA, "Unsupported channel count", "%d", 2);
+    EXPECT_EQ(error.detail(), "2");
+
+    std::string longName(200, 'n');
+    Error truncated = Error::formatted(ErrorCode::INVALID_DATA, "Bad name", "name=%s", longName.c_str());
+    EXPECT_EQ(truncated.detail().size(), Error::DETAIL_CAPACITY);
+    EXPECT_EQ(truncated.detail().substr(0, 5), "name=");
+    EXPECT_EQ(truncated.detail().substr(Error::DETAIL_CAPACITY - 3), "...");
+}
+
+TEST(ErrorTest, ConvertsToErrorInfo) {
+    Error error(ErrorCode::INVALID_SIZE, "Invalid image buffer", "0x0");
+    ErrorInfo info = error.toErrorInfo();
+    EXPECT_EQ(info.code, ErrorCode::INVALID_SIZE);
+    EXPECT_EQ(info.message, "Invalid image buffer");
+    EXPECT_EQ(info.details, "0x0");
+}
+
+TEST(ErrorTest, CopiesAreIndependent) {
+    Error original(ErrorCode::DECODE_FAILED, "No barcode found", "a.png");
+    Error copy = original;
+    original = Error(ErrorCode::INVALID_DATA, "Empty data");
+    EXPECT_EQ(copy.code(), ErrorCode::DECODE_FAILED);
+    EXPECT_EQ(copy.detail(), "a.png");
+    EXPECT_TRUE(original.detail().empty());
+}
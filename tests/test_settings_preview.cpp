@@ -0,0 +1,250 @@
+/**
+ * @file test_settings_preview.cpp
+ * @brief Unit tests for the progressive settings preview
+ */
+
+#include <gtest/gtest.h>
+#include "settings_preview.h"
+#include "settings_dialog.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace creo_barcode;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Renders a blank image of the requested size, optionally slowly
+class FakeRenderer {
+public:
+    SettingsPreview::RenderFn fn() {
+        return [this](const std::string& payload, const BarcodeConfig& config,
+                      RenderedImage& image, std::string& error) {
+            ++calls;
+            if (delay.count() > 0) {
+                std::this_thread::sleep_for(delay);
+            }
+            if (payload.empty()) {
+                error = "Empty data";
+                return false;
+            }
+            image.width = config.width;
+            image.height = config.height;
+            image.pixels.assign(static_cast<size_t>(config.width) * config.height, 255);
+            return true;
+        };
+    }
+
+    std::atomic<int> calls{0};
+    std::chrono::milliseconds delay{0};
+};
+
+class FrameLog {
+public:
+    SettingsPreview::FrameCallback fn() {
+        return [this](const PreviewFrame& frame) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            frames_.push_back(frame);
+        };
+    }
+
+    std::vector<PreviewFrame> frames() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return frames_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<PreviewFrame> frames_;
+};
+
+BarcodeConfig validConfig(int width = 200) {
+    BarcodeConfig config;
+    config.width = width;
+    config.height = 80;
+    return config;
+}
+
+PreviewOptions testOptions(RenderCache* cache, std::chrono::milliseconds debounce = 20ms) {
+    PreviewOptions options;
+    options.debounce = debounce;
+    options.cache = cache;
+    return options;
+}
+
+} // anonymous namespace
+
+TEST(SettingsPreviewTest, DraftThenFinal) {
+    FakeRenderer renderer;
+    FrameLog log;
+    SettingsPreview preview(log.fn(), testOptions(nullptr), renderer.fn());
+
+    uint64_t generation = preview.update(validConfig());
+    ASSERT_TRUE(preview.waitIdle(5s));
+
+    auto frames = log.frames();
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0].stage, PreviewStage::DRAFT);
+    EXPECT_EQ(frames[0].image->width, 50);
+    EXPECT_EQ(frames[0].image->height, 20);
+    EXPECT_EQ(frames[1].stage, PreviewStage::FINAL);
+    EXPECT_EQ(frames[1].image->width, 200);
+    EXPECT_EQ(frames[1].generation, generation);
+
+    PreviewFrame latest = preview.latest();
+    EXPECT_EQ(latest.stage, PreviewStage::FINAL);
+    EXPECT_TRUE(latest.ok());
+}
+
+TEST(SettingsPreviewTest, UpdateDoesNotWaitForRendering) {
+    FakeRenderer renderer;
+    renderer.delay = 200ms;
+    SettingsPreview preview(nullptr, testOptions(nullptr), renderer.fn());
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; ++i) {
+        preview.update(validConfig(200 + i));
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 100ms);
+    preview.cancel();
+}
+
+TEST(SettingsPreviewTest, RapidEditsRenderOnlyTheLastFinal) {
+    FakeRenderer renderer;
+    FrameLog log;
+    SettingsPreview preview(log.fn(), testOptions(nullptr, 100ms), renderer.fn());
+
+    uint64_t last = 0;
+    for (int width = 100; width <= 300; width += 20) {
+        last = preview.update(validConfig(width));
+        std::this_thread::sleep_for(2ms);
+    }
+    ASSERT_TRUE(preview.waitIdle(5s));
+
+    int finals = 0;
+    for (const auto& frame : log.frames()) {
+        if (frame.stage == PreviewStage::FINAL) {
+            ++finals;
+            EXPECT_EQ(frame.generation, last);
+            EXPECT_EQ(frame.image->width, 300);
+        }
+    }
+    EXPECT_EQ(finals, 1);
+    EXPECT_EQ(preview.stats().finals, 1u);
+}
+
+TEST(SettingsPreviewTest, StaleRenderIsDiscarded) {
+    FakeRenderer renderer;
+    renderer.delay = 50ms;
+    FrameLog log;
+    SettingsPreview preview(log.fn(), testOptions(nullptr), renderer.fn());
+
+    uint64_t first = preview.update(validConfig(200));
+    std::this_thread::sleep_for(10ms);     // first draft is rendering now
+    uint64_t second = preview.update(validConfig(400));
+    ASSERT_TRUE(preview.waitIdle(5s));
+
+    for (const auto& frame : log.frames()) {
+        EXPECT_NE(frame.generation, first);
+        EXPECT_EQ(frame.generation, second);
+    }
+    EXPECT_GE(preview.stats().discarded, 1u);
+}
+
+TEST(SettingsPreviewTest, CancelDropsPendingFinal) {
+    FakeRenderer renderer;
+    FrameLog log;
+    SettingsPreview preview(log.fn(), testOptions(nullptr, 200ms), renderer.fn());
+
+    preview.update(validConfig());
+    std::this_thread::sleep_for(50ms);     // draft delivered, final still debouncing
+    preview.cancel();
+    ASSERT_TRUE(preview.waitIdle(5s));
+    std::this_thread::sleep_for(250ms);
+
+    for (const auto& frame : log.frames()) {
+        EXPECT_EQ(frame.stage, PreviewStage::DRAFT);
+    }
+    EXPECT_FALSE(preview.latest().ok());
+}
+
+TEST(SettingsPreviewTest, InvalidConfigReportsErrorWithoutRendering) {
+    FakeRenderer renderer;
+    FrameLog log;
+    SettingsPreview preview(log.fn(), testOptions(nullptr), renderer.fn());
+
+    BarcodeConfig config = validConfig();
+    config.dpi = 10;
+    preview.update(config);
+    ASSERT_TRUE(preview.waitIdle(5s));
+
+    auto frames = log.frames();
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_FALSE(frames[0].ok());
+    EXPECT_NE(frames[0].error.find("DPI"), std::string::npos);
+    EXPECT_EQ(renderer.calls.load(), 0);
+}
+
+TEST(SettingsPreviewTest, RendererFailureIsReported) {
+    FakeRenderer renderer;
+    PreviewOptions options = testOptions(nullptr);
+    options.samplePayload = "";
+    SettingsPreview preview(nullptr, options, renderer.fn());
+
+    preview.update(validConfig());
+    ASSERT_TRUE(preview.waitIdle(5s));
+    PreviewFrame latest = preview.latest();
+    EXPECT_FALSE(latest.ok());
+    EXPECT_EQ(latest.error, "Empty data");
+}
+
+TEST(SettingsPreviewTest, RevisitedSettingsComeFromTheRenderCache) {
+    RenderCache cache;
+    FakeRenderer renderer;
+    SettingsPreview preview(nullptr, testOptions(&cache), renderer.fn());
+
+    preview.update(validConfig(200));
+    ASSERT_TRUE(preview.waitIdle(5s));
+    preview.update(validConfig(300));
+    ASSERT_TRUE(preview.waitIdle(5s));
+    EXPECT_EQ(renderer.calls.load(), 4);
+
+    preview.update(validConfig(200));
+    ASSERT_TRUE(preview.waitIdle(5s));
+    EXPECT_EQ(renderer.calls.load(), 4);
+    EXPECT_TRUE(preview.latest().cached);
+    EXPECT_TRUE(cache.contains("PART-0001", validConfig(200)));
+}
+
+TEST(SettingsPreviewTest, DraftConfigScalesDimensions) {
+    BarcodeConfig draft = SettingsPreview::draftConfig(validConfig(200), 4);
+    EXPECT_EQ(draft.width, 50);
+    EXPECT_EQ(draft.height, 20);
+    EXPECT_EQ(draft.margin, 2);
+
+    BarcodeConfig tiny = validConfig(2);
+    EXPECT_EQ(SettingsPreview::draftConfig(tiny, 4).width, 1);
+    EXPECT_EQ(SettingsPreview::draftConfig(tiny, 1).width, 2);
+}
+
+TEST(SettingsPreviewTest, DialogForwardsOnlyValidEdits) {
+    SettingsDialog dialog;
+    FrameLog log;
+    PreviewOptions options;
+    options.debounce = 10ms;
+    options.cache = nullptr;
+    dialog.enablePreview(log.fn(), options);
+    ASSERT_NE(dialog.preview(), nullptr);
+
+    BarcodeConfig invalid = validConfig();
+    invalid.width = 5;
+    EXPECT_FALSE(dialog.onConfigEdited(invalid).valid);
+    EXPECT_EQ(dialog.preview()->stats().updates, 0u);
+
+    EXPECT_TRUE(dialog.onConfigEdited(validConfig()).valid);
+    EXPECT_EQ(dialog.preview()->stats().updates, 1u);
+    ASSERT_TRUE(dialog.preview()->waitIdle(5s));
+}
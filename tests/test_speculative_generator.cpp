@@ -0,0 +1,232 @@
+/**
+ * @file test_speculative_generator.cpp
+ * @brief Unit tests for speculative barcode pre-rendering
+ */
+
+#include <gtest/gtest.h>
+#include "speculative_generator.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace creo_barcode;
+using namespace std::chrono_literals;
+
+namespace creo_barcode {
+namespace testing {
+    void simulateDrawingActivated(ProDrawing drawing);
+    void resetSimulatedState();
+}
+}
+
+namespace {
+
+// Blank renders; optionally slow or blocked until released
+class FakeRenderer {
+public:
+    SpeculativeGenerator::RenderFn fn() {
+        return [this](const std::string& data, const BarcodeConfig& config,
+                      RenderedImage& image, std::string& error) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ++calls;
+                started_.notify_all();
+                released_.wait(lock, [this]() { return !blocked_; });
+            }
+            if (delay.count() > 0) {
+                std::this_thread::sleep_for(delay);
+            }
+            if (data == "BROKEN") {
+                error = "Encoder failure";
+                return false;
+            }
+            image.width = config.width;
+            image.height = config.height;
+            image.pixels.assign(static_cast<size_t>(config.width) * config.height, 255);
+            return true;
+        };
+    }
+
+    void block() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        blocked_ = true;
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            blocked_ = false;
+        }
+        released_.notify_all();
+    }
+
+    bool waitForCalls(int count) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return started_.wait_for(lock, 5s, [this, count]() { return calls >= count; });
+    }
+
+    int callCount() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls;
+    }
+
+    std::chrono::milliseconds delay{0};
+
+private:
+    std::mutex mutex_;
+    std::condition_variable started_;
+    std::condition_variable released_;
+    bool blocked_ = false;
+    int calls = 0;
+};
+
+ProDrawing fakeDrawing(uintptr_t id) {
+    return reinterpret_cast<ProDrawing>(id);
+}
+
+SpeculationOptions testOptions(RenderCache* cache) {
+    SpeculationOptions options;
+    options.cache = cache;
+    options.lowPriority = false;
+    return options;
+}
+
+} // anonymous namespace
+
+TEST(SpeculativeGeneratorTest, PreRendersEveryPartIntoTheCache) {
+    RenderCache cache;
+    FakeRenderer renderer;
+    SpeculativeGenerator speculator(testOptions(&cache), renderer.fn());
+
+    BarcodeConfig config;
+    speculator.activate(fakeDrawing(1), {"PART-A", "PART-B"}, config);
+    ASSERT_TRUE(speculator.waitIdle(5s));
+
+    EXPECT_TRUE(cache.contains("PART-A", config));
+    EXPECT_TRUE(cache.contains("PART-B", config));
+    EXPECT_EQ(speculator.stats().rendered, 2u);
+    EXPECT_EQ(speculator.activeDrawing(), fakeDrawing(1));
+}
+
+TEST(SpeculativeGeneratorTest, CachedPartsAreNotRenderedAgain) {
+    RenderCache cache;
+    FakeRenderer renderer;
+    SpeculativeGenerator speculator(testOptions(&cache), renderer.fn());
+
+    speculator.activate(fakeDrawing(1), {"PART-A"}, BarcodeConfig());
+    ASSERT_TRUE(speculator.waitIdle(5s));
+    speculator.activate(fakeDrawing(2), {"PART-B"}, BarcodeConfig());
+    ASSERT_TRUE(speculator.waitIdle(5s));
+    speculator.activate(fakeDrawing(1), {"PART-A"}, BarcodeConfig());
+    ASSERT_TRUE(speculator.waitIdle(5s));
+
+    EXPECT_EQ(renderer.callCount(), 2);
+    EXPECT_EQ(speculator.stats().alreadyCached, 1u);
+    EXPECT_EQ(speculator.stats().activations, 3u);
+}
+
+TEST(SpeculativeGeneratorTest, SwitchingDrawingsCancelsRemainingParts) {
+    RenderCache cache;
+    FakeRenderer renderer;
+    SpeculativeGenerator speculator(testOptions(&cache), renderer.fn());
+
+    renderer.block();
+    BarcodeConfig config;
+    speculator.activate(fakeDrawing(1), {"A1", "A2", "A3", "A4"}, config);
+    ASSERT_TRUE(renderer.waitForCalls(1));     // A1 is rendering
+
+    speculator.activate(fakeDrawing(2), {"B1"}, config);
+    renderer.release();
+    ASSERT_TRUE(speculator.waitIdle(5s));
+
+    // The render in flight is kept, the rest of drawing 1 is dropped
+    EXPECT_TRUE(cache.contains("A1", config));
+    EXPECT_FALSE(cache.contains("A2", config));
+    EXPECT_FALSE(cache.contains("A4", config));
+    EXPECT_TRUE(cache.contains("B1", config));
+    EXPECT_EQ(speculator.stats().cancelled, 3u);
+    EXPECT_EQ(renderer.callCount(), 2);
+}
+
+TEST(SpeculativeGeneratorTest, CancelStopsPendingWork) {
+    RenderCache cache;
+    FakeRenderer renderer;
+    SpeculativeGenerator speculator(testOptions(&cache), renderer.fn());
+
+    renderer.block();
+    speculator.activate(fakeDrawing(1), {"A1", "A2"}, BarcodeConfig());
+    ASSERT_TRUE(renderer.waitForCalls(1));
+    speculator.cancel();
+    renderer.release();
+    ASSERT_TRUE(speculator.waitIdle(5s));
+
+    EXPECT_EQ(speculator.activeDrawing(), nullptr);
+    EXPECT_FALSE(cache.contains("A2", BarcodeConfig()));
+    EXPECT_EQ(speculator.stats().cancelled, 1u);
+}
+
+TEST(SpeculativeGeneratorTest, ActivateDoesNotWaitForRendering) {
+    RenderCache cache;
+    FakeRenderer renderer;
+    renderer.delay = 100ms;
+    SpeculativeGenerator speculator(testOptions(&cache), renderer.fn());
+
+    auto start = std::chrono::steady_clock::now();
+    speculator.activate(fakeDrawing(1), {"A1", "A2", "A3"}, BarcodeConfig());
+    speculator.activate(fakeDrawing(2), {"B1", "B2", "B3"}, BarcodeConfig());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 50ms);
+    speculator.cancel();
+}
+
+TEST(SpeculativeGeneratorTest, DuplicateAndExcessPartsAreTrimmed) {
+    RenderCache cache;
+    FakeRenderer renderer;
+    SpeculationOptions options = testOptions(&cache);
+    options.maxParts = 2;
+    SpeculativeGenerator speculator(options, renderer.fn());
+
+    speculator.activate(fakeDrawing(1), {"A", "A", "", "B", "C"}, BarcodeConfig());
+    ASSERT_TRUE(speculator.waitIdle(5s));
+
+    EXPECT_EQ(renderer.callCount(), 2);
+    EXPECT_TRUE(cache.contains("B", BarcodeConfig()));
+    EXPECT_FALSE(cache.contains("C", BarcodeConfig()));
+}
+
+TEST(SpeculativeGeneratorTest, RenderFailuresAreCountedNotCached) {
+    RenderCache cache;
+    FakeRenderer renderer;
+    SpeculativeGenerator speculator(testOptions(&cache), renderer.fn());
+
+    speculator.activate(fakeDrawing(1), {"BROKEN", "FINE"}, BarcodeConfig());
+    ASSERT_TRUE(speculator.waitIdle(5s));
+
+    EXPECT_EQ(speculator.stats().failed, 1u);
+    EXPECT_EQ(speculator.stats().rendered, 1u);
+    EXPECT_FALSE(cache.contains("BROKEN", BarcodeConfig()));
+}
+
+TEST(SpeculativeGeneratorTest, DrawingActivationReachesTheCallback) {
+    creo_barcode::testing::resetSimulatedState();
+    DrawingInterface drawingInterface;
+    ProDrawing activated = nullptr;
+    int notifications = 0;
+    drawingInterface.setDrawingActivatedCallback([&](ProDrawing drawing) {
+        activated = drawing;
+        ++notifications;
+    });
+
+    creo_barcode::testing::simulateDrawingActivated(fakeDrawing(7));
+    EXPECT_EQ(activated, fakeDrawing(7));
+    EXPECT_TRUE(drawingInterface.isDrawingOpen());
+
+    creo_barcode::testing::simulateDrawingActivated(nullptr);
+    EXPECT_EQ(activated, nullptr);
+    EXPECT_FALSE(drawingInterface.isDrawingOpen());
+
+    drawingInterface.setDrawingActivatedCallback(nullptr);
+    creo_barcode::testing::simulateDrawingActivated(fakeDrawing(8));
+    EXPECT_EQ(notifications, 2);
+    creo_barcode::testing::resetSimulatedState();
+}
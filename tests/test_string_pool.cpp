@@ -0,0 +1,112 @@
+/**
+ * @file test_string_pool.cpp
+ * @brief Unit tests for StringPool and InternedString
+ */
+
+#include <gtest/gtest.h>
+#include "string_pool.h"
+#include "batch_processor.h"
+#include <cstring>
+#include <thread>
+
+using namespace creo_barcode;
+
+TEST(StringPoolTest, EqualStringsShareAHandle) {
+    StringPool pool;
+    std::string a = "PART_001";
+    std::string b = "PART_" + std::string("001");
+
+    InternedString ha = pool.intern(a);
+    InternedString hb = pool.intern(b);
+    EXPECT_EQ(ha, hb);
+    EXPECT_EQ(ha.c_str(), hb.c_str());
+    EXPECT_NE(ha, pool.intern("PART_002"));
+    EXPECT_EQ(pool.size(), 2u);
+}
+
+TEST(StringPoolTest, HandlesAreNulTerminatedCopies) {
+    StringPool pool;
+    std::string source = "ASM-100/REV_B";
+    InternedString handle = pool.intern(source);
+    source[0] = 'X';
+
+    EXPECT_EQ(handle.view(), "ASM-100/REV_B");
+    EXPECT_STREQ(handle.c_str(), "ASM-100/REV_B");
+    EXPECT_EQ(handle.size(), 13u);
+    EXPECT_EQ(handle.str(), "ASM-100/REV_B");
+}
+
+TEST(StringPoolTest, EmptyStringIsDefaultHandle) {
+    StringPool pool;
+    EXPECT_EQ(pool.intern(""), InternedString());
+    EXPECT_TRUE(pool.intern("").empty());
+    EXPECT_EQ(pool.size(), 0u);
+}
+
+TEST(StringPoolTest, FindDoesNotInsert) {
+    StringPool pool;
+    bool found = true;
+    pool.find("PART_001", found);
+    EXPECT_FALSE(found);
+    EXPECT_EQ(pool.size(), 0u);
+
+    InternedString handle = pool.intern("PART_001");
+    EXPECT_EQ(pool.find("PART_001", found), handle);
+    EXPECT_TRUE(found);
+}
+
+TEST(StringPoolTest, HandlesStayValidAsPoolGrows) {
+    StringPool pool;
+    InternedString first = pool.intern("PART_first");
+    std::string large(100000, 'L');
+    InternedString big = pool.intern(large);
+
+    for (int i = 0; i < 50000; ++i) {
+        pool.intern("PART_" + std::to_string(i));
+    }
+
+    EXPECT_STREQ(first.c_str(), "PART_first");
+    EXPECT_EQ(big.view(), large);
+    EXPECT_EQ(pool.intern("PART_first"), first);
+    EXPECT_GE(pool.memoryBytes(), large.size());
+}
+
+TEST(StringPoolTest, ConcurrentInternYieldsOneHandle) {
+    StringPool pool;
+    const int threads = 8;
+    const int names = 1000;
+    std::vector<std::vector<InternedString>> handles(threads);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&pool, &handles, t]() {
+            for (int i = 0; i < names; ++i) {
+                handles[t].push_back(pool.intern("PART_" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(pool.size(), static_cast<size_t>(names));
+    for (int t = 1; t < threads; ++t) {
+        for (int i = 0; i < names; ++i) {
+            ASSERT_EQ(handles[t][i], handles[0][i]);
+        }
+    }
+}
+
+TEST(StringPoolTest, BatchQueueLeavesTheGlobalPoolAlone) {
+    // Batch paths are unique per run; interning them would only grow the pool
+    BatchProcessor processor;
+    processor.addFiles({"queued_only.drw", "queued_only.drw"});
+    processor.addFile("queued_single.drw");
+    EXPECT_EQ(processor.getQueueSize(), 3u);
+
+    bool found = true;
+    StringPool::global().find("queued_only.drw", found);
+    EXPECT_FALSE(found);
+    StringPool::global().find("queued_single.drw", found);
+    EXPECT_FALSE(found);
+}
@@ -0,0 +1,264 @@
+/**
+ * @file test_sync_monitor.cpp
+ * @brief Unit tests for event-driven sync checking
+ */
+
+#include <gtest/gtest.h>
+#include "sync_monitor.h"
+#include "payload_index.h"
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace creo_barcode;
+using namespace std::chrono_literals;
+
+namespace creo_barcode {
+namespace testing {
+    void setSimulatedDrawingState(ProDrawing drawing, ProMdl model,
+                                  ModelType modelType, const std::string& partName);
+    void simulateModelRenamed(ProMdl model, const std::string& newName);
+    void simulateModelSaved(ProMdl model);
+    void simulateModelErased(ProMdl model);
+    void resetSimulatedState();
+}
+}
+
+namespace {
+
+ProMdl fakeModel(uintptr_t id) {
+    return reinterpret_cast<ProMdl>(id);
+}
+
+class SyncMonitorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        checker.setPayloadIndex(&index);
+        checker.setWarningDisplayCallback([this](const std::string&, const BarcodeInstance& instance) {
+            std::lock_guard<std::mutex> lock(mutex);
+            warnings.push_back(instance);
+        });
+    }
+
+    void addBarcode(const std::string& payload, const std::string& drawing, const std::string& image) {
+        index.add(payload, BarcodeLocation(drawing, 1, 10.0, 20.0, image));
+    }
+
+    // Shows the monitor's queued warnings here, as Creo's thread would
+    std::vector<BarcodeInstance> takeWarnings(SyncMonitor& monitor) {
+        monitor.dispatchWarnings();
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<BarcodeInstance> taken;
+        taken.swap(warnings);
+        return taken;
+    }
+
+    PayloadIndex index;
+    DataSyncChecker checker;
+    std::mutex mutex;
+    std::vector<BarcodeInstance> warnings;
+};
+
+} // anonymous namespace
+
+TEST_F(SyncMonitorTest, RenameWarnsOnlyForBarcodesOfThatModel) {
+    addBarcode("PART-A", "a.drw", "a1.png");
+    addBarcode("PART-A", "b.drw", "a2.png");
+    addBarcode("PART-B", "b.drw", "b1.png");
+    SyncMonitor monitor(checker, index, 10ms);
+
+    monitor.onModelRenamed(fakeModel(1), "PART-A", "PART-A2");
+    ASSERT_TRUE(monitor.waitIdle(5s));
+
+    auto raised = takeWarnings(monitor);
+    ASSERT_EQ(raised.size(), 2u);
+    for (const auto& instance : raised) {
+        EXPECT_EQ(instance.decodedData, "PART-A");
+        EXPECT_NE(instance.imagePath, "b1.png");
+    }
+    SyncMonitorStats stats = monitor.stats();
+    EXPECT_EQ(stats.barcodesChecked, 2u);
+    EXPECT_EQ(stats.outOfSync, 2u);
+}
+
+TEST_F(SyncMonitorTest, BurstOfEventsIsOnePass) {
+    addBarcode("PART-A", "a.drw", "a.png");
+    SyncMonitor monitor(checker, index, 100ms);
+
+    monitor.onModelRenamed(fakeModel(1), "PART-A", "PART-B");
+    monitor.onModelSaved(fakeModel(1), "PART-B");
+    monitor.onModelRenamed(fakeModel(1), "PART-B", "PART-C");
+    EXPECT_EQ(monitor.pendingModels(), 1u);
+    ASSERT_TRUE(monitor.waitIdle(5s));
+
+    SyncMonitorStats stats = monitor.stats();
+    EXPECT_EQ(stats.events, 3u);
+    EXPECT_EQ(stats.passes, 1u);
+    EXPECT_EQ(stats.modelsChecked, 1u);
+    EXPECT_EQ(takeWarnings(monitor).size(), 1u);
+}
+
+TEST_F(SyncMonitorTest, UndispatchedWarningsAreBounded) {
+    const size_t barcodes = SyncMonitor::MAX_PENDING_WARNINGS + 10;
+    for (size_t i = 0; i < barcodes; ++i) {
+        addBarcode("PART-A", "a.drw", "a" + std::to_string(i) + ".png");
+    }
+    SyncMonitor monitor(checker, index, 10ms);
+
+    monitor.onModelRenamed(fakeModel(1), "PART-A", "PART-B");
+    ASSERT_TRUE(monitor.waitIdle(5s));
+    EXPECT_EQ(monitor.pendingWarnings(), SyncMonitor::MAX_PENDING_WARNINGS);
+    EXPECT_EQ(monitor.stats().dropped, 10u);
+
+    auto raised = takeWarnings(monitor);
+    ASSERT_EQ(raised.size(), SyncMonitor::MAX_PENDING_WARNINGS);
+    EXPECT_EQ(raised.back().imagePath, "a" + std::to_string(barcodes - 1) + ".png");
+}
+
+TEST_F(SyncMonitorTest, RecheckReplacesTheQueuedWarning) {
+    addBarcode("PART-A", "a.drw", "a.png");
+    SyncMonitor monitor(checker, index, 10ms);
+
+    monitor.onModelRenamed(fakeModel(1), "PART-A", "PART-B");
+    ASSERT_TRUE(monitor.waitIdle(5s));
+    monitor.onModelRenamed(fakeModel(2), "PART-A", "PART-C");
+    ASSERT_TRUE(monitor.waitIdle(5s));
+
+    EXPECT_EQ(monitor.stats().outOfSync, 2u);
+    EXPECT_EQ(monitor.pendingWarnings(), 1u);
+    EXPECT_EQ(takeWarnings(monitor).size(), 1u);
+}
+
+TEST_F(SyncMonitorTest, RenamingBackRaisesNoWarning) {
+    addBarcode("PART-A", "a.drw", "a.png");
+    SyncMonitor monitor(checker, index, 50ms);
+
+    monitor.onModelRenamed(fakeModel(1), "PART-A", "PART-X");
+    monitor.onModelRenamed(fakeModel(1), "PART-X", "PART-A");
+    ASSERT_TRUE(monitor.waitIdle(5s));
+
+    EXPECT_TRUE(takeWarnings(monitor).empty());
+    EXPECT_EQ(monitor.stats().barcodesChecked, 1u);
+}
+
+TEST_F(SyncMonitorTest, SaveWithUnchangedNameFindsNothingOutOfSync) {
+    addBarcode("PART-A", "a.drw", "a.png");
+    SyncMonitor monitor(checker, index, 10ms);
+
+    monitor.onModelSaved(fakeModel(1), "PART-A");
+    ASSERT_TRUE(monitor.waitIdle(5s));
+
+    EXPECT_TRUE(takeWarnings(monitor).empty());
+    EXPECT_EQ(monitor.stats().barcodesChecked, 1u);
+}
+
+TEST_F(SyncMonitorTest, SaveUnderANewNameActsAsRename) {
+    addBarcode("PART-A", "a.drw", "a.png");
+    SyncMonitor monitor(checker, index, 10ms);
+
+    monitor.onModelSaved(fakeModel(1), "PART-A");
+    ASSERT_TRUE(monitor.waitIdle(5s));
+    monitor.onModelSaved(fakeModel(1), "PART-RENAMED");
+    ASSERT_TRUE(monitor.waitIdle(5s));
+
+    auto raised = takeWarnings(monitor);
+    ASSERT_EQ(raised.size(), 1u);
+    EXPECT_EQ(raised[0].imagePath, "a.png");
+}
+
+TEST_F(SyncMonitorTest, WarningsAreShownOnTheDispatchingThread) {
+    addBarcode("PART-A", "a.drw", "a.png");
+    std::thread::id shownOn;
+    checker.setWarningDisplayCallback([&](const std::string&, const BarcodeInstance&) {
+        shownOn = std::this_thread::get_id();
+    });
+    SyncMonitor monitor(checker, index, 10ms);
+
+    monitor.onModelRenamed(fakeModel(1), "PART-A", "PART-B");
+    ASSERT_TRUE(monitor.waitIdle(5s));
+    EXPECT_EQ(shownOn, std::thread::id());
+    EXPECT_EQ(monitor.pendingWarnings(), 1u);
+
+    EXPECT_EQ(monitor.dispatchWarnings(), 1u);
+    EXPECT_EQ(shownOn, std::this_thread::get_id());
+    EXPECT_EQ(monitor.pendingWarnings(), 0u);
+    EXPECT_EQ(monitor.dispatchWarnings(), 0u);
+    EXPECT_EQ(monitor.stats().dispatched, 1u);
+}
+
+TEST_F(SyncMonitorTest, ErasedModelIsForgotten) {
+    addBarcode("PART-A", "a.drw", "a.png");
+    SyncMonitor monitor(checker, index, 10ms);
+
+    monitor.onModelSaved(fakeModel(1), "PART-A");
+    ASSERT_TRUE(monitor.waitIdle(5s));
+    monitor.onModelErased(fakeModel(1));
+
+    // Same handle, different model: not a rename of PART-A
+    monitor.onModelSaved(fakeModel(1), "PART-OTHER");
+    ASSERT_TRUE(monitor.waitIdle(5s));
+    EXPECT_TRUE(takeWarnings(monitor).empty());
+    EXPECT_EQ(monitor.stats().barcodesChecked, 1u);
+}
+
+TEST_F(SyncMonitorTest, ModelsWithoutBarcodesCostNoChecks) {
+    for (int i = 0; i < 100; ++i) {
+        addBarcode("OTHER-" + std::to_string(i), "x.drw", std::to_string(i) + ".png");
+    }
+    SyncMonitor monitor(checker, index, 10ms);
+
+    monitor.onModelRenamed(fakeModel(1), "PART-A", "PART-B");
+    ASSERT_TRUE(monitor.waitIdle(5s));
+
+    EXPECT_EQ(monitor.stats().modelsChecked, 1u);
+    EXPECT_EQ(monitor.stats().barcodesChecked, 0u);
+}
+
+TEST_F(SyncMonitorTest, EncodedPayloadsAreMatched) {
+    BarcodeGenerator codec;
+    std::string name = "PART\tA";
+    addBarcode(codec.encodeSpecialChars(name), "a.drw", "a.png");
+    SyncMonitor monitor(checker, index, 10ms);
+
+    monitor.onModelRenamed(fakeModel(1), name, "PART-B");
+    ASSERT_TRUE(monitor.waitIdle(5s));
+
+    auto raised = takeWarnings(monitor);
+    ASSERT_EQ(raised.size(), 1u);
+    EXPECT_EQ(raised[0].decodedData, name);
+}
+
+TEST_F(SyncMonitorTest, DrawingInterfaceNotificationsReachTheMonitor) {
+    creo_barcode::testing::resetSimulatedState();
+    creo_barcode::testing::setSimulatedDrawingState(nullptr, fakeModel(1), ModelType::PART, "PART-A");
+    addBarcode("PART-A", "a.drw", "a.png");
+
+    SyncMonitor monitor(checker, index, 10ms);
+    DrawingInterface drawingInterface;
+    drawingInterface.setModelRenamedCallback(
+        [&](ProMdl model, const std::string& oldName, const std::string& newName) {
+            monitor.onModelRenamed(model, oldName, newName);
+        });
+    drawingInterface.setModelSavedCallback([&](ProMdl model) {
+        std::string name;
+        ASSERT_EQ(drawingInterface.getPartName(model, name), PRO_TK_NO_ERROR);
+        monitor.onModelSaved(model, name);
+    });
+    drawingInterface.setModelErasedCallback([&](ProMdl model) { monitor.onModelErased(model); });
+
+    creo_barcode::testing::simulateModelRenamed(fakeModel(1), "PART-B");
+    creo_barcode::testing::simulateModelSaved(fakeModel(1));
+    ASSERT_TRUE(monitor.waitIdle(5s));
+
+    EXPECT_EQ(monitor.stats().events, 2u);
+    EXPECT_EQ(takeWarnings(monitor).size(), 1u);
+
+    // After the erase, a save under another name is not a rename
+    creo_barcode::testing::simulateModelErased(fakeModel(1));
+    creo_barcode::testing::setSimulatedDrawingState(nullptr, fakeModel(1), ModelType::PART, "PART-C");
+    creo_barcode::testing::simulateModelSaved(fakeModel(1));
+    ASSERT_TRUE(monitor.waitIdle(5s));
+    EXPECT_TRUE(takeWarnings(monitor).empty());
+    creo_barcode::testing::resetSimulatedState();
+}
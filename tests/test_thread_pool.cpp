@@ -0,0 +1,108 @@
+/**
+ * @file test_thread_pool.cpp
+ * @brief Unit tests for ThreadPool
+ */
+
+#include <gtest/gtest.h>
+#include "thread_pool.h"
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <stdexcept>
+
+using namespace creo_barcode;
+
+TEST(ThreadPoolTest, RunsAllSubmittedTasks) {
+    std::atomic<int> counter{0};
+    {
+        ThreadPool pool(4);
+        EXPECT_EQ(pool.threadCount(), 4u);
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_TRUE(pool.submit([&counter]() { counter.fetch_add(1); }));
+        }
+    }
+    // Destruction drains the queue
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(ThreadPoolTest, DefaultUsesAtLeastOneThread) {
+    ThreadPool pool;
+    EXPECT_GE(pool.threadCount(), 1u);
+}
+
+TEST(ThreadPoolTest, RejectsTasksAfterShutdown) {
+    ThreadPool pool(1);
+    pool.shutdown();
+    bool ran = false;
+    EXPECT_FALSE(pool.submit([&ran]() { ran = true; }));
+    pool.shutdown();
+    EXPECT_FALSE(ran);
+}
+
+TEST(ThreadPoolTest, ThrowingTaskDoesNotKillWorker) {
+    std::atomic<int> counter{0};
+    ThreadPool pool(1);
+    pool.submit([]() { throw std::runtime_error("task failed"); });
+    pool.submit([&counter]() { counter.fetch_add(1); });
+    pool.shutdown();
+    EXPECT_EQ(counter.load(), 1);
+}
+
+TEST(ThreadPoolTest, IdentifiesWorkerThreads) {
+    ThreadPool pool(2);
+    EXPECT_FALSE(pool.isWorkerThread());
+
+    std::atomic<bool> onWorker{false};
+    pool.submit([&]() { onWorker = pool.isWorkerThread(); });
+    pool.shutdown();
+    EXPECT_TRUE(onWorker.load());
+}
+
+TEST(ThreadPoolTest, TasksRunConcurrently) {
+    ThreadPool pool(4);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic<int> arrived{0};
+
+    for (int i = 0; i < 4; ++i) {
+        pool.submit([&]() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                threads.insert(std::this_thread::get_id());
+            }
+            // Every task waits for the others, so they must overlap
+            arrived.fetch_add(1);
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (arrived.load() < 4 && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    pool.shutdown();
+    EXPECT_EQ(arrived.load(), 4);
+    EXPECT_EQ(threads.size(), 4u);
+}
+
+TEST(ThreadPoolTest, AsyncReturnsValuesAndExceptions) {
+    ThreadPool pool(2);
+    auto value = pool.async([]() { return 42; });
+    auto failure = pool.async([]() -> int { throw std::runtime_error("bad task"); });
+
+    EXPECT_EQ(value.get(), 42);
+    EXPECT_THROW(failure.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, AsyncRunsInlineAfterShutdown) {
+    ThreadPool pool(1);
+    pool.shutdown();
+    auto caller = std::this_thread::get_id();
+    auto future = pool.async([]() { return std::this_thread::get_id(); });
+    EXPECT_EQ(future.get(), caller);
+}
+
+TEST(ThreadPoolTest, SharedPoolIsSingleton) {
+    ThreadPool& shared = ThreadPool::shared();
+    EXPECT_EQ(&shared, &ThreadPool::shared());
+    EXPECT_GE(shared.threadCount(), 1u);
+    EXPECT_EQ(shared.async([]() { return 7; }).get(), 7);
+}
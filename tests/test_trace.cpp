@@ -0,0 +1,181 @@
+/**
+ * @file test_trace.cpp
+ * @brief Unit tests for Tracer, TraceScope and Chrome trace export
+ */
+
+#include <gtest/gtest.h>
+#include "trace.h"
+#include "batch_processor.h"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <thread>
+
+using namespace creo_barcode;
+
+namespace {
+
+class TraceTest : public ::testing::Test {
+protected:
+    void TearDown() override { Tracer::getInstance().stop(); }
+};
+
+size_t countNamed(const std::vector<TraceEvent>& events, const std::string& name) {
+    size_t count = 0;
+    for (const auto& event : events) {
+        if (name == event.name) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // anonymous namespace
+
+TEST_F(TraceTest, DisabledScopesRecordNothing) {
+    Tracer& tracer = Tracer::getInstance();
+    tracer.start();
+    tracer.stop();
+    {
+        TRACE_SCOPE("test", "ignored");
+    }
+    EXPECT_TRUE(tracer.collectEvents().empty());
+}
+
+TEST_F(TraceTest, NestedScopesAreContained) {
+    Tracer& tracer = Tracer::getInstance();
+    tracer.start();
+    {
+        TRACE_SCOPE_DETAIL("test", "outer", "PART_001");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        {
+            TRACE_SCOPE("test", "inner");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    tracer.stop();
+
+    auto events = tracer.collectEvents();
+    ASSERT_EQ(events.size(), 2u);
+    const TraceEvent& outer = events[0];
+    const TraceEvent& inner = events[1];
+    EXPECT_STREQ(outer.name, "outer");
+    EXPECT_EQ(outer.detail.view(), "PART_001");
+    EXPECT_STREQ(inner.name, "inner");
+    EXPECT_GE(inner.durationNanos, 2000000u);
+    EXPECT_GE(inner.startNanos, outer.startNanos);
+    EXPECT_LE(inner.startNanos + inner.durationNanos, outer.startNanos + outer.durationNanos);
+    EXPECT_EQ(inner.threadIndex, outer.threadIndex);
+}
+
+TEST_F(TraceTest, StartDiscardsPreviousTrace) {
+    Tracer& tracer = Tracer::getInstance();
+    tracer.start();
+    {
+        TRACE_SCOPE("test", "old");
+    }
+    tracer.start();
+    {
+        TRACE_SCOPE("test", "new");
+    }
+    auto events = tracer.collectEvents();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_STREQ(events[0].name, "new");
+}
+
+TEST_F(TraceTest, ThreadsKeepSeparateBuffersAfterExit) {
+    Tracer& tracer = Tracer::getInstance();
+    tracer.start();
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([t]() {
+            Tracer::getInstance().setCurrentThreadName("worker " + std::to_string(t));
+            for (int i = 0; i < 100; ++i) {
+                TRACE_SCOPE("test", "work");
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    auto events = tracer.collectEvents();
+    EXPECT_EQ(countNamed(events, "work"), 400u);
+    std::set<uint32_t> threads;
+    for (const auto& event : events) {
+        threads.insert(event.threadIndex);
+    }
+    EXPECT_EQ(threads.size(), 4u);
+}
+
+TEST_F(TraceTest, ExportsChromeTraceJson) {
+    Tracer& tracer = Tracer::getInstance();
+    tracer.start();
+    tracer.setCurrentThreadName("test \"main\"");
+    {
+        TRACE_SCOPE_DETAIL("batch", "file", "C:\\drawings\\a.drw");
+    }
+    std::thread([]() { TRACE_SCOPE("generator", "png_write"); }).join();
+    tracer.stop();
+
+    std::string path = (std::filesystem::temp_directory_path() / "creo_trace_test.json").string();
+    ASSERT_TRUE(tracer.exportChromeTrace(path));
+
+    std::ifstream file(path);
+    nlohmann::json trace = nlohmann::json::parse(file);
+    ASSERT_TRUE(trace.contains("traceEvents"));
+
+    size_t complete = 0;
+    bool namedThread = false;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "X") {
+            ++complete;
+            EXPECT_TRUE(event.contains("ts"));
+            EXPECT_TRUE(event.contains("dur"));
+            if (event["name"] == "file") {
+                EXPECT_EQ(event["cat"], "batch");
+                EXPECT_EQ(event["args"]["detail"], "C:\\drawings\\a.drw");
+            }
+        } else if (event["ph"] == "M" && event["name"] == "thread_name") {
+            namedThread = namedThread || event["args"]["name"] == "test \"main\"";
+        }
+    }
+    EXPECT_EQ(complete, 2u);
+    EXPECT_TRUE(namedThread);
+    std::filesystem::remove(path);
+}
+
+TEST_F(TraceTest, BatchProcessorRecordsStages) {
+    Tracer& tracer = Tracer::getInstance();
+    tracer.start();
+
+    BatchProcessor processor;
+    processor.addFiles({"missing_a.drw", "missing_b.drw"});
+    processor.process(BarcodeConfig());
+    tracer.stop();
+
+    auto events = tracer.collectEvents();
+    EXPECT_EQ(countNamed(events, "process"), 1u);
+    EXPECT_EQ(countNamed(events, "file"), 2u);
+    EXPECT_EQ(countNamed(events, "file_probe"), 2u);
+}
+
+TEST_F(TraceTest, EnabledScopeCost) {
+    Tracer& tracer = Tracer::getInstance();
+    tracer.start();
+
+    const int scopes = 200000;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < scopes; ++i) {
+        TRACE_SCOPE("test", "cost");
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    tracer.stop();
+
+    EXPECT_EQ(countNamed(tracer.collectEvents(), "cost"), static_cast<size_t>(scopes));
+    double nsPerScope = std::chrono::duration<double, std::nano>(elapsed).count() / scopes;
+    RecordProperty("enabled_ns_per_scope", std::to_string(nsPerScope));
+}
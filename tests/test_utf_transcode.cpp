@@ -0,0 +1,170 @@
+/**
+ * @file test_utf_transcode.cpp
+ * @brief Unit tests for the UTF-8 <-> UTF-16/wide transcoder
+ */
+
+#include <gtest/gtest.h>
+#include "utf_transcode.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace creo_barcode;
+
+namespace {
+
+std::u16string toUtf16(const std::string& utf8) {
+    std::u16string out(utf8.size(), u'\0');
+    utf::TranscodeResult result = utf::utf8ToUtf16(utf8.data(), utf8.size(), out.data(), out.size());
+    EXPECT_TRUE(result.ok());
+    EXPECT_EQ(result.read, utf8.size());
+    out.resize(result.written);
+    return out;
+}
+
+std::string fromUtf16(const std::u16string& utf16) {
+    std::string out(utf16.size() * 3, '\0');
+    utf::TranscodeResult result = utf::utf16ToUtf8(utf16.data(), utf16.size(), out.data(), out.size());
+    EXPECT_TRUE(result.ok());
+    out.resize(result.written);
+    return out;
+}
+
+} // anonymous namespace
+
+TEST(UtfTranscodeTest, AsciiRoundTripsAcrossBlockBoundaries) {
+    for (size_t length = 0; length < 70; ++length) {
+        std::string ascii;
+        for (size_t i = 0; i < length; ++i) {
+            ascii.push_back(static_cast<char>('!' + i % 90));
+        }
+        std::u16string wide = toUtf16(ascii);
+        ASSERT_EQ(wide.size(), length);
+        for (size_t i = 0; i < length; ++i) {
+            EXPECT_EQ(wide[i], static_cast<char16_t>(ascii[i]));
+        }
+        EXPECT_EQ(fromUtf16(wide), ascii);
+    }
+}
+
+TEST(UtfTranscodeTest, ConvertsMultiByteCharacters) {
+    // "零件-é-😀" : CJK (3 bytes), Latin-1 (2 bytes), astral (4 bytes)
+    std::string utf8 = "\xE9\x9B\xB6\xE4\xBB\xB6-\xC3\xA9-\xF0\x9F\x98\x80";
+    std::u16string expected = u"零件-é-\U0001F600";
+
+    EXPECT_EQ(utf::utf16Length(utf8.data(), utf8.size()), expected.size());
+    EXPECT_EQ(toUtf16(utf8), expected);
+    EXPECT_EQ(utf::utf8Length(expected.data(), expected.size()), utf8.size());
+    EXPECT_EQ(fromUtf16(expected), utf8);
+}
+
+TEST(UtfTranscodeTest, MixedTextAroundAsciiRuns) {
+    std::string utf8 = std::string(40, 'A') + "\xC3\xA9" + std::string(33, 'b') +
+                       "\xE4\xBB\xB6" + std::string(16, 'c');
+    std::u16string wide = toUtf16(utf8);
+    EXPECT_EQ(wide.size(), 40u + 1 + 33 + 1 + 16);
+    EXPECT_EQ(wide[40], u'é');
+    EXPECT_EQ(wide[74], u'件');
+    EXPECT_EQ(fromUtf16(wide), utf8);
+}
+
+TEST(UtfTranscodeTest, ReplacesInvalidUtf8) {
+    struct Case {
+        std::string input;
+        std::u16string expected;
+    };
+    std::vector<Case> cases = {
+        {"\x80", u"�"},                          // lone continuation
+        {"a\xC3", u"a�"},                        // truncated 2-byte
+        {"\xC0\xAF", u"��"},                // overlong lead
+        {"\xE0\x80\xAF", u"���"},      // overlong 3-byte
+        {"\xED\xA0\x80", u"���"},      // encoded surrogate
+        {"\xF4\x90\x80\x80", u"����"},  // above U+10FFFF
+        {"\xE4\xBBx", u"�x"},                    // maximal subpart, then ASCII
+        {"\xFF", u"�"},
+    };
+    for (const auto& c : cases) {
+        EXPECT_EQ(toUtf16(c.input), c.expected);
+        EXPECT_EQ(utf::utf16Length(c.input.data(), c.input.size()), c.expected.size());
+    }
+}
+
+TEST(UtfTranscodeTest, ReplacesUnpairedSurrogates) {
+    std::u16string lone = {u'a', static_cast<char16_t>(0xD800), u'b', static_cast<char16_t>(0xDC00)};
+    EXPECT_EQ(fromUtf16(lone), "a\xEF\xBF\xBD" "b\xEF\xBF\xBD");
+    EXPECT_EQ(utf::utf8Length(lone.data(), lone.size()), 8u);
+}
+
+TEST(UtfTranscodeTest, StopsBeforeCharacterThatDoesNotFit) {
+    std::string utf8 = "ab\xF0\x9F\x98\x80" "c";
+    char16_t out[3];
+    utf::TranscodeResult result = utf::utf8ToUtf16(utf8.data(), utf8.size(), out, 3);
+    EXPECT_EQ(result.status, utf::TranscodeStatus::OUTPUT_TOO_SMALL);
+    EXPECT_EQ(result.written, 2u);  // the surrogate pair needs two units
+    EXPECT_EQ(result.read, 2u);
+
+    std::u16string wide = u"x件";
+    char bytes[3];
+    result = utf::utf16ToUtf8(wide.data(), wide.size(), bytes, sizeof(bytes));
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(result.written, 1u);
+    EXPECT_EQ(result.read, 1u);
+}
+
+TEST(UtfTranscodeTest, TruncatedAsciiKeepsPrefix) {
+    std::string ascii(100, 'z');
+    wchar_t out[40];
+    utf::TranscodeResult result = utf::utf8ToWide(ascii.data(), ascii.size(), out, 40);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(result.written, 40u);
+    EXPECT_EQ(result.read, 40u);
+    EXPECT_EQ(out[39], L'z');
+}
+
+TEST(UtfTranscodeTest, WideStringsReuseCapacity) {
+    std::wstring wide;
+    std::string back;
+    std::string utf8 = "Drawing_\xE9\x9B\xB6\xE4\xBB\xB6_01.drw";
+
+    utf::utf8ToWide(utf8, wide);
+    EXPECT_EQ(wide, L"Drawing_零件_01.drw");
+    utf::wideToUtf8(wide, back);
+    EXPECT_EQ(back, utf8);
+
+    size_t capacity = back.capacity();
+    utf::wideToUtf8(L"short", back);
+    EXPECT_EQ(back, "short");
+    EXPECT_EQ(back.capacity(), capacity);
+
+    utf::utf8ToWide("", wide);
+    EXPECT_TRUE(wide.empty());
+}
+
+TEST(UtfTranscodeTest, WideHandlesAstralCharacters) {
+    std::string utf8 = "\xF0\x9F\x98\x80";
+    std::wstring wide;
+    utf::utf8ToWide(utf8, wide);
+    EXPECT_EQ(wide.size(), sizeof(wchar_t) == 2 ? 2u : 1u);
+    EXPECT_EQ(utf::wideLength(utf8.data(), utf8.size()), wide.size());
+    std::string back;
+    utf::wideToUtf8(wide, back);
+    EXPECT_EQ(back, utf8);
+}
+
+TEST(UtfTranscodeTest, AsciiThroughput) {
+    std::string path(4096, 'p');
+    std::wstring wide;
+    std::string back;
+    const int iterations = 2000;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        utf::utf8ToWide(path, wide);
+        utf::wideToUtf8(wide, back);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double mbPerSecond = (2.0 * path.size() * iterations) /
+                         std::chrono::duration<double>(elapsed).count() / 1e6;
+    RecordProperty("ascii_round_trip_mb_per_s", static_cast<int>(mbPerSecond));
+    EXPECT_EQ(back, path);
+}
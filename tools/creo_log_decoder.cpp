@@ -0,0 +1,53 @@
+/**
+ * @file creo_log_decoder.cpp
+ * @brief Command-line decoder for binary log files
+ *
+ * Usage: creo_log_decoder <file.blog> [--level VERBOSE|INFO|WARNING|ERROR]
+ */
+
+#include "binary_log.h"
+#include <cstring>
+#include <iostream>
+
+using namespace creo_barcode;
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <file.blog> [--level VERBOSE|INFO|WARNING|ERROR]" << std::endl;
+        return 2;
+    }
+
+    LogLevel minLevel = LogLevel::VERBOSE;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+            if (!logLevelFromString(argv[++i], minLevel)) {
+                std::cerr << "Unknown level: " << argv[i] << std::endl;
+                return 2;
+            }
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    BinaryLogDecoder decoder;
+    if (!decoder.open(argv[1])) {
+        ErrorInfo error = decoder.getLastError();
+        std::cerr << error.message << ": " << error.details << std::endl;
+        return 1;
+    }
+
+    DecodedLogEvent event;
+    while (decoder.next(event)) {
+        if (event.level >= minLevel) {
+            std::cout << BinaryLogDecoder::formatEvent(event) << '\n';
+        }
+    }
+
+    ErrorInfo error = decoder.getLastError();
+    if (!error.isSuccess()) {
+        std::cerr << error.message << ": " << error.details << std::endl;
+        return 1;
+    }
+    return 0;
+}